@@ -8,12 +8,18 @@ namespace D3D12TranslationLayer
     {
     public:
         HeapSuballocationBlock() : BlockAllocators::CGenericBlock<UINT64>(), m_pDirectHeapAllocation(nullptr) {}
-        HeapSuballocationBlock(UINT64 newOffset, UINT64 newSize, ID3D12Resource *pResource = nullptr) : BlockAllocators::CGenericBlock<UINT64>(newOffset, newSize), m_pDirectHeapAllocation(pResource) {}
+        HeapSuballocationBlock(UINT64 newOffset, UINT64 newSize, ID3D12Resource *pResource = nullptr, bool bRingAllocation = false) :
+            BlockAllocators::CGenericBlock<UINT64>(newOffset, newSize), m_pDirectHeapAllocation(pResource), m_bRingAllocation(bRingAllocation) {}
 
         bool IsDirectAllocation() const { return m_pDirectHeapAllocation; }
         ID3D12Resource *GetDirectHeapAllocation() const { assert(IsDirectAllocation()); return m_pDirectHeapAllocation; }
+
+        // Ring allocations come from a command list manager's upload ring, rather than from an allocator,
+        // and are recycled by the ring's fence ledger instead of the deferred deletion queue.
+        bool IsRingAllocation() const { return m_bRingAllocation; }
     private:
         ID3D12Resource *m_pDirectHeapAllocation;
+        bool m_bRingAllocation = false;
     };
 
     class ImmediateContext; // Forward Declaration
@@ -63,43 +69,59 @@ namespace D3D12TranslationLayer
 
     typedef DirectAllocator<HeapSuballocationBlock, InternalHeapAllocator, UINT64> DirectHeapAllocator;
     typedef BlockAllocators::CDisjointBuddyAllocator<HeapSuballocationBlock, InternalHeapAllocator, UINT64, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT> DisjointBuddyHeapAllocator;
+    typedef BlockAllocators::CDisjointTLSFAllocator<HeapSuballocationBlock, InternalHeapAllocator, UINT64, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT> DisjointTLSFHeapAllocator;
 
-    class ThreadSafeBuddyHeapAllocator : DisjointBuddyHeapAllocator
+    struct HeapSuballocatorUsage
+    {
+        UINT64 AllocatedBytes;
+        UINT64 CommittedBytes; // Space committed but not allocated is lost to fragmentation, or to partially used heaps
+    };
+
+    template <class SuballocationAllocator>
+    class ThreadSafeHeapAllocator : SuballocationAllocator
     {
     public:
         template <typename... InnerAllocatorArgs>
-        ThreadSafeBuddyHeapAllocator(UINT64 maxBlockSize, UINT64 threshold, bool bNeedsThreadSafety, InnerAllocatorArgs&&... innerArgs) : // throw(std::bad_alloc)
-            DisjointBuddyHeapAllocator(maxBlockSize, threshold, std::forward<InnerAllocatorArgs>(innerArgs)...),
+        ThreadSafeHeapAllocator(UINT64 maxBlockSize, UINT64 threshold, bool bNeedsThreadSafety, InnerAllocatorArgs&&... innerArgs) : // throw(std::bad_alloc)
+            SuballocationAllocator(maxBlockSize, threshold, std::forward<InnerAllocatorArgs>(innerArgs)...),
             m_Lock(bNeedsThreadSafety)
         {}
-        ThreadSafeBuddyHeapAllocator() = default;
-        ThreadSafeBuddyHeapAllocator(ThreadSafeBuddyHeapAllocator&&) = default;
-        ThreadSafeBuddyHeapAllocator& operator=(ThreadSafeBuddyHeapAllocator&&) = default;
+        ThreadSafeHeapAllocator() = default;
+        ThreadSafeHeapAllocator(ThreadSafeHeapAllocator&&) = default;
+        ThreadSafeHeapAllocator& operator=(ThreadSafeHeapAllocator&&) = default;
         
         HeapSuballocationBlock Allocate(UINT64 size)
         {
             auto scopedLock = m_Lock.TakeLock();
-            return DisjointBuddyHeapAllocator::Allocate(size);
+            return SuballocationAllocator::Allocate(size);
         }
 
         void Deallocate(const HeapSuballocationBlock &block)
         {
             auto scopedLock = m_Lock.TakeLock();
-            DisjointBuddyHeapAllocator::Deallocate(block);
+            SuballocationAllocator::Deallocate(block);
         }
 
         auto GetInnerAllocation(const HeapSuballocationBlock &block) const
         {
             auto scopedLock = m_Lock.TakeLock();
-            return DisjointBuddyHeapAllocator::GetInnerAllocation(block);
+            return SuballocationAllocator::GetInnerAllocation(block);
+        }
+
+        HeapSuballocatorUsage GetUsage()
+        {
+            auto scopedLock = m_Lock.TakeLock();
+            return { SuballocationAllocator::GetAllocatedSize(), SuballocationAllocator::GetCommittedSize() };
         }
 
         // Exposing methods that don't require locks.
-        using DisjointBuddyHeapAllocator::IsOwner;
+        using SuballocationAllocator::IsOwner;
 
     private:
         OptLock<> m_Lock;
     };
+    using ThreadSafeBuddyHeapAllocator = ThreadSafeHeapAllocator<DisjointBuddyHeapAllocator>;
+    using ThreadSafeTLSFHeapAllocator = ThreadSafeHeapAllocator<DisjointTLSFHeapAllocator>;
 
     // Allocator that will conditionally choose to individually allocate resources or suballocate based on a 
     // passed in function
@@ -158,6 +180,8 @@ namespace D3D12TranslationLayer
             else { return m_SuballocationAllocator.GetInnerAllocationOffset(block); }
         }
 
+        auto GetSuballocatorUsage() { return m_SuballocationAllocator.GetUsage(); }
+
     private:
         SuballocationAllocator m_SuballocationAllocator;
         DirectAllocator m_DirectAllocator;
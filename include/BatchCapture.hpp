@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+
+namespace D3D12TranslationLayer
+{
+    //==================================================================================================================================
+    // Batch capture
+    // Serializes BatchedContext command streams to a memory-mapped file, with object pointers replaced by stable IDs,
+    // so that they can be replayed offline through the BatchedContext dispatch table.
+    //
+    // File layout:
+    //   CaptureFileHeader
+    //   Repeated: CaptureBatchHeader, command data[CommandDataSize], CapturedObject[NumNewObjects]
+    //==================================================================================================================================
+    enum class CapturedObjectType : UINT
+    {
+        Resource,
+        SRV,
+        RTV,
+        DSV,
+        UAV,
+        VDOV,
+        VPIV,
+        VPOV,
+        View, // Untyped ViewBase
+        Sampler,
+        PipelineState,
+        Async,
+        Query,
+        Extension,
+    };
+
+    template <typename T> struct CapturedObjectTypeOf;
+    template <> struct CapturedObjectTypeOf<Resource> { static constexpr CapturedObjectType value = CapturedObjectType::Resource; };
+    template <> struct CapturedObjectTypeOf<SRV> { static constexpr CapturedObjectType value = CapturedObjectType::SRV; };
+    template <> struct CapturedObjectTypeOf<RTV> { static constexpr CapturedObjectType value = CapturedObjectType::RTV; };
+    template <> struct CapturedObjectTypeOf<DSV> { static constexpr CapturedObjectType value = CapturedObjectType::DSV; };
+    template <> struct CapturedObjectTypeOf<UAV> { static constexpr CapturedObjectType value = CapturedObjectType::UAV; };
+    template <> struct CapturedObjectTypeOf<VDOV> { static constexpr CapturedObjectType value = CapturedObjectType::VDOV; };
+    template <> struct CapturedObjectTypeOf<VPIV> { static constexpr CapturedObjectType value = CapturedObjectType::VPIV; };
+    template <> struct CapturedObjectTypeOf<VPOV> { static constexpr CapturedObjectType value = CapturedObjectType::VPOV; };
+    template <> struct CapturedObjectTypeOf<ViewBase> { static constexpr CapturedObjectType value = CapturedObjectType::View; };
+    template <> struct CapturedObjectTypeOf<Sampler> { static constexpr CapturedObjectType value = CapturedObjectType::Sampler; };
+    template <> struct CapturedObjectTypeOf<PipelineState> { static constexpr CapturedObjectType value = CapturedObjectType::PipelineState; };
+    template <> struct CapturedObjectTypeOf<Async> { static constexpr CapturedObjectType value = CapturedObjectType::Async; };
+    template <> struct CapturedObjectTypeOf<Query> { static constexpr CapturedObjectType value = CapturedObjectType::Query; };
+    template <> struct CapturedObjectTypeOf<BatchedExtension> { static constexpr CapturedObjectType value = CapturedObjectType::Extension; };
+
+    // Visits object pointers embedded in batched commands. Pointers are passed by reference and may be rewritten,
+    // which is how capture swaps them for IDs, and replay swaps them back.
+    struct CapturedObjectVisitor
+    {
+        virtual void VisitObject(CapturedObjectType Type, void*& pObject) = 0;
+
+        template <typename T> void operator()(T*& pObject)
+        {
+            VisitObject(CapturedObjectTypeOf<T>::value, reinterpret_cast<void*&>(pObject));
+        }
+        template <typename T, size_t N> void operator()(T* (&pObjects)[N])
+        {
+            for (auto& pObject : pObjects)
+            {
+                (*this)(pObject);
+            }
+        }
+    };
+
+    struct CaptureFileHeader
+    {
+        static constexpr UINT64 c_Magic = 0x5041434C54443344ull; // "D3DTLCAP"
+        static constexpr UINT c_Version = 1;
+
+        UINT64 Magic;
+        UINT Version;
+        UINT NumCommandTypes; // The command list must match between capture and replay.
+        UINT PointerSize;
+        UINT Reserved;
+    };
+
+    struct CaptureBatchHeader
+    {
+        UINT64 BatchID;
+        UINT64 CommandDataSize;
+        UINT NumCommands;
+        UINT NumNewObjects; // Objects seen for the first time in this batch.
+    };
+
+    struct CapturedObject
+    {
+        UINT64 ID;
+        CapturedObjectType Type;
+        UINT Reserved;
+    };
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    class BatchCaptureWriter : private CapturedObjectVisitor
+    {
+    public:
+        BatchCaptureWriter(const wchar_t* pFileName, UINT64 MaxFileSize); // throws
+
+        // Appends a batch. Nested command list batches are flattened into the parent.
+        // Objects destroyed by the batch's post-batch actions are forgotten afterwards, so an object later
+        // created at the same address is captured under a new ID.
+        // Returns false once the file is full, after which further batches are dropped.
+        bool WriteBatch(BatchedContext::BatchStorage const& Commands,
+                        BatchedContext::PostBatchActionList const& PostBatchActions,
+                        uint64_t BatchID) noexcept;
+
+    private:
+        void VisitObject(CapturedObjectType Type, void*& pObject) final;
+        bool AppendCommands(BatchedContext::BatchStorage const& Commands, UINT& NumCommands) noexcept;
+        void* Reserve(UINT64 Size) noexcept;
+
+        MappedFile m_File;
+        UINT64 m_WriteOffset = 0;
+        bool m_bFull = false;
+
+        std::unordered_map<void*, UINT64> m_ObjectIDs;
+        UINT64 m_NextObjectID = 1; // IDs are never reused, 0 is null.
+        std::vector<CapturedObject> m_NewObjects;
+    };
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    class BatchReplayer : private CapturedObjectVisitor
+    {
+    public:
+        // Called the first time each object ID is encountered, returns the object to use in its place.
+        using ObjectResolver = std::function<void*(CapturedObjectType Type, UINT64 ID)>;
+
+        struct ReplayStatistics
+        {
+            UINT64 NumBatches;
+            UINT64 NumCommands;
+            UINT64 NumSkippedCommands; // Commands which reference data that isn't captured, e.g. upload heap contents.
+        };
+
+        BatchReplayer(const wchar_t* pFileName, ObjectResolver Resolver); // throws
+
+        // Dispatches the next captured batch into ImmCtx. Returns false once the capture is exhausted.
+        bool ReplayNextBatch(ImmediateContext& ImmCtx); // throws
+        // Rewinds to the first batch. Resolved objects are retained.
+        void Rewind() noexcept { m_ReadOffset = sizeof(CaptureFileHeader); }
+
+        ReplayStatistics const& GetStatistics() const noexcept { return m_Stats; }
+
+    private:
+        void VisitObject(CapturedObjectType Type, void*& pObject) final;
+
+        MappedFile m_File;
+        UINT64 m_ReadOffset = sizeof(CaptureFileHeader);
+        ObjectResolver m_Resolver;
+        std::unordered_map<UINT64, void*> m_Objects;
+        std::vector<BatchedContext::BatchPrimitive> m_CommandScratch;
+        ReplayStatistics m_Stats = {};
+    };
+}
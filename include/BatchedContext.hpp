@@ -6,36 +6,164 @@ namespace D3D12TranslationLayer
 {
 
 class BatchedQuery;
+class BatchCaptureWriter;
+struct CapturedObjectVisitor;
 
 struct BatchedExtension
 {
     virtual void Dispatch(ImmediateContext& ImmCtx, const void* pData, size_t DataSize) = 0;
 };
 
+// Decides how eagerly the recording thread hands batches to the worker thread.
+// OnBatchSubmitted and the getters are called on the recording thread (under the recording lock),
+// OnBatchProcessed is called on the worker thread. Times are in QueryPerformanceCounter ticks.
+struct BatchKickoffPolicy
+{
+    virtual ~BatchKickoffPolicy() = default;
+
+    // Number of commands recorded between checks for an idle worker thread.
+    virtual UINT GetKickoffThreshold() noexcept = 0;
+    // Number of queued batches at which the recording thread blocks. Clamped to BatchedContext::c_MaxOutstandingBatches.
+    virtual UINT GetMaxOutstandingBatches() noexcept = 0;
+
+    // RecordingTicks estimates the time the recording thread spent recording the batch's commands, and is 0 if none of them
+    // were recorded on that thread (e.g. the batch only executes nested command list batches).
+    virtual void OnBatchSubmitted(UINT NumCommands, UINT NumOutstandingBatches, UINT64 RecordingTicks) noexcept = 0;
+    virtual void OnBatchProcessed(UINT NumCommands, UINT64 ProcessingTicks) noexcept = 0;
+};
+
+// The historical behavior: check for an idle worker every N commands, and allow a fixed queue depth.
+class FixedBatchKickoffPolicy : public BatchKickoffPolicy
+{
+    const UINT m_KickoffThreshold;
+    const UINT m_MaxOutstandingBatches;
+
+public:
+    FixedBatchKickoffPolicy(UINT KickoffThreshold, UINT MaxOutstandingBatches) noexcept
+        : m_KickoffThreshold(KickoffThreshold)
+        , m_MaxOutstandingBatches(MaxOutstandingBatches)
+    {
+    }
+
+    UINT GetKickoffThreshold() noexcept final { return m_KickoffThreshold; }
+    UINT GetMaxOutstandingBatches() noexcept final { return m_MaxOutstandingBatches; }
+    void OnBatchSubmitted(UINT, UINT, UINT64) noexcept final { }
+    void OnBatchProcessed(UINT, UINT64) noexcept final { }
+};
+
+// Sizes the kickoff threshold so that each idle check hands the worker roughly c_TargetBatchSeconds of work,
+// based on exponentially-weighted moving averages of the per-command dispatch cost on the worker and the
+// per-command recording cost on the app thread. When batches start to queue up, checks are spread further
+// apart, and the queue depth is capped so that queued work doesn't exceed c_MaxQueuedSeconds.
+class AdaptiveBatchKickoffPolicy : public BatchKickoffPolicy
+{
+public:
+    static constexpr UINT c_InitialKickoffThreshold = 10;
+    static constexpr UINT c_MinKickoffThreshold = 4;
+    static constexpr UINT c_MaxKickoffThreshold = 512;
+    static constexpr UINT c_MinOutstandingBatches = 2;
+    static constexpr UINT c_MaxOutstandingBatches = 5;
+    static constexpr double c_EWMAWeight = 1.0 / 16.0;
+    static constexpr double c_TargetBatchSeconds = 50e-6;
+    static constexpr double c_MaxQueuedSeconds = 4e-3;
+
+    AdaptiveBatchKickoffPolicy() noexcept;
+
+    UINT GetKickoffThreshold() noexcept final { return m_KickoffThreshold; }
+    UINT GetMaxOutstandingBatches() noexcept final { return m_MaxOutstandingBatches; }
+    void OnBatchSubmitted(UINT NumCommands, UINT NumOutstandingBatches, UINT64 RecordingTicks) noexcept final;
+    void OnBatchProcessed(UINT NumCommands, UINT64 ProcessingTicks) noexcept final;
+
+private:
+    double m_TicksPerSecond;
+
+    // Written by the worker thread.
+    std::atomic<double> m_DispatchTicksPerCommand{ 0.0 };
+
+    // Recording thread state.
+    double m_RecordingTicksPerCommand = 0.0;
+    double m_CommandsPerBatch = 0.0;
+    double m_OutstandingBatches = 0.0;
+    UINT m_KickoffThreshold = c_InitialKickoffThreshold;
+    UINT m_MaxOutstandingBatches = c_MaxOutstandingBatches;
+};
+
+// Free batch pages, kept on an interlocked singly-linked list. The list header carries a sequence tag alongside the head pointer,
+// so the recording thread can pop pages while the worker pushes retired ones without a lock, and without ABA hazards.
+// Pages which sat unused on the list for a whole trim period are returned to the heap, so a single burst of large batches
+// doesn't pin its peak working set for the lifetime of the context.
+// Only one page size is pooled. segmented_stack fixes its segment size at compile time, so larger size classes (and large-page
+// backing, which only pays off for them) would first need BatchStorage to pick its segment size per batch.
 class FreePageContainer
 {
-    OptLock<> m_CS;
-    void* m_FreePageHead = nullptr;
+    SLIST_HEADER m_FreePages;
+    // Smallest depth the list has reached since the last trim, i.e. how many pages went unused.
+    std::atomic<USHORT> m_LowWaterMark{ 0 };
+    std::atomic<UINT> m_NumChainsAdded{ 0 };
+
+    static constexpr UINT c_TrimPeriod = 64; // In retired batches
+
+    void Trim() noexcept;
 
 public:
-    class LockedAdder
+    // Accumulates pages into a local chain, which is published to the free list with a single interlocked operation.
+    class Adder
     {
-        std::unique_lock<std::mutex> m_Lock;
-        void*& m_FreePageHead;
+        FreePageContainer& m_Container;
+        PSLIST_ENTRY m_pFirst = nullptr;
+        PSLIST_ENTRY m_pLast = nullptr;
+        ULONG m_Count = 0;
 
     public:
         void AddPage(void* pPage) noexcept;
-        LockedAdder(FreePageContainer& Container) noexcept
-            : m_Lock(Container.m_CS.TakeLock())
-            , m_FreePageHead(Container.m_FreePageHead)
-        {
-        }
+        Adder(FreePageContainer& Container) noexcept : m_Container(Container) {}
+        ~Adder();
     };
-    FreePageContainer(bool bAllocCS) : m_CS(bAllocCS) {}
+    FreePageContainer() noexcept { InitializeSListHead(&m_FreePages); }
     ~FreePageContainer();
     void* RemovePage() noexcept;
 };
 
+// Shadow copies of the bindings the recording thread has sent to the immediate context, so redundant binds never make it
+// into a batch. Each Filter method returns false if the bind changes nothing. Otherwise it updates the shadow state, and
+// narrows range binds to [First, Last), the smallest range of their entries which changes something.
+class BatchedBindFilter
+{
+    struct SStageShadowState
+    {
+        SRV* m_SRVs[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT] = {};
+        Sampler* m_Samplers[D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT] = {};
+        Resource* m_CBs[D3D11_COMMONSHADER_CONSTANT_BUFFER_HW_SLOT_COUNT] = {};
+        UINT m_CBFirstConstant[D3D11_COMMONSHADER_CONSTANT_BUFFER_HW_SLOT_COUNT] = {};
+        UINT m_CBNumConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_HW_SLOT_COUNT] = {};
+    };
+    SStageShadowState m_StageState[ShaderStageCount];
+    Resource* m_VBs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
+    UINT m_VBStrides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
+    UINT m_VBOffsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
+    PipelineState* m_pPSO = nullptr;
+    FLOAT m_BlendFactor[4] = {};
+
+public:
+    bool FilterPipelineState(PipelineState* pPSO) noexcept;
+    bool FilterShaderResources(EShaderStage Stage, UINT StartSlot, UINT NumSRVs, SRV* const* ppSRVs, UINT& First, UINT& Last) noexcept;
+    bool FilterSamplers(EShaderStage Stage, UINT StartSlot, UINT NumSamplers, Sampler* const* ppSamplers, UINT& First, UINT& Last) noexcept;
+    // Null offsets and sizes bind the whole buffer, which the immediate context tracks as the maximum size.
+    bool FilterConstantBuffers(EShaderStage Stage, UINT StartSlot, UINT NumBuffers, Resource* const* ppCBs,
+                               const UINT* pFirstConstant, const UINT* pNumConstants, UINT& First, UINT& Last) noexcept;
+    bool FilterVertexBuffers(UINT StartSlot, UINT NumBuffers, Resource* const* ppVBs, const UINT* pStrides, const UINT* pOffsets,
+                             UINT& First, UINT& Last) noexcept;
+    bool FilterBlendFactor(const FLOAT BlendFactor[4]) noexcept;
+
+    // A pipeline state unbinds itself from the immediate context when it's destroyed, and a new one can then be created at the
+    // same address, so the shadow mustn't hold on to it. Other objects stay bound until the app unbinds them.
+    void ObjectDestroyed(PipelineState* pPSO) noexcept;
+    template <typename T> void ObjectDestroyed(T*) noexcept {}
+
+    // Matches the immediate context's cleared state.
+    void Clear() noexcept;
+};
+
 class BatchedContext
 {
 private:
@@ -53,6 +181,145 @@ public:
     using BatchStorage = segmented_stack<BatchPrimitive, BatchSizeInBytes / sizeof(BatchPrimitive), BatchStorageAllocator>;
     static constexpr UINT c_MaxOutstandingBatches = 5;
 
+    // Deferred work, mostly object destruction, to run once a batch has been processed. Actions are stored inline in pages
+    // from the batch page allocator, so they're recycled along with batch commands instead of churning the heap.
+    // Each entry is a header followed by its payload. Every entry is consumed exactly once: either run by Execute, or
+    // destroyed without running when that doesn't happen (an earlier action errors out, or the list is torn down).
+    // Destroying an entry still deletes or releases the object it owns.
+    class PostBatchActionList
+    {
+    public:
+        PostBatchActionList(std::nothrow_t, BatchStorageAllocator const& allocator) noexcept
+            : m_Storage(std::nothrow, allocator)
+        {
+        }
+        PostBatchActionList(BatchStorageAllocator const& allocator) // throw( bad_alloc )
+            : m_Storage(allocator)
+        {
+        }
+        PostBatchActionList(PostBatchActionList&& other) noexcept
+            : m_Storage(std::move(other.m_Storage))
+        {
+        }
+        PostBatchActionList& operator=(PostBatchActionList&& other) noexcept
+        {
+            DestroyPending();
+            m_Storage = std::move(other.m_Storage);
+            return *this;
+        }
+        ~PostBatchActionList() { DestroyPending(); }
+
+        template <typename T> void AddDelete(T* pObject) { Emplace(&InvokeDelete<T>, &InvokeDelete<T>, pObject, pObject); } // throw( bad_alloc )
+        void AddRelease(Resource* pResource) { Emplace(&InvokeRelease, &InvokeRelease, pResource, pResource); } // throw( bad_alloc )
+        // pDestroyedObject is the object the callable destroys, if any, see ForEachDestroyedObject.
+        template <typename TFunc> void AddCallable(TFunc&& f, void* pDestroyedObject = nullptr) // throw( bad_alloc )
+        {
+            using TCallable = std::decay_t<TFunc>;
+            if constexpr (sizeof(TCallable) <= c_MaxInlineCallableSize && alignof(TCallable) <= alignof(BatchPrimitive))
+            {
+                Emplace(&InvokeCallable<TCallable>, &DestroyCallable<TCallable>, pDestroyedObject, std::forward<TFunc>(f));
+            }
+            else
+            {
+                std::unique_ptr<TCallable> spCallable(new TCallable(std::forward<TFunc>(f)));
+                Emplace(&InvokeHeapCallable<TCallable>, &DestroyHeapCallable<TCallable>, pDestroyedObject, spCallable.get());
+                spCallable.release();
+            }
+        }
+
+        // Calls fn(void*) with each object that running the list will destroy. Used to drop bookkeeping
+        // keyed on object addresses, since the addresses are free to be reused afterwards.
+        template <typename TFn> void ForEachDestroyedObject(TFn&& fn) const
+        {
+            for (auto segmentIter = m_Storage.segments_begin();
+                 segmentIter != m_Storage.segments_end();
+                 ++segmentIter)
+            {
+                const BatchPrimitive* pEntry = segmentIter->begin();
+                while (pEntry < segmentIter->end())
+                {
+                    auto pHeader = reinterpret_cast<const ActionHeader*>(pEntry);
+                    pEntry = reinterpret_cast<const BatchPrimitive*>(pHeader + 1) + pHeader->PayloadSize;
+                    if (pHeader->pDestroyedObject)
+                    {
+                        fn(pHeader->pDestroyedObject);
+                    }
+                }
+            }
+        }
+
+        bool empty() noexcept { return m_Storage.empty(); }
+        void swap(PostBatchActionList& other) noexcept { m_Storage.swap(other.m_Storage); }
+
+        // Runs each action in the order it was added, and empties the list.
+        // If an action errors out, the remaining ones are destroyed without running before the error propagates.
+        void Execute();
+        // Destroys any actions that haven't run, and hands the pages back.
+        void ReturnPages(FreePageContainer::Adder& Adder) noexcept;
+
+    private:
+        // Runs the action, consuming its payload even if it throws.
+        using InvokeFunction = void(*)(void* pPayload);
+        // Consumes the payload of an action that won't be run.
+        using DestroyFunction = void(*)(void* pPayload) noexcept;
+        struct alignas(BatchPrimitive) ActionHeader
+        {
+            InvokeFunction pfnInvoke;
+            DestroyFunction pfnDestroy; // Cleared once the entry is consumed.
+            void* pDestroyedObject;
+            UINT PayloadSize; // In BatchPrimitives
+        };
+        static constexpr size_t c_MaxInlineCallableSize = 256;
+
+        // Deletes and releases double as their own destroy functions, since the list owns the reference.
+        template <typename T> static void InvokeDelete(void* pPayload) noexcept { delete *static_cast<T**>(pPayload); }
+        static void InvokeRelease(void* pPayload) noexcept { (*static_cast<Resource**>(pPayload))->Release(); }
+        template <typename TCallable> static void InvokeCallable(void* pPayload)
+        {
+            auto& Callable = *static_cast<TCallable*>(pPayload);
+            auto Destroy = MakeScopeExit([&Callable]() { Callable.~TCallable(); });
+            Callable();
+        }
+        template <typename TCallable> static void DestroyCallable(void* pPayload) noexcept
+        {
+            static_cast<TCallable*>(pPayload)->~TCallable();
+        }
+        template <typename TCallable> static void InvokeHeapCallable(void* pPayload)
+        {
+            std::unique_ptr<TCallable> spCallable(*static_cast<TCallable**>(pPayload));
+            (*spCallable)();
+        }
+        template <typename TCallable> static void DestroyHeapCallable(void* pPayload) noexcept
+        {
+            delete *static_cast<TCallable**>(pPayload);
+        }
+
+        // Destroys every entry that hasn't been consumed, and empties the list.
+        void DestroyPending() noexcept;
+
+        template <typename TPayload> void Emplace(InvokeFunction pfnInvoke, DestroyFunction pfnDestroy, void* pDestroyedObject, TPayload&& Payload)
+        {
+            using T = std::decay_t<TPayload>;
+            constexpr size_t PayloadSize = (sizeof(T) + sizeof(BatchPrimitive) - 1) / sizeof(BatchPrimitive);
+            constexpr size_t EntrySize = sizeof(ActionHeader) / sizeof(BatchPrimitive) + PayloadSize;
+            if (!m_Storage.reserve_contiguous(EntrySize))
+            {
+                throw std::bad_alloc();
+            }
+
+            // Only commit the entry once the payload is constructed, in case that throws.
+            auto pHeader = reinterpret_cast<ActionHeader*>(m_Storage.append_contiguous_manually());
+            new (pHeader + 1) T(std::forward<TPayload>(Payload));
+            pHeader->pfnInvoke = pfnInvoke;
+            pHeader->pfnDestroy = pfnDestroy;
+            pHeader->pDestroyedObject = pDestroyedObject;
+            pHeader->PayloadSize = static_cast<UINT>(PayloadSize);
+            (void)m_Storage.append_contiguous_manually(EntrySize);
+        }
+
+        BatchStorage m_Storage;
+    };
+
     class Batch
     {
         friend class BatchedContext;
@@ -60,18 +327,20 @@ public:
         uint64_t m_BatchID;
 
         BatchStorage m_BatchCommands;
-        std::vector<std::function<void()>> m_PostBatchFunctions;
+        PostBatchActionList m_PostBatchActions;
         UINT m_NumCommands;
+        UINT64 m_RecordingTicks = 0;
 
         // Used to check GPU completion. Guarded by submission lock.
         UINT m_FlushRequestedMask = 0;
 
         Batch(BatchStorageAllocator const& allocator)
             : m_BatchCommands(std::nothrow, allocator)
+            , m_PostBatchActions(std::nothrow, allocator)
         {
         }
         void Retire(FreePageContainer& FreePages) noexcept;
-        void PrepareToSubmit(BatchStorage BatchCommands, std::vector<std::function<void()>> PostBatchFunctions, uint64_t BatchID, UINT NumCommands, bool bFlushImmCtxAfterBatch);
+        void PrepareToSubmit(BatchStorage BatchCommands, PostBatchActionList PostBatchActions, uint64_t BatchID, UINT NumCommands, bool bFlushImmCtxAfterBatch);
     };
 
     static const void* AlignPtr(const void* pPtr) noexcept
@@ -513,6 +782,13 @@ public:
         bool CreatesAndDestroysAreMultithreaded : 1;
         bool SubmitBatchesToWorkerThread : 1;
         BatchedContext* pParentContext;
+        // Hand batches to the worker thread through a lock-free ring with spin-then-park waits,
+        // instead of a locked deque and kernel semaphores. Only meaningful with SubmitBatchesToWorkerThread.
+        bool UseLockFreeBatchQueue : 1;
+        // Use AdaptiveBatchKickoffPolicy instead of the fixed kickoff threshold. Ignored if pKickoffPolicy is provided.
+        bool UseAdaptiveBatchKickoff : 1;
+        // Optional, must outlive the context.
+        BatchKickoffPolicy* pKickoffPolicy;
     };
     struct Callbacks
     {
@@ -520,6 +796,21 @@ public:
         std::function<void()> PostSubmitCallback;
     };
 
+    // Cumulative since the context was created. Times are in QueryPerformanceCounter ticks.
+    struct BatchStatistics
+    {
+        UINT64 NumBatchesSubmitted;
+        UINT64 NumCommandsSubmitted;
+        UINT64 RecorderStallTicks; // Time the recording thread spent blocked waiting for the worker thread.
+        UINT64 NumElidedCommands; // Binds dropped on the recording thread because they matched the current state.
+        UINT64 ElapsedTicks;
+        UINT64 TicksPerSecond;
+
+        double BatchesPerSecond() const { return ElapsedTicks ? double(NumBatchesSubmitted) * TicksPerSecond / ElapsedTicks : 0.0; }
+        double CommandsPerBatch() const { return NumBatchesSubmitted ? double(NumCommandsSubmitted) / NumBatchesSubmitted : 0.0; }
+        double RecorderStallSeconds() const { return TicksPerSecond ? double(RecorderStallTicks) / TicksPerSecond : 0.0; }
+    };
+
     BatchedContext(ImmediateContext& ImmCtx, CreationArgs flags, Callbacks const& callbacks);
     ~BatchedContext();
 
@@ -542,21 +833,23 @@ public:
         return m_ImmCtx;
     }
 
-    template <typename TFunc> void AddPostBatchFunction(TFunc&& f)
+    template <typename TFunc> void AddPostBatchFunction(TFunc&& f, void* pDestroyedObject = nullptr)
     {
         auto Lock = m_RecordingLock.TakeLock();
-        m_PostBatchFunctions.emplace_back(std::forward<TFunc>(f));
+        m_PostBatchActions.AddCallable(std::forward<TFunc>(f), pDestroyedObject);
     }
     template <typename T>
     void TRANSLATION_API DeleteObject(T* pObject)
     {
-        AddPostBatchFunction([pObject]() { delete pObject; });
+        auto Lock = m_RecordingLock.TakeLock();
+        m_BindFilter.ObjectDestroyed(pObject);
+        m_PostBatchActions.AddDelete(pObject);
     }
     void TRANSLATION_API ReleaseResource(Resource* pResource)
     {
         auto Lock = m_RecordingLock.TakeLock();
         auto Size = pResource->GetResourceSize();
-        m_PostBatchFunctions.emplace_back([pResource]() { pResource->Release(); });
+        m_PostBatchActions.AddRelease(pResource);
         m_PendingDestructionMemorySize += Size;
         if (m_PendingDestructionMemorySize >= 64 * 1024 * 1024 ||
             pResource->Parent()->IsShared())
@@ -567,6 +860,8 @@ public:
 
     void TRANSLATION_API PostSubmit();
 
+    BatchStatistics TRANSLATION_API GetBatchStatistics() const;
+
     void TRANSLATION_API SetPipelineState(PipelineState* pPipeline);
 
     void TRANSLATION_API DrawInstanced(UINT countPerInstance, UINT instanceCount, UINT vertexStart, UINT instanceStart);
@@ -704,17 +999,32 @@ public:
             throw std::bad_alloc();
         }
 
+        const UINT64 SampleStartTime = BeginRecordingSample();
         void* pPtr = m_CurrentBatch.append_contiguous_manually(CommandSize / sizeof(BatchPrimitive));
         auto pExtensionCmd = new (pPtr) CmdExtension(pExt, nullptr, ExtensionSize);
         new (AlignPtr(pExtensionCmd + 1)) TExt(std::forward<Args>(args)...);
+        EndRecordingSample(SampleStartTime);
         ++m_CurrentCommandCount;
         SubmitBatchIfIdle();
     }
 
     using DispatcherFunction = void(*)(ImmediateContext&, const void*&);
+    using CommandVisitorFunction = void(*)(const void*&, CapturedObjectVisitor*);
 
     void ProcessBatchImpl(Batch* pBatchToProcess);
 
+    // Serializes every batch processed from now on to a file, which can be replayed with BatchReplayer.
+    // Capture silently stops once MaxFileSize is reached.
+    static constexpr UINT64 c_DefaultMaxCaptureFileSize = 1024ull * 1024 * 1024;
+    void TRANSLATION_API BeginCapture(const wchar_t* pFileName, UINT64 MaxFileSize = c_DefaultMaxCaptureFileSize); // throws
+    void TRANSLATION_API EndCapture();
+
+    // Visits the object pointers in the command at pCommandData, and advances it to the next command.
+    // The visitor may rewrite the pointers in place. Returns the command's value.
+    static UINT VisitCommandObjects(const void*& pCommandData, CapturedObjectVisitor* pVisitor);
+    static DispatcherFunction const* GetDispatchTable() noexcept;
+    static BatchStorage const& GetNestedBatchCommands(const void* pCommandData) noexcept;
+
 private:
     ImmediateContext& m_ImmCtx;
     const DispatcherFunction* const m_DispatchTable;
@@ -724,7 +1034,9 @@ private:
     template <typename TCmd> void AddToBatch(TCmd const& command)
     {
         auto Lock = m_RecordingLock.TakeLock();
+        const UINT64 SampleStartTime = BeginRecordingSample();
         AddToBatch(m_CurrentBatch, command);
+        EndRecordingSample(SampleStartTime);
 
         ++m_CurrentCommandCount;
         SubmitBatchIfIdle();
@@ -738,7 +1050,20 @@ private:
     bool WaitForSingleBatch(DWORD timeout);
     bool IsBatchThread();
 
+    void EnqueueBatch(std::unique_ptr<Batch> pBatch);
+    Batch* GetFrontQueuedBatch();
+    Batch* FindQueuedBatch(uint64_t BatchID);
+    bool QueuedBatchesEmpty();
+    void RetireFrontQueuedBatch();
+    void SignalBatchSubmitted();
+    void WaitForBatchSubmitted();
+    void SignalBatchConsumed();
+    bool WaitForBatchConsumed(DWORD timeout);
+    void WaitForSingleBatchAndRecordStall();
+    UINT GetMaxOutstandingBatches();
+
     void BatchThread();
+    void CaptureBatch(BatchStorage const& batch, PostBatchActionList const& PostBatchActions, uint64_t BatchID) noexcept;
 
     template <typename TFunc>
     bool SyncWithBatch(uint64_t& BatchID, bool DoNotFlush, TFunc&& GetImmObjectFenceValues);
@@ -750,18 +1075,43 @@ private: // Referenced by recording and batch threads
     SafeHANDLE m_BatchSubmittedSemaphore; // Signaled by recording thread to indicate new work available.
     SafeHANDLE m_BatchConsumedSemaphore; // Signaled by batch thread to indicate it's completed work, waited on by main thread when work submitted.
 
+    // Used in place of the semaphores and m_QueuedBatches when UseLockFreeBatchQueue is set.
+    // Pushes are lock-free, but retiring the front entry still happens under m_SubmissionLock so that
+    // SyncWithBatch can safely inspect queued batches.
+    static constexpr UINT c_BatchRingSize = 8;
+    static_assert(c_BatchRingSize > c_MaxOutstandingBatches, "Ring must hold every outstanding batch plus the one being submitted.");
+    std::optional<SPSCRing<Batch*, c_BatchRingSize>> m_BatchRing;
+    std::optional<SpinThenParkSemaphore> m_BatchSubmittedSignal;
+    std::optional<SpinThenParkSemaphore> m_BatchConsumedSignal;
+
     OptLock<> m_SubmissionLock{ m_CreationArgs.SubmitBatchesToWorkerThread }; // Synchronizes the deques and free page list.
     std::deque<std::unique_ptr<Batch>> m_QueuedBatches;
     std::deque<std::unique_ptr<Batch>> m_FreeBatches;
 
     // Note: Must be declared before BatchStorageAllocator
-    FreePageContainer m_FreePages{ m_CreationArgs.SubmitBatchesToWorkerThread };
+    FreePageContainer m_FreePages;
 
     uint64_t m_CompletedBatchID = 0;
 
     const Callbacks m_Callbacks;
     std::atomic<bool> m_bFlushPendingCallback;
 
+    std::unique_ptr<BatchKickoffPolicy> m_spOwnedKickoffPolicy;
+    BatchKickoffPolicy* m_pKickoffPolicy;
+
+    // Read by GetBatchStatistics from any thread.
+    LARGE_INTEGER m_CreationTime;
+    LARGE_INTEGER m_TimerFrequency;
+    std::atomic<UINT64> m_NumBatchesSubmitted{ 0 };
+    std::atomic<UINT64> m_NumCommandsSubmitted{ 0 };
+    std::atomic<UINT64> m_RecorderStallTicks{ 0 };
+    std::atomic<UINT64> m_NumElidedCommands{ 0 };
+
+    // Written by the recording thread, read by whichever thread processes batches.
+    std::mutex m_CaptureLock;
+    std::unique_ptr<BatchCaptureWriter> m_spCaptureWriter;
+    std::atomic<bool> m_bCapturing{ false };
+
 private: // Referenced by recording thread
     CBoundState<UAV, D3D11_1_UAV_SLOT_COUNT> m_UAVs;
     UINT m_NumScissors = 0;
@@ -769,6 +1119,9 @@ private: // Referenced by recording thread
     UINT m_NumViewports = 0;
     D3D12_VIEWPORT m_Viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE] = {};
 
+    // Pipeline states are also forgotten from DeleteObject, under the recording lock.
+    BatchedBindFilter m_BindFilter;
+
     void ClearStateImpl();
 
     const BatchStorageAllocator m_BatchStorageAllocator
@@ -780,13 +1133,43 @@ private: // Referenced by recording thread
     static constexpr UINT c_CommandKickoffMinThreshold = 10; // Arbitrary for now
     OptLock<std::recursive_mutex> m_RecordingLock{ m_CreationArgs.CreatesAndDestroysAreMultithreaded };
     UINT m_CurrentCommandCount = 0;
+    UINT m_NextKickoffCheckCommandCount = c_CommandKickoffMinThreshold;
     UINT m_NumOutstandingBatches = 0;
+
+    // Recording cost is sampled on one in every c_RecordingSampleInterval commands, so that the kickoff policy sees the time
+    // spent recording rather than the time between submissions, which includes whatever the app does between calls.
+    static constexpr UINT c_RecordingSampleInterval = 16;
+    UINT m_NumRecordedCommands = 0; // Excludes nested batches, which were recorded on other threads
+    UINT m_NumRecordingSamples = 0;
+    UINT64 m_SampledRecordingTicks = 0;
+    UINT64 BeginRecordingSample() noexcept
+    {
+        if (m_NumRecordedCommands++ % c_RecordingSampleInterval != 0)
+        {
+            return 0;
+        }
+        LARGE_INTEGER StartTime;
+        QueryPerformanceCounter(&StartTime);
+        return StartTime.QuadPart;
+    }
+    void EndRecordingSample(UINT64 StartTime) noexcept
+    {
+        if (StartTime != 0)
+        {
+            LARGE_INTEGER EndTime;
+            QueryPerformanceCounter(&EndTime);
+            m_SampledRecordingTicks += EndTime.QuadPart - StartTime;
+            ++m_NumRecordingSamples;
+        }
+    }
+    // Extrapolates the samples to all commands recorded since the last call.
+    UINT64 TakeRecordingTicks() noexcept;
     uint64_t m_RecordingBatchID = 1;
 
     BatchStorage m_CurrentBatch{ m_BatchStorageAllocator };
 
 private: // Written by non-recording application threads, read by recording thread
-    std::vector<std::function<void()>> m_PostBatchFunctions;
+    PostBatchActionList m_PostBatchActions{ m_BatchStorageAllocator };
     uint64_t m_PendingDestructionMemorySize = 0;
 };
 
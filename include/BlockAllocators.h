@@ -406,6 +406,95 @@ public:
     _SizeType GetInnerAllocationOffset(const _BlockType &block) const;
 };
 
+//================================================================================================
+// Uses two-level segregated fit (TLSF) to allocate offsets from a virtual resource, with an inner
+// allocator which allocates disjoint resources for each threshold-sized chunk of the range.
+// Unlike the buddy allocator, blocks are only rounded up to _MinBlockSize rather than to a power
+// of two, and both allocation and deallocation run in constant time. Blocks never straddle a chunk.
+// Bookkeeping is kept out of band, since the memory being managed may not be CPU-visible.
+//
+// Template parameters
+// _BlockType - Block class type
+// _InnerAllocator - Allocator which backs each chunk
+// _SizeType - Offset and Size types used by the block
+// _MinBlockSize - Allocation granularity
+template<class _BlockType, class _InnerAllocator, class _SizeType = SIZE_T, _SizeType _MinBlockSize = 1>
+class CDisjointTLSFAllocator
+{
+private:
+    using InnerAllocatorDecayed = typename std::decay<_InnerAllocator>::type;
+public:
+    typedef typename std::invoke_result<decltype(&InnerAllocatorDecayed::Allocate), InnerAllocatorDecayed, _SizeType>::type AllocationType;
+
+private:
+    // Sizes are in units of _MinBlockSize (granules). The first level splits sizes by power of two,
+    // the second level linearly subdivides each power of two. Sizes below c_SecondLevelCount map 1:1.
+    static constexpr UINT c_SecondLevelBits = 4;
+    static constexpr UINT c_SecondLevelCount = 1 << c_SecondLevelBits;
+    static constexpr UINT c_FirstLevelCount = 32 - c_SecondLevelBits + 1;
+    static constexpr UINT32 c_InvalidGranule = UINT32(-1);
+    static constexpr UINT32 c_FreeFlag = 0x80000000;
+
+    // Boundary tags are only meaningful on the first and last granule of a block,
+    // and free list links only on the first granule of a free block.
+    struct GranuleInfo
+    {
+        UINT32 m_SizeAndFlags = 0;
+        UINT32 m_PrevFree = c_InvalidGranule;
+        UINT32 m_NextFree = c_InvalidGranule;
+    };
+    std::vector<GranuleInfo> m_Granules;
+
+    struct RefcountedAllocation
+    {
+        UINT m_Refcount = 0;
+        AllocationType m_Allocation = AllocationType{};
+    };
+    std::vector<RefcountedAllocation> m_Allocations; // One per chunk
+
+    UINT32 m_FirstLevelBitmap = 0;
+    UINT32 m_SecondLevelBitmaps[c_FirstLevelCount] = {};
+    UINT32 m_FreeHeads[c_FirstLevelCount][c_SecondLevelCount] = {};
+
+    _SizeType m_Threshold = 0;
+    UINT32 m_GranulesPerChunk = 0;
+    UINT32 m_MaxChunks = 0;
+    _InnerAllocator m_InnerAllocator;
+
+    _SizeType m_AllocatedSize = 0;
+    UINT32 m_NumCommittedChunks = 0;
+
+    inline UINT BucketFromOffset(_SizeType offset) const { return UINT(offset / m_Threshold); }
+
+    static inline UINT Log2Floor(UINT32 value);
+    static inline void MapSize(UINT32 size, UINT &firstLevel, UINT &secondLevel);
+    inline void SetBlockTags(UINT32 granule, UINT32 size, bool bFree);
+    inline void InsertFreeBlock(UINT32 granule, UINT32 size);
+    inline void RemoveFreeBlock(UINT32 granule, UINT32 size);
+    inline UINT32 FindFreeBlock(UINT32 size) const;
+    inline void FreeBlock(UINT32 granule, UINT32 size);
+    inline bool AddChunk(); // throw(std::bad_alloc)
+
+public:
+    template <typename... InnerAllocatorArgs>
+    CDisjointTLSFAllocator(_SizeType maxBlockSize, _SizeType threshold, InnerAllocatorArgs&&... innerArgs);
+    CDisjointTLSFAllocator() = default;
+    CDisjointTLSFAllocator(CDisjointTLSFAllocator&&) = default;
+    CDisjointTLSFAllocator& operator=(CDisjointTLSFAllocator&&) = default;
+
+    _BlockType Allocate(_SizeType size);
+    void Deallocate(const _BlockType &block);
+    bool IsOwner(const _BlockType &block) const;
+    void Reset();
+
+    AllocationType GetInnerAllocation(const _BlockType &block) const;
+    _SizeType GetInnerAllocationOffset(const _BlockType &block) const;
+
+    // Committed chunks which aren't fully allocated are lost to fragmentation, or only partially used.
+    _SizeType GetAllocatedSize() const { return m_AllocatedSize; }
+    _SizeType GetCommittedSize() const { return _SizeType(m_NumCommittedChunks) * m_Threshold; }
+};
+
 //================================================================================================
 // On allocate uses the _BelowOrEqualAllocator if the size is <= _ThresholdValue and the
 // _AboveAllocator if the size is > _ThresholdValue 
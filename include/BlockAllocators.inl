@@ -348,4 +348,326 @@ _SizeType CDisjointBuddyAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBl
     return offset % m_Threshold;
 }
 
+//================================================================================================
+// class CDisjointTLSFAllocator
+//================================================================================================
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize> template <typename... InnerAllocatorArgs>
+CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::CDisjointTLSFAllocator(_SizeType maxBlockSize, _SizeType threshold, InnerAllocatorArgs&&... innerArgs)
+    : m_Threshold(threshold)
+    , m_GranulesPerChunk(UINT32(threshold / _MinBlockSize))
+    , m_MaxChunks(UINT32(maxBlockSize / threshold))
+    , m_InnerAllocator(std::forward<InnerAllocatorArgs>(innerArgs)...)
+{
+    // Chunks must be a power-of-two number of granules, so that a request for a whole chunk
+    // rounds up to the size class which holds whole chunks. Granule indices must fit in 31 bits.
+    assert((threshold / _MinBlockSize) * _MinBlockSize == threshold);
+    assert(0 == (m_GranulesPerChunk & (m_GranulesPerChunk - 1)));
+    assert(maxBlockSize / _MinBlockSize < c_FreeFlag);
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+UINT CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::Log2Floor(UINT32 value)
+{
+    assert(value != 0);
+    ULONG index;
+    _BitScanReverse(&index, value);
+    return index;
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+void CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::MapSize(UINT32 size, UINT &firstLevel, UINT &secondLevel)
+{
+    if (size < c_SecondLevelCount)
+    {
+        firstLevel = 0;
+        secondLevel = size;
+    }
+    else
+    {
+        UINT log2 = Log2Floor(size);
+        firstLevel = log2 - c_SecondLevelBits + 1;
+        secondLevel = (size >> (log2 - c_SecondLevelBits)) - c_SecondLevelCount;
+    }
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+void CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::SetBlockTags(UINT32 granule, UINT32 size, bool bFree)
+{
+    const UINT32 tag = size | (bFree ? c_FreeFlag : 0);
+    m_Granules[granule].m_SizeAndFlags = tag;
+    m_Granules[granule + size - 1].m_SizeAndFlags = tag;
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+void CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::InsertFreeBlock(UINT32 granule, UINT32 size)
+{
+    UINT firstLevel, secondLevel;
+    MapSize(size, firstLevel, secondLevel);
+
+    UINT32 &head = m_FreeHeads[firstLevel][secondLevel];
+    const bool bWasEmpty = (m_SecondLevelBitmaps[firstLevel] & (1u << secondLevel)) == 0;
+    m_Granules[granule].m_PrevFree = c_InvalidGranule;
+    m_Granules[granule].m_NextFree = bWasEmpty ? c_InvalidGranule : head;
+    if (!bWasEmpty)
+    {
+        m_Granules[head].m_PrevFree = granule;
+    }
+    head = granule;
+
+    m_SecondLevelBitmaps[firstLevel] |= (1u << secondLevel);
+    m_FirstLevelBitmap |= (1u << firstLevel);
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+void CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::RemoveFreeBlock(UINT32 granule, UINT32 size)
+{
+    UINT firstLevel, secondLevel;
+    MapSize(size, firstLevel, secondLevel);
+
+    const UINT32 prev = m_Granules[granule].m_PrevFree;
+    const UINT32 next = m_Granules[granule].m_NextFree;
+    if (next != c_InvalidGranule)
+    {
+        m_Granules[next].m_PrevFree = prev;
+    }
+    if (prev != c_InvalidGranule)
+    {
+        m_Granules[prev].m_NextFree = next;
+    }
+    else
+    {
+        assert(m_FreeHeads[firstLevel][secondLevel] == granule);
+        m_FreeHeads[firstLevel][secondLevel] = next;
+        if (next == c_InvalidGranule)
+        {
+            m_SecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+            if (m_SecondLevelBitmaps[firstLevel] == 0)
+            {
+                m_FirstLevelBitmap &= ~(1u << firstLevel);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+UINT32 CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::FindFreeBlock(UINT32 size) const
+{
+    // Round up to the start of the next size class, so that any block in the class that's found is large enough.
+    if (size >= c_SecondLevelCount)
+    {
+        size += (1u << (Log2Floor(size) - c_SecondLevelBits)) - 1;
+    }
+
+    UINT firstLevel, secondLevel;
+    MapSize(size, firstLevel, secondLevel);
+
+    UINT32 secondLevelMap = m_SecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+    if (secondLevelMap == 0)
+    {
+        const UINT32 firstLevelMap = m_FirstLevelBitmap & (~0u << (firstLevel + 1));
+        if (firstLevelMap == 0)
+        {
+            return c_InvalidGranule;
+        }
+        ULONG index;
+        _BitScanForward(&index, firstLevelMap);
+        firstLevel = index;
+        secondLevelMap = m_SecondLevelBitmaps[firstLevel];
+    }
+
+    ULONG index;
+    _BitScanForward(&index, secondLevelMap);
+    return m_FreeHeads[firstLevel][index];
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+void CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::FreeBlock(UINT32 granule, UINT32 size)
+{
+    // Coalesce with free neighbors, without crossing chunk boundaries.
+    const UINT32 chunkStart = granule - (granule % m_GranulesPerChunk);
+    if (granule != chunkStart)
+    {
+        const UINT32 prevTag = m_Granules[granule - 1].m_SizeAndFlags;
+        if (prevTag & c_FreeFlag)
+        {
+            const UINT32 prevSize = prevTag & ~c_FreeFlag;
+            granule -= prevSize;
+            size += prevSize;
+            RemoveFreeBlock(granule, prevSize);
+        }
+    }
+
+    const UINT32 next = granule + size;
+    if (next != chunkStart + m_GranulesPerChunk)
+    {
+        const UINT32 nextTag = m_Granules[next].m_SizeAndFlags;
+        if (nextTag & c_FreeFlag)
+        {
+            const UINT32 nextSize = nextTag & ~c_FreeFlag;
+            RemoveFreeBlock(next, nextSize);
+            size += nextSize;
+        }
+    }
+
+    SetBlockTags(granule, size, true);
+    InsertFreeBlock(granule, size);
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+bool CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::AddChunk() // throw(std::bad_alloc)
+{
+    if (m_Allocations.size() >= m_MaxChunks)
+    {
+        return false;
+    }
+
+    const UINT32 chunkStart = UINT32(m_Granules.size());
+    m_Allocations.emplace_back(); // throw(std::bad_alloc)
+    try
+    {
+        m_Granules.resize(chunkStart + m_GranulesPerChunk); // throw(std::bad_alloc)
+    }
+    catch (std::bad_alloc&)
+    {
+        m_Allocations.pop_back();
+        throw;
+    }
+
+    SetBlockTags(chunkStart, m_GranulesPerChunk, true);
+    InsertFreeBlock(chunkStart, m_GranulesPerChunk);
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+_BlockType CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::Allocate(_SizeType size) // throw(std::bad_alloc)
+{
+    if (size > m_Threshold)
+    {
+        throw(std::bad_alloc()); // Can't allocate a block that large
+    }
+
+    const UINT32 granules = max(UINT32((size + (_MinBlockSize - 1)) / _MinBlockSize), 1u);
+    UINT32 granule = FindFreeBlock(granules);
+    if (granule == c_InvalidGranule)
+    {
+        if (!AddChunk()) // throw(std::bad_alloc)
+        {
+            // The virtual range is exhausted, so return the NULL block type
+            return _BlockType(0, 0);
+        }
+        granule = FindFreeBlock(granules);
+        assert(granule != c_InvalidGranule);
+    }
+
+    const UINT32 blockSize = m_Granules[granule].m_SizeAndFlags & ~c_FreeFlag;
+    assert(blockSize >= granules);
+    RemoveFreeBlock(granule, blockSize);
+    if (blockSize > granules)
+    {
+        SetBlockTags(granule + granules, blockSize - granules, true);
+        InsertFreeBlock(granule + granules, blockSize - granules);
+    }
+    SetBlockTags(granule, granules, false);
+
+    RefcountedAllocation &allocation = m_Allocations[granule / m_GranulesPerChunk];
+    if (allocation.m_Refcount == 0)
+    {
+        try
+        {
+            allocation.m_Allocation = m_InnerAllocator.Allocate(m_Threshold); // throw(std::bad_alloc)
+        }
+        catch (...)
+        {
+            FreeBlock(granule, granules);
+            throw;
+        }
+    }
+
+    // No more exceptions
+    if (allocation.m_Refcount++ == 0)
+    {
+        ++m_NumCommittedChunks;
+    }
+    m_AllocatedSize += _SizeType(granules) * _MinBlockSize;
+
+    return _BlockType(_SizeType(granule) * _MinBlockSize, _SizeType(granules) * _MinBlockSize);
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+void CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::Deallocate(const _BlockType &block)
+{
+    assert(IsOwner(block));
+
+    const UINT32 granule = UINT32(block.GetOffset() / _MinBlockSize);
+    const UINT32 granules = UINT32(block.GetSize() / _MinBlockSize);
+    assert(m_Granules[granule].m_SizeAndFlags == granules);
+
+    RefcountedAllocation &allocation = m_Allocations[BucketFromOffset(block.GetOffset())];
+    assert(allocation.m_Refcount > 0);
+    if (--allocation.m_Refcount == 0)
+    {
+        m_InnerAllocator.Deallocate(allocation.m_Allocation);
+        --m_NumCommittedChunks;
+    }
+    m_AllocatedSize -= block.GetSize();
+
+    FreeBlock(granule, granules);
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+bool CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::IsOwner(const _BlockType &block) const
+{
+    return block.GetSize() <= m_Threshold && BucketFromOffset(block.GetOffset()) < m_Allocations.size();
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+void CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::Reset()
+{
+    for (RefcountedAllocation& Allocation : m_Allocations)
+    {
+        if (Allocation.m_Refcount > 0)
+        {
+            m_InnerAllocator.Deallocate(Allocation.m_Allocation);
+        }
+    }
+    m_Allocations.clear();
+    m_Granules.clear();
+    m_FirstLevelBitmap = 0;
+    std::fill(std::begin(m_SecondLevelBitmaps), std::end(m_SecondLevelBitmaps), 0u);
+    m_AllocatedSize = 0;
+    m_NumCommittedChunks = 0;
+    m_InnerAllocator.Reset();
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+auto CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::GetInnerAllocation(const _BlockType &block) const -> AllocationType
+{
+    assert(IsOwner(block));
+
+    UINT bucket = BucketFromOffset(block.GetOffset());
+    assert(m_Allocations[bucket].m_Refcount > 0);
+    return m_Allocations[bucket].m_Allocation;
+}
+
+//------------------------------------------------------------------------------------------------
+template<class _BlockType, class _InnerAllocator, class _SizeType, _SizeType _MinBlockSize>
+_SizeType CDisjointTLSFAllocator<_BlockType, _InnerAllocator, _SizeType, _MinBlockSize>::GetInnerAllocationOffset(const _BlockType &block) const
+{
+    assert(IsOwner(block));
+    return block.GetOffset() % m_Threshold;
+}
+
 } // namespace BlockAllocators
@@ -56,6 +56,19 @@ namespace D3D12TranslationLayer
         HANDLE GetEvent() noexcept { return m_hWaitEvent; }
         void AddResourceToResidencySet(Resource *pResource);
 
+        // Persistently-mapped linear ring for small uploads consumed by this manager's command lists. Allocations are fenced
+        // with the ID of the command list being recorded, and moved to the next one if it's submitted before they're released,
+        // and they're recycled without going through the suballocator or the deferred deletion queue.
+        static constexpr UINT64 cUploadRingSize = 4 * 1024 * 1024;
+        static constexpr UINT64 cUploadRingMaxAllocationSize = 64 * 1024;
+        static constexpr UINT64 cUploadRingAlignment = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+        bool TryAllocateFromUploadRing(UINT64 Size, _Out_ UINT64& Offset) noexcept;
+        // FenceValue is the ID of the command list which consumes the allocation.
+        void ReleaseUploadRingAllocation(UINT64 FenceValue) noexcept;
+        void ReclaimUploadRingSpace() noexcept;
+        ID3D12Resource* GetUploadRingResource() noexcept { return m_pUploadRing.get(); }
+        UploadRingStatistics GetUploadRingStatistics() const noexcept;
+
         UINT64 GetCommandListID() { return m_commandListID; }
         UINT64 GetCommandListIDInterlockedRead() { return InterlockedRead64((volatile LONGLONG*)&m_commandListID); }
         _Out_range_(0, COMMAND_LIST_TYPE::MAX_VALID - 1) COMMAND_LIST_TYPE GetCommandListType() { return m_type; }
@@ -67,6 +80,8 @@ namespace D3D12TranslationLayer
         ID3D12VideoDecodeCommandList2* GetVideoDecodeCommandList(ID3D12CommandList *pCommandList = nullptr) { return  m_type == COMMAND_LIST_TYPE::VIDEO_DECODE ? static_cast<ID3D12VideoDecodeCommandList2 * const>(pCommandList ? pCommandList : m_pCommandList.get()) : nullptr;  }
         ID3D12VideoProcessCommandList2* GetVideoProcessCommandList(ID3D12CommandList *pCommandList = nullptr) { return  m_type == COMMAND_LIST_TYPE::VIDEO_PROCESS ? static_cast<ID3D12VideoProcessCommandList2 * const>(pCommandList ? pCommandList : m_pCommandList.get()) : nullptr; }
         ID3D12GraphicsCommandList* GetGraphicsCommandList(ID3D12CommandList *pCommandList = nullptr) { return  m_type == COMMAND_LIST_TYPE::GRAPHICS ? static_cast<ID3D12GraphicsCommandList * const>(pCommandList ? pCommandList : m_pCommandList.get()) : nullptr; }
+        // Only available when the resource state manager uses enhanced barriers.
+        ID3D12GraphicsCommandList7* GetGraphicsCommandList7() { return m_pGraphicsCommandList7.get(); }
 
         bool WaitForFenceValueInternal(bool IsImmediateContextThread, UINT64 FenceValue);
         bool ComputeOnly() {return !!(m_pParent->FeatureLevel() == D3D_FEATURE_LEVEL_1_0_CORE);}
@@ -85,6 +100,7 @@ namespace D3D12TranslationLayer
         ImmediateContext* const                             m_pParent; // weak-ref
         const COMMAND_LIST_TYPE                             m_type;
         unique_comptr<ID3D12CommandList>                    m_pCommandList;
+        unique_comptr<ID3D12GraphicsCommandList7>           m_pGraphicsCommandList7;
         unique_comptr<ID3D12CommandAllocator>               m_pCommandAllocator;
         unique_comptr<ID3D12CommandQueue>                   m_pCommandQueue;
         unique_comptr<ID3D12SharingContract>                m_pSharingContract;
@@ -101,6 +117,14 @@ namespace D3D12TranslationLayer
         bool                                                m_bNeedSubmitFence;
         ThrowingSafeHandle                                  m_hWaitEvent;
 
+        unique_comptr<ID3D12Resource>                       m_pUploadRing;
+        CUploadRingLedger                                   m_UploadRingLedger; // In units of cUploadRingAlignment
+        // Ring statistics are atomics, since telemetry can be read from other threads
+        std::atomic<UINT64>                                 m_UploadRingSize{ 0 };
+        std::atomic<UINT64>                                 m_UploadRingBytesInUse{ 0 };
+        std::atomic<UINT64>                                 m_NumUploadRingAllocations{ 0 };
+        std::atomic<UINT64>                                 m_NumUploadRingFullFallbacks{ 0 };
+
         // The more upload heap space allocated in a command list, the more memory we are 
         // potentially holding up that could have been recycled into the pool. If too
         // much is held up, flush the command list
@@ -36,6 +36,8 @@
 #include <utility>
 #include <vector>
 #include <queue>
+#include <deque>
+#include <list>
 #include <map>
 #include <set>
 #include <unordered_map>
@@ -49,6 +51,8 @@
 #include <atomic>
 #include <optional>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <bitset>
 #include <type_traits>
 #include <climits>
@@ -14,12 +14,15 @@
 #define TRANSLATION_API
 #include "VideoViewHelper.hpp"
 #include "SubresourceHelpers.hpp"
+#include "PixelCopyKernels.hpp"
 #include "Util.hpp"
 #include "DeviceChild.hpp"
 
 #include <BlockAllocators.h>
 #include "Allocator.h"
 #include "XPlatHelpers.h"
+#include "SPSCQueue.hpp"
+#include "MappedFile.hpp"
 
 #include <ThreadPool.hpp>
 #include <segmented_stack.h>
@@ -30,11 +33,13 @@
 #include "Shader.hpp"
 #include "Sampler.hpp"
 #include "View.hpp"
+#include "PipelineStateCache.hpp"
 #include "PipelineState.hpp"
 #include "SwapChainManager.hpp"
 #include "ResourceBinding.hpp"
 #include "Fence.hpp"
 #include "Residency.h"
+#include "EnhancedBarriers.hpp"
 #include "ResourceState.hpp"
 #include "RootSignature.hpp"
 #include "Resource.hpp"
@@ -43,6 +48,7 @@
 #include "BlitHelper.hpp"
 #include "ImmediateContext.hpp"
 #include "BatchedContext.hpp"
+#include "BatchCapture.hpp"
 #include "BatchedResource.hpp"
 #include "BatchedQuery.hpp"
 #include "CommandListManager.hpp"
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+
+namespace D3D12TranslationLayer
+{
+    //==================================================================================================================================
+    // Enhanced barriers
+    // Translates the legacy barriers generated by the resource state manager into barrier groups for
+    // ID3D12GraphicsCommandList7::Barrier. State tracking, including the promotion and decay rules emulated by the state manager,
+    // stays in terms of legacy states, and each state maps to the layout a legacy barrier leaves a texture in, so enhanced and
+    // legacy barriers can be recorded against the same resources. What's gained is precision: a barrier only waits for the
+    // pipeline stages and flushes the caches of the accesses on either side of it, and transitions which only add reads whose
+    // stages and accesses are already covered, without changing the layout, are dropped.
+    //
+    // The translation doesn't need a device, so it can be run on the barriers reported by SimulateSubmitResourceTransitions.
+    //==================================================================================================================================
+    enum class EnhancedBarrierResourceType
+    {
+        Buffer, // No layout
+        Texture,
+        SimultaneousAccessTexture, // Always in the COMMON layout
+    };
+
+    struct EnhancedBarrierScope
+    {
+        D3D12_BARRIER_SYNC Sync;
+        D3D12_BARRIER_ACCESS Access;
+        D3D12_BARRIER_LAYOUT Layout; // UNDEFINED for buffers
+    };
+
+    class EnhancedBarrierTranslator
+    {
+    public:
+        static EnhancedBarrierScope GetScope(D3D12_RESOURCE_STATES State, EnhancedBarrierResourceType Type) noexcept;
+        static EnhancedBarrierResourceType GetResourceType(ID3D12Resource* pResource) noexcept;
+
+        // Replaces the current groups with the translation of the barriers. Barriers keep their relative order.
+        // GetResourceTypeImpl is called with the resource of each barrier which has one, e.g. GetResourceType, or a lookup in tests.
+        template <typename TGetResourceTypeImpl>
+        void Translate(_In_reads_(Count) D3D12_RESOURCE_BARRIER const* pBarriers, UINT Count, TGetResourceTypeImpl&& GetResourceTypeImpl) noexcept(false)
+        {
+            Reset();
+            for (UINT i = 0; i < Count; ++i)
+            {
+                ID3D12Resource* pResource = GetResource(pBarriers[i]);
+                AddBarrier(pBarriers[i], pResource ? GetResourceTypeImpl(pResource) : EnhancedBarrierResourceType::Buffer); // throw( bad_alloc )
+            }
+            ResolveGroups();
+        }
+
+        // Valid until the next translation.
+        D3D12_BARRIER_GROUP const* GetGroups() const noexcept { return m_Groups.data(); }
+        UINT GetNumGroups() const noexcept { return (UINT)m_Groups.size(); }
+        // Number of legacy barriers in the last translation which didn't need an enhanced barrier.
+        UINT GetNumElided() const noexcept { return m_NumElided; }
+
+    private:
+        static ID3D12Resource* GetResource(D3D12_RESOURCE_BARRIER const& Barrier) noexcept;
+        void Reset() noexcept;
+        void AddBarrier(D3D12_RESOURCE_BARRIER const& Barrier, EnhancedBarrierResourceType Type) noexcept(false);
+        void AddTransition(D3D12_RESOURCE_BARRIER const& Barrier, EnhancedBarrierResourceType Type) noexcept(false);
+        void AddUAVBarrier(D3D12_RESOURCE_BARRIER const& Barrier, EnhancedBarrierResourceType Type) noexcept(false);
+        // Starts a new group unless the last one has the same type.
+        void AddToGroup(D3D12_BARRIER_TYPE Type) noexcept(false);
+        // Points the groups into the barrier vectors, which may have been reallocated while they were being built.
+        void ResolveGroups() noexcept;
+
+        std::vector<D3D12_GLOBAL_BARRIER> m_GlobalBarriers;
+        std::vector<D3D12_TEXTURE_BARRIER> m_TextureBarriers;
+        std::vector<D3D12_BUFFER_BARRIER> m_BufferBarriers;
+        std::vector<D3D12_BARRIER_GROUP> m_Groups;
+        UINT m_NumElided = 0;
+    };
+}
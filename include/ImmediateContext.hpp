@@ -12,6 +12,67 @@ struct TranslationLayerCallbacks
     std::function<void()> m_pfnPostSubmit;
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// A contiguous circular buffer of objects, kept sorted by the fence value they're waiting on,
+// so that the front is always the first object to become available
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename TResourceType>
+class CFenceOrderedRing
+{
+public:
+    typedef std::pair<UINT64, TResourceType> TEntry;
+
+    bool empty() const noexcept { return m_Count == 0; }
+    size_t size() const noexcept { return m_Count; }
+    TEntry& front() noexcept { assert(!empty()); return m_Entries[m_Head]; }
+
+    void pop_front() noexcept
+    {
+        assert(!empty());
+        m_Entries[m_Head].second = TResourceType();
+        m_Head = (m_Head + 1) & (m_Entries.size() - 1);
+        --m_Count;
+    }
+
+    void insert(UINT64 FenceValue, TResourceType&& Resource) // throw( bad_alloc )
+    {
+        if (m_Count == m_Entries.size())
+        {
+            Grow(); // throw( bad_alloc )
+        }
+
+        // Objects are nearly always returned in fence order, in which case nothing moves
+        size_t Index = m_Count;
+        for (; Index > 0 && At(Index - 1).first > FenceValue; --Index)
+        {
+            At(Index) = std::move(At(Index - 1));
+        }
+        At(Index) = TEntry(FenceValue, std::move(Resource));
+        ++m_Count;
+    }
+
+private:
+    static constexpr size_t c_InitialCapacity = 8;
+
+    TEntry& At(size_t Index) noexcept { return m_Entries[(m_Head + Index) & (m_Entries.size() - 1)]; }
+
+    void Grow() // throw( bad_alloc )
+    {
+        // Capacity stays a power of two, so wrapping is a mask
+        std::vector<TEntry> NewEntries(max(m_Entries.size() * 2, c_InitialCapacity)); // throw( bad_alloc )
+        for (size_t i = 0; i < m_Count; ++i)
+        {
+            NewEntries[i] = std::move(At(i));
+        }
+        m_Entries.swap(NewEntries);
+        m_Head = 0;
+    }
+
+    std::vector<TEntry> m_Entries;
+    size_t m_Head = 0;
+    size_t m_Count = 0;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // A pool of objects that are recycled on specific fence values
 // This class assumes single threaded caller
@@ -20,17 +81,20 @@ template<typename TResourceType>
 class CFencePool
 {
 public:
-    void ReturnToPool(TResourceType&& Resource, UINT64 FenceValue) noexcept
+    // Returns false if the resource was released rather than pooled
+    bool ReturnToPool(TResourceType&& Resource, UINT64 FenceValue) noexcept
     {
         try
         {
             auto lock = m_pLock ? std::unique_lock(*m_pLock) : std::unique_lock<std::mutex>();
-            m_Pool.emplace_back(FenceValue, std::move(Resource)); // throw( bad_alloc )
+            m_Pool.insert(FenceValue, std::move(Resource)); // throw( bad_alloc )
+            return true;
         }
         catch (std::bad_alloc&)
         {
             // Just drop the error
             // All uses of this pool use unique_comptr, which will release the resource
+            return false;
         }
     }
 
@@ -38,37 +102,37 @@ public:
     TResourceType RetrieveFromPool(UINT64 CurrentFenceValue, PFNCreateNew pfnCreateNew, const CreationArgType&... CreationArgs) noexcept(false)
     {
         auto lock = m_pLock ? std::unique_lock(*m_pLock) : std::unique_lock<std::mutex>();
-        auto Head = m_Pool.begin();
-        if (Head == m_Pool.end() || (CurrentFenceValue < Head->first))
+        if (m_Pool.empty() || (CurrentFenceValue < m_Pool.front().first))
         {
             return std::move(pfnCreateNew(CreationArgs...)); // throw( _com_error )
         }
 
-        assert(Head->second);
-        TResourceType ret = std::move(Head->second);
-        m_Pool.erase(Head);
+        assert(m_Pool.front().second);
+        TResourceType ret = std::move(m_Pool.front().second);
+        m_Pool.pop_front();
         return std::move(ret);
     }
 
-    void Trim(UINT64 TrimThreshold, UINT64 CurrentFenceValue)
+    // Returns whether a pooled object was released
+    bool Trim(UINT64 TrimThreshold, UINT64 CurrentFenceValue)
     {
         auto lock = m_pLock ? std::unique_lock(*m_pLock) : std::unique_lock<std::mutex>();
 
-        auto Head = m_Pool.begin();
-
-        if (Head == m_Pool.end() || (CurrentFenceValue < Head->first))
+        if (m_Pool.empty() || (CurrentFenceValue < m_Pool.front().first))
         {
-            return;
+            return false;
         }
 
-        UINT64 difference = CurrentFenceValue - Head->first;
+        UINT64 difference = CurrentFenceValue - m_Pool.front().first;
 
         if (difference >= TrimThreshold)
         {
             // only erase one item per 'pump'
-            assert(Head->second);
-            m_Pool.erase(Head);
+            assert(m_Pool.front().second);
+            m_Pool.pop_front();
+            return true;
         }
+        return false;
     }
 
     CFencePool(bool bLock = false) noexcept
@@ -88,8 +152,7 @@ public:
     }
 
 protected:
-    typedef std::pair<UINT64, TResourceType> TPoolEntry;
-    typedef std::list<TPoolEntry> TPool;
+    typedef CFenceOrderedRing<TResourceType> TPool;
 
     CFencePool(CFencePool const& other) = delete;
     CFencePool& operator=(CFencePool const& other) = delete;
@@ -113,13 +176,12 @@ public:
     TResourceType RetrieveFromPool(UINT64 CurrentFenceValue, PFNWaitForFenceValue pfnWaitForFenceValue, PFNCreateNew pfnCreateNew, const CreationArgType&... CreationArgs) noexcept(false)
     {
         auto lock = this->m_pLock ? std::unique_lock(*this->m_pLock) : std::unique_lock<std::mutex>();
-        auto Head = this->m_Pool.begin();
 
-        if (Head == this->m_Pool.end())
+        if (this->m_Pool.empty())
         {
             return std::move(pfnCreateNew(CreationArgs...)); // throw( _com_error )
         }
-        else if (CurrentFenceValue < Head->first)
+        else if (CurrentFenceValue < this->m_Pool.front().first)
         {
             if (this->m_Pool.size() < m_MaxInFlightDepth)
             {
@@ -127,13 +189,13 @@ public:
             }
             else
             {
-                pfnWaitForFenceValue(Head->first); // throw( _com_error )
+                pfnWaitForFenceValue(this->m_Pool.front().first); // throw( _com_error )
             }
         }
 
-        assert(Head->second);
-        TResourceType ret = std::move(Head->second);
-        this->m_Pool.erase(Head);
+        assert(this->m_Pool.front().second);
+        TResourceType ret = std::move(this->m_Pool.front().second);
+        this->m_Pool.pop_front();
         return std::move(ret);
     }
 
@@ -162,6 +224,9 @@ protected:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Multi-level pool (for dynamic resource data upload)
 // This class is free-threaded (to enable D3D11 free-threaded resource destruction)
+// Sizes are bucketed in multiples of ResourceSizeMultiple up to c_NumLinearLevels multiples, and logarithmically beyond that,
+// with c_SubLevelsPerPowerOfTwo levels per power of two, so large sizes don't create a long tail of empty levels.
+// Pooled resources are created at their level's size, which rounds large sizes up by at most 1 / c_SubLevelsPerPowerOfTwo.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename TResourceType, UINT64 ResourceSizeMultiple>
 class CMultiLevelPool
@@ -183,14 +248,17 @@ public:
             m_MultiPool.resize(PoolIndex + 1);
         }
 
-        m_MultiPool[PoolIndex].ReturnToPool(std::move(Resource), FenceValue);
+        if (m_MultiPool[PoolIndex].ReturnToPool(std::move(Resource), FenceValue))
+        {
+            m_PooledSize.fetch_add(SizeFromIndex(PoolIndex), std::memory_order_relaxed);
+        }
     }
 
     template <typename PFNCreateNew>
     TResourceType RetrieveFromPool(UINT64 Size, UINT64 CurrentFenceValue, PFNCreateNew pfnCreateNew) noexcept(false)
     {
         UINT PoolIndex = IndexFromSize(Size);
-        UINT AlignedSize = (PoolIndex + 1) * ResourceSizeMultiple;
+        UINT64 AlignedSize = SizeFromIndex(PoolIndex);
 
         auto Lock = m_Lock.TakeLock();
 
@@ -209,21 +277,70 @@ public:
         // m_Lock will be held during this potentially slow operation
         // This is not optimized because it is expected that once an app reaches steady-state
         // behavior, the pool will not need to grow.
-        return std::move(m_MultiPool[PoolIndex].RetrieveFromPool(CurrentFenceValue, pfnCreateNew, AlignedSize)); // throw( _com_error )
+        bool bCreatedNew = false;
+        auto pfnTrackedCreateNew = [&](UINT64 CreateSize)
+        {
+            bCreatedNew = true;
+            return pfnCreateNew(CreateSize); // throw( _com_error )
+        };
+        TResourceType ret = m_MultiPool[PoolIndex].RetrieveFromPool(CurrentFenceValue, pfnTrackedCreateNew, AlignedSize); // throw( _com_error )
+        if (!bCreatedNew)
+        {
+            m_PooledSize.fetch_sub(AlignedSize, std::memory_order_relaxed);
+        }
+        return std::move(ret);
     }
 
     void Trim(UINT64 CurrentFenceValue)
     {
         auto Lock = m_Lock.TakeLock();
 
-        for (TPool& pool : m_MultiPool)
+        for (UINT PoolIndex = 0; PoolIndex < m_MultiPool.size(); ++PoolIndex)
         {
-            pool.Trim(m_TrimThreshold, CurrentFenceValue);
+            if (m_MultiPool[PoolIndex].Trim(m_TrimThreshold, CurrentFenceValue))
+            {
+                m_PooledSize.fetch_sub(SizeFromIndex(PoolIndex), std::memory_order_relaxed);
+            }
         }
     }
 
+    // Size of the resources waiting in the pool, readable without the pool's lock
+    UINT64 GetPooledSize() const noexcept { return m_PooledSize.load(std::memory_order_relaxed); }
+
 protected:
-    UINT IndexFromSize(UINT64 Size) noexcept { return (Size == 0) ? 0 : (UINT)((Size - 1) / ResourceSizeMultiple); }
+    static constexpr UINT c_NumLinearLevels = 16;
+    static constexpr UINT c_SubLevelBits = 3;
+    static constexpr UINT c_SubLevelsPerPowerOfTwo = 1 << c_SubLevelBits;
+    static constexpr UINT c_FirstLogLevelPower = 4; // log2(c_NumLinearLevels)
+    static_assert(c_NumLinearLevels == 1u << c_FirstLogLevelPower);
+
+    static UINT IndexFromSize(UINT64 Size) noexcept
+    {
+        const UINT64 Multiples = (Size == 0) ? 1 : (Size - 1) / ResourceSizeMultiple + 1;
+        if (Multiples <= c_NumLinearLevels)
+        {
+            return (UINT)(Multiples - 1);
+        }
+
+        // Multiples is in (2^Power, 2^(Power+1)], which is split into c_SubLevelsPerPowerOfTwo levels
+        const UINT Power = BlockAllocators::Log2Ceil(Multiples) - 1;
+        const UINT64 SubLevelWidth = 1ull << (Power - c_SubLevelBits);
+        const UINT SubLevel = (UINT)((Multiples - (1ull << Power) + SubLevelWidth - 1) / SubLevelWidth) - 1;
+        return c_NumLinearLevels + (Power - c_FirstLogLevelPower) * c_SubLevelsPerPowerOfTwo + SubLevel;
+    }
+
+    static UINT64 SizeFromIndex(UINT Index) noexcept
+    {
+        if (Index < c_NumLinearLevels)
+        {
+            return (Index + 1) * ResourceSizeMultiple;
+        }
+
+        const UINT Power = c_FirstLogLevelPower + (Index - c_NumLinearLevels) / c_SubLevelsPerPowerOfTwo;
+        const UINT SubLevel = (Index - c_NumLinearLevels) % c_SubLevelsPerPowerOfTwo;
+        const UINT64 Multiples = (1ull << Power) + (SubLevel + 1) * (1ull << (Power - c_SubLevelBits));
+        return Multiples * ResourceSizeMultiple;
+    }
 
 protected:
     typedef CFencePool<TResourceType> TPool;
@@ -233,6 +350,7 @@ protected:
     TMultiPool m_MultiPool;
     OptLock<> m_Lock;
     UINT64 m_TrimThreshold;
+    std::atomic<UINT64> m_PooledSize{ 0 };
 };
 
 typedef CMultiLevelPool<unique_comptr<ID3D12Resource>, 64*1024> TDynamicBufferPool;
@@ -300,6 +418,33 @@ public:
         }
     }
 
+    // Includes allocations whose fence has completed but which haven't been deallocated yet.
+    UINT32 GetNumItemsInUse() const { return UINT32(m_Size - (m_Head - m_Tail)); }
+
+    // Items allocated under the given fence value, which is expected to be the current one.
+    UINT32 GetNumItemsAllocatedAt(UINT64 FenceValue) const
+    {
+        LedgerEntry const& entry = m_Ledger[m_LedgerIndex];
+        return entry.m_FenceValue == FenceValue ? entry.m_NumAllocations : 0;
+    }
+
+    // The fence value of the most recent allocations.
+    UINT64 GetCurrentFenceValue() const { return m_Ledger[m_LedgerIndex].m_FenceValue; }
+
+    // Keeps the allocations made under FenceValue until NewFenceValue completes instead. Later allocations are made under
+    // later fence values, so space is still reclaimed in the order it was allocated.
+    void DelayDeallocation(UINT64 FenceValue, UINT64 NewFenceValue)
+    {
+        assert(NewFenceValue > FenceValue);
+        for (size_t i = 0; i < _countof(m_Ledger); i++)
+        {
+            if ((m_LedgerMask & (1 << i)) && m_Ledger[i].m_FenceValue == FenceValue)
+            {
+                m_Ledger[i].m_FenceValue = NewFenceValue;
+            }
+        }
+    }
+
     void Deallocate(UINT64 CompletedFenceValue)
     {
         for (size_t i = 0; i < _countof(m_Ledger); i++)
@@ -373,6 +518,212 @@ private:
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Upload Ring Ledger
+// Tracks space in an upload ring, whose allocations are fenced with the ID of the command list being recorded. An allocation
+// can be consumed by a later command list than the one it was allocated under, e.g. when recording the transitions for the
+// copy out of it submits the command list first. So until every allocation has been released, which happens once the commands
+// consuming it are recorded, submitting a command list moves the space allocated under it to the next one.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class CUploadRingLedger
+{
+public:
+
+    CUploadRingLedger(UINT32 Size = 0)
+        : m_Ring(Size)
+    {}
+
+    HRESULT Allocate(UINT32 NumItems, UINT64 CurrentFenceValue, _Out_ UINT32& OffsetOut)
+    {
+        HRESULT hr = m_Ring.Allocate(NumItems, CurrentFenceValue, OffsetOut);
+        if (SUCCEEDED(hr))
+        {
+            ++m_NumOutstanding;
+        }
+        return hr;
+    }
+
+    // FenceValue is the ID of the command list which consumes the allocation.
+    void Release(UINT64 FenceValue)
+    {
+        assert(m_NumOutstanding > 0);
+        assert(FenceValue <= m_Ring.GetCurrentFenceValue());
+        UNREFERENCED_PARAMETER(FenceValue);
+        --m_NumOutstanding;
+    }
+
+    // Called when the command list with ID FenceValue is submitted, before the next one is recorded.
+    void Submitted(UINT64 FenceValue)
+    {
+        if (m_NumOutstanding > 0)
+        {
+            m_Ring.DelayDeallocation(FenceValue, FenceValue + 1);
+        }
+    }
+
+    void Deallocate(UINT64 CompletedFenceValue) { m_Ring.Deallocate(CompletedFenceValue); }
+    UINT32 GetNumItemsInUse() const { return m_Ring.GetNumItemsInUse(); }
+    UINT32 GetNumOutstanding() const { return m_NumOutstanding; }
+
+private:
+
+    CFencedRingBuffer m_Ring;
+    UINT32 m_NumOutstanding = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Descriptor table cache
+// Remembers where recently written descriptor tables live in an online heap, keyed on the CPU handles they were copied from,
+// so that binding an identical table again can point at the existing copy instead of copying the descriptors again.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A cached table is only reused within the ring buffer allocations of the command list which wrote it, since older
+// allocations can be retired before the current command list executes. It's also dropped when the online heap rolls
+// over, or when a descriptor in the same address range of the source heap as one of its descriptors is rewritten, which
+// covers renames and recycled descriptor slots.
+struct DescriptorTableScope
+{
+    UINT64 CommandListID;
+    UINT64 HeapGeneration;
+    UINT64 SourceEpoch;
+
+    bool operator==(DescriptorTableScope const& o) const
+    {
+        return CommandListID == o.CommandListID && HeapGeneration == o.HeapGeneration && SourceEpoch == o.SourceEpoch;
+    }
+};
+
+struct DescriptorTableCacheStatistics
+{
+    UINT64 NumLookups;
+    UINT64 NumHits; // Each hit saves a CopyDescriptors call, and the table's ring space
+    UINT64 NumDescriptorCopiesSaved;
+};
+
+template <UINT MaxDescriptors, UINT NumEntries = 64>
+class CDescriptorTableCache
+{
+public:
+    // On a hit, returns true with the cached table in Table, which the caller can use without reserving ring space.
+    bool Find(DescriptorTableScope const& Scope,
+              UINT NumDescriptors,
+              _In_reads_(NumDescriptors) const D3D12_CPU_DESCRIPTOR_HANDLE* pDescriptors,
+              _Out_ D3D12_GPU_DESCRIPTOR_HANDLE& Table) noexcept
+    {
+        assert(NumDescriptors <= MaxDescriptors);
+        Table = {};
+        if (NumDescriptors == 0)
+        {
+            return false;
+        }
+
+        const size_t Hash = HashDescriptors(NumDescriptors, pDescriptors);
+        m_NumLookups.fetch_add(1, std::memory_order_relaxed);
+        SEntry const& Entry = m_Entries[Hash % NumEntries];
+        if (Entry.m_bValid &&
+            Entry.m_Hash == Hash &&
+            Entry.m_Scope == Scope &&
+            Entry.m_NumDescriptors == NumDescriptors &&
+            std::equal(pDescriptors, pDescriptors + NumDescriptors, Entry.m_Descriptors,
+                [](D3D12_CPU_DESCRIPTOR_HANDLE a, D3D12_CPU_DESCRIPTOR_HANDLE b) { return a.ptr == b.ptr; }))
+        {
+            m_NumHits.fetch_add(1, std::memory_order_relaxed);
+            m_NumDescriptorCopiesSaved.fetch_add(NumDescriptors, std::memory_order_relaxed);
+            Table = Entry.m_Table;
+            return true;
+        }
+        return false;
+    }
+
+    // Records a table which the caller has just written, replacing the entry it hashes to.
+    void Insert(DescriptorTableScope const& Scope,
+                UINT NumDescriptors,
+                _In_reads_(NumDescriptors) const D3D12_CPU_DESCRIPTOR_HANDLE* pDescriptors,
+                D3D12_GPU_DESCRIPTOR_HANDLE Table) noexcept
+    {
+        assert(NumDescriptors <= MaxDescriptors);
+        if (NumDescriptors == 0)
+        {
+            return;
+        }
+
+        const size_t Hash = HashDescriptors(NumDescriptors, pDescriptors);
+        SEntry& Entry = m_Entries[Hash % NumEntries];
+        Entry.m_bValid = true;
+        Entry.m_Hash = Hash;
+        Entry.m_Scope = Scope;
+        Entry.m_NumDescriptors = NumDescriptors;
+        Entry.m_Table = Table;
+        std::copy(pDescriptors, pDescriptors + NumDescriptors, Entry.m_Descriptors);
+    }
+
+    DescriptorTableCacheStatistics GetStatistics() const noexcept
+    {
+        DescriptorTableCacheStatistics Stats = {};
+        Stats.NumLookups = m_NumLookups.load(std::memory_order_relaxed);
+        Stats.NumHits = m_NumHits.load(std::memory_order_relaxed);
+        Stats.NumDescriptorCopiesSaved = m_NumDescriptorCopiesSaved.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
+private:
+    static size_t HashDescriptors(UINT NumDescriptors, _In_reads_(NumDescriptors) const D3D12_CPU_DESCRIPTOR_HANDLE* pDescriptors) noexcept
+    {
+        size_t Hash = NumDescriptors;
+        for (UINT i = 0; i < NumDescriptors; ++i)
+        {
+            hash_combine(Hash, pDescriptors[i].ptr);
+        }
+        return Hash;
+    }
+
+    struct SEntry
+    {
+        bool m_bValid = false;
+        size_t m_Hash;
+        DescriptorTableScope m_Scope;
+        UINT m_NumDescriptors;
+        D3D12_GPU_DESCRIPTOR_HANDLE m_Table;
+        D3D12_CPU_DESCRIPTOR_HANDLE m_Descriptors[MaxDescriptors];
+    };
+
+    SEntry m_Entries[NumEntries];
+    // Atomic so that statistics can be read from other threads
+    std::atomic<UINT64> m_NumLookups{ 0 };
+    std::atomic<UINT64> m_NumHits{ 0 };
+    std::atomic<UINT64> m_NumDescriptorCopiesSaved{ 0 };
+};
+
+// Counters for a command list manager's upload ring
+struct UploadRingStatistics
+{
+    UINT64 SizeInBytes;
+    UINT64 BytesInUse; // Includes space from completed command lists which hasn't been reclaimed yet
+    UINT64 NumAllocations;
+    UINT64 NumRingFullFallbacks; // Allocations which found the ring full and fell back to the suballocator
+};
+
+// Counters for diagnosing hitches caused by paging, pool growth or descriptor heap roll over
+struct MemoryTelemetry
+{
+    ResidencyStatistics Residency;
+    UploadRingStatistics UploadRing;
+
+    // Size of the transitionable buffers waiting in the dynamic buffer pools
+    UINT64 PooledUploadBufferBytes;
+    UINT64 PooledReadbackBufferBytes;
+    UINT64 PooledDecoderBufferBytes;
+
+    HeapSuballocatorUsage UploadHeapSuballocator;
+    HeapSuballocatorUsage ReadbackHeapSuballocator;
+    HeapSuballocatorUsage DecoderHeapSuballocator;
+
+    // Times an online descriptor heap ran out of space, and was grown or swapped for a pooled heap
+    UINT64 NumViewHeapRollOvers;
+    UINT64 NumSamplerHeapRollOvers;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Descriptor heap manager
 // Used to allocate descriptors from CPU-only heaps corresponding to view/sampler objects
@@ -385,28 +736,49 @@ public: // Types
     typedef UINT HeapIndex;
 
 private: // Types
-    struct SFreeRange { HeapOffsetRaw Start; HeapOffsetRaw End; };
+    // Free slots are tracked with a two-level bitmap. A set bit in m_FreeBits marks a free slot, and a set bit in
+    // m_NonEmptyWords marks a word of m_FreeBits with at least one free slot, so allocation is a couple of bit scans,
+    // and freeing a slot is O(1).
     struct SHeapEntry
     {
         unique_comptr<ID3D12DescriptorHeap> m_Heap;
-        std::list<SFreeRange> m_FreeList;
+        HeapOffsetRaw m_Base = 0;
+        std::vector<UINT64> m_FreeBits;
+        std::vector<UINT64> m_NonEmptyWords;
+        UINT m_NumFree = 0;
 
-        SHeapEntry() { }
-        SHeapEntry(SHeapEntry &&o) : m_Heap(std::move(o.m_Heap)), m_FreeList(std::move(o.m_FreeList)) { }
+        SHeapEntry() = default;
+        SHeapEntry(SHeapEntry&&) = default;
     };
 
-    // Note: This data structure relies on the pointer validity guarantee of std::deque,
-    // that as long as inserts/deletes are only on either end of the container, pointers
-    // to elements continue to be valid. If trimming becomes an option, the free heap
-    // list must be re-generated at that time.
+    // Heap entries are never removed, because views hold on to their HeapIndex. Trimming only releases
+    // the D3D12 heap, and the entry is reused the next time a heap is needed.
     typedef std::deque<SHeapEntry> THeapMap;
 
+    // When creates and destroys are multithreaded, slots are cached in magazines, selected by thread ID, so that
+    // most allocations and frees only contend with other threads which share a magazine. Slots in a magazine
+    // are still marked as allocated in their heap.
+    static constexpr UINT c_NumMagazines = 8;
+    static constexpr UINT c_MagazineSize = 32;
+
+    struct SSlot
+    {
+        HeapOffsetRaw m_Offset;
+        HeapIndex m_Index;
+    };
+    struct alignas(64) SMagazine
+    {
+        std::mutex m_Lock;
+        UINT m_Count = 0;
+        SSlot m_Slots[c_MagazineSize];
+    };
+
 public: // Methods
     CDescriptorHeapManager(ID3D12Device* pDevice,
                            D3D12_DESCRIPTOR_HEAP_TYPE Type,
                            UINT NumDescriptorsPerHeap,
                            bool bLockRequired,
-                           UINT NodeMask) noexcept
+                           UINT NodeMask) noexcept(false)
         : m_Desc( { Type,
                     NumDescriptorsPerHeap,
                     D3D12_DESCRIPTOR_HEAP_FLAG_NONE,
@@ -415,106 +787,286 @@ public: // Methods
         , m_pDevice(pDevice)
         , m_CritSect(bLockRequired)
     {
+        if (bLockRequired)
+        {
+            m_pMagazines.reset(new SMagazine[c_NumMagazines]); // throw( bad_alloc )
+        }
     }
 
     HeapOffset AllocateHeapSlot(_Out_opt_ HeapIndex *outIndex = nullptr) noexcept(false)
     {
-        auto Lock = m_CritSect.TakeLock();
-        if (m_FreeHeaps.empty())
+        SSlot Slot;
+        if (m_pMagazines)
+        {
+            SMagazine& Magazine = GetMagazine();
+            std::lock_guard<std::mutex> MagazineLock(Magazine.m_Lock);
+            if (Magazine.m_Count == 0)
+            {
+                auto Lock = m_CritSect.TakeLock();
+                Magazine.m_Count = AllocateSlots(Magazine.m_Slots, c_MagazineSize / 2); // throw( _com_error, bad_alloc )
+            }
+            Slot = Magazine.m_Slots[--Magazine.m_Count];
+        }
+        else
+        {
+            auto Lock = m_CritSect.TakeLock();
+            AllocateSlots(&Slot, 1); // throw( _com_error, bad_alloc )
+        }
+
+        if (outIndex)
         {
-            AllocateHeap(); // throw( _com_error )
+            *outIndex = Slot.m_Index;
         }
-        assert(!m_FreeHeaps.empty());
-        HeapIndex index = m_FreeHeaps.front();
-        SHeapEntry &HeapEntry = m_Heaps[index];
-        assert(!HeapEntry.m_FreeList.empty());
-        SFreeRange &Range = *HeapEntry.m_FreeList.begin();
-        HeapOffset Ret = { Range.Start };
-        Range.Start += m_DescriptorSize;
+        return { Slot.m_Offset };
+    }
 
-        if (Range.Start == Range.End)
+    void FreeHeapSlot(HeapOffset Offset, HeapIndex index) noexcept
+    {
+        NoteDescriptorRewritten(Offset);
+        if (m_pMagazines)
         {
-            HeapEntry.m_FreeList.pop_front();
-            if (HeapEntry.m_FreeList.empty())
+            SMagazine& Magazine = GetMagazine();
+            std::lock_guard<std::mutex> MagazineLock(Magazine.m_Lock);
+            if (Magazine.m_Count == c_MagazineSize)
             {
-                m_FreeHeaps.pop_front();
+                // Return the older half, and keep the most recently freed slots for reuse.
+                auto Lock = m_CritSect.TakeLock();
+                for (UINT i = 0; i < c_MagazineSize / 2; ++i)
+                {
+                    ReleaseSlot(Magazine.m_Slots[i]);
+                }
+                std::copy(Magazine.m_Slots + c_MagazineSize / 2, Magazine.m_Slots + c_MagazineSize, Magazine.m_Slots);
+                Magazine.m_Count = c_MagazineSize / 2;
             }
+            Magazine.m_Slots[Magazine.m_Count++] = { Offset.ptr, index };
         }
-        if (outIndex)
+        else
         {
-            *outIndex = index;
+            auto Lock = m_CritSect.TakeLock();
+            ReleaseSlot({ Offset.ptr, index });
         }
-        return Ret;
     }
 
-    void FreeHeapSlot(HeapOffset Offset, HeapIndex index) noexcept
+    // Changes whenever one of the descriptors, which may already have been copied into an online heap, is rewritten,
+    // either in place or by freeing its slot for reuse. Epochs are kept per range of descriptor addresses, so rewriting
+    // a descriptor elsewhere in the heaps usually leaves it unchanged.
+    UINT64 GetWriteEpoch(UINT NumDescriptors, _In_reads_(NumDescriptors) const HeapOffset* pDescriptors) const noexcept
+    {
+        // Each range's epoch only increases, so the sum changes if any of them does
+        UINT64 Epoch = 0;
+        for (UINT i = 0; i < NumDescriptors; ++i)
+        {
+            Epoch += m_WriteEpochs[GetWriteEpochRange(pDescriptors[i])].load(std::memory_order_acquire);
+        }
+        return Epoch;
+    }
+    void NoteDescriptorRewritten(HeapOffset Offset) noexcept
     {
+        m_WriteEpochs[GetWriteEpochRange(Offset)].fetch_add(1, std::memory_order_release);
+    }
+
+    // Releases descriptor heaps which have no allocated slots, keeping one of them as a spare.
+    void TrimFreeHeaps() noexcept
+    {
+        FlushMagazines();
+
         auto Lock = m_CritSect.TakeLock();
-        try
+        bool bKeptSpare = false;
+        for (HeapIndex index = 0; index < m_Heaps.size(); ++index)
         {
-            assert(index < m_Heaps.size());
             SHeapEntry &HeapEntry = m_Heaps[index];
+            if (!HeapEntry.m_Heap.get() || HeapEntry.m_NumFree != m_Desc.NumDescriptors)
+            {
+                continue;
+            }
+            if (!bKeptSpare)
+            {
+                bKeptSpare = true;
+                continue;
+            }
+
+            HeapEntry.m_Heap = nullptr;
+            HeapEntry.m_NumFree = 0;
+            m_FreeHeaps[index / 64] &= ~(1ull << (index % 64));
+            ++m_NumTrimmedHeaps;
+        }
+    }
+
+private: // Methods
+    UINT GetWriteEpochRange(HeapOffset Offset) const noexcept
+    {
+        return static_cast<UINT>((Offset.ptr / (m_DescriptorSize * c_DescriptorsPerWriteEpochRange)) % c_NumWriteEpochRanges);
+    }
+
+    static UINT FindFirstSetBit(UINT64 bits) noexcept
+    {
+        assert(bits != 0);
+        unsigned long index = 0;
+#ifdef BitScanForward64
+        BitScanForward64(&index, bits);
+#else
+        if (!BitScanForward(&index, static_cast<unsigned long>(bits)))
+        {
+            BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+            index += 32;
+        }
+#endif
+        return index;
+    }
 
-            SFreeRange NewRange = 
+    SMagazine& GetMagazine() noexcept
+    {
+        return m_pMagazines[GetCurrentThreadId() % c_NumMagazines];
+    }
+
+    void FlushMagazines() noexcept
+    {
+        if (!m_pMagazines)
+        {
+            return;
+        }
+        for (UINT i = 0; i < c_NumMagazines; ++i)
+        {
+            SMagazine& Magazine = m_pMagazines[i];
+            std::lock_guard<std::mutex> MagazineLock(Magazine.m_Lock);
+            auto Lock = m_CritSect.TakeLock();
+            for (UINT j = 0; j < Magazine.m_Count; ++j)
             {
-                Offset.ptr,
-                Offset.ptr + m_DescriptorSize
-            };
-
-            bool bFound = false;
-            for (auto it = HeapEntry.m_FreeList.begin(), end = HeapEntry.m_FreeList.end();
-                 it != end && !bFound;
-                 ++it)
+                ReleaseSlot(Magazine.m_Slots[j]);
+            }
+            Magazine.m_Count = 0;
+        }
+    }
+
+    // Allocates between 1 and Count slots, preferring the lowest-indexed heaps so that
+    // the others are more likely to drain and become trimmable.
+    UINT AllocateSlots(_Out_writes_(Count) SSlot* pSlots, UINT Count) noexcept(false)
+    {
+        UINT FreeHeapWord = 0;
+        while (FreeHeapWord < m_FreeHeaps.size() && m_FreeHeaps[FreeHeapWord] == 0)
+        {
+            ++FreeHeapWord;
+        }
+        if (FreeHeapWord == m_FreeHeaps.size())
+        {
+            AllocateHeap(); // throw( _com_error, bad_alloc )
+            FreeHeapWord = 0;
+            while (m_FreeHeaps[FreeHeapWord] == 0)
             {
-                SFreeRange &Range = *it;
-                assert(Range.Start <= Range.End);
-                if (Range.Start == Offset.ptr + m_DescriptorSize)
-                {
-                    Range.Start = Offset.ptr;
-                    bFound = true;
-                }
-                else if (Range.End == Offset.ptr)
-                {
-                    Range.End += m_DescriptorSize;
-                    bFound = true;
-                }
-                else
-                {
-                    assert(Range.End < Offset.ptr || Range.Start > Offset.ptr);
-                    if (Range.Start > Offset.ptr)
-                    {
-                        HeapEntry.m_FreeList.insert(it, NewRange); // throw( bad_alloc )
-                        bFound = true;
-                    }
-                }
+                ++FreeHeapWord;
             }
+        }
 
-            if (!bFound)
+        UINT NumAllocated = 0;
+        while (NumAllocated < Count && FreeHeapWord < m_FreeHeaps.size())
+        {
+            if (m_FreeHeaps[FreeHeapWord] == 0)
             {
-                if (HeapEntry.m_FreeList.empty())
-                {
-                    m_FreeHeaps.push_back(index); // throw( bad_alloc )
-                }
-                HeapEntry.m_FreeList.push_back(NewRange); // throw( bad_alloc )
+                ++FreeHeapWord;
+                continue;
             }
+
+            const HeapIndex index = FreeHeapWord * 64 + FindFirstSetBit(m_FreeHeaps[FreeHeapWord]);
+            SHeapEntry &HeapEntry = m_Heaps[index];
+            while (NumAllocated < Count && HeapEntry.m_NumFree > 0)
+            {
+                pSlots[NumAllocated++] = { HeapEntry.m_Base + AllocateSlotIndex(HeapEntry) * m_DescriptorSize, index };
+            }
+            if (HeapEntry.m_NumFree == 0)
+            {
+                m_FreeHeaps[FreeHeapWord] &= ~(1ull << (index % 64));
+            }
+        }
+        return NumAllocated;
+    }
+
+    static UINT AllocateSlotIndex(SHeapEntry &HeapEntry) noexcept
+    {
+        assert(HeapEntry.m_NumFree > 0);
+        UINT SummaryWord = 0;
+        while (HeapEntry.m_NonEmptyWords[SummaryWord] == 0)
+        {
+            ++SummaryWord;
+        }
+        const UINT Word = SummaryWord * 64 + FindFirstSetBit(HeapEntry.m_NonEmptyWords[SummaryWord]);
+        const UINT Bit = FindFirstSetBit(HeapEntry.m_FreeBits[Word]);
+
+        HeapEntry.m_FreeBits[Word] &= ~(1ull << Bit);
+        if (HeapEntry.m_FreeBits[Word] == 0)
+        {
+            HeapEntry.m_NonEmptyWords[SummaryWord] &= ~(1ull << (Word % 64));
         }
-        catch( std::bad_alloc& )
+        --HeapEntry.m_NumFree;
+        return Word * 64 + Bit;
+    }
+
+    void ReleaseSlot(SSlot const& Slot) noexcept
+    {
+        assert(Slot.m_Index < m_Heaps.size());
+        SHeapEntry &HeapEntry = m_Heaps[Slot.m_Index];
+        assert(HeapEntry.m_Heap.get() && Slot.m_Offset >= HeapEntry.m_Base);
+        assert((Slot.m_Offset - HeapEntry.m_Base) % m_DescriptorSize == 0);
+
+        const UINT SlotIndex = static_cast<UINT>((Slot.m_Offset - HeapEntry.m_Base) / m_DescriptorSize);
+        assert(SlotIndex < m_Desc.NumDescriptors);
+        const UINT Word = SlotIndex / 64;
+        assert((HeapEntry.m_FreeBits[Word] & (1ull << (SlotIndex % 64))) == 0);
+
+        HeapEntry.m_FreeBits[Word] |= 1ull << (SlotIndex % 64);
+        HeapEntry.m_NonEmptyWords[Word / 64] |= 1ull << (Word % 64);
+        if (HeapEntry.m_NumFree++ == 0)
         {
-            // Do nothing - there will be slots that can no longer be reclaimed.
+            m_FreeHeaps[Slot.m_Index / 64] |= 1ull << (Slot.m_Index % 64);
         }
     }
 
-private: // Methods
     void AllocateHeap() noexcept(false)
     {
         SHeapEntry NewEntry;
-        ThrowFailure( m_pDevice->CreateDescriptorHeap(&m_Desc, IID_PPV_ARGS(&NewEntry.m_Heap)) ); // throw( _com_error )
-        HeapOffset HeapBase = NewEntry.m_Heap->GetCPUDescriptorHandleForHeapStart();
-        NewEntry.m_FreeList.push_back({HeapBase.ptr,
-                                        HeapBase.ptr + m_Desc.NumDescriptors * m_DescriptorSize}); // throw( bad_alloc )
+        SHeapEntry* pEntry = &NewEntry;
+        HeapIndex index = static_cast<HeapIndex>(m_Heaps.size());
+        if (m_NumTrimmedHeaps > 0)
+        {
+            for (index = 0; m_Heaps[index].m_Heap.get(); ++index);
+            pEntry = &m_Heaps[index];
+        }
+        else
+        {
+            const UINT NumWords = (m_Desc.NumDescriptors + 63) / 64;
+            NewEntry.m_FreeBits.resize(NumWords); // throw( bad_alloc )
+            NewEntry.m_NonEmptyWords.resize((NumWords + 63) / 64); // throw( bad_alloc )
+            if (m_FreeHeaps.size() <= index / 64)
+            {
+                m_FreeHeaps.push_back(0); // throw( bad_alloc )
+            }
+        }
+
+        ThrowFailure( m_pDevice->CreateDescriptorHeap(&m_Desc, IID_PPV_ARGS(&pEntry->m_Heap)) ); // throw( _com_error )
+        pEntry->m_Base = pEntry->m_Heap->GetCPUDescriptorHandleForHeapStart().ptr;
+
+        // Mark every slot free, leaving the bits past the end of the heap clear.
+        const UINT NumWords = static_cast<UINT>(pEntry->m_FreeBits.size());
+        std::fill(pEntry->m_FreeBits.begin(), pEntry->m_FreeBits.end(), ~0ull);
+        std::fill(pEntry->m_NonEmptyWords.begin(), pEntry->m_NonEmptyWords.end(), ~0ull);
+        if (m_Desc.NumDescriptors % 64)
+        {
+            pEntry->m_FreeBits.back() = (1ull << (m_Desc.NumDescriptors % 64)) - 1;
+        }
+        if (NumWords % 64)
+        {
+            pEntry->m_NonEmptyWords.back() = (1ull << (NumWords % 64)) - 1;
+        }
+        pEntry->m_NumFree = m_Desc.NumDescriptors;
 
-        m_Heaps.emplace_back(std::move(NewEntry)); // throw( bad_alloc )
-        m_FreeHeaps.push_back(static_cast<HeapIndex>(m_Heaps.size() - 1)); // throw( bad_alloc )
+        if (pEntry == &NewEntry)
+        {
+            m_Heaps.emplace_back(std::move(NewEntry)); // throw( bad_alloc )
+        }
+        else
+        {
+            --m_NumTrimmedHeaps;
+        }
+        m_FreeHeaps[index / 64] |= 1ull << (index % 64);
     }
 
 private: // Members
@@ -524,7 +1076,79 @@ private: // Members
     OptLock<> m_CritSect;
 
     THeapMap m_Heaps;
-    std::list<HeapIndex> m_FreeHeaps;
+    std::vector<UINT64> m_FreeHeaps; // Bit per heap with at least one free slot
+    UINT m_NumTrimmedHeaps = 0;
+    std::unique_ptr<SMagazine[]> m_pMagazines;
+
+    static constexpr UINT c_DescriptorsPerWriteEpochRange = 64;
+    static constexpr UINT c_NumWriteEpochRanges = 256;
+    std::atomic<UINT64> m_WriteEpochs[c_NumWriteEpochRanges] = {};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bindless index allocator
+// Hands out persistent slots in the shader-visible heaps, for views and samplers which are bound by index rather than through
+// descriptor tables. Indices are recycled once the last command list which could have referenced them has completed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CBindlessIndexAllocator
+{
+public:
+    static constexpr UINT c_InvalidIndex = UINT_MAX;
+
+    CBindlessIndexAllocator(bool bLockRequired) noexcept(false)
+        : m_Lock(bLockRequired)
+    {
+    }
+
+    void Initialize(UINT FirstIndex, UINT NumIndices) noexcept
+    {
+        m_NextUnused = FirstIndex;
+        m_End = FirstIndex + NumIndices;
+    }
+
+    // Returns c_InvalidIndex when every index is either live, or retired by a command list which hasn't completed.
+    UINT Allocate(UINT64 CompletedFenceValue) noexcept
+    {
+        auto Lock = m_Lock.TakeLock();
+        if (!m_Retired.empty() && m_Retired.front().first <= CompletedFenceValue)
+        {
+            UINT Index = m_Retired.front().second;
+            m_Retired.pop_front();
+            return Index;
+        }
+        if (m_NextUnused < m_End)
+        {
+            return m_NextUnused++;
+        }
+        return c_InvalidIndex;
+    }
+
+    void Retire(UINT Index, UINT64 FenceValue) noexcept
+    {
+        assert(Index != c_InvalidIndex);
+        auto Lock = m_Lock.TakeLock();
+        try
+        {
+            m_Retired.insert(FenceValue, std::move(Index)); // throw( bad_alloc )
+        }
+        catch (std::bad_alloc&)
+        {
+            // The index is leaked, which only costs capacity
+        }
+    }
+
+    // The fence value which has to complete before Allocate can recycle an index, or UINT64_MAX if nothing is retired.
+    UINT64 GetOldestRetiredFenceValue() noexcept
+    {
+        auto Lock = m_Lock.TakeLock();
+        return m_Retired.empty() ? UINT64_MAX : m_Retired.front().first;
+    }
+
+private:
+    OptLock<> m_Lock;
+    CFenceOrderedRing<UINT> m_Retired;
+    UINT m_NextUnused = 0;
+    UINT m_End = 0;
 };
 
 // Extra data appended to the end of stream-output buffers
@@ -703,7 +1327,8 @@ struct RetiredD3D12Object : public RetiredObject
     std::unique_ptr<ResidencyManagedObjectWrapper> m_pResidencyHandle;
 };
 
-typedef ConditionalAllocator<HeapSuballocationBlock, UINT64, DirectHeapAllocator, ThreadSafeBuddyHeapAllocator, bool> ConditionalHeapAllocator;
+// Suballocations only round up to D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, rather than to a power of two like the buddy allocator.
+typedef ConditionalAllocator<HeapSuballocationBlock, UINT64, DirectHeapAllocator, ThreadSafeTLSFHeapAllocator, bool> ConditionalHeapAllocator;
 struct RetiredSuballocationBlock : public RetiredObject
 {
     RetiredSuballocationBlock(HeapSuballocationBlock &block, ConditionalHeapAllocator &parentAllocator, COMMAND_LIST_TYPE CommandListType, UINT64 lastCommandListID) :
@@ -923,10 +1548,21 @@ public:
         UINT DisableGPUTimeout : 1;
         UINT IsXbox : 1;
         UINT AdjustYUY2BlitCoords : 1;
+        UINT UsePredictiveEviction : 1;
+        UINT TrimDescriptorHeaps : 1;
+#ifdef USE_BINDLESS_DESCRIPTORS
+        // Experimental: no shader translation path indexes the descriptor heaps yet, so this is only built with the
+        // USE_BINDLESS_DESCRIPTORS option. Only honored with resource binding tier 3 and shader model 6.6.
+        UINT UseBindlessDescriptors : 1;
+#endif
+        UINT UseSplitBarriers : 1;
+        UINT UseEnhancedBarriers : 1; // Only honored when the device supports enhanced barriers
         GUID CreatorID;
         DWORD MaxAllocatedUploadHeapSpacePerCommandList;
         DWORD MaxSRVHeapSize;
         DWORD BufferPoolTrimThreshold;
+        const wchar_t* PipelineStateCacheFileName; // Optional, only needs to remain valid during construction
+        UINT64 MaxPipelineStateCacheSize; // 0 selects PipelineStateCache::c_DefaultMaxSize
     };
 
     ImmediateContext(UINT nodeIndex, D3D12_FEATURE_DATA_D3D12_OPTIONS& caps,
@@ -940,6 +1576,7 @@ public:
 
     bool RequiresBufferOutofBoundsHandling() { return m_CreationArgs.RequiresBufferOutOfBoundsHandling; }
     bool IsXbox() { return m_CreationArgs.IsXbox; } // Currently only accurate with D3D11.
+    bool UseBindlessDescriptors() const { return m_bUseBindlessDescriptors; }
 
     CommandListManager *GetCommandListManager(COMMAND_LIST_TYPE type) noexcept;
     ID3D12CommandList *GetCommandList(COMMAND_LIST_TYPE type) noexcept;
@@ -988,6 +1625,24 @@ public:
     D3D12ResourceSuballocation AcquireSuballocatedHeap(AllocatorHeapType HeapType, UINT64 Size, ResourceAllocationContext threadingContext, bool bCannotBeOffset = false) noexcept(false);
     void ReleaseSuballocatedHeap(AllocatorHeapType HeapType, D3D12ResourceSuballocation &resource, UINT64 FenceValue, COMMAND_LIST_TYPE commandListType) noexcept;
     void ReleaseSuballocatedHeap(AllocatorHeapType HeapType, D3D12ResourceSuballocation &resource, const UINT64 FenceValues[]) noexcept;
+    UploadRingStatistics GetUploadRingStatistics() noexcept;
+
+    // Must be called on the immediate context thread. Counters written by other threads are read without locks,
+    // except for the heap suballocators' usage, which takes their locks if they're free-threaded.
+    MemoryTelemetry GetMemoryTelemetry() noexcept;
+
+    // Must be called on the immediate context thread.
+    DescriptorTableCacheStatistics GetSRVTableCacheStatistics() const noexcept { return m_SRVTableCache.GetStatistics(); }
+    DescriptorTableCacheStatistics GetSamplerTableCacheStatistics() const noexcept { return m_SamplerTableCache.GetStatistics(); }
+
+    // Free-threaded.
+    PipelineStateCompileStatistics GetPipelineStateCompileStatistics() const noexcept { return m_PSOCompileScheduler.GetStatistics(); }
+
+    // Must be called on the immediate context thread.
+    ResourceBarrierStatistics GetResourceBarrierStatistics() const noexcept { return m_ResourceStateManager.GetBarrierStatistics(); }
+
+    // Overrides the residency priority derived from the resource's bind flags.
+    void TRANSLATION_API SetResidencyPriority(Resource* pResource, D3D12_RESIDENCY_PRIORITY Priority);
 
     void ReturnAllBuffersToPool( Resource& UnderlyingResource) noexcept;
    
@@ -1095,6 +1750,7 @@ public:
     // Subresource binding states are assumed to already be changed using wrappers below
     void TransitionResourceForBindings(Resource* pResource) noexcept;
     void TransitionResourceForBindings(ViewBase* pView) noexcept;
+    void TransitionResourceForChangedBindings(ViewBase* pView) noexcept;
     static void ConstantBufferBound(Resource* pBuffer, UINT slot, EShaderStage stage) noexcept;
     static void ConstantBufferUnbound(Resource* pBuffer, UINT slot, EShaderStage stage) noexcept;
     static void VertexBufferBound(Resource* pBuffer, UINT slot) noexcept;
@@ -1414,13 +2070,17 @@ private:
     template <bool bDispatch> UINT CalculateViewSlotsForBindings() noexcept;
     template <bool bDispatch> UINT CalculateSamplerSlotsForBindings() noexcept;
 
+    // Look up dirty SRV and sampler tables in the descriptor table caches, before ring space is reserved for them
+    template<EShaderStage eShader>
+    void FindCachedDescriptorTablesHelper() noexcept;
+
     // Mark used in command list, copy to descriptor heap, and bind table
     template<EShaderStage eShader>
-    void DirtyShaderResourcesHelper(UINT& HeapSlot) noexcept;
+    void DirtyShaderResourcesHelper(UINT& HeapSlot) noexcept(false);
     template<EShaderStage eShader>
     void DirtyConstantBuffersHelper(UINT& HeapSlot) noexcept;
     template<EShaderStage eShader>
-    void DirtySamplersHelper(UINT& HeapSlot) noexcept;
+    void DirtySamplersHelper(UINT& HeapSlot) noexcept(false);
 
     // Mark used in command list and bind table (descriptors already in heap)
     template<EShaderStage eShader>
@@ -1447,7 +2107,7 @@ private:
 
     UINT GetCurrentCommandListTypeMask() noexcept;
 
-    void InsertUAVBarriersIfNeeded(CViewBoundState<UAV, D3D11_1_UAV_SLOT_COUNT>& UAVBindings, UINT NumUAVs) noexcept;
+    void InsertUAVBarriersIfNeeded(CViewBoundState<UAV, D3D11_1_UAV_SLOT_COUNT>& UAVBindings, UINT NumUAVs) noexcept(false);
 
 public: // Methods
     UINT GetNodeMask() const noexcept
@@ -1492,6 +2152,9 @@ public: // variables
 
     std::unordered_map<RootSignatureDesc, std::unique_ptr<RootSignature>> m_RootSignatures;
 
+    // Declared ahead of the thread pool, so that in-flight compiles finish with them before they're torn down
+    PipelineStateCompileScheduler m_PSOCompileScheduler;
+    std::unique_ptr<PipelineStateCache> m_spPipelineStateCache;
     std::unique_ptr<CThreadPool> m_spPSOCompilationThreadPool;
 
     // "Online" descriptor heaps
@@ -1509,6 +2172,8 @@ public: // variables
         CFencedRingBuffer m_DescriptorRingBuffer;
 
         CFencePool< unique_comptr<ID3D12DescriptorHeap> > m_HeapPool;
+        // Atomic so that telemetry can be read from other threads
+        std::atomic<UINT64> m_NumRollOvers{ 0 };
 
         inline D3D12_CPU_DESCRIPTOR_HANDLE CPUHandle(UINT slot) { 
             assert(slot < m_Desc.NumDescriptors);
@@ -1520,14 +2185,61 @@ public: // variables
         }
     } m_ViewHeap, m_SamplerHeap;
 
+    // UAV tables aren't cached, since UAVs are recreated every time they're refreshed, and CBVs are created in place.
+    CDescriptorTableCache<D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT> m_SRVTableCache;
+    CDescriptorTableCache<D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT> m_SamplerTableCache;
+
+    // Dirty bits of tables which were found in the caches before ring space was reserved, so they don't need to be written
+    UINT m_CachedDescriptorTables = 0;
+
+    DescriptorTableScope GetDescriptorTableScope(OnlineDescriptorHeap const& Heap, CDescriptorHeapManager const& Source,
+        UINT NumDescriptors, _In_reads_(NumDescriptors) const D3D12_CPU_DESCRIPTOR_HANDLE* pDescriptors) noexcept
+    {
+        return { GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS), Heap.m_NumRollOvers.load(std::memory_order_relaxed),
+                 Source.GetWriteEpoch(NumDescriptors, pDescriptors) };
+    }
+
     void RollOverHeap(OnlineDescriptorHeap& Heap) noexcept(false);
     UINT ReserveSlotsForBindings(OnlineDescriptorHeap& Heap, UINT (ImmediateContext::*pfnCalcRequiredSlots)()) noexcept(false);
     UINT ReserveSlots(OnlineDescriptorHeap& Heap, UINT NumSlots) noexcept(false);
 
-    D3D12_CPU_DESCRIPTOR_HANDLE m_NullSRVs[(UINT)RESOURCE_DIMENSION::TEXTURECUBEARRAY+1];
-    D3D12_CPU_DESCRIPTOR_HANDLE m_NullUAVs[(UINT)RESOURCE_DIMENSION::TEXTURECUBEARRAY+1];
+    D3D12_CPU_DESCRIPTOR_HANDLE m_NullSRVs[(UINT)RESOURCE_DIMENSION::TEXTURECUBEARRAY+1] = {};
+    D3D12_CPU_DESCRIPTOR_HANDLE m_NullUAVs[(UINT)RESOURCE_DIMENSION::TEXTURECUBEARRAY+1] = {};
     D3D12_CPU_DESCRIPTOR_HANDLE m_NullRTV;
     D3D12_CPU_DESCRIPTOR_HANDLE m_NullSampler;
+
+    // Bindless mode
+    // The start of each shader-visible heap is used as the per-draw ring, and the remainder holds persistent descriptors,
+    // so the heaps are never replaced. Bindings are uploaded as tightly packed arrays of heap indices, in slot order.
+    static constexpr UINT c_BindlessViewRingSize = 65536;
+    static constexpr UINT c_BindlessSamplerRingSize = 512;
+    // Only CBV tables use the view ring in bindless mode, so a draw needs at most one table per graphics stage, and other
+    // operations need a few slots. Once the previous command list completes, the current one holds at most half of the
+    // ring plus one operation, so the free space around it always has a contiguous block of nearly a quarter of the ring.
+    static constexpr UINT c_MaxBindlessRingSlotsPerOperation = 5 * D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT;
+    static_assert(c_MaxBindlessRingSlotsPerOperation < c_BindlessSamplerRingSize / 4, "Bindless rings must be recoverable without waiting on the current command list.");
+    UINT m_NullSRVBindlessIndices[(UINT)RESOURCE_DIMENSION::TEXTURECUBEARRAY+1];
+    UINT m_NullUAVBindlessIndices[(UINT)RESOURCE_DIMENSION::TEXTURECUBEARRAY+1];
+    UINT m_NullSamplerBindlessIndex;
+    UINT64 m_BindlessCommandListID = 0;
+
+    // Index tables written by one PreDraw/PreDispatch are gathered here and uploaded together. Each table is aligned so
+    // that it can be bound as a root CBV, and its GPU VA is patched into the stage state once the upload is placed.
+    static constexpr UINT c_BindlessIndexTableAlignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT / sizeof(UINT);
+    static constexpr UINT c_MaxBindlessIndexTables = 5 * 2 + 1; // (SRV, Sampler) * 5 shader stages + UAV
+    static_assert(D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT <= c_BindlessIndexTableAlignment, "Sampler tables are padded to one alignment unit.");
+    UINT m_BindlessIndexScratch[5 * D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT + 5 * c_BindlessIndexTableAlignment + D3D11_1_UAV_SLOT_COUNT];
+    UINT m_NumBindlessIndices = 0;
+    D3D12_GPU_DESCRIPTOR_HANDLE* m_pBindlessIndexTables[c_MaxBindlessIndexTables];
+    UINT m_BindlessIndexTableOffsets[c_MaxBindlessIndexTables];
+    UINT m_NumBindlessIndexTables = 0;
+
+    void PrepareBindlessBindings() noexcept(false);
+    UINT CopyToBindlessIndex(CBindlessIndexAllocator& Allocator, OnlineDescriptorHeap& Heap, D3D12_CPU_DESCRIPTOR_HANDLE Descriptor) noexcept(false);
+    template <typename TIface> UINT GetBindlessIndex(View<TIface>* pView) noexcept(false);
+    UINT GetBindlessIndex(Sampler* pSampler) noexcept(false);
+    UINT* AppendBindlessIndexTable(UINT NumIndices, D3D12_GPU_DESCRIPTOR_HANDLE& Table) noexcept;
+    void UploadBindlessIndexTables() noexcept(false);
     TDeclVector m_UAVDeclScratch;
 
     // Offline descriptor heaps
@@ -1537,13 +2249,15 @@ public: // variables
     CDescriptorHeapManager m_DSVAllocator;
     CDescriptorHeapManager m_SamplerAllocator;
 
+    // Persistent slots in the shader-visible heaps, only used in bindless mode
+    CBindlessIndexAllocator m_BindlessViewIndices;
+    CBindlessIndexAllocator m_BindlessSamplerIndices;
+
     ResourceCache m_ResourceCache;
     std::vector<D3D12_RECT> m_RectCache;
 
     // UAV barriers are not managed by the state manager.
-    // The state manager deals with changes in state, where UAV barriers need to be inserted
-    // in steady-state scenarios.
-    std::vector<D3D12_RESOURCE_BARRIER> m_vUAVBarriers;
+    UAVBarrierTracker m_UAVBarriers;
 
     // Objects for GenerateMips
     typedef std::tuple<DXGI_FORMAT, D3D12_RESOURCE_DIMENSION> MipGenKey;
@@ -1587,6 +2301,8 @@ public: // variables
         return m_CreationArgs.UseRoundTripPSOs;
     }
 
+    PipelineStateCache* GetPipelineStateCache() noexcept { return m_spPipelineStateCache.get(); }
+
     TranslationLayerCallbacks const& GetUpperlayerCallbacks() { return m_callbacks; }
 
     ResidencyManager &GetResidencyManager() { return m_residencyManager; }
@@ -1622,7 +2338,7 @@ private: // Dynamic/staging resource pools
         return m_UploadBufferPool;
     }
 
-    // This is the maximum amount of memory the buddy allocator can use. Picking an abritrarily high
+    // This is the maximum amount of memory the heap suballocator can use. Picking an abritrarily high
     // cap that allows this to pass tests that can potentially spend the whole GPU's memory on
     // suballocated heaps
     static constexpr UINT64 cBuddyMaxBlockSize = 32ll * 1024ll * 1024ll * 1024ll;
@@ -1707,6 +2423,7 @@ private:
     } m_SyncronousOpScrachSpace;
 
     const bool m_bUseRingBufferDescriptorHeaps;
+    bool m_bUseBindlessDescriptors = false;
 
 public: // cached feature data
 
@@ -476,33 +476,48 @@ inline void TRANSLATION_API ImmediateContext::DrawInstancedIndirect(Resource* pB
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
-inline void ImmediateContext::InsertUAVBarriersIfNeeded(CViewBoundState<UAV, D3D11_1_UAV_SLOT_COUNT>& UAVBindings, UINT NumUAVs) noexcept
+inline void ImmediateContext::InsertUAVBarriersIfNeeded(CViewBoundState<UAV, D3D11_1_UAV_SLOT_COUNT>& UAVBindings, UINT NumUAVs) noexcept(false)
 {
     // Insert UAV barriers if necessary, and indicate UAV barriers will be necessary next time
     // TODO: Optimizations here could avoid inserting barriers on read-after-read
     auto pUAVs = UAVBindings.GetBound();
-    m_vUAVBarriers.clear();
+    const UINT64 CommandListID = GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS);
     for (UINT i = 0; i < NumUAVs; ++i)
     {
         if (pUAVs[i])
         {
-            if (pUAVs[i]->m_pResource->m_Identity->m_LastUAVAccess == GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS))
-            {
-                m_vUAVBarriers.push_back({ D3D12_RESOURCE_BARRIER_TYPE_UAV });
-                m_vUAVBarriers.back().UAV.pResource = pUAVs[i]->m_pResource->GetUnderlyingResource();
-            }
-            pUAVs[i]->m_pResource->m_Identity->m_LastUAVAccess = GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS);
+            m_UAVBarriers.AddAccess(pUAVs[i]->m_pResource->GetUnderlyingResource(), pUAVs[i]->m_pResource->m_Identity->m_LastUAVAccess, CommandListID);
         }
     }
-    if (m_vUAVBarriers.size())
+
+    UINT NumElided = 0;
+    auto& Barriers = m_UAVBarriers.TakeBarriers(NumElided);
+    if (Barriers.size())
+    {
+        m_ResourceStateManager.SubmitGraphicsBarriers(Barriers.data(), (UINT)Barriers.size()); // throw( bad_alloc )
+    }
+    if (Barriers.size() || NumElided)
+    {
+        m_ResourceStateManager.AddUAVBarrierStatistics((UINT)Barriers.size(), NumElided);
+    }
+
+    for (UINT i = 0; i < NumUAVs; ++i)
     {
-        GetGraphicsCommandList()->ResourceBarrier((UINT)m_vUAVBarriers.size(), m_vUAVBarriers.data());
+        if (pUAVs[i])
+        {
+            m_UAVBarriers.StampAccess(pUAVs[i]->m_pResource->m_Identity->m_LastUAVAccess, CommandListID);
+        }
     }
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
 inline void ImmediateContext::PreDraw() noexcept(false)
 {
+    if (m_bUseBindlessDescriptors)
+    {
+        PrepareBindlessBindings(); // throws
+    }
+
 #ifdef USE_PIX
     PIXScopedEvent(GetGraphicsCommandList(), 0ull, L"PreDraw");
 #endif
@@ -529,6 +544,11 @@ inline void ImmediateContext::PreDraw() noexcept(false)
             static constexpr UINT64 CBDirtyBits[] = { e_PSConstantBuffersDirty, e_VSConstantBuffersDirty, e_GSConstantBuffersDirty, e_HSConstantBuffersDirty, e_DSConstantBuffersDirty };
             static constexpr UINT64 SRVDirtyBits[] = { e_PSShaderResourcesDirty, e_VSShaderResourcesDirty, e_GSShaderResourcesDirty, e_HSShaderResourcesDirty, e_DSShaderResourcesDirty };
             static constexpr UINT64 SamplerDirtyBits[] = { e_PSSamplersDirty, e_VSSamplersDirty, e_GSSamplersDirty, e_HSSamplersDirty, e_DSSamplersDirty };
+            if (NewDesc.IsBindless() != OldDesc.IsBindless())
+            {
+                // Descriptor tables and index tables aren't interchangeable
+                m_DirtyStates |= e_GraphicsBindingsDirty;
+            }
             for (UINT i = 0; i < std::extent<decltype(OldDesc.m_ShaderStages)>::value; ++i)
             {
                 if (NewDesc.m_ShaderStages[i].GetCBBindingCount() > OldDesc.m_ShaderStages[i].GetCBBindingCount())
@@ -618,13 +638,24 @@ inline void ImmediateContext::PreDraw() noexcept(false)
         m_DirtyStates |= e_UnorderedAccessViewsDirty;
     }
 
+    // Tables found in the caches point at existing copies, so they don't need ring space
+    m_CachedDescriptorTables = 0;
+    if (m_DirtyStates & e_GraphicsBindingsDirty)
+    {
+        FindCachedDescriptorTablesHelper<e_PS>();
+        FindCachedDescriptorTablesHelper<e_VS>();
+        FindCachedDescriptorTablesHelper<e_GS>();
+        FindCachedDescriptorTablesHelper<e_HS>();
+        FindCachedDescriptorTablesHelper<e_DS>();
+    }
+
     // Now that pipeline dirty bits are set appropriately, check if we need to update the descriptor heap
     UINT ViewHeapSlot = ReserveSlotsForBindings(m_ViewHeap, &ImmediateContext::CalculateViewSlotsForBindings<false>); // throw( _com_error )
     UINT SamplerHeapSlot = ReserveSlotsForBindings(m_SamplerHeap, &ImmediateContext::CalculateSamplerSlotsForBindings<false>); // throw( _com_error )
 
     auto& UAVBindings = m_CurrentState.m_UAVs;
     UINT numUAVs = RootSigDesc.GetUAVBindingCount();
-    InsertUAVBarriersIfNeeded(UAVBindings, numUAVs);
+    InsertUAVBarriersIfNeeded(UAVBindings, numUAVs); // throw( bad_alloc )
 
     // Update the descriptor heap, and apply dirty bindings
     if (m_DirtyStates & e_GraphicsBindingsDirty)
@@ -650,7 +681,13 @@ inline void ImmediateContext::PreDraw() noexcept(false)
         DirtySamplersHelper<e_HS>(SamplerHeapSlot);
         DirtySamplersHelper<e_DS>(SamplerHeapSlot);
 
-        if (m_DirtyStates & e_UnorderedAccessViewsDirty)
+        if ((m_DirtyStates & e_UnorderedAccessViewsDirty) && RootSigDesc.IsBindless())
+        {
+            UINT* pIndices = AppendBindlessIndexTable(numUAVs, m_CurrentState.m_UAVTableBase);
+            UAVBindings.FillBindlessIndices(pIndices, m_NullUAVBindlessIndices, numUAVs,
+                [this](UAV* pUAV) { return GetBindlessIndex(pUAV); }); // throw( _com_error )
+        }
+        else if (m_DirtyStates & e_UnorderedAccessViewsDirty)
         {
             auto& UAVTableBase = m_CurrentState.m_UAVTableBase;
             static const UINT MaxUAVs = UAVBindings.NumBindings;
@@ -668,6 +705,8 @@ inline void ImmediateContext::PreDraw() noexcept(false)
 
             ViewHeapSlot += numUAVs;
         }
+
+        UploadBindlessIndexTables(); // throw( _com_error )
     }
 
     // Now the current state is up to date, let's apply it to the command list
@@ -743,7 +782,14 @@ inline void ImmediateContext::PreDraw() noexcept(false)
             static const UINT UAVTableIndex = 15;
             auto const& UAVTableBase = m_CurrentState.m_UAVTableBase;
 
-            GetGraphicsCommandList()->SetGraphicsRootDescriptorTable(UAVTableIndex, UAVTableBase);
+            if (m_CurrentState.m_pPSO->GetRootSignature()->m_Desc.IsBindless())
+            {
+                GetGraphicsCommandList()->SetGraphicsRootConstantBufferView(UAVTableIndex, UAVTableBase.ptr);
+            }
+            else
+            {
+                GetGraphicsCommandList()->SetGraphicsRootDescriptorTable(UAVTableIndex, UAVTableBase);
+            }
         }
 
         // States that cannot be dirty (no recomputing necessary)
@@ -782,24 +828,30 @@ template <bool bDispatch>
 inline UINT ImmediateContext::CalculateViewSlotsForBindings() noexcept
 {
     UINT NumRequiredSlots = 0;
-    auto pfnAccumulate = [this, &NumRequiredSlots](UINT dirtyBit, UINT count)
+    auto& RootSigDesc = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc;
+    const UINT DirtyStates = m_DirtyStates & ~m_CachedDescriptorTables;
+    auto pfnAccumulate = [DirtyStates, &NumRequiredSlots](UINT dirtyBit, UINT count)
     {
-        if (m_DirtyStates & dirtyBit) { NumRequiredSlots += count; }
+        if (DirtyStates & dirtyBit) { NumRequiredSlots += count; }
+    };
+    // Bindless SRVs and UAVs are bound by index, so only CBs need space in the ring
+    auto pfnAccumulateView = [&pfnAccumulate, &RootSigDesc](UINT dirtyBit, UINT count)
+    {
+        if (!RootSigDesc.IsBindless()) { pfnAccumulate(dirtyBit, count); }
     };
-    auto& RootSigDesc = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc;
     if (bDispatch)
     {
-        pfnAccumulate(e_CSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_CS>().GetSRVBindingCount());
+        pfnAccumulateView(e_CSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_CS>().GetSRVBindingCount());
         pfnAccumulate(e_CSConstantBuffersDirty, RootSigDesc.GetShaderStage<e_CS>().GetCBBindingCount());
-        pfnAccumulate(e_CSUnorderedAccessViewsDirty, RootSigDesc.GetUAVBindingCount());
+        pfnAccumulateView(e_CSUnorderedAccessViewsDirty, RootSigDesc.GetUAVBindingCount());
     }
     else
     {
-        pfnAccumulate(e_PSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_PS>().GetSRVBindingCount());
-        pfnAccumulate(e_VSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_VS>().GetSRVBindingCount());
-        pfnAccumulate(e_GSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_GS>().GetSRVBindingCount());
-        pfnAccumulate(e_HSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_HS>().GetSRVBindingCount());
-        pfnAccumulate(e_DSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_DS>().GetSRVBindingCount());
+        pfnAccumulateView(e_PSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_PS>().GetSRVBindingCount());
+        pfnAccumulateView(e_VSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_VS>().GetSRVBindingCount());
+        pfnAccumulateView(e_GSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_GS>().GetSRVBindingCount());
+        pfnAccumulateView(e_HSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_HS>().GetSRVBindingCount());
+        pfnAccumulateView(e_DSShaderResourcesDirty, RootSigDesc.GetShaderStage<e_DS>().GetSRVBindingCount());
 
         pfnAccumulate(e_PSConstantBuffersDirty, RootSigDesc.GetShaderStage<e_PS>().GetCBBindingCount());
         pfnAccumulate(e_VSConstantBuffersDirty, RootSigDesc.GetShaderStage<e_VS>().GetCBBindingCount());
@@ -807,7 +859,7 @@ inline UINT ImmediateContext::CalculateViewSlotsForBindings() noexcept
         pfnAccumulate(e_HSConstantBuffersDirty, RootSigDesc.GetShaderStage<e_HS>().GetCBBindingCount());
         pfnAccumulate(e_DSConstantBuffersDirty, RootSigDesc.GetShaderStage<e_DS>().GetCBBindingCount());
 
-        pfnAccumulate(e_UnorderedAccessViewsDirty, RootSigDesc.GetUAVBindingCount());
+        pfnAccumulateView(e_UnorderedAccessViewsDirty, RootSigDesc.GetUAVBindingCount());
     }
     return NumRequiredSlots;
 }
@@ -816,11 +868,16 @@ template <bool bDispatch>
 inline UINT ImmediateContext::CalculateSamplerSlotsForBindings() noexcept
 {
     UINT NumRequiredSlots = 0;
-    auto pfnAccumulate = [this, &NumRequiredSlots](UINT dirtyBit, UINT count)
+    const UINT DirtyStates = m_DirtyStates & ~m_CachedDescriptorTables;
+    auto pfnAccumulate = [DirtyStates, &NumRequiredSlots](UINT dirtyBit, UINT count)
     {
-        if (m_DirtyStates & dirtyBit) { NumRequiredSlots += count; }
+        if (DirtyStates & dirtyBit) { NumRequiredSlots += count; }
     };
     auto& RootSigDesc = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc;
+    if (RootSigDesc.IsBindless())
+    {
+        return 0;
+    }
     if (bDispatch)
     {
         pfnAccumulate(e_CSSamplersDirty, RootSigDesc.GetShaderStage<e_CS>().GetSamplerBindingCount());
@@ -837,20 +894,92 @@ inline UINT ImmediateContext::CalculateSamplerSlotsForBindings() noexcept
 }
 
 
+//----------------------------------------------------------------------------------------------------------------------------------
+template <typename TIface>
+inline UINT ImmediateContext::GetBindlessIndex(View<TIface>* pView) noexcept(false)
+{
+    D3D12_CPU_DESCRIPTOR_HANDLE Descriptor = pView->GetRefreshedDescriptorHandle(); // throw( _com_error )
+    if (pView->m_BindlessIndex == CBindlessIndexAllocator::c_InvalidIndex || pView->m_BindlessUniqueness != pView->m_ViewUniqueness)
+    {
+        // The old index may still be referenced by this command list, so renamed views move to a new index instead of overwriting it
+        UINT NewIndex = CopyToBindlessIndex(m_BindlessViewIndices, m_ViewHeap, Descriptor); // throw( _com_error )
+        if (pView->m_BindlessIndex != CBindlessIndexAllocator::c_InvalidIndex)
+        {
+            m_BindlessViewIndices.Retire(pView->m_BindlessIndex, GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS));
+        }
+        pView->m_BindlessIndex = NewIndex;
+        pView->m_BindlessUniqueness = pView->m_ViewUniqueness;
+    }
+    pView->MarkUsedInCommandListIfNewer(COMMAND_LIST_TYPE::GRAPHICS, GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS));
+    return pView->m_BindlessIndex;
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 template<EShaderStage eShader>
-inline void ImmediateContext::DirtyShaderResourcesHelper(UINT& HeapSlot) noexcept
+inline void ImmediateContext::FindCachedDescriptorTablesHelper() noexcept
 {
     typedef SShaderTraits<eShader> TShaderTraits;
-    if ((m_DirtyStates & TShaderTraits::c_ShaderResourcesDirty) == 0)
+    auto& RootSigDesc = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc;
+    if (RootSigDesc.IsBindless())
+    {
+        return;
+    }
+
+    SStageState& CurrentState = TShaderTraits::CurrentStageState(m_CurrentState);
+    D3D12_GPU_DESCRIPTOR_HANDLE Table;
+    if (m_DirtyStates & TShaderTraits::c_ShaderResourcesDirty)
+    {
+        UINT numSRVs = RootSigDesc.GetShaderStage<eShader>().GetSRVBindingCount();
+        D3D12_CPU_DESCRIPTOR_HANDLE Descriptors[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT];
+        CurrentState.m_SRVs.FillDescriptors(Descriptors, m_NullSRVs, numSRVs);
+
+        if (m_SRVTableCache.Find(GetDescriptorTableScope(m_ViewHeap, m_SRVAllocator, numSRVs, Descriptors), numSRVs, Descriptors, Table))
+        {
+            CurrentState.m_SRVTableBase = Table;
+            m_CachedDescriptorTables |= TShaderTraits::c_ShaderResourcesDirty;
+        }
+    }
+
+    // Compute-only devices have no sampler heap
+    if ((m_DirtyStates & TShaderTraits::c_SamplersDirty) && !ComputeOnly())
+    {
+        UINT numSamplers = RootSigDesc.GetShaderStage<eShader>().GetSamplerBindingCount();
+        D3D12_CPU_DESCRIPTOR_HANDLE Descriptors[D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT];
+        CurrentState.m_Samplers.FillDescriptors(Descriptors, &m_NullSampler, numSamplers);
+
+        if (m_SamplerTableCache.Find(GetDescriptorTableScope(m_SamplerHeap, m_SamplerAllocator, numSamplers, Descriptors), numSamplers, Descriptors, Table))
+        {
+            CurrentState.m_SamplerTableBase = Table;
+            m_CachedDescriptorTables |= TShaderTraits::c_SamplersDirty;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+template<EShaderStage eShader>
+inline void ImmediateContext::DirtyShaderResourcesHelper(UINT& HeapSlot) noexcept(false)
+{
+    typedef SShaderTraits<eShader> TShaderTraits;
+    if ((m_DirtyStates & TShaderTraits::c_ShaderResourcesDirty) == 0 ||
+        (m_CachedDescriptorTables & TShaderTraits::c_ShaderResourcesDirty))
     {
         return;
     }
 
     SStageState& CurrentState = TShaderTraits::CurrentStageState(m_CurrentState);
     auto& SRVBindings = CurrentState.m_SRVs;
-    UINT RootSigHWM = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc.GetShaderStage<eShader>().GetSRVBindingCount();
+    auto& RootSigDesc = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc;
+    UINT RootSigHWM = RootSigDesc.GetShaderStage<eShader>().GetSRVBindingCount();
     UINT numSRVs = RootSigHWM;
+
+    if (RootSigDesc.IsBindless())
+    {
+        UINT* pIndices = AppendBindlessIndexTable(numSRVs, CurrentState.m_SRVTableBase);
+        SRVBindings.FillBindlessIndices(pIndices, m_NullSRVBindlessIndices, RootSigHWM,
+            [this](SRV* pSRV) { return GetBindlessIndex(pSRV); }); // throw( _com_error )
+        return;
+    }
+
     static const UINT MaxSRVs = SRVBindings.NumBindings;
     assert(HeapSlot + numSRVs <= m_ViewHeap.m_Desc.NumDescriptors);
 
@@ -863,6 +992,8 @@ inline void ImmediateContext::DirtyShaderResourcesHelper(UINT& HeapSlot) noexcep
     m_pDevice12->CopyDescriptors(1, &SRVTableBaseCPU, &numSRVs,
         numSRVs, Descriptors, nullptr /*sizes*/,
         m_ViewHeap.m_Desc.Type);
+    m_SRVTableCache.Insert(GetDescriptorTableScope(m_ViewHeap, m_SRVAllocator, numSRVs, Descriptors), numSRVs, Descriptors,
+                           CurrentState.m_SRVTableBase);
 
     HeapSlot += numSRVs;
 }
@@ -904,20 +1035,30 @@ inline void ImmediateContext::DirtyConstantBuffersHelper(UINT& HeapSlot) noexcep
 
 //----------------------------------------------------------------------------------------------------------------------------------
 template<EShaderStage eShader>
-inline void ImmediateContext::DirtySamplersHelper(UINT& HeapSlot) noexcept
+inline void ImmediateContext::DirtySamplersHelper(UINT& HeapSlot) noexcept(false)
 {
     typedef SShaderTraits<eShader> TShaderTraits;
-    if ((m_DirtyStates & TShaderTraits::c_SamplersDirty) == 0)
+    if ((m_DirtyStates & TShaderTraits::c_SamplersDirty) == 0 ||
+        (m_CachedDescriptorTables & TShaderTraits::c_SamplersDirty))
     {
         return;
     }
 
     SStageState& CurrentState = TShaderTraits::CurrentStageState(m_CurrentState);
-    UINT RootSigHWM = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc.GetShaderStage<eShader>().GetSamplerBindingCount();
+    auto& RootSigDesc = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc;
+    UINT RootSigHWM = RootSigDesc.GetShaderStage<eShader>().GetSamplerBindingCount();
     UINT numSamplers = RootSigHWM;
     auto& SamplerBindings = CurrentState.m_Samplers;
     static const UINT MaxSamplers = SamplerBindings.NumBindings;
 
+    if (RootSigDesc.IsBindless())
+    {
+        UINT* pIndices = AppendBindlessIndexTable(numSamplers, CurrentState.m_SamplerTableBase);
+        SamplerBindings.FillBindlessIndices(pIndices, m_NullSamplerBindlessIndex, RootSigHWM,
+            [this](Sampler* pSampler) { return GetBindlessIndex(pSampler); }); // throw( _com_error )
+        return;
+    }
+
     assert(HeapSlot + numSamplers <= m_SamplerHeap.m_Desc.NumDescriptors);
 
     D3D12_CPU_DESCRIPTOR_HANDLE Descriptors[MaxSamplers];
@@ -929,6 +1070,8 @@ inline void ImmediateContext::DirtySamplersHelper(UINT& HeapSlot) noexcept
     m_pDevice12->CopyDescriptors(1, &SamplerTableBaseCPU, &numSamplers,
         numSamplers, Descriptors, nullptr /*sizes*/,
         m_SamplerHeap.m_Desc.Type);
+    m_SamplerTableCache.Insert(GetDescriptorTableScope(m_SamplerHeap, m_SamplerAllocator, numSamplers, Descriptors), numSamplers, Descriptors,
+                               CurrentState.m_SamplerTableBase);
 
     HeapSlot += numSamplers;
 }
@@ -961,6 +1104,10 @@ template<EShaderStage eShader> struct DescriptorBindFuncs
     {
         return &ID3D12GraphicsCommandList::SetGraphicsRootDescriptorTable;
     }
+    static decltype(&ID3D12GraphicsCommandList::SetGraphicsRootConstantBufferView) GetBindlessBindFunc()
+    {
+        return &ID3D12GraphicsCommandList::SetGraphicsRootConstantBufferView;
+    }
 };
 template<> struct DescriptorBindFuncs<e_CS>
 {
@@ -968,6 +1115,10 @@ template<> struct DescriptorBindFuncs<e_CS>
     {
         return &ID3D12GraphicsCommandList::SetComputeRootDescriptorTable;
     }
+    static decltype(&ID3D12GraphicsCommandList::SetComputeRootConstantBufferView) GetBindlessBindFunc()
+    {
+        return &ID3D12GraphicsCommandList::SetComputeRootConstantBufferView;
+    }
 };
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -989,6 +1140,14 @@ inline void ImmediateContext::ApplyShaderResourcesHelper() noexcept
         return;
     }
 
+    if (m_CurrentState.m_pPSO->GetRootSignature()->m_Desc.IsBindless())
+    {
+        (GetGraphicsCommandList()->*DescriptorBindFuncs<eShader>::GetBindlessBindFunc())(
+            SRVBindIndices<eShader>::c_TableIndex,
+            CurrentState.m_SRVTableBase.ptr);
+        return;
+    }
+
     (GetGraphicsCommandList()->*DescriptorBindFuncs<eShader>::GetBindFunc())(
         SRVBindIndices<eShader>::c_TableIndex,
         CurrentState.m_SRVTableBase);
@@ -1037,6 +1196,14 @@ inline void ImmediateContext::ApplySamplersHelper() noexcept
         return;
     }
 
+    if (m_CurrentState.m_pPSO->GetRootSignature()->m_Desc.IsBindless())
+    {
+        (GetGraphicsCommandList()->*DescriptorBindFuncs<eShader>::GetBindlessBindFunc())(
+            SamplerBindIndices<eShader>::c_TableIndex,
+            CurrentState.m_SamplerTableBase.ptr);
+        return;
+    }
+
     (GetGraphicsCommandList()->*DescriptorBindFuncs<eShader>::GetBindFunc())(
         SamplerBindIndices<eShader>::c_TableIndex,
         CurrentState.m_SamplerTableBase);
@@ -1094,6 +1261,11 @@ inline void TRANSLATION_API ImmediateContext::DispatchIndirect(Resource* pBuffer
 //----------------------------------------------------------------------------------------------------------------------------------
 inline void ImmediateContext::PreDispatch() noexcept(false)
 {
+    if (m_bUseBindlessDescriptors)
+    {
+        PrepareBindlessBindings(); // throws
+    }
+
 #ifdef USE_PIX
     PIXScopedEvent(GetGraphicsCommandList(), 0ull, L"PreDispatch");
 #endif
@@ -1117,6 +1289,10 @@ inline void ImmediateContext::PreDispatch() noexcept(false)
         {
             RootSignatureDesc const& OldDesc = m_CurrentState.m_pLastComputeRootSig->m_Desc;
             RootSignatureDesc const& NewDesc = m_CurrentState.m_pPSO->GetRootSignature()->m_Desc;
+            if (NewDesc.IsBindless() != OldDesc.IsBindless())
+            {
+                m_DirtyStates |= e_ComputeBindingsDirty;
+            }
             if (NewDesc.m_ShaderStages[0].GetCBBindingCount() > OldDesc.m_ShaderStages[0].GetCBBindingCount())
             {
                 m_DirtyStates |= e_CSConstantBuffersDirty;
@@ -1148,6 +1324,12 @@ inline void ImmediateContext::PreDispatch() noexcept(false)
     m_DirtyStates |= m_CurrentState.m_CS.m_Samplers.IsDirty(shaderStage.GetSamplerBindingCount()) ? e_CSSamplersDirty : 0;
     m_DirtyStates |= m_CurrentState.m_CSUAVs.IsDirty(pComputeShader ? pComputeShader->m_UAVDecls : EmptyDecls, RootSigDesc.GetUAVBindingCount(), !!(m_DirtyStates & e_CSUnorderedAccessViewsDirty)) ? e_CSUnorderedAccessViewsDirty : 0;
 
+    m_CachedDescriptorTables = 0;
+    if (m_DirtyStates & e_ComputeBindingsDirty)
+    {
+        FindCachedDescriptorTablesHelper<e_CS>();
+    }
+
     // Now that pipeline dirty bits are set appropriately, check if we need to update the descriptor heap
     UINT ViewHeapSlot = ReserveSlotsForBindings(m_ViewHeap, &ImmediateContext::CalculateViewSlotsForBindings<true>); // throw( _com_error )
     UINT SamplerHeapSlot = 0;
@@ -1158,7 +1340,7 @@ inline void ImmediateContext::PreDispatch() noexcept(false)
 
     auto& UAVBindings = m_CurrentState.m_CSUAVs;
     UINT numUAVs = RootSigDesc.GetUAVBindingCount();
-    InsertUAVBarriersIfNeeded(UAVBindings, numUAVs);
+    InsertUAVBarriersIfNeeded(UAVBindings, numUAVs); // throw( bad_alloc )
 
     // Second pass copies data into the the descriptor heap
     if (m_DirtyStates & e_ComputeBindingsDirty)
@@ -1169,7 +1351,13 @@ inline void ImmediateContext::PreDispatch() noexcept(false)
         {
             DirtySamplersHelper<e_CS>(SamplerHeapSlot);
         }
-        if (m_DirtyStates & e_CSUnorderedAccessViewsDirty)
+        if ((m_DirtyStates & e_CSUnorderedAccessViewsDirty) && RootSigDesc.IsBindless())
+        {
+            UINT* pIndices = AppendBindlessIndexTable(numUAVs, m_CurrentState.m_CSUAVTableBase);
+            UAVBindings.FillBindlessIndices(pIndices, m_NullUAVBindlessIndices, numUAVs,
+                [this](UAV* pUAV) { return GetBindlessIndex(pUAV); }); // throw( _com_error )
+        }
+        else if (m_DirtyStates & e_CSUnorderedAccessViewsDirty)
         {
             auto& UAVTableBase = m_CurrentState.m_CSUAVTableBase;
 
@@ -1188,6 +1376,8 @@ inline void ImmediateContext::PreDispatch() noexcept(false)
 
             ViewHeapSlot += numUAVs;
         }
+
+        UploadBindlessIndexTables(); // throw( _com_error )
     }
 
     m_StatesToReassert |= (m_DirtyStates & e_ComputeStateDirty);
@@ -1239,7 +1429,14 @@ inline void ImmediateContext::PreDispatch() noexcept(false)
             static const UINT UAVTableIndex = 3;
             auto const& UAVTableBase = m_CurrentState.m_CSUAVTableBase;
 
-            GetGraphicsCommandList()->SetComputeRootDescriptorTable(UAVTableIndex, UAVTableBase);
+            if (m_CurrentState.m_pPSO->GetRootSignature()->m_Desc.IsBindless())
+            {
+                GetGraphicsCommandList()->SetComputeRootConstantBufferView(UAVTableIndex, UAVTableBase.ptr);
+            }
+            else
+            {
+                GetGraphicsCommandList()->SetComputeRootDescriptorTable(UAVTableIndex, UAVTableBase);
+            }
         }
     }
 
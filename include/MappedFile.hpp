@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+
+namespace D3D12TranslationLayer
+{
+    //----------------------------------------------------------------------------------------------------------------------------------
+    // A file mapped into memory in its entirety. Writable mappings are created at their maximum size
+    // and truncated to the used size on close. Files opened for read can still be replaced or deleted by other
+    // processes while they're mapped.
+    class MappedFile
+    {
+    public:
+        MappedFile(const wchar_t* pFileName, UINT64 MaxSizeInBytes); // Create for write, throws
+        MappedFile(const wchar_t* pFileName); // Open for read, throws
+        ~MappedFile();
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        BYTE* GetData() const noexcept { return m_pData; }
+        UINT64 GetSize() const noexcept { return m_Size; }
+        void SetUsedSize(UINT64 UsedSize) noexcept { assert(UsedSize <= m_Size); m_UsedSize = UsedSize; }
+
+    private:
+        BYTE* m_pData = nullptr;
+        UINT64 m_Size = 0;
+        UINT64 m_UsedSize = 0;
+        bool m_bWritable;
+        SafeHANDLE m_hFile;
+        SafeHANDLE m_hMapping;
+    };
+}
@@ -74,6 +74,81 @@ namespace D3D12TranslationLayer
         }
     };
 
+    struct PipelineState;
+
+    struct PipelineStateCompileStatistics
+    {
+        UINT64 NumCompiles; // Driver creates, including ones satisfied by the on-disk cache
+        UINT64 NumDeduplicated; // Pipeline states which shared the compile of an identical one
+        UINT64 NumInlineCompiles; // Queued compiles which GetForUse started itself, because no worker had yet
+        UINT64 NumBlockingWaits; // GetForUse calls which waited for a worker to finish
+        UINT64 BlockedTimeUs; // Time GetForUse spent waiting for or performing compiles
+    };
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    // A compile shared by all pipeline states created from identical descs. Queued compiles are speculative and run at background
+    // priority, but whichever of a worker or GetForUse gets to one first compiles it, so a draw never waits behind the queue.
+    class PipelineStateCompile
+    {
+    public:
+        enum class EState { Pending, Running, Done };
+
+        PipelineStateCompile(PipelineStateCacheKey const& Key, PipelineState* pSource) noexcept
+            : m_Key(Key)
+            , m_pSource(pSource)
+        {
+        }
+
+        // Must be called with m_Lock held.
+        void Complete(HRESULT hr, ID3D12PipelineState* pPSO) noexcept
+        {
+            m_hr = hr;
+            if (SUCCEEDED(hr))
+            {
+                m_spPSO.reset(pPSO);
+            }
+            m_State = EState::Done;
+            m_pCompiler = nullptr;
+            m_Completed.notify_all();
+        }
+
+        PipelineStateCacheKey const m_Key;
+        std::mutex m_Lock;
+        std::condition_variable m_Completed;
+        EState m_State = EState::Pending;
+        PipelineState* m_pSource; // Provides the desc for background compiles, cleared when it's destroyed
+        PipelineState* m_pCompiler = nullptr; // Set while Running
+        HRESULT m_hr = S_OK;
+        unique_comptr<ID3D12PipelineState> m_spPSO;
+        CThreadPoolWork m_Work; // Last, so that pending work is cancelled before the rest is torn down
+    };
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    class PipelineStateCompileScheduler
+    {
+    public:
+        PipelineStateCompileScheduler() noexcept;
+
+        // Returns a live compile of an identical desc to share, or a new one which pSource is responsible for starting.
+        // Failed compiles aren't shared, nor are pending ones whose source was destroyed, since no worker would pick them up.
+        std::shared_ptr<PipelineStateCompile> FindOrAdd(PipelineStateCacheKey const& Key, PipelineState* pSource, bool& bAdded) noexcept(false);
+        void Release(std::shared_ptr<PipelineStateCompile>& spCompile) noexcept;
+
+        PipelineStateCompileStatistics GetStatistics() const noexcept;
+
+        // Updated from worker threads as well as the immediate context thread
+        std::atomic<UINT64> m_NumCompiles{ 0 };
+        std::atomic<UINT64> m_NumDeduplicated{ 0 };
+        std::atomic<UINT64> m_NumInlineCompiles{ 0 };
+        std::atomic<UINT64> m_NumBlockingWaits{ 0 };
+        std::atomic<UINT64> m_BlockedTicks{ 0 };
+
+    private:
+        std::mutex m_Lock;
+        std::unordered_map<PipelineStateCacheKey, std::weak_ptr<PipelineStateCompile>, PipelineStateCacheKeyHash> m_Compiles;
+        UINT64 m_TicksPerSecond;
+    };
+
     struct PipelineState : protected DeviceChildImpl<ID3D12PipelineState>
     {
     public:
@@ -118,11 +193,12 @@ namespace D3D12TranslationLayer
         PipelineState(ImmediateContext *pContext, const COMPUTE_PIPELINE_STATE_DESC &desc);
         ~PipelineState();
 
+        // Immediate context thread only
         ID3D12PipelineState* GetForUse(COMMAND_LIST_TYPE CommandListType)
         {
-            if (m_ThreadpoolWork)
+            if (!m_bCompileResolved)
             {
-                m_ThreadpoolWork.Wait(false);
+                ResolveCompile();
             }
             return DeviceChildImpl::GetForUse(CommandListType);
         }
@@ -152,12 +228,25 @@ namespace D3D12TranslationLayer
         std::unique_ptr<D3D12_SO_DECLARATION_ENTRY[]> spSODecls;
         UINT SOStrides[D3D12_SO_STREAM_COUNT];
 
-        CThreadPoolWork m_ThreadpoolWork;
+        std::shared_ptr<PipelineStateCompile> m_spCompile;
+        bool m_bCompileResolved = false;
 
         template<EPipelineType Type>
         void Create();
 
         template<EPipelineType Type>
         void CreateImpl();
+
+        enum class ECompileResolution { AlreadyDone, CompiledInline, Waited };
+        HRESULT CompileNow() noexcept;
+        ECompileResolution CompileOrWait() noexcept;
+        void ResolveCompile() noexcept;
+        void DetachFromCompile() noexcept;
+        static void RunBackgroundCompile(PipelineStateCompile& Compile) noexcept;
+
+        D3D12_CACHED_PIPELINE_STATE& GetCachedPSO()
+        {
+            return m_PipelineStateType == e_Draw ? Graphics.m_Desc.CachedPSO : Compute.m_Desc.CachedPSO;
+        }
     };
 };
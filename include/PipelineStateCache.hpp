@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+
+namespace D3D12TranslationLayer
+{
+    class MappedFile;
+    struct RootSignatureDesc;
+
+    //==================================================================================================================================
+    // Pipeline state cache
+    // Persists driver PSO blobs (ID3D12PipelineState::GetCachedBlob) across processes, so that pipeline states seen in a previous run
+    // can be recreated from CachedPSO instead of compiled from scratch. Entries are keyed on a hash of everything that feeds into
+    // the PSO: the full pipeline desc, the contents of the shader bytecode, and the translation layer's root signature layout.
+    //
+    // File layout:
+    //   PipelineStateCacheFileHeader
+    //   Repeated: PipelineStateCacheEntryHeader, blob data[BlobSize] padded to 8 bytes
+    //
+    // The whole file is discarded when the format version or the adapter's vendor, device or driver version change.
+    // On write back, entries which were least recently used (counted in cache generations, i.e. processes which wrote the
+    // file) are dropped to keep the file under its size limit.
+    //==================================================================================================================================
+    struct PipelineStateCacheKey
+    {
+        UINT64 Hash[2];
+
+        bool operator==(PipelineStateCacheKey const& o) const noexcept { return Hash[0] == o.Hash[0] && Hash[1] == o.Hash[1]; }
+        bool operator!=(PipelineStateCacheKey const& o) const noexcept { return !(*this == o); }
+    };
+
+    struct PipelineStateCacheKeyHash
+    {
+        size_t operator()(PipelineStateCacheKey const& Key) const noexcept { return static_cast<size_t>(Key.Hash[0]); }
+    };
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    // Accumulates a 128-bit key from two independently seeded 64-bit lanes. The result must be stable across processes
+    // and builds, so structs are hashed one field at a time rather than as raw memory, which would include padding.
+    class PipelineStateCacheKeyBuilder
+    {
+    public:
+        void AddBytes(const void* pData, SIZE_T Size) noexcept;
+        void AddString(const char* pString) noexcept; // Null is distinct from the empty string
+
+        template <typename T> void Add(T Value) noexcept
+        {
+            static_assert(std::is_scalar<T>::value && !std::is_pointer<T>::value, "Add fields individually.");
+            AddBytes(&Value, sizeof(Value));
+        }
+
+        void Add(D3D12_SHADER_BYTECODE const& ByteCode) noexcept;
+        void Add(D3D12_STREAM_OUTPUT_DESC const& StreamOutput) noexcept;
+        void Add(D3D12_BLEND_DESC const& BlendState) noexcept;
+        void Add(D3D12_RASTERIZER_DESC const& RasterizerState) noexcept;
+        void Add(D3D12_DEPTH_STENCIL_DESC const& DepthStencilState) noexcept;
+        void Add(D3D12_INPUT_LAYOUT_DESC const& InputLayout) noexcept;
+        void Add(RootSignatureDesc const& RootSignature) noexcept;
+
+        PipelineStateCacheKey GetKey() const noexcept;
+
+    private:
+        UINT64 m_Lanes[2] = { 0xcbf29ce484222325ull, 0x84222325cbf29ce4ull };
+        UINT64 m_Size = 0;
+    };
+
+    // The root signature pointer and CachedPSO members of the desc are ignored.
+    PipelineStateCacheKey ComputePipelineStateCacheKey(D3D12_GRAPHICS_PIPELINE_STATE_DESC const& Desc, RootSignatureDesc const& RootSignature) noexcept;
+    PipelineStateCacheKey ComputePipelineStateCacheKey(D3D12_COMPUTE_PIPELINE_STATE_DESC const& Desc, RootSignatureDesc const& RootSignature) noexcept;
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    // Cached blobs are only valid for the driver that produced them.
+    struct PipelineStateCacheDeviceIdentity
+    {
+        UINT VendorID;
+        UINT DeviceID;
+        UINT64 DriverVersion;
+
+        // If the adapter couldn't be queried, files written for other drivers can't be told apart, so the cache isn't used.
+        bool IsKnown() const noexcept { return VendorID != 0 && DeviceID != 0 && DriverVersion != 0; }
+    };
+
+    struct PipelineStateCacheFileHeader
+    {
+        static constexpr UINT64 c_Magic = 0x4F53504C54443344ull; // "D3DTLPSO"
+        static constexpr UINT c_Version = 1;
+
+        UINT64 Magic;
+        UINT Version;
+        UINT NumEntries;
+        PipelineStateCacheDeviceIdentity Device;
+        UINT64 Generation; // Incremented by each process which writes the file
+    };
+
+    struct PipelineStateCacheEntryHeader
+    {
+        PipelineStateCacheKey Key;
+        UINT64 LastUsedGeneration;
+        UINT64 BlobSize;
+    };
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    class PipelineStateCache
+    {
+    public:
+        static constexpr UINT64 c_DefaultMaxSize = 128 * 1024 * 1024;
+
+        // A missing, corrupt or stale file results in an empty cache. Only throws bad_alloc.
+        PipelineStateCache(const wchar_t* pFileName, UINT64 MaxSizeInBytes, PipelineStateCacheDeviceIdentity const& Device);
+        // Writes the cache back to disk if anything changed. Failures are ignored.
+        ~PipelineStateCache();
+
+        PipelineStateCache(PipelineStateCache const&) = delete;
+        PipelineStateCache& operator=(PipelineStateCache const&) = delete;
+
+        // Free-threaded. Returned blobs remain valid for the lifetime of the cache.
+        bool Find(PipelineStateCacheKey const& Key, const void*& pBlob, SIZE_T& BlobSize) noexcept;
+        // Free-threaded. Replaces any existing entry, e.g. one the driver rejected.
+        void Store(PipelineStateCacheKey const& Key, const void* pBlob, SIZE_T BlobSize) noexcept;
+
+        // File format helpers, which only operate on memory.
+        using EntryVisitor = std::function<void(PipelineStateCacheEntryHeader const& Entry, BYTE const* pBlob)>;
+        // Returns false if the data isn't a cache file which is valid for Device, in which case no entries are visited.
+        static bool ParseFile(BYTE const* pData, UINT64 Size, PipelineStateCacheDeviceIdentity const& Device, UINT64& Generation, EntryVisitor const& Visitor) noexcept(false);
+        static UINT64 GetEntrySize(UINT64 BlobSize) noexcept { return sizeof(PipelineStateCacheEntryHeader) + Align<UINT64>(BlobSize, 8); }
+        // Returns a pointer past the written entry.
+        static BYTE* WriteEntry(BYTE* pDest, PipelineStateCacheEntryHeader const& Entry, const void* pBlob) noexcept;
+
+    private:
+        struct Entry
+        {
+            const void* pBlob;
+            SIZE_T BlobSize;
+            UINT64 LastUsedGeneration;
+            std::unique_ptr<BYTE[]> spOwnedBlob; // Null when the blob lives in the file mapping
+        };
+
+        void WriteBack() noexcept(false);
+
+        std::wstring m_FileName;
+        UINT64 m_MaxSize;
+        PipelineStateCacheDeviceIdentity m_Device;
+        UINT64 m_Generation = 1;
+        bool m_bDirty = false;
+
+        std::unique_ptr<MappedFile> m_spFile;
+
+        std::mutex m_Lock;
+        std::unordered_map<PipelineStateCacheKey, Entry, PipelineStateCacheKeyHash> m_Entries;
+        // Blobs may still be in use by a thread which found them when they're replaced.
+        std::vector<std::unique_ptr<BYTE[]>> m_RetiredBlobs;
+    };
+}
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+
+namespace D3D12TranslationLayer
+{
+    //==================================================================================================================================
+    // Pixel copy kernels
+    // Row kernels for the format fixups done on the CPU while uploading and reading back texture data: splitting interleaved
+    // depth/stencil data (R24G8 and R32G8X24) into the planes D3D12 stores them in and merging them back, and swapping the R and B
+    // channels of R10G10B10A2. Each level produces identical results; the scalar level is always available, and the best level
+    // the build and CPU support is picked once per process.
+    //
+    // Interleaving kernels OR the plane into the destination rather than overwriting it, since each interleaved pixel is
+    // assembled from both planes.
+    //==================================================================================================================================
+    enum class PixelCopyKernelLevel
+    {
+        Scalar,
+        SSE41,
+        AVX2,
+        NEON, // Only with USE_NEON_PIXEL_COPY_KERNELS
+    };
+
+    struct PixelCopyKernels
+    {
+        // Interleaved to planar
+        void (*pfnDeInterleaveR24Depth)(_In_reads_(Count) const UINT* pSrc, _Out_writes_(Count) UINT* pDst, UINT Count) noexcept;
+        void (*pfnDeInterleaveR24Stencil)(_In_reads_(Count) const UINT* pSrc, _Out_writes_(Count) UINT8* pDst, UINT Count) noexcept;
+        void (*pfnDeInterleaveR32Depth)(_In_reads_(Count) const UINT64* pSrc, _Out_writes_(Count) UINT* pDst, UINT Count) noexcept;
+        void (*pfnDeInterleaveR32Stencil)(_In_reads_(Count) const UINT64* pSrc, _Out_writes_(Count) UINT8* pDst, UINT Count) noexcept;
+
+        // Planar to interleaved
+        void (*pfnInterleaveR24Depth)(_In_reads_(Count) const UINT* pSrc, _Inout_updates_(Count) UINT* pDst, UINT Count) noexcept;
+        void (*pfnInterleaveR24Stencil)(_In_reads_(Count) const UINT8* pSrc, _Inout_updates_(Count) UINT* pDst, UINT Count) noexcept;
+        void (*pfnInterleaveR32Depth)(_In_reads_(Count) const UINT* pSrc, _Inout_updates_(Count) UINT64* pDst, UINT Count) noexcept;
+        void (*pfnInterleaveR32Stencil)(_In_reads_(Count) const UINT8* pSrc, _Inout_updates_(Count) UINT64* pDst, UINT Count) noexcept;
+
+        // R10G10B10A2 <-> B10G10R10A2
+        void (*pfnSwap10bitRB)(_In_reads_(Count) const UINT* pSrc, _Out_writes_(Count) UINT* pDst, UINT Count) noexcept;
+    };
+
+    // Returns null if the level isn't available in this build or on this CPU.
+    PixelCopyKernels const* GetPixelCopyKernels(PixelCopyKernelLevel Level) noexcept;
+    // The fastest available level.
+    PixelCopyKernels const& GetPixelCopyKernels() noexcept;
+}
@@ -4,6 +4,18 @@
 
 namespace D3D12TranslationLayer
 {
+    // Counters maintained by the residency manager, which can be read without taking its lock.
+    struct ResidencyStatistics
+    {
+        UINT64 NumSubmits;
+        UINT64 BytesMadeResident;
+        UINT64 BytesEvicted; // Includes evictions requested by the OS through trim notifications
+        UINT64 LastSubmitBytesMadeResident;
+        UINT64 LastSubmitBytesEvicted;
+        UINT64 NumEvictionWaits; // Times the paging thread had to wait for the GPU before it could evict
+        UINT64 EvictionWaitTimeUs;
+    };
+
     // Used to contain waits that must be satisfied before a pinned ManagedObject can be unpinned.
     class PinWaits
     {
@@ -65,16 +77,17 @@ namespace D3D12TranslationLayer
             EVICTED
         };
 
-        ManagedObject() = default;
-        ~ManagedObject()
+        // Lower priority objects are evicted first under budget pressure, and age out sooner.
+        enum class PRIORITY_CLASS : UINT8
         {
-#if TRANSLATION_LAYER_DBG
-            for (bool val : CommandListsUsedOn)
-            {
-                assert(!val);
-            }
-#endif
-        }
+            LOW,
+            NORMAL,
+            HIGH
+        };
+        static constexpr UINT NumPriorityClasses = 3;
+
+        ManagedObject() = default;
+        ~ManagedObject() = default;
 
         void Initialize(ID3D12Pageable* pUnderlyingIn, UINT64 ObjectSize)
         {
@@ -92,6 +105,7 @@ namespace D3D12TranslationLayer
 
         // Wether the object is resident or not
         RESIDENCY_STATUS ResidencyStatus = RESIDENCY_STATUS::RESIDENT;
+        PRIORITY_CLASS PriorityClass = PRIORITY_CLASS::NORMAL;
 
         // The underlying D3D Object being tracked
         ID3D12Pageable* pUnderlying = nullptr;
@@ -103,11 +117,17 @@ namespace D3D12TranslationLayer
         UINT64 LastUsedTimestamp = 0;
 
         // This is used to track which open command lists this resource is currently used on.
+        // Each entry holds the generation of the last residency set the object was inserted into,
+        // so closing a set doesn't need to visit its objects.
         // + 1 for transient residency sets.
-        bool CommandListsUsedOn[(UINT)COMMAND_LIST_TYPE::MAX_VALID + 1] = {};
+        UINT64 CommandListsUsedOnGeneration[(UINT)COMMAND_LIST_TYPE::MAX_VALID + 1] = {};
 
         // Linked list entry
         LIST_ENTRY ListEntry;
+        // The LRU epoch in which the object was last linked into the resident list, and the one in which it was last referenced.
+        // When the latter is newer, the object's position in the list is stale, and it's moved once it's encountered.
+        UINT64 ListEpoch = 0;
+        UINT64 LastReferencedEpoch = 0;
 
         // Pinning an object prevents eviction.  Callers must seperately make resident as usual.
         UINT32 PinCount = 0;
@@ -134,9 +154,9 @@ namespace D3D12TranslationLayer
             assert(CommandListIndex != InvalidIndex);
 
             // If we haven't seen this object on this command list mark it
-            if (pObject->CommandListsUsedOn[CommandListIndex] == false)
+            if (pObject->CommandListsUsedOnGeneration[CommandListIndex] != Generation)
             {
-                pObject->CommandListsUsedOn[CommandListIndex] = true;
+                pObject->CommandListsUsedOnGeneration[CommandListIndex] = Generation;
                 Set.push_back(pObject);
 
                 return true;
@@ -151,18 +171,15 @@ namespace D3D12TranslationLayer
         {
             assert(CommandListIndex == InvalidIndex);
             CommandListIndex = commandListType;
+            Generation = NextGeneration.fetch_add(1, std::memory_order_relaxed);
 
             Set.clear();
         }
 
-        // Walks the set to clear CommandListsUsedOn for each object; callers must ensure the resources are still valid.
+        // Objects inserted while the set was open carry a generation that no other set will use,
+        // so there's nothing to clear on them.
         void Close()
         {
-            for (auto pObject : Set)
-            {
-                pObject->CommandListsUsedOn[CommandListIndex] = false;
-            }
-
             CommandListIndex = InvalidIndex;
         }
 
@@ -175,7 +192,11 @@ namespace D3D12TranslationLayer
         }
 
         UINT32 CommandListIndex = InvalidIndex;
+        UINT64 Generation = 0;
         std::vector<ManagedObject*> Set;
+
+        // Starts at 1 so that no set matches a newly created object
+        static inline std::atomic<UINT64> NextGeneration{ 1 };
     };
 
     namespace Internal
@@ -217,8 +238,86 @@ namespace D3D12TranslationLayer
             UINT64 LastWaitedValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
         };
 
+        // Executes Evict and EnqueueMakeResident calls on a dedicated thread, in the order they were queued, so that
+        // submitting threads don't block on paging operations, or on the GPU finishing with objects that are being evicted.
+        // A reference is held on each queued object until the paging thread is done with it.
+        class PagingQueue
+        {
+            struct PagingWork
+            {
+                std::vector<ID3D12Pageable*> Objects;
+                // Null for MakeResident work, and for command list types which haven't been created
+                CComPtr<ID3D12Fence> WaitFences[(UINT)COMMAND_LIST_TYPE::MAX_VALID];
+                UINT64 WaitFenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID];
+                // Zero for evictions
+                UINT64 SignalValue;
+            };
+
+        public:
+            // Storage for an eviction, allocated before the LRU marks the objects evicted, so that queuing them can't fail.
+            class EvictReservation
+            {
+                friend class PagingQueue;
+                std::list<PagingWork> Work;
+            };
+
+            PagingQueue() = default;
+            ~PagingQueue() { Shutdown(); }
+
+            HRESULT Initialize(ID3D12Device3* pDevice, ID3D12Fence* pPagingFence);
+
+            // Waits for all queued work to be executed, and stops the paging thread.
+            void Shutdown() noexcept;
+
+            // Makes sure that Reservation can hold an eviction of up to MaxObjects objects. Reservations are reusable.
+            void ReserveEvict(EvictReservation& Reservation, size_t MaxObjects); // throw( bad_alloc )
+
+            // The objects are evicted once each non-null fence in WaitFences has reached the corresponding value in WaitFenceValues.
+            // The fences are captured here rather than looked up by the paging thread, which would race with their creation.
+            void QueueEvict(EvictReservation& Reservation,
+                            std::vector<ID3D12Pageable*> const& Objects,
+                            ID3D12Fence* const WaitFences[],
+                            const UINT64 WaitFenceValues[]) noexcept;
+
+            // The paging fence is signaled with SignalValue once the objects are resident.
+            void QueueMakeResident(UINT NumObjects, _In_reads_(NumObjects) ID3D12Pageable* const* ppObjects, UINT64 SignalValue); // throw( bad_alloc )
+
+            // Returns and clears the first MakeResident failure since the last call. The paging fence is signaled even if
+            // objects couldn't be made resident, so that queues waiting on it don't hang, and the submitting thread reports it.
+            HRESULT TakeMakeResidentError() noexcept { return MakeResidentError.exchange(S_OK); }
+
+            UINT64 GetNumSyncPointWaits() const noexcept { return NumSyncPointWaits.load(std::memory_order_relaxed); }
+            UINT64 GetSyncPointWaitTicks() const noexcept { return SyncPointWaitTicks.load(std::memory_order_relaxed); }
+
+        private:
+            // Takes a single node list so that the queue itself never needs to allocate
+            void Enqueue(std::list<PagingWork>& Work) noexcept;
+            void PagingThread();
+            void Execute(PagingWork& Work);
+            bool WaitForFenceValue(ID3D12Fence* pFence, UINT64 Value);
+
+            CComPtr<ID3D12Device3> Device;
+            CComPtr<ID3D12Fence> PagingFence;
+
+            std::mutex QueueLock;
+            std::list<PagingWork> Queue;
+            bool bShutdown = false;
+
+            SafeHANDLE WorkAvailableEvent;
+            SafeHANDLE FenceEvent;
+            SafeHANDLE Thread;
+
+            std::atomic<UINT64> NumSyncPointWaits{ 0 };
+            std::atomic<UINT64> SyncPointWaitTicks{ 0 };
+            std::atomic<HRESULT> MakeResidentError{ S_OK };
+        };
+
         // A Least Recently Used Cache. Tracks all of the objects requested by the app so that objects
         // that aren't used freqently can get evicted to help the app stay under buget.
+        // Referencing an object only stamps it with the current epoch. The list is reordered lazily: objects which
+        // have been referenced since they were linked are moved to the tail when a walk from the head reaches them.
+        // Objects are linked at the tail with the current epoch, or at the head with epoch 0, so list epochs never
+        // decrease from head to tail, and the first object which isn't stale is the least recently used.
         class LRUCache
         {
         public:
@@ -230,8 +329,16 @@ namespace D3D12TranslationLayer
                 InitializeListHead(&ResidentObjectListHead);
             };
 
+            // Objects referenced in the same epoch are considered equally recent.
+            void BeginEpoch()
+            {
+                ++CurrentEpoch;
+            }
+
             void Insert(ManagedObject* pObject)
             {
+                // New objects are the first candidates for eviction until they're referenced
+                pObject->ListEpoch = pObject->LastReferencedEpoch = 0;
                 if (pObject->ResidencyStatus == ManagedObject::RESIDENCY_STATUS::RESIDENT)
                 {
                     InsertHeadList(&ResidentObjectListHead, &pObject->ListEntry);
@@ -258,15 +365,14 @@ namespace D3D12TranslationLayer
                 }
             }
 
-            // When an object is used by the GPU we move it to the end of the list.
+            // When an object is used by the GPU it logically moves to the end of the list.
             // This way things closer to the head of the list are the objects which
             // are stale and better candidates for eviction
             void ObjectReferenced(ManagedObject* pObject)
             {
                 assert(pObject->ResidencyStatus == ManagedObject::RESIDENCY_STATUS::RESIDENT);
 
-                RemoveEntryList(&pObject->ListEntry);
-                InsertTailList(&ResidentObjectListHead, &pObject->ListEntry);
+                pObject->LastReferencedEpoch = CurrentEpoch;
             }
 
             void MakeResident(ManagedObject* pObject)
@@ -274,11 +380,13 @@ namespace D3D12TranslationLayer
                 assert(pObject->ResidencyStatus == ManagedObject::RESIDENCY_STATUS::EVICTED);
 
                 pObject->ResidencyStatus = ManagedObject::RESIDENCY_STATUS::RESIDENT;
+                pObject->ListEpoch = pObject->LastReferencedEpoch = CurrentEpoch;
                 InsertTailList(&ResidentObjectListHead, &pObject->ListEntry);
 
                 NumEvictedObjects--;
                 NumResidentObjects++;
                 ResidentSize += pObject->Size;
+                TotalMadeResidentSize.fetch_add(pObject->Size, std::memory_order_relaxed);
             }
 
             void Evict(ManagedObject* pObject)
@@ -292,6 +400,7 @@ namespace D3D12TranslationLayer
                 NumResidentObjects--;
                 ResidentSize -= pObject->Size;
                 NumEvictedObjects++;
+                TotalEvictedSize.fetch_add(pObject->Size, std::memory_order_relaxed);
             }
 
             // Evict all of the resident objects used in sync points up to the specficied one (inclusive)
@@ -305,19 +414,74 @@ namespace D3D12TranslationLayer
 
             ManagedObject* GetResidentListHead()
             {
-                if (IsListEmpty(&ResidentObjectListHead))
+                return GetResidentObjectAfter(&ResidentObjectListHead);
+            }
+
+            // Returns the next object in LRU order, moving any objects with stale positions out of the way.
+            ManagedObject* GetResidentObjectAfter(LIST_ENTRY* pEntry)
+            {
+                while (pEntry->Flink != &ResidentObjectListHead)
+                {
+                    ManagedObject* pObject = CONTAINING_RECORD(pEntry->Flink, ManagedObject, ListEntry);
+                    if (!RequeueIfReferenced(pObject))
+                    {
+                        assert(pObject->ListEntry.Flink == &ResidentObjectListHead ||
+                               pObject->ListEpoch <= CONTAINING_RECORD(pObject->ListEntry.Flink, ManagedObject, ListEntry)->ListEpoch);
+                        return pObject;
+                    }
+                }
+                return nullptr;
+            }
+
+            // Moves the object to the tail if it was referenced after it was linked. Returns whether it was moved.
+            // It's linked with the current epoch, as nothing after it in the list can have been referenced more recently.
+            bool RequeueIfReferenced(ManagedObject* pObject)
+            {
+                if (pObject->LastReferencedEpoch <= pObject->ListEpoch)
                 {
-                    return nullptr;
+                    return false;
                 }
-                return CONTAINING_RECORD(ResidentObjectListHead.Flink, ManagedObject, ListEntry);
+
+                pObject->ListEpoch = CurrentEpoch;
+                RemoveEntryList(&pObject->ListEntry);
+                InsertTailList(&ResidentObjectListHead, &pObject->ListEntry);
+                return true;
             }
 
             LIST_ENTRY ResidentObjectListHead;
+            UINT64 CurrentEpoch = 0;
 
             UINT32 NumResidentObjects;
             UINT32 NumEvictedObjects;
 
             UINT64 ResidentSize;
+
+            // Only written with the residency manager's lock held
+            std::atomic<UINT64> TotalMadeResidentSize{ 0 };
+            std::atomic<UINT64> TotalEvictedSize{ 0 };
+        };
+
+        // A rolling estimate of how much each submission grows the working set, used to evict objects the GPU is
+        // done with ahead of budget pressure, so that later submissions don't need to wait on the GPU.
+        class WorkingSetGrowthPredictor
+        {
+        public:
+            void AddSubmission(UINT64 SizeToMakeResident)
+            {
+                GrowthEstimate += (double(SizeToMakeResident) - GrowthEstimate) * cSmoothing;
+            }
+
+            // The usage to make room for, given the usage once the current submission's objects are resident
+            INT64 ProjectUsage(INT64 CurrentUsage) const
+            {
+                return CurrentUsage + INT64(GrowthEstimate * cLookahead);
+            }
+
+            // Number of submissions ahead that room is made for
+            static constexpr UINT cLookahead = 4;
+            static constexpr double cSmoothing = 1.0 / 16.0;
+
+            double GrowthEstimate = 0.0;
         };
     }
 
@@ -345,6 +509,14 @@ namespace D3D12TranslationLayer
 
         void BeginTrackingObject(ManagedObject* pObject)
         {
+            if (pObject && pObject->PriorityClass != ManagedObject::PRIORITY_CLASS::NORMAL)
+            {
+                // Let the OS know too, for when it has to choose between processes
+                [[maybe_unused]] HRESULT hr = SetDevicePriority(pObject, pObject->PriorityClass == ManagedObject::PRIORITY_CLASS::HIGH ?
+                    D3D12_RESIDENCY_PRIORITY_HIGH : D3D12_RESIDENCY_PRIORITY_LOW);
+                assert(SUCCEEDED(hr));
+            }
+
             std::lock_guard Lock(Mutex);
 
             if (pObject)
@@ -387,7 +559,20 @@ namespace D3D12TranslationLayer
             pSet->Discard();
         }
 
+        // Sets the OS residency priority of the object, and the priority class this residency manager evicts it with.
+        HRESULT SetResidencyPriority(ManagedObject* pObject, D3D12_RESIDENCY_PRIORITY Priority);
+
+        ResidencyStatistics GetStatistics() const noexcept;
+
+        // Objects which couldn't be made resident are only detected by the paging thread, after their command list was submitted.
+        HRESULT TakeMakeResidentError() noexcept { return Paging.TakeMakeResidentError(); }
+
     private:
+        HRESULT SetDevicePriority(ManagedObject* pObject, D3D12_RESIDENCY_PRIORITY Priority)
+        {
+            return Device->SetResidencyPriority(1, &pObject->pUnderlying, &Priority);
+        }
+
         HRESULT PrepareToExecuteMasterSet(ID3D12CommandQueue* Queue, UINT CommandListIndex, ResidencySet* pMasterSet)
         {
             // Evict or make resident all of the objects we identified above.
@@ -418,9 +603,10 @@ namespace D3D12TranslationLayer
 
         HRESULT ProcessPagingWork(UINT CommandListIndex, ResidencySet *pMasterSet);
 
-        void GetCurrentBudget(UINT64 Timestamp, DXCoreAdapterMemoryBudget* InfoOut);
+        // Fences that evictions wait on, null for command list types that haven't been created
+        void GetQueueFences(ID3D12Fence* Fences[]) noexcept;
 
-        void WaitForSyncPoint(UINT64 FenceValues[]);
+        void GetCurrentBudget(UINT64 Timestamp, DXCoreAdapterMemoryBudget* InfoOut);
 
         // Generate a result between the minimum period and the maximum period based on the current
         // local memory pressure. I.e. when memory pressure is low, objects will persist longer before
@@ -447,7 +633,10 @@ namespace D3D12TranslationLayer
         }
 
         ImmediateContext& ImmCtx;
+        // Signaled by the paging thread as objects are made resident. Values are reserved by the submitting thread,
+        // so that queues can wait for them before the paging thread gets to the work.
         Internal::Fence AsyncThreadFence;
+        Internal::PagingQueue Paging;
 
         CComPtr<ID3D12Device3> Device;
         CComPtr<ID3D12Device15> Device15;
@@ -472,6 +661,14 @@ namespace D3D12TranslationLayer
         UINT64 BudgetQueryPeriodTicks;
         UINT64 LastBudgetTimestamp = 0;
 
+        bool bPredictiveEviction = false;
+        Internal::WorkingSetGrowthPredictor WorkingSetGrowth;
+
+        UINT64 TicksPerSecond = 1;
+        std::atomic<UINT64> NumSubmits{ 0 };
+        std::atomic<UINT64> LastSubmitBytesMadeResident{ 0 };
+        std::atomic<UINT64> LastSubmitBytesEvicted{ 0 };
+
         // Use a union so that we only need 1 allocation
         union ResidentScratchSpace
         {
@@ -480,5 +677,6 @@ namespace D3D12TranslationLayer
         };
         std::vector<ResidentScratchSpace> MakeResidentList;
         std::vector<ID3D12Pageable *> EvictionList;
+        Internal::PagingQueue::EvictReservation EvictStorage;
     };
 };
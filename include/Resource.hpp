@@ -208,9 +208,11 @@ namespace D3D12TranslationLayer
         // ManagedObject uses a type of linked lists that breaks when copying it around, so disable the copy operator
         ResidencyManagedObjectWrapper(const ResidencyManagedObjectWrapper&) = delete;
 
-        void Initialize(ID3D12Pageable *pResource, UINT64 resourceSize, bool isResident = true)
+        void Initialize(ID3D12Pageable *pResource, UINT64 resourceSize, bool isResident = true,
+            ManagedObject::PRIORITY_CLASS priorityClass = ManagedObject::PRIORITY_CLASS::NORMAL)
         {
             m_residencyHandle.Initialize(pResource, resourceSize);
+            m_residencyHandle.PriorityClass = priorityClass;
             if (!isResident)
             {
                 m_residencyHandle.ResidencyStatus = ManagedObject::RESIDENCY_STATUS::EVICTED;
@@ -248,6 +250,11 @@ namespace D3D12TranslationLayer
 
                 assert(m_bufferSubAllocation.GetOffset() == 0);
             }
+            else if (m_bufferSubAllocation.IsRingAllocation())
+            {
+                // Ring allocations are offsets into a single upload ring resource
+                offset = UINT(m_bufferSubAllocation.GetOffset());
+            }
             else
             {
                 // The disjoint buddy allocator works as if all the resources were 
@@ -337,17 +344,22 @@ namespace D3D12TranslationLayer
         UINT64 Size;
         SIZE_T Ptr;
         static constexpr UINT c_DirectAllocationMask = 1u;
+        static constexpr UINT c_RingAllocationMask = 2u;
         static UINT GetDirectAllocationMask(HeapSuballocationBlock const& block)
         {
             return block.IsDirectAllocation() ? c_DirectAllocationMask : 0u;
         }
+        static UINT GetRingAllocationMask(HeapSuballocationBlock const& block)
+        {
+            return block.IsRingAllocation() ? c_RingAllocationMask : 0u;
+        }
 
     public:
         EncodedResourceSuballocation() = default;
         EncodedResourceSuballocation(HeapSuballocationBlock const& block, ID3D12Resource* pPtr)
             : Offset(block.GetOffset())
             , Size(block.GetSize())
-            , Ptr(reinterpret_cast<SIZE_T>(pPtr) | GetDirectAllocationMask(block))
+            , Ptr(reinterpret_cast<SIZE_T>(pPtr) | GetDirectAllocationMask(block) | GetRingAllocationMask(block))
         {
         }
         EncodedResourceSuballocation(D3D12ResourceSuballocation const& suballoc)
@@ -355,9 +367,10 @@ namespace D3D12TranslationLayer
         {
         }
         bool IsDirectAllocation() const { return (Ptr & c_DirectAllocationMask) != 0; }
-        ID3D12Resource* GetResource() const { return reinterpret_cast<ID3D12Resource*>(Ptr & ~SIZE_T(1)); }
+        bool IsRingAllocation() const { return (Ptr & c_RingAllocationMask) != 0; }
+        ID3D12Resource* GetResource() const { return reinterpret_cast<ID3D12Resource*>(Ptr & ~SIZE_T(c_DirectAllocationMask | c_RingAllocationMask)); }
         ID3D12Resource* GetDirectAllocation() const { return IsDirectAllocation() ? GetResource() : nullptr; }
-        HeapSuballocationBlock DecodeSuballocation() const { return HeapSuballocationBlock(Offset, Size, GetDirectAllocation()); }
+        HeapSuballocationBlock DecodeSuballocation() const { return HeapSuballocationBlock(Offset, Size, GetDirectAllocation(), IsRingAllocation()); }
         D3D12ResourceSuballocation Decode() const { return D3D12ResourceSuballocation(GetResource(), DecodeSuballocation()); }
     };
 
@@ -532,6 +545,9 @@ namespace D3D12TranslationLayer
             std::swap(m_Identity, Other.m_Identity);
             std::swap(m_SubresourcePlacement[0].Offset, Other.m_SubresourcePlacement[0].Offset);
             DeviceChild::SwapIdentities(Other);
+            // Current states were swapped too
+            ++m_DesiredStateVersion;
+            ++Other.m_DesiredStateVersion;
         }
 
         void AddToResidencyManager(bool bIsResident);
@@ -664,7 +680,7 @@ namespace D3D12TranslationLayer
             CCurrentResourceState m_currentState;
             std::unique_ptr<ResidencyManagedObjectWrapper> m_pResidencyHandle;
 
-            UINT64 m_LastUAVAccess = 0;
+            UAVBarrierTracker::AccessStamp m_LastUAVAccess;
 
             bool HasRestrictedOutstandingResources()
             {
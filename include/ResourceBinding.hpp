@@ -98,6 +98,7 @@ namespace D3D12TranslationLayer
         void IndexBufferUnbound();
 
         bool AreAllSubresourcesTheSame() const { return m_NumViewsReferencingSubresources == 0; }
+        UINT GetNumSubresources() const { return static_cast<UINT>(m_SubresourceBindings.size()); }
         D3D12_RESOURCE_STATES GetD3D12ResourceUsageFromBindings(UINT subresource) const;
         COMMAND_LIST_TYPE GetCommandListTypeFromBindings() const;
 
@@ -281,6 +282,19 @@ namespace D3D12TranslationLayer
             }
         }
 
+        // Bindless equivalent of FillDescriptors, pfnGetIndex returns the persistent heap index of a bound view
+        template <typename TGetIndex>
+        void FillBindlessIndices(_Out_writes_(RootSignatureHWM) UINT* pIndices,
+            _In_reads_(D3D10_SB_RESOURCE_DIMENSION_TEXTURECUBEARRAY) UINT const* pNullIndices,
+            _In_range_(0, NumBindings) UINT RootSignatureHWM, TGetIndex&& pfnGetIndex) noexcept(false)
+        {
+            for (UINT i = 0; i < RootSignatureHWM; ++i)
+            {
+                pIndices[i] = this->m_Bound[i] ? pfnGetIndex(this->m_Bound[i]) : pNullIndices[(UINT)GetNullType(i)]; // throw( _com_error )
+                this->m_DirtyBits.set(i, false);
+            }
+        }
+
         void Clear(EShaderStage shader)
         {
             for (UINT i = 0; i < NumBindSlots; ++i)
@@ -356,6 +370,17 @@ namespace D3D12TranslationLayer
             }
         }
 
+        template <typename TGetIndex>
+        void FillBindlessIndices(_Out_writes_(RootSignatureHWM) UINT* pIndices, UINT NullIndex,
+            _In_range_(0, NumBindings) UINT RootSignatureHWM, TGetIndex&& pfnGetIndex) noexcept(false)
+        {
+            for (UINT i = 0; i < RootSignatureHWM; ++i)
+            {
+                pIndices[i] = (m_Bound[i]) ? pfnGetIndex(m_Bound[i]) : NullIndex; // throw( _com_error )
+                m_DirtyBits.set(i, false);
+            }
+        }
+
         void Clear()
         {
             for (UINT i = 0; i < NumBindings; ++i)
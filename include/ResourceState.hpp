@@ -49,6 +49,9 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
             D3D12_RESOURCE_STATES State = UNKNOWN_RESOURCE_STATE;
             COMMAND_LIST_TYPE CommandListType = COMMAND_LIST_TYPE::UNKNOWN;
             SubresourceTransitionFlags Flags = SubresourceTransitionFlags::None;
+
+            bool operator==(SubresourceInfo const& o) const noexcept { return State == o.State && CommandListType == o.CommandListType && Flags == o.Flags; }
+            bool operator!=(SubresourceInfo const& o) const noexcept { return !(*this == o); }
         };
 
     private:
@@ -66,6 +69,9 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
         bool AreAllSubresourcesSame() const noexcept { return m_bAllSubresourcesSame; }
 
         SubresourceInfo const& GetSubresourceInfo(UINT SubresourceIndex) const noexcept;
+        // Returns one past the last subresource which shares SubresourceIndex's desired state, or UINT_MAX if all subresources do.
+        // This scans the subresources, stopping at MaxEnd if the caller doesn't need to look further.
+        UINT GetSubresourceRunEnd(UINT SubresourceIndex, UINT MaxEnd = UINT_MAX) const noexcept;
         void SetResourceState(SubresourceInfo const& Info) noexcept;
         void SetSubresourceState(UINT SubresourceIndex, SubresourceInfo const& Info) noexcept;
 
@@ -76,6 +82,10 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
     // CCurrentResourceState
     // Stores the current state of either an entire resource, or each subresource.
     // Current state can either be shared read across multiple queues, or exclusive on a single queue.
+    //
+    // Subresource state is run-length encoded: consecutive subresources with identical state share a single run, so large
+    // arrays and mip chains which are transitioned a range at a time only cost as much as the number of distinct ranges.
+    // Adjacent runs are merged whenever they become identical, which brings the resource back to a single whole-resource run.
     //==================================================================================================================================
     class CCurrentResourceState
     {
@@ -103,31 +113,52 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
 
     private:
         const bool m_bSimultaneousAccess;
-        bool m_bAllSubresourcesSame = true;
+        UINT m_NumRuns = 1;
 
         // Note: As a (minor) memory optimization, using a contiguous block of memory for exclusive + shared state.
         // The memory is owned by the exclusive state pointer. The shared state pointer is non-owning and possibly null.
+        // All three arrays are indexed by run, and sized for the worst case of one run per subresource.
         PreallocatedInlineArray<ExclusiveState, 1> m_spExclusiveState;
         PreallocatedInlineArray<SharedState, 1> m_pSharedState;
-
-        void ConvertToSubresourceTracking() noexcept;
+        PreallocatedInlineArray<UINT, 1> m_spRunStart; // First subresource of each run, in ascending order
+
+        UINT GetNumSubresources() const noexcept { return static_cast<UINT>(m_spRunStart.size()); }
+        UINT GetRunEnd(UINT Run) const noexcept { return Run + 1 < m_NumRuns ? m_spRunStart[Run + 1] : GetNumSubresources(); }
+        UINT FindRun(UINT SubresourceIndex) const noexcept;
+        bool AreRunsEqual(UINT RunA, UINT RunB) const noexcept;
+        void CopyRun(UINT DestRun, UINT SrcRun) noexcept;
+        // Returns the run which starts at SubresourceIndex, splitting the run containing it if needed.
+        UINT SplitRun(UINT SubresourceIndex) noexcept;
+        // Merges identical runs in [FirstRun, EndRun], as well as FirstRun with its predecessor.
+        void MergeRuns(UINT FirstRun, UINT EndRun) noexcept;
 
     public:
         static size_t CalcPreallocationSize(UINT SubresourceCount, bool bSimultaneousAccess)
         {
-            return (sizeof(ExclusiveState) + (bSimultaneousAccess ? sizeof(SharedState) : 0u)) * (SubresourceCount - 1);
+            return (sizeof(ExclusiveState) + (bSimultaneousAccess ? sizeof(SharedState) : 0u) + sizeof(UINT)) * (SubresourceCount - 1);
         }
         CCurrentResourceState(UINT SubresourceCount, bool bSimultaneousAccess, void*& pPreallocatedMemory) noexcept;
 
         bool SupportsSimultaneousAccess() const noexcept { return m_bSimultaneousAccess; }
-        bool AreAllSubresourcesSame() const noexcept { return m_bAllSubresourcesSame; }
+        bool AreAllSubresourcesSame() const noexcept { return m_NumRuns == 1; }
+        UINT GetNumRuns() const noexcept { return m_NumRuns; }
+        // Returns one past the last subresource which shares SubresourceIndex's state.
+        UINT GetSubresourceRunEnd(UINT SubresourceIndex) const noexcept { return GetRunEnd(FindRun(SubresourceIndex)); }
 
         bool IsExclusiveState(UINT SubresourceIndex) const noexcept;
 
         void SetExclusiveResourceState(ExclusiveState const& State) noexcept;
         void SetSharedResourceState(COMMAND_LIST_TYPE Type, UINT64 FenceValue, D3D12_RESOURCE_STATES State) noexcept;
-        void SetExclusiveSubresourceState(UINT SubresourceIndex, ExclusiveState const& State) noexcept;
-        void SetSharedSubresourceState(UINT SubresourceIndex, COMMAND_LIST_TYPE Type, UINT64 FenceValue, D3D12_RESOURCE_STATES State) noexcept;
+        void SetExclusiveSubresourceState(UINT SubresourceIndex, ExclusiveState const& State) noexcept
+        {
+            SetExclusiveSubresourceRangeState(SubresourceIndex, 1, State);
+        }
+        void SetSharedSubresourceState(UINT SubresourceIndex, COMMAND_LIST_TYPE Type, UINT64 FenceValue, D3D12_RESOURCE_STATES State) noexcept
+        {
+            SetSharedSubresourceRangeState(SubresourceIndex, 1, Type, FenceValue, State);
+        }
+        void SetExclusiveSubresourceRangeState(UINT FirstSubresource, UINT NumSubresources, ExclusiveState const& State) noexcept;
+        void SetSharedSubresourceRangeState(UINT FirstSubresource, UINT NumSubresources, COMMAND_LIST_TYPE Type, UINT64 FenceValue, D3D12_RESOURCE_STATES State) noexcept;
         ExclusiveState const& GetExclusiveSubresourceState(UINT SubresourceIndex) const noexcept;
         SharedState const& GetSharedSubresourceState(UINT SubresourceIndex) const noexcept;
 
@@ -158,6 +189,15 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
         const bool m_bTriggersSwapchainDeferredWaits;
         std::vector<DeferredWait> m_ResourceDeferredWaits;
 
+        // Incremented whenever the resource may leave the state its bindings need: when a transition is requested for anything
+        // other than its bindings, or when its current state is replaced.
+        UINT64 m_DesiredStateVersion = 1;
+        // The desired state version and state of the last transition requested for the bindings of the whole resource, or 0 if
+        // its bindings have since differed between subresources. While both match, the resource is in or queued for the state
+        // its bindings need, so binding changes which don't change that state don't need to queue it again.
+        UINT64 m_BindingTransitionVersion = 0;
+        D3D12_RESOURCE_STATES m_BindingTransitionState = UNKNOWN_RESOURCE_STATE;
+
         static size_t CalcPreallocationSize(UINT NumSubresources) { return CDesiredResourceState::CalcPreallocationSize(NumSubresources); }
         TransitionableResourceBase(UINT NumSubresources, bool bTriggersDeferredWaits, void*& pPreallocatedMemory) noexcept
             : m_DesiredState(NumSubresources, pPreallocatedMemory)
@@ -180,6 +220,70 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
         }
     };
 
+    //==================================================================================================================================
+    // ResourceBarrierStatistics
+    // Counts of barriers recorded by the state manager and the immediate context. Split barriers count once per half.
+    //==================================================================================================================================
+    struct ResourceBarrierStatistics
+    {
+        UINT64 NumTransitionBarriers;
+        UINT64 NumSplitBeginBarriers;
+        UINT64 NumSplitEndBarriers;
+        UINT64 NumUAVBarriers;
+        UINT64 NumElidedUAVBarriers; // Per-resource UAV barriers which were coalesced or found redundant
+        UINT64 NumElidedTransitionBarriers; // Counted above, but not recorded since enhanced barriers don't need them
+    };
+
+    //==================================================================================================================================
+    // UAVBarrierTracker
+    // Decides which UAV barriers a draw or dispatch needs. The state manager deals with changes in state, where UAV barriers
+    // are needed in steady-state scenarios, between accesses to resources which stay in the UNORDERED_ACCESS state.
+    //
+    // A resource needs a barrier if it was accessed as a UAV earlier in the same command list, and no barrier on all UAVs has
+    // been recorded since. Several per-resource barriers are replaced by a single barrier on all UAVs, which also covers every
+    // other UAV access made so far in the command list, so that following operations don't need barriers for those either.
+    //==================================================================================================================================
+    class UAVBarrierTracker
+    {
+    public:
+        // When a resource was last accessed as a UAV. Kept with the resource, and only updated through StampAccess.
+        struct AccessStamp
+        {
+            UINT64 CommandListID = 0;
+            UINT64 BarrierEpoch = 0;
+        };
+
+        UAVBarrierTracker() noexcept(false)
+        {
+            // There's at most one barrier per slot, so collecting them never allocates.
+            m_vBarriers.reserve(D3D11_1_UAV_SLOT_COUNT); // throw( bad_alloc )
+            m_vTakenBarriers.reserve(D3D11_1_UAV_SLOT_COUNT); // throw( bad_alloc )
+        }
+
+        // Called for each UAV bound to the operation, before any of them are stamped, so that a resource bound to several
+        // slots doesn't need a barrier against itself.
+        void AddAccess(ID3D12Resource* pResource, AccessStamp const& LastAccess, UINT64 CommandListID) noexcept;
+        // Returns the barriers to record before the operation, and starts collecting the next operation's.
+        // The returned vector is valid until the next call.
+        std::vector<D3D12_RESOURCE_BARRIER>& TakeBarriers(UINT& NumElided) noexcept;
+        // Called for each UAV bound to the operation, after its barriers were recorded.
+        void StampAccess(AccessStamp& LastAccess, UINT64 CommandListID) const noexcept
+        {
+            LastAccess.CommandListID = CommandListID;
+            LastAccess.BarrierEpoch = m_BarrierEpoch;
+        }
+        // For barriers on all UAVs which were recorded without going through the tracker.
+        void AllUAVBarrierRecorded() noexcept { ++m_BarrierEpoch; }
+
+    private:
+        std::vector<D3D12_RESOURCE_BARRIER> m_vBarriers;
+        std::vector<D3D12_RESOURCE_BARRIER> m_vTakenBarriers;
+        UINT m_NumElided = 0;
+        // Incremented by each barrier on all UAVs. Accesses stamped with an earlier epoch in the current command list are
+        // already synchronized.
+        UINT64 m_BarrierEpoch = 0;
+    };
+
     //==================================================================================================================================
     // ResourceStateManagerBase
     // The main business logic for handling resource transitions, including multi-queue sync and shared/exclusive state changes.
@@ -207,6 +311,15 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
     // Only once all of this has been done do we update the "current" state of resources,
     // because this is the only way that we know whether or not the destination queue has been flushed,
     // and therefore, we can get the correct fence values to store in the subresources.
+    //
+    // Optionally, split barriers are used to overlap write-to-read transitions with unrelated work. When an operation other than
+    // a draw or dispatch goes to the graphics queue, subresources which are waiting on a pre-draw transition out of a write state
+    // (i.e. their next consumer is known from their bindings) get a BEGIN_ONLY barrier, and their current state moves to the
+    // destination state. The matching END_ONLY barrier is recorded the next time the resource is processed for a draw, when its
+    // desired state changes, or when the graphics command list is closed, since split barriers can't span command lists.
+    //
+    // Optionally, barriers on the graphics command list are recorded as enhanced barriers (see EnhancedBarrierTranslator).
+    // Everything above is unchanged, since the translation happens as the legacy barriers are submitted.
     //==================================================================================================================================
     class ResourceStateManagerBase
     {
@@ -226,7 +339,8 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
         {
             TransitionableResourceBase& AffectedResource;
             CCurrentResourceState& CurrentState;
-            UINT SubresourceIndex;
+            UINT SubresourceIndex; // D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, or the first of NumSubresources
+            UINT NumSubresources;
             D3D12_RESOURCE_STATES NewState;
             PostApplyExclusiveState ExclusiveState;
             bool WasTransitioningToDestinationType;
@@ -235,6 +349,34 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
         std::vector<D3D12_RESOURCE_BARRIER> m_vDstResourceBarriers;
         std::vector<D3D12_RESOURCE_BARRIER> m_vTentativeResourceBarriers;
         std::vector<PostApplyUpdate> m_vPostApplyUpdates;
+
+        // Split transitions on the graphics queue. Candidates are collected while processing resources, and only begun if the
+        // operation ends up targeting the graphics queue. Once begun, only the barrier is kept, which remains valid after the
+        // resource is destroyed since destruction is deferred until the command list completes.
+        struct SplitBarrier
+        {
+            D3D12_RESOURCE_BARRIER Desc; // Subresource is the first of NumSubresources, or ALL_SUBRESOURCES
+            UINT NumSubresources;
+            CDesiredResourceState::SubresourceInfo DesiredInfo;
+            TransitionableResourceBase* pResource; // Only valid for candidates
+            CCurrentResourceState* pCurrentState; // Only valid for candidates
+        };
+        bool m_bUseSplitBarriers = false;
+        std::vector<SplitBarrier> m_vSplitBarrierCandidates;
+        std::vector<SplitBarrier> m_vPendingSplitBarriers;
+        std::vector<D3D12_RESOURCE_BARRIER> m_vSplitEndBarriers;
+
+        bool m_bUseEnhancedBarriers = false;
+        EnhancedBarrierTranslator m_EnhancedBarriers;
+
+        // Atomic so that statistics can be read from other threads
+        std::atomic<UINT64> m_NumTransitionBarriers{ 0 };
+        std::atomic<UINT64> m_NumSplitBeginBarriers{ 0 };
+        std::atomic<UINT64> m_NumSplitEndBarriers{ 0 };
+        std::atomic<UINT64> m_NumUAVBarriers{ 0 };
+        std::atomic<UINT64> m_NumElidedUAVBarriers{ 0 };
+        std::atomic<UINT64> m_NumElidedTransitionBarriers{ 0 };
+
         COMMAND_LIST_TYPE m_DestinationCommandListType;
         bool m_bApplySwapchainDeferredWaits;
         bool m_bFlushQueues[(UINT)COMMAND_LIST_TYPE::MAX_VALID];
@@ -260,6 +402,27 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
                                    UINT SubresourceIndex,
                                    CDesiredResourceState::SubresourceInfo const& State) noexcept;
 
+        // Requests the state needed by bindings which are the same for all subresources, and remembers it if it was applied.
+        void TransitionResourceForUniformBindings(TransitionableResourceBase& Resource, D3D12_RESOURCE_STATES State) noexcept;
+        // Whether the resource is in or queued for the state needed by its bindings, which are the same for all subresources.
+        static bool IsBindingTransitionCurrent(TransitionableResourceBase const& Resource, D3D12_RESOURCE_STATES State) noexcept
+        {
+            return Resource.m_BindingTransitionVersion == Resource.m_DesiredStateVersion &&
+                Resource.m_BindingTransitionState == State;
+        }
+
+        // Update destination state of a resource/specified subresources to correspond to the resource's bind points.
+        void TransitionResourceForBindings(TransitionableResourceBase& Resource, CResourceBindings const& Bindings) noexcept;
+        void TransitionSubresourcesForBindings(TransitionableResourceBase& Resource,
+                                               CResourceBindings const& Bindings,
+                                               CViewSubresourceSubset const& Subresources) noexcept;
+        // As above, but for when bindings were added or removed. Skipped if the state needed by the bindings didn't change,
+        // and the resource can't have left it since it was last requested. Returns whether the transition was requested.
+        bool TransitionResourceForChangedBindings(TransitionableResourceBase& Resource, CResourceBindings const& Bindings) noexcept;
+        bool TransitionSubresourcesForChangedBindings(TransitionableResourceBase& Resource,
+                                                      CResourceBindings const& Bindings,
+                                                      CViewSubresourceSubset const& Subresources) noexcept;
+
         // Deferred waits are inserted when a transition is processing that puts applicable resources
         // into a write state. The command list is flushed, and these waits are inserted before the barriers.
         void AddDeferredWait(std::shared_ptr<Fence> const& spFence, UINT64 Value) noexcept(false);
@@ -267,6 +430,18 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
         // Clear out any state from previous iterations.
         void ApplyResourceTransitionsPreamble() noexcept;
 
+        void SetUseSplitBarriers(bool bUseSplitBarriers) noexcept { m_bUseSplitBarriers = bUseSplitBarriers; }
+        // Only affects the graphics command list, and requires it to support ID3D12GraphicsCommandList7.
+        void SetUseEnhancedBarriers(bool bUseEnhancedBarriers) noexcept { m_bUseEnhancedBarriers = bUseEnhancedBarriers; }
+        bool UsesEnhancedBarriers() const noexcept { return m_bUseEnhancedBarriers; }
+        ResourceBarrierStatistics GetBarrierStatistics() const noexcept;
+
+        // Returns END_ONLY barriers for all split transitions begun in the graphics command list, which must be recorded before
+        // it's closed. The returned vector is valid until the next call.
+        std::vector<D3D12_RESOURCE_BARRIER>& TakeSplitEndBarriers() noexcept(false);
+        // For when the graphics command list is discarded rather than closed.
+        void DiscardSplitBarriers() noexcept { m_vPendingSplitBarriers.clear(); }
+
         // What to do with the resource, in the context of the transition list, after processing it.
         enum class TransitionResult
         {
@@ -371,7 +546,7 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
                     }
                     else
                     {
-                        update.CurrentState.SetExclusiveSubresourceState(update.SubresourceIndex, NewExclusiveState);
+                        update.CurrentState.SetExclusiveSubresourceRangeState(update.SubresourceIndex, update.NumSubresources, NewExclusiveState);
                     }
                 }
                 else if (update.WasTransitioningToDestinationType)
@@ -382,7 +557,7 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
                     }
                     else
                     {
-                        update.CurrentState.SetSharedSubresourceState(update.SubresourceIndex, m_DestinationCommandListType, NewFenceValue, update.NewState);
+                        update.CurrentState.SetSharedSubresourceRangeState(update.SubresourceIndex, update.NumSubresources, m_DestinationCommandListType, NewFenceValue, update.NewState);
                     }
                 }
                 else
@@ -399,11 +574,29 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
         void AddCurrentStateUpdate(TransitionableResourceBase& Resource,
                                    CCurrentResourceState& CurrentState,
                                    UINT SubresourceIndex,
+                                   UINT NumSubresources,
                                    D3D12_RESOURCE_STATES NewState,
                                    PostApplyExclusiveState ExclusiveState,
                                    bool IsGoingToDestinationType) noexcept(false);
+        // Adds one barrier per subresource in the span described by Desc and NumSubresources.
+        static void AddTransitionBarriers(std::vector<D3D12_RESOURCE_BARRIER>& Barriers, D3D12_RESOURCE_BARRIER const& Desc, UINT NumSubresources) noexcept(false);
+        void RecordBarrierStatistics(std::vector<D3D12_RESOURCE_BARRIER> const& Barriers) noexcept;
+        void AddSplitBarrierCandidate(TransitionableResourceBase& TransitionableResource,
+                                      CCurrentResourceState& CurrentState,
+                                      UINT i,
+                                      UINT NumSubresources,
+                                      CDesiredResourceState::SubresourceInfo const& SubresourceDestinationInfo,
+                                      D3D12_RESOURCE_BARRIER const& TransitionDesc) noexcept(false);
+        void BeginSplitBarrierCandidates() noexcept(false);
+        // Ends split transitions on the resource unless it's still waiting for the draw they were begun for.
+        void EndSplitBarriers(ID3D12Resource* pTransitioningResource,
+                              CDesiredResourceState const& DestinationState,
+                              bool bIsPreDraw) noexcept(false);
+        // The subresource helpers process a span of NumSubresources subresources starting at i, which all share the same
+        // current and desired state. TransitionDesc's subresource is either i, or ALL_SUBRESOURCES for the whole resource.
         void ProcessTransitioningSubresourceExclusive(CCurrentResourceState& CurrentState,
                                                       UINT i,
+                                                      UINT NumSubresources,
                                                       COMMAND_LIST_TYPE curCmdListType,
                                                       _In_reads_((UINT)COMMAND_LIST_TYPE::MAX_VALID) const UINT64* CurrentFenceValues,
                                                       CDesiredResourceState::SubresourceInfo& SubresourceDestinationInfo,
@@ -413,13 +606,14 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
                                                       SubresourceTransitionFlags Flags) noexcept(false);
         void ProcessTransitioningSubresourceShared(CCurrentResourceState& CurrentState,
                                                    UINT i,
+                                                   UINT NumSubresources,
                                                    D3D12_RESOURCE_STATES after,
                                                    SubresourceTransitionFlags Flags,
                                                    _In_reads_((UINT)COMMAND_LIST_TYPE::MAX_VALID) const UINT64* CurrentFenceValues,
                                                    COMMAND_LIST_TYPE curCmdListType,
                                                    D3D12_RESOURCE_BARRIER& TransitionDesc,
                                                    TransitionableResourceBase& TransitionableResource) noexcept(false);
-        void SubmitResourceBarriers(_In_reads_(Count) D3D12_RESOURCE_BARRIER const* pBarriers, UINT Count, _In_ CommandListManager* pManager) noexcept;
+        void SubmitResourceBarriers(_In_reads_(Count) D3D12_RESOURCE_BARRIER const* pBarriers, UINT Count, _In_ CommandListManager* pManager) noexcept(false);
     };
 
     //==================================================================================================================================
@@ -461,10 +655,31 @@ constexpr D3D12_RESOURCE_STATES RESOURCE_STATE_ALL_WRITE_BITS =
         // Update destination state of specified subresources to correspond to the resource's bind points.
         void TransitionSubresourcesForBindings(Resource* pResource,
                                                CViewSubresourceSubset const& Subresources) noexcept;
+        // As above, but for when bindings were added or removed. Skipped if the state needed by the bindings didn't change,
+        // and the resource can't have left it since it was last requested.
+        void TransitionResourceForChangedBindings(Resource* pResource) noexcept;
+        void TransitionSubresourcesForChangedBindings(Resource* pResource,
+                                                      CViewSubresourceSubset const& Subresources) noexcept;
 
         // Submit all barriers and queue sync.
         void ApplyAllResourceTransitions(bool bIsPreDraw = false) noexcept(false);
 
+        // Records the ends of any split transitions in the graphics command list, before it's closed.
+        void EndAllSplitBarriers() noexcept(false);
+        // Records barriers which aren't generated by the state manager, e.g. UAV barriers, in the graphics command list, in the
+        // same form as the ones which are.
+        void SubmitGraphicsBarriers(_In_reads_(Count) D3D12_RESOURCE_BARRIER const* pBarriers, UINT Count) noexcept(false);
+        void AddUAVBarrierStatistics(UINT NumBarriers, UINT NumElided) noexcept
+        {
+            m_NumUAVBarriers.fetch_add(NumBarriers, std::memory_order_relaxed);
+            m_NumElidedUAVBarriers.fetch_add(NumElided, std::memory_order_relaxed);
+        }
+
         using ResourceStateManagerBase::AddDeferredWait;
+        using ResourceStateManagerBase::SetUseSplitBarriers;
+        using ResourceStateManagerBase::SetUseEnhancedBarriers;
+        using ResourceStateManagerBase::UsesEnhancedBarriers;
+        using ResourceStateManagerBase::GetBarrierStatistics;
+        using ResourceStateManagerBase::DiscardSplitBarriers;
     };
 };
\ No newline at end of file
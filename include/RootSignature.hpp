@@ -105,13 +105,17 @@ namespace D3D12TranslationLayer
             Compute = 1,
             RequiresBufferOutOfBoundsHandling = 2,
             UsesShaderInterfaces = 4,
+            Bindless = 8, // SRV, UAV and sampler tables are replaced by root CBVs holding descriptor heap indices
         };
         const Flags m_Flags;
 
         UINT m_NumSRVSpacesUsed[5];
 
+        // Register space of the root CBVs which hold bindless indices: SRVs in b0, samplers in b1, and UAVs in b2
+        static constexpr UINT c_BindlessIndicesSpace = 100;
+
         template <int N>
-        static Flags ComputeFlags(bool bRequiresBufferOutOfBoundsHandling, std::array<SShaderDecls const*, N> const& shaders)
+        static Flags ComputeFlags(bool bRequiresBufferOutOfBoundsHandling, bool bBindless, std::array<SShaderDecls const*, N> const& shaders)
         {
             UINT flags =
                 ((N == 1) ? Compute : 0) |
@@ -124,10 +128,15 @@ namespace D3D12TranslationLayer
                     break;
                 }
             }
+            // Interfaces rely on dynamically indexing descriptor ranges in additional spaces, so they stay on tables
+            if (bBindless && !(flags & UsesShaderInterfaces))
+            {
+                flags |= Bindless;
+            }
             return (Flags)flags;
         }
 
-        RootSignatureDesc(SShaderDecls const* pVS, SShaderDecls const* pPS, SShaderDecls const* pGS, SShaderDecls const* pHS, SShaderDecls const* pDS, bool bRequiresBufferOutOfBoundsHandling)
+        RootSignatureDesc(SShaderDecls const* pVS, SShaderDecls const* pPS, SShaderDecls const* pGS, SShaderDecls const* pHS, SShaderDecls const* pDS, bool bRequiresBufferOutOfBoundsHandling, bool bBindless)
             : m_ShaderStages{
                 { ShaderStage(pPS) },
                 { ShaderStage(pVS) },
@@ -135,7 +144,7 @@ namespace D3D12TranslationLayer
                 { ShaderStage(pHS) },
                 { ShaderStage(pDS) } }
             , m_UAVBucket(NonCBBindingCountToBucket(NumUAVBindings(pVS, pPS, pGS, pHS, pDS)))
-            , m_Flags(ComputeFlags<5>(bRequiresBufferOutOfBoundsHandling, std::array<SShaderDecls const*, 5>{ pPS, pVS, pGS, pHS, pDS }))
+            , m_Flags(ComputeFlags<5>(bRequiresBufferOutOfBoundsHandling, bBindless, std::array<SShaderDecls const*, 5>{ pPS, pVS, pGS, pHS, pDS }))
             , m_NumSRVSpacesUsed{
                 pPS ? pPS->m_NumSRVSpacesUsed : 1u,
                 pVS ? pVS->m_NumSRVSpacesUsed : 1u,
@@ -144,11 +153,11 @@ namespace D3D12TranslationLayer
                 pDS ? pDS->m_NumSRVSpacesUsed : 1u }
         {
         }
-        RootSignatureDesc(SShaderDecls const* pCS, bool bRequiresBufferOutOfBoundsHandling)
+        RootSignatureDesc(SShaderDecls const* pCS, bool bRequiresBufferOutOfBoundsHandling, bool bBindless)
             : m_ShaderStages{
                 { ShaderStage(pCS) } }
                 , m_UAVBucket(NonCBBindingCountToBucket(pCS ? (UINT)pCS->m_UAVDecls.size() : 0u))
-            , m_Flags(ComputeFlags<1>(bRequiresBufferOutOfBoundsHandling, std::array<SShaderDecls const*, 1>{ pCS }))
+            , m_Flags(ComputeFlags<1>(bRequiresBufferOutOfBoundsHandling, bBindless, std::array<SShaderDecls const*, 1>{ pCS }))
             , m_NumSRVSpacesUsed{ pCS ? pCS->m_NumSRVSpacesUsed : 1u }
         {
         }
@@ -156,6 +165,7 @@ namespace D3D12TranslationLayer
         RootSignatureDesc& operator=(RootSignatureDesc const&) = default;
 
         UINT GetUAVBindingCount() const { return NonCBBucketToBindingCount(m_UAVBucket); }
+        bool IsBindless() const { return (m_Flags & Bindless) != 0; }
         UINT64 GetAsUINT64() const { return *reinterpret_cast<const UINT64*>(this); }
         void GetAsD3D12Desc(VersionedRootSignatureDescWithStorage& Storage, ImmediateContext* pParent) const;
 
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+
+namespace D3D12TranslationLayer
+{
+    //==================================================================================================================================
+    // SPSCRing
+    // Bounded single-producer/single-consumer ring buffer. The producer only writes m_Tail, the consumer only writes m_Head,
+    // so neither side needs a lock to push or pop. Capacity must be a power of two.
+    //==================================================================================================================================
+    template <typename T, UINT Capacity>
+    class SPSCRing
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+        static_assert(std::is_trivially_copyable<T>::value, "Ring entries are copied without synchronization.");
+        static constexpr size_t c_CacheLineSize = 64;
+
+        alignas(c_CacheLineSize) std::atomic<UINT64> m_Head{ 0 }; // Written by consumer
+        alignas(c_CacheLineSize) std::atomic<UINT64> m_Tail{ 0 }; // Written by producer
+        alignas(c_CacheLineSize) T m_Entries[Capacity] = {};
+
+    public:
+        // Producer only. Returns false if the ring is full.
+        bool TryPush(T const& Value) noexcept
+        {
+            const UINT64 Tail = m_Tail.load(std::memory_order_relaxed);
+            if (Tail - m_Head.load(std::memory_order_acquire) == Capacity)
+            {
+                return false;
+            }
+            m_Entries[Tail & (Capacity - 1)] = Value;
+            m_Tail.store(Tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only. Returns nullptr if the ring is empty.
+        T const* Front() const noexcept
+        {
+            const UINT64 Head = m_Head.load(std::memory_order_relaxed);
+            if (Head == m_Tail.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            return &m_Entries[Head & (Capacity - 1)];
+        }
+
+        // Consumer only. Must follow a successful Front().
+        void Pop() noexcept
+        {
+            const UINT64 Head = m_Head.load(std::memory_order_relaxed);
+            assert(Head != m_Tail.load(std::memory_order_acquire));
+            m_Head.store(Head + 1, std::memory_order_release);
+        }
+
+        // Observers other than the producer and consumer must synchronize with Pop() externally,
+        // otherwise the entries they inspect may be retired underneath them.
+        UINT64 size() const noexcept { return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire); }
+        bool empty() const noexcept { return size() == 0; }
+        T const& operator[](UINT64 Index) const noexcept
+        {
+            assert(Index < size());
+            return m_Entries[(m_Head.load(std::memory_order_acquire) + Index) & (Capacity - 1)];
+        }
+    };
+
+    //==================================================================================================================================
+    // SpinThenParkSemaphore
+    // Counting semaphore with exactly one waiting thread. Waits spin in user mode for a bounded number of iterations before
+    // parking on an event, and Release() only transitions into the kernel when the waiter is actually parked.
+    //==================================================================================================================================
+    class SpinThenParkSemaphore
+    {
+        // Positive: available count. -1: the waiter is parked (or about to be) on m_Event.
+        std::atomic<LONG> m_Count{ 0 };
+        XPlatHelpers::unique_event m_Event;
+        UINT m_SpinCount;
+
+        static void Pause() noexcept
+        {
+#ifdef _WIN32
+            YieldProcessor();
+#else
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+        }
+
+        bool TryAcquire() noexcept
+        {
+            LONG Count = m_Count.load(std::memory_order_relaxed);
+            while (Count > 0)
+            {
+                if (m_Count.compare_exchange_weak(Count, Count - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    public:
+        static constexpr UINT c_DefaultSpinCount = 4000;
+
+        SpinThenParkSemaphore(UINT SpinCount = c_DefaultSpinCount) noexcept(false)
+            : m_SpinCount(SpinCount)
+        {
+            m_Event.create();
+            if (!m_Event)
+            {
+                throw std::bad_alloc();
+            }
+        }
+
+        void Release() noexcept
+        {
+            if (m_Count.fetch_add(1, std::memory_order_release) < 0)
+            {
+                m_Event.set();
+            }
+        }
+
+        // Timeout of 0 only polls, INFINITE never gives up.
+        bool Wait(DWORD TimeoutMs) noexcept
+        {
+            if (TryAcquire())
+            {
+                return true;
+            }
+            if (TimeoutMs == 0)
+            {
+                return false;
+            }
+
+            for (UINT i = 0; i < m_SpinCount; ++i)
+            {
+                Pause();
+                if (TryAcquire())
+                {
+                    return true;
+                }
+            }
+
+            if (m_Count.fetch_sub(1, std::memory_order_acquire) > 0)
+            {
+                return true;
+            }
+
+            if (XPlatHelpers::WaitForEvent(m_Event.get(), TimeoutMs))
+            {
+                return true;
+            }
+
+            // Timed out. Withdraw from the count unless a Release() has already committed to waking us,
+            // in which case the event is (or is about to be) signaled and must be consumed.
+            LONG Count = m_Count.load(std::memory_order_relaxed);
+            while (Count < 0)
+            {
+                if (m_Count.compare_exchange_weak(Count, Count + 1, std::memory_order_relaxed))
+                {
+                    return false;
+                }
+            }
+            XPlatHelpers::WaitForEvent(m_Event.get());
+            return true;
+        }
+    };
+}
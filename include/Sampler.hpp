@@ -17,5 +17,6 @@ namespace D3D12TranslationLayer
     public:
         D3D12_CPU_DESCRIPTOR_HANDLE m_Descriptor;
         UINT m_DescriptorHeapIndex;
+        UINT m_BindlessIndex = UINT_MAX; // Assigned the first time it's bound under a bindless root signature
     };
 };
\ No newline at end of file
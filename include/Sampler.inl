@@ -18,6 +18,10 @@ namespace D3D12TranslationLayer
     //----------------------------------------------------------------------------------------------------------------------------------
     inline Sampler::~Sampler() noexcept
     {
+        if (m_BindlessIndex != CBindlessIndexAllocator::c_InvalidIndex)
+        {
+            m_pParent->m_BindlessSamplerIndices.Retire(m_BindlessIndex, m_LastUsedCommandListID[(UINT)COMMAND_LIST_TYPE::GRAPHICS]);
+        }
         if (!m_pParent->ComputeOnly())
         {
             m_pParent->m_SamplerAllocator.FreeHeapSlot(m_Descriptor, m_DescriptorHeapIndex);
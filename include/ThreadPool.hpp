@@ -2,19 +2,27 @@
 // Licensed under the MIT License.
 #pragma once
 
+class CThreadPool;
+
+//==================================================================================================================================
+// CThreadPool
+// Portable work-stealing thread pool. Each worker owns a deque per priority: work queued from a worker goes to its own
+// deque, work queued from other threads is spread round-robin, and idle workers steal from the others. Jobs are the
+// caller's CThreadPoolWork objects, so queueing doesn't allocate anything beyond amortized deque growth.
+// Workers are started on demand, when work is queued and none are idle, up to the pool's maximum.
+//==================================================================================================================================
 class CThreadPoolWork
 {
     friend class CThreadPool;
 
 private:
-    PTP_WORK m_pWork = nullptr;
-    std::function<void()> m_WorkFunction;
+    enum class EState { Idle, Queued, Running, Done };
 
-    static void CALLBACK WorkCallback(PTP_CALLBACK_INSTANCE, PVOID Context, PTP_WORK)
-    {
-        CThreadPoolWork* pWork = reinterpret_cast<CThreadPoolWork*>(Context);
-        pWork->m_WorkFunction();
-    }
+    CThreadPool* m_pPool = nullptr;
+    std::function<void()> m_WorkFunction;
+    std::atomic<EState> m_State{ EState::Idle };
+    // Index of the worker deque holding this work while Queued, only written under that deque's lock.
+    std::atomic<UINT> m_QueueIndex{ UINT_MAX };
 
 public:
     CThreadPoolWork() = default;
@@ -25,16 +33,10 @@ public:
     CThreadPoolWork& operator=(CThreadPoolWork const&) = delete;
     CThreadPoolWork& operator=(CThreadPoolWork&&) = delete;
 
-    void Wait(bool bCancel = true)
-    {
-        if (m_pWork)
-        {
-            WaitForThreadpoolWorkCallbacks(m_pWork, bCancel);
-            CloseThreadpoolWork(m_pWork);
-            m_pWork = nullptr;
-        }
-    }
-    operator bool() { return m_pWork != nullptr; }
+    // Cancels the work if it hasn't started, otherwise waits for it. Without bCancel, work that hasn't started
+    // runs on the calling thread instead, rather than waiting for a worker to get to it.
+    inline void Wait(bool bCancel = true);
+    operator bool() const { return m_State.load(std::memory_order_acquire) != EState::Idle; }
 
     ~CThreadPoolWork()
     {
@@ -44,64 +46,295 @@ public:
 
 class CThreadPool
 {
+public:
+    enum class EPriority { High, Normal, Low, Count };
+
 private:
-    TP_CALLBACK_ENVIRON m_Environment;
-    PTP_POOL m_pPool = nullptr;
-    PTP_CLEANUP_GROUP m_pCleanup = nullptr;
+    struct WorkerQueue
+    {
+        std::mutex m_Lock;
+        std::deque<CThreadPoolWork*> m_Work[(UINT)EPriority::Count];
+    };
+
+    std::unique_ptr<WorkerQueue[]> m_spQueues; // One per potential worker
+    std::vector<std::thread> m_Workers; // Only modified under m_WakeLock
+    UINT m_NumWorkers = 0; // Maximum
+    std::atomic<UINT> m_NumStartedWorkers{ 0 };
+    std::atomic<UINT> m_NextQueue{ 0 };
+    EPriority m_DefaultPriority = EPriority::Normal;
     bool m_bCancelPendingWorkOnCleanup = true;
 
-public:
-    CThreadPool()
+    // Workers sleep when nothing is queued. Guarded by m_WakeLock.
+    std::mutex m_WakeLock;
+    std::condition_variable m_WakeCV;
+    UINT64 m_NumQueued = 0;
+    UINT m_NumIdleWorkers = 0;
+    bool m_bShutdown = false;
+
+    // Signaled when any work finishes
+    std::mutex m_DoneLock;
+    std::condition_variable m_DoneCV;
+
+    static UINT& CurrentWorkerIndex() { static thread_local UINT s_Index = UINT_MAX; return s_Index; }
+    static CThreadPool*& CurrentWorkerPool() { static thread_local CThreadPool* s_pPool = nullptr; return s_pPool; }
+
+    // Must be called with the deque's lock held. The caller is then responsible for running or completing the work.
+    CThreadPoolWork* Claim(std::deque<CThreadPoolWork*>& Deque, std::deque<CThreadPoolWork*>::iterator Iter)
+    {
+        CThreadPoolWork* pWork = *Iter;
+        pWork->m_QueueIndex.store(UINT_MAX, std::memory_order_relaxed);
+        pWork->m_State.store(CThreadPoolWork::EState::Running, std::memory_order_relaxed);
+        Deque.erase(Iter);
+        {
+            // Deque locks are always taken before m_WakeLock
+            std::lock_guard<std::mutex> Lock(m_WakeLock);
+            assert(m_NumQueued > 0);
+            --m_NumQueued;
+        }
+        return pWork;
+    }
+
+    CThreadPoolWork* TryPop(UINT WorkerIndex)
     {
-        InitializeThreadpoolEnvironment(&m_Environment);
-        m_pPool = CreateThreadpool(nullptr);
-        if (!m_pPool)
+        for (EPriority Priority : { EPriority::High, EPriority::Normal, EPriority::Low })
         {
-            throw _com_error(HRESULT_FROM_WIN32(GetLastError()));
+            // Own work in FIFO order first, then steal the most recently queued work of others, so that owners
+            // and thieves rarely contend on the same end. Work is only queued to started workers.
+            const UINT NumStartedWorkers = m_NumStartedWorkers.load(std::memory_order_acquire);
+            for (UINT i = 0; i < NumStartedWorkers; ++i)
+            {
+                const UINT QueueIndex = (WorkerIndex + i) % NumStartedWorkers;
+                WorkerQueue& Queue = m_spQueues[QueueIndex];
+                std::lock_guard<std::mutex> Lock(Queue.m_Lock);
+                auto& Deque = Queue.m_Work[(UINT)Priority];
+                if (!Deque.empty())
+                {
+                    return Claim(Deque, (i == 0) ? Deque.begin() : std::prev(Deque.end()));
+                }
+            }
         }
+        return nullptr;
+    }
 
-        m_pCleanup = CreateThreadpoolCleanupGroup();
-        if (!m_pCleanup)
+    // The work mustn't be touched afterwards, its owner may destroy it as soon as it's Done.
+    void Complete(CThreadPoolWork& Work)
+    {
         {
-            CloseThreadpool(m_pPool);
-            throw _com_error(HRESULT_FROM_WIN32(GetLastError()));
+            std::lock_guard<std::mutex> Lock(m_DoneLock);
+            Work.m_State.store(CThreadPoolWork::EState::Done, std::memory_order_release);
         }
+        m_DoneCV.notify_all();
+    }
 
-        // No more failures
-        SetThreadpoolCallbackPool(&m_Environment, m_pPool);
-        SetThreadpoolCallbackCleanupGroup(&m_Environment, m_pCleanup, nullptr);
+    void Run(CThreadPoolWork& Work)
+    {
+        Work.m_WorkFunction();
+        Complete(Work);
+    }
+
+    void WorkerThread(UINT WorkerIndex)
+    {
+        CurrentWorkerIndex() = WorkerIndex;
+        CurrentWorkerPool() = this;
+        for (;;)
+        {
+            if (CThreadPoolWork* pWork = TryPop(WorkerIndex))
+            {
+                Run(*pWork);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> Lock(m_WakeLock);
+            ++m_NumIdleWorkers;
+            m_WakeCV.wait(Lock, [this]() { return m_bShutdown || m_NumQueued > 0; });
+            --m_NumIdleWorkers;
+            if (m_bShutdown && m_NumQueued == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    // Removes queued work. Returns false if a worker has already claimed it.
+    bool TryClaim(CThreadPoolWork& Work)
+    {
+        // m_QueueIndex is only stable under the owning deque's lock, so lock the one it was last seen in and recheck.
+        for (;;)
+        {
+            const UINT QueueIndex = Work.m_QueueIndex.load(std::memory_order_relaxed);
+            if (QueueIndex == UINT_MAX)
+            {
+                return false;
+            }
+            WorkerQueue& Queue = m_spQueues[QueueIndex];
+            std::lock_guard<std::mutex> Lock(Queue.m_Lock);
+            if (Work.m_QueueIndex.load(std::memory_order_relaxed) != QueueIndex)
+            {
+                continue;
+            }
+            for (auto& Deque : Queue.m_Work)
+            {
+                auto Iter = std::find(Deque.begin(), Deque.end(), &Work);
+                if (Iter != Deque.end())
+                {
+                    Claim(Deque, Iter);
+                    return true;
+                }
+            }
+            assert(false);
+            return false;
+        }
+    }
+
+    // Starts another worker if none are idle to pick up new work. Only fails if there are no workers at all.
+    void StartWorkerIfNeeded()
+    {
+        std::lock_guard<std::mutex> Lock(m_WakeLock);
+        if (m_NumIdleWorkers > m_NumQueued || m_Workers.size() == m_NumWorkers)
+        {
+            return;
+        }
+        try
+        {
+            m_Workers.emplace_back(&CThreadPool::WorkerThread, this, (UINT)m_Workers.size()); // throw( system_error ), reserved up front
+        }
+        catch (std::system_error&)
+        {
+            if (m_Workers.empty())
+            {
+                throw _com_error(E_OUTOFMEMORY);
+            }
+            return;
+        }
+        m_NumStartedWorkers.store((UINT)m_Workers.size(), std::memory_order_release);
+    }
+
+    void CancelAllPending()
+    {
+        for (UINT i = 0; i < m_NumWorkers; ++i)
+        {
+            std::lock_guard<std::mutex> Lock(m_spQueues[i].m_Lock);
+            for (auto& Deque : m_spQueues[i].m_Work)
+            {
+                while (!Deque.empty())
+                {
+                    Complete(*Claim(Deque, Deque.begin()));
+                }
+            }
+        }
+    }
+
+    friend class CThreadPoolWork;
+    void Wait(CThreadPoolWork& Work, bool bCancel)
+    {
+        if (TryClaim(Work))
+        {
+            if (bCancel)
+            {
+                Complete(Work);
+            }
+            else
+            {
+                Run(Work);
+            }
+        }
+
+        std::unique_lock<std::mutex> Lock(m_DoneLock);
+        m_DoneCV.wait(Lock, [&Work]() { return Work.m_State.load(std::memory_order_relaxed) == CThreadPoolWork::EState::Done; });
+    }
+
+public:
+    // NumThreads is the maximum number of workers, 0 uses one per hardware thread. None are started until work is queued.
+    explicit CThreadPool(UINT NumThreads = 0)
+    {
+        m_NumWorkers = NumThreads ? NumThreads : std::max<UINT>(1, std::thread::hardware_concurrency());
+        m_spQueues.reset(new WorkerQueue[m_NumWorkers]); // throw( bad_alloc )
+        m_Workers.reserve(m_NumWorkers); // throw( bad_alloc )
     }
 
     ~CThreadPool()
     {
-        CloseThreadpoolCleanupGroupMembers(m_pCleanup, m_bCancelPendingWorkOnCleanup, nullptr);
-        CloseThreadpoolCleanupGroup(m_pCleanup);
-        CloseThreadpool(m_pPool);
-        DestroyThreadpoolEnvironment(&m_Environment);
+        if (m_bCancelPendingWorkOnCleanup)
+        {
+            CancelAllPending();
+        }
+        Shutdown();
     }
 
-    // Noncopyable, non-movable since m_Environment is not a pointer.
+    // Noncopyable, non-movable since workers reference the pool.
     CThreadPool(CThreadPool const&) = delete;
     CThreadPool(CThreadPool&&) = delete;
     CThreadPool& operator=(CThreadPool const&) = delete;
     CThreadPool& operator=(CThreadPool&&) = delete;
 
     void SetCancelPendingWorkOnCleanup(bool bCancel) { m_bCancelPendingWorkOnCleanup = bCancel; }
+    // Priority of work queued without an explicit one.
+    void SetDefaultPriority(EPriority Priority) { m_DefaultPriority = Priority; }
+    UINT GetNumThreads() const { return m_NumWorkers; }
+    UINT GetNumStartedThreads() const { return m_NumStartedWorkers.load(std::memory_order_acquire); }
 
     void QueueThreadpoolWork(CThreadPoolWork& Work, std::function<void()> WorkFunction)
     {
-        if (Work.m_pWork != nullptr)
+        QueueThreadpoolWork(Work, std::move(WorkFunction), m_DefaultPriority);
+    }
+
+    void QueueThreadpoolWork(CThreadPoolWork& Work, std::function<void()> WorkFunction, EPriority Priority)
+    {
+        if (Work.m_State.load(std::memory_order_acquire) != CThreadPoolWork::EState::Idle)
         {
             throw _com_error(E_INVALIDARG);
         }
 
+        StartWorkerIfNeeded(); // throw( _com_error )
+
+        Work.m_pPool = this;
         Work.m_WorkFunction = std::move(WorkFunction);
-        Work.m_pWork = CreateThreadpoolWork(&CThreadPoolWork::WorkCallback, &Work, &m_Environment);
-        if (!Work.m_pWork)
+
+        const UINT QueueIndex = (CurrentWorkerPool() == this) ?
+            CurrentWorkerIndex() : m_NextQueue.fetch_add(1, std::memory_order_relaxed) % GetNumStartedThreads();
+        {
+            WorkerQueue& Queue = m_spQueues[QueueIndex];
+            std::lock_guard<std::mutex> Lock(Queue.m_Lock);
+            Queue.m_Work[(UINT)Priority].push_back(&Work); // throw( bad_alloc )
+            Work.m_State.store(CThreadPoolWork::EState::Queued, std::memory_order_relaxed);
+            Work.m_QueueIndex.store(QueueIndex, std::memory_order_relaxed);
+
+            // Counted before the deque lock is released, so a worker can't claim the work and decrement the count first.
+            std::lock_guard<std::mutex> WakeLock(m_WakeLock);
+            ++m_NumQueued;
+        }
+        m_WakeCV.notify_one();
+    }
+
+private:
+    void Shutdown()
+    {
         {
-            throw _com_error(HRESULT_FROM_WIN32(GetLastError()));
+            std::lock_guard<std::mutex> Lock(m_WakeLock);
+            m_bShutdown = true;
         }
+        m_WakeCV.notify_all();
+        for (auto& Worker : m_Workers)
+        {
+            Worker.join();
+        }
+        m_Workers.clear();
+    }
+};
 
-        SubmitThreadpoolWork(Work.m_pWork);
+//----------------------------------------------------------------------------------------------------------------------------------
+inline void CThreadPoolWork::Wait(bool bCancel)
+{
+    // Work which is Done can outlive its pool, so don't touch the pool unless it's still outstanding.
+    if (m_State.load(std::memory_order_acquire) == EState::Idle)
+    {
+        return;
+    }
+    if (m_State.load(std::memory_order_acquire) != EState::Done)
+    {
+        m_pPool->Wait(*this, bCancel);
     }
-};
\ No newline at end of file
+    m_WorkFunction = nullptr;
+    m_pPool = nullptr;
+    m_State.store(EState::Idle, std::memory_order_relaxed);
+}
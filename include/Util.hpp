@@ -180,6 +180,14 @@ namespace D3D12TranslationLayer
         return std::max<T>(Align(uValue, uAlign), uAlign);
     }
 
+    // Converts QueryPerformanceCounter ticks to microseconds. Whole seconds are scaled separately from the remainder,
+    // since Ticks * 1000000 overflows after a few hours of accumulated ticks at a 10 MHz frequency.
+    inline UINT64 TicksToMicroseconds(UINT64 Ticks, UINT64 TicksPerSecond)
+    {
+        assert(TicksPerSecond > 0);
+        return (Ticks / TicksPerSecond) * 1000000 + (Ticks % TicksPerSecond) * 1000000 / TicksPerSecond;
+    }
+
     // Avoid including kernel libraries by adding list implementation here:
 
     inline BOOLEAN IsListEmpty(_In_ const LIST_ENTRY * ListHead)
@@ -100,6 +100,10 @@ namespace D3D12TranslationLayer
     public:
         CViewSubresourceSubset m_subresources;
         UINT m_ViewUniqueness;
+
+        // Slot in the shader-visible heap when bound under a bindless root signature, and the view uniqueness it was copied at
+        UINT m_BindlessIndex = UINT_MAX;
+        UINT m_BindlessUniqueness = 0;
     };
 
     template< class TIface >
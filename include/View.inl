@@ -70,7 +70,7 @@ namespace D3D12TranslationLayer
     {
         m_currentBindings.ViewBound(stage, slot);
         m_pResource->ViewBound(this, stage, slot);
-        m_pParent->TransitionResourceForBindings(this);
+        m_pParent->TransitionResourceForChangedBindings(this);
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
@@ -79,7 +79,7 @@ namespace D3D12TranslationLayer
     {
         m_currentBindings.ViewUnbound(stage, slot);
         m_pResource->ViewUnbound(this, stage, slot);
-        m_pParent->TransitionResourceForBindings(this);
+        m_pParent->TransitionResourceForChangedBindings(this);
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
@@ -127,6 +127,7 @@ namespace D3D12TranslationLayer
                 m_pResource->GetUnderlyingResource(),
                 &Desc,
                 m_Descriptor);
+            m_pParent->GetViewAllocator<TIface>().NoteDescriptorRewritten(m_Descriptor);
 
             m_ViewUniqueness = m_pResource->GetUniqueness<TIface>();
             return S_OK;
@@ -149,6 +150,7 @@ namespace D3D12TranslationLayer
             &Desc,
             m_Descriptor
             );
+        m_pParent->GetViewAllocator<UnorderedAccessViewType>().NoteDescriptorRewritten(m_Descriptor);
 
         m_ViewUniqueness = m_pResource->GetUniqueness<UnorderedAccessViewType>();
         return S_OK;
@@ -211,6 +213,10 @@ namespace D3D12TranslationLayer
     template<typename TIface>
     View<TIface>::~View() noexcept
     {
+        if (m_BindlessIndex != CBindlessIndexAllocator::c_InvalidIndex)
+        {
+            m_pParent->m_BindlessViewIndices.Retire(m_BindlessIndex, m_LastUsedCommandListID[(UINT)COMMAND_LIST_TYPE::GRAPHICS]);
+        }
         m_pParent->GetViewAllocator<TIface>().FreeHeapSlot(m_Descriptor, m_DescriptorHeapIndex);
     }
 
@@ -0,0 +1,254 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+
+namespace D3D12TranslationLayer
+{
+
+//----------------------------------------------------------------------------------------------------------------------------------
+BatchCaptureWriter::BatchCaptureWriter(const wchar_t* pFileName, UINT64 MaxFileSize)
+    : m_File(pFileName, MaxFileSize) // throws
+{
+    auto pHeader = static_cast<CaptureFileHeader*>(Reserve(sizeof(CaptureFileHeader)));
+    if (!pHeader)
+    {
+        ThrowFailure(E_INVALIDARG);
+    }
+    pHeader->Magic = CaptureFileHeader::c_Magic;
+    pHeader->Version = CaptureFileHeader::c_Version;
+    pHeader->NumCommandTypes = BatchedContext::c_LastCommand + 1;
+    pHeader->PointerSize = sizeof(void*);
+    pHeader->Reserved = 0;
+    m_File.SetUsedSize(m_WriteOffset);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void* BatchCaptureWriter::Reserve(UINT64 Size) noexcept
+{
+    if (m_bFull || m_File.GetSize() - m_WriteOffset < Size)
+    {
+        m_bFull = true;
+        return nullptr;
+    }
+    void* pPtr = m_File.GetData() + m_WriteOffset;
+    m_WriteOffset += Size;
+    return pPtr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchCaptureWriter::VisitObject(CapturedObjectType Type, void*& pObject)
+{
+    if (!pObject)
+    {
+        return;
+    }
+
+    auto result = m_ObjectIDs.emplace(pObject, m_NextObjectID); // throw( bad_alloc )
+    if (result.second)
+    {
+        ++m_NextObjectID;
+        m_NewObjects.push_back({ result.first->second, Type, 0 }); // throw( bad_alloc )
+    }
+    pObject = reinterpret_cast<void*>(static_cast<UINT_PTR>(result.first->second));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchCaptureWriter::AppendCommands(BatchedContext::BatchStorage const& Commands, UINT& NumCommands) noexcept
+{
+    for (auto segmentIter = Commands.segments_begin();
+         segmentIter != Commands.segments_end();
+         ++segmentIter)
+    {
+        const void* pCommandData = segmentIter->begin();
+        while (pCommandData < segmentIter->end())
+        {
+            const void* pCommandStart = pCommandData;
+            const UINT CmdValue = BatchedContext::VisitCommandObjects(pCommandData, nullptr);
+
+            // Command lists are recorded into their own batches, inline them so the capture is self-contained.
+            if (CmdValue == BatchedContext::CmdExecuteNestedBatch::CmdValue)
+            {
+                if (!AppendCommands(BatchedContext::GetNestedBatchCommands(pCommandStart), NumCommands))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            const UINT64 CommandSize = reinterpret_cast<const BYTE*>(pCommandData) - reinterpret_cast<const BYTE*>(pCommandStart);
+            void* pDest = Reserve(CommandSize);
+            if (!pDest)
+            {
+                return false;
+            }
+            memcpy(pDest, pCommandStart, CommandSize);
+
+            try
+            {
+                const void* pCapturedCommand = pDest;
+                (void)BatchedContext::VisitCommandObjects(pCapturedCommand, this); // throw( bad_alloc )
+            }
+            catch (std::bad_alloc&)
+            {
+                m_bFull = true;
+                return false;
+            }
+            ++NumCommands;
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchCaptureWriter::WriteBatch(BatchedContext::BatchStorage const& Commands,
+                                    BatchedContext::PostBatchActionList const& PostBatchActions,
+                                    uint64_t BatchID) noexcept
+{
+    if (m_bFull)
+    {
+        return false;
+    }
+
+    // However far the batch gets, it's processed and its objects destroyed.
+    auto ForgetDestroyedObjects = MakeScopeExit([&]()
+    {
+        PostBatchActions.ForEachDestroyedObject([this](void* pObject) { m_ObjectIDs.erase(pObject); });
+    });
+
+    // If anything doesn't fit, the file is left ending at the last complete batch.
+    auto pHeader = static_cast<CaptureBatchHeader*>(Reserve(sizeof(CaptureBatchHeader)));
+    if (!pHeader)
+    {
+        return false;
+    }
+    const UINT64 CommandStart = m_WriteOffset;
+
+    UINT NumCommands = 0;
+    if (!AppendCommands(Commands, NumCommands))
+    {
+        return false;
+    }
+
+    pHeader->BatchID = BatchID;
+    pHeader->CommandDataSize = m_WriteOffset - CommandStart;
+    pHeader->NumCommands = NumCommands;
+    pHeader->NumNewObjects = static_cast<UINT>(m_NewObjects.size());
+
+    if (!m_NewObjects.empty())
+    {
+        const UINT64 TableSize = m_NewObjects.size() * sizeof(CapturedObject);
+        void* pTable = Reserve(TableSize);
+        if (!pTable)
+        {
+            return false;
+        }
+        memcpy(pTable, m_NewObjects.data(), TableSize);
+        m_NewObjects.clear();
+    }
+
+    m_File.SetUsedSize(m_WriteOffset);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+BatchReplayer::BatchReplayer(const wchar_t* pFileName, ObjectResolver Resolver)
+    : m_File(pFileName) // throws
+    , m_Resolver(std::move(Resolver))
+{
+    if (m_File.GetSize() < sizeof(CaptureFileHeader))
+    {
+        ThrowFailure(E_INVALIDARG);
+    }
+    auto& Header = *reinterpret_cast<CaptureFileHeader const*>(m_File.GetData());
+    if (Header.Magic != CaptureFileHeader::c_Magic ||
+        Header.Version != CaptureFileHeader::c_Version ||
+        Header.NumCommandTypes != BatchedContext::c_LastCommand + 1 ||
+        Header.PointerSize != sizeof(void*))
+    {
+        ThrowFailure(E_INVALIDARG);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchReplayer::VisitObject(CapturedObjectType, void*& pObject)
+{
+    if (!pObject)
+    {
+        return;
+    }
+
+    auto iter = m_Objects.find(reinterpret_cast<UINT_PTR>(pObject));
+    if (iter == m_Objects.end())
+    {
+        ThrowFailure(E_INVALIDARG);
+    }
+    pObject = iter->second;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchReplayer::ReplayNextBatch(ImmediateContext& ImmCtx)
+{
+    const BYTE* pFileData = m_File.GetData();
+    const UINT64 FileSize = m_File.GetSize();
+    if (FileSize - m_ReadOffset < sizeof(CaptureBatchHeader))
+    {
+        return false;
+    }
+
+    auto& Header = *reinterpret_cast<CaptureBatchHeader const*>(pFileData + m_ReadOffset);
+    const UINT64 CommandStart = m_ReadOffset + sizeof(CaptureBatchHeader);
+    const UINT64 TableSize = UINT64(Header.NumNewObjects) * sizeof(CapturedObject);
+    if (Header.CommandDataSize % sizeof(BatchedContext::BatchPrimitive) != 0 ||
+        FileSize - CommandStart < Header.CommandDataSize ||
+        FileSize - CommandStart - Header.CommandDataSize < TableSize)
+    {
+        ThrowFailure(E_INVALIDARG);
+    }
+
+    // Objects created since the previous batch are resolved up-front, in creation order.
+    auto pNewObjects = reinterpret_cast<CapturedObject const*>(pFileData + CommandStart + Header.CommandDataSize);
+    for (UINT i = 0; i < Header.NumNewObjects; ++i)
+    {
+        if (m_Objects.find(pNewObjects[i].ID) == m_Objects.end())
+        {
+            m_Objects.emplace(pNewObjects[i].ID, m_Resolver(pNewObjects[i].Type, pNewObjects[i].ID)); // throw( bad_alloc )
+        }
+    }
+
+    // The mapping is read-only, so commands are patched in a scratch copy.
+    m_CommandScratch.resize(static_cast<size_t>(Header.CommandDataSize / sizeof(BatchedContext::BatchPrimitive))); // throw( bad_alloc )
+    memcpy(m_CommandScratch.data(), pFileData + CommandStart, static_cast<size_t>(Header.CommandDataSize));
+    m_ReadOffset = CommandStart + Header.CommandDataSize + TableSize;
+
+    auto pDispatchTable = BatchedContext::GetDispatchTable();
+    const void* pCommandData = m_CommandScratch.data();
+    const void* pCommandEnd = m_CommandScratch.data() + m_CommandScratch.size();
+    while (pCommandData < pCommandEnd)
+    {
+        const UINT CmdValue = *reinterpret_cast<UINT const*>(pCommandData);
+        if (CmdValue > BatchedContext::c_LastCommand)
+        {
+            ThrowFailure(E_INVALIDARG);
+        }
+
+        // The upload heap contents referenced by these aren't part of the capture.
+        if (CmdValue == BatchedContext::CmdFinalizeUpdateSubresources::CmdValue ||
+            CmdValue == BatchedContext::CmdFinalizeUpdateSubresourcesWithLocalPlacement::CmdValue)
+        {
+            (void)BatchedContext::VisitCommandObjects(pCommandData, nullptr);
+            ++m_Stats.NumSkippedCommands;
+            continue;
+        }
+
+        const void* pCommandStart = pCommandData;
+        (void)BatchedContext::VisitCommandObjects(pCommandData, this); // throws
+        pDispatchTable[CmdValue](ImmCtx, pCommandStart); // throws
+        assert(pCommandStart == pCommandData);
+        ++m_Stats.NumCommands;
+    }
+
+    ++m_Stats.NumBatches;
+    return true;
+}
+
+}
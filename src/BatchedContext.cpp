@@ -640,6 +640,536 @@ constexpr BatchedContext::DispatcherFunction DispatchArrayImpl<0, Rest...>::valu
 // Instantiate with the correct number of commands. Note that the array generated is inclusive, not exclusive.
 constexpr auto& DispatchArray = DispatchArrayImpl<BatchedContext::c_LastCommand>::value;
 
+//----------------------------------------------------------------------------------------------------------------------------------
+// Visitors for the object pointers embedded in each command, used to capture and replay batches.
+// Ptr on input points to current command, and on output points to next command. A null visitor just skips the command.
+template <typename T> void VisitEntries(CapturedObjectVisitor* pVisitor, T** ppEntries, UINT NumEntries)
+{
+    for (UINT i = 0; pVisitor && i < NumEntries; ++i)
+    {
+        (*pVisitor)(ppEntries[i]);
+    }
+}
+inline void VisitEntries(CapturedObjectVisitor*, const void*, UINT) { }
+
+template <typename TCmd, typename... TMembers>
+void VisitCommand(const void*& pCommandData, CapturedObjectVisitor* pVisitor, TMembers... Members)
+{
+    auto& Data = const_cast<TCmd&>(GetCommandData<TCmd>(pCommandData));
+    if (pVisitor)
+    {
+        ((*pVisitor)(Data.*Members), ...);
+    }
+}
+
+template <typename TCmd, typename TEntry, typename TEntryCountType, typename... TMembers>
+void VisitCommandVariableSize(const void*& pCommandData, CapturedObjectVisitor* pVisitor, UINT TEntryCountType::*NumEntries, TMembers... Members)
+{
+    TEntry const* entries = nullptr;
+    auto& Data = const_cast<TCmd&>(GetCommandDataVariableSize<TCmd>(pCommandData, NumEntries, entries));
+    if (pVisitor)
+    {
+        ((*pVisitor)(Data.*Members), ...);
+    }
+    VisitEntries(pVisitor, const_cast<TEntry*>(entries), Data.*NumEntries);
+}
+
+template <UINT CommandValue> struct CommandVisitor;
+template <> struct CommandVisitor<BatchedContext::CmdSetPipelineState::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetPipelineState>(pCommandData, pVisitor, &BatchedContext::CmdSetPipelineState::pPSO);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDrawInstanced::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdDrawInstanced>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDrawIndexedInstanced::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdDrawIndexedInstanced>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDispatch::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdDispatch>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDrawAuto::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdDrawAuto>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDrawInstancedIndirect::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdDrawInstancedIndirect>(pCommandData, pVisitor, &BatchedContext::CmdDrawInstancedIndirect::pBuffer);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDrawIndexedInstancedIndirect::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdDrawIndexedInstancedIndirect>(pCommandData, pVisitor, &BatchedContext::CmdDrawIndexedInstancedIndirect::pBuffer);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDispatchIndirect::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdDispatchIndirect>(pCommandData, pVisitor, &BatchedContext::CmdDispatchIndirect::pBuffer);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetTopology::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetTopology>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetVertexBuffers::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        struct Temp { BatchedContext::CmdSetVertexBuffers Cmd; Resource* pFirstVB; } const* pTemp = reinterpret_cast<Temp const*>(pCommandData);
+        auto ppVBs = const_cast<Resource**>(&pTemp->pFirstVB);
+        const UINT numVBs = pTemp->Cmd.numVBs;
+        pCommandData = BatchedContext::AlignPtr(reinterpret_cast<UINT const*>(ppVBs + numVBs) + 2 * numVBs);
+        VisitEntries(pVisitor, ppVBs, numVBs);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetIndexBuffer::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetIndexBuffer>(pCommandData, pVisitor, &BatchedContext::CmdSetIndexBuffer::pBuffer);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetShaderResources::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdSetShaderResources, SRV*>(pCommandData, pVisitor, &BatchedContext::CmdSetShaderResources::numSRVs);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetSamplers::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdSetSamplers, Sampler*>(pCommandData, pVisitor, &BatchedContext::CmdSetSamplers::numSamplers);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetConstantBuffers::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        struct Temp { BatchedContext::CmdSetConstantBuffers Cmd; Resource* pFirstCB; } const* pTemp = reinterpret_cast<Temp const*>(pCommandData);
+        auto ppCBs = const_cast<Resource**>(&pTemp->pFirstCB);
+        const UINT numCBs = pTemp->Cmd.numCBs;
+        pCommandData = BatchedContext::AlignPtr(reinterpret_cast<UINT const*>(ppCBs + numCBs) + 2 * numCBs);
+        VisitEntries(pVisitor, ppCBs, numCBs);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetConstantBuffersNullOffsetSize::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdSetConstantBuffersNullOffsetSize, Resource*>(pCommandData, pVisitor, &BatchedContext::CmdSetConstantBuffersNullOffsetSize::numCBs);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetSOBuffers::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetSOBuffers>(pCommandData, pVisitor, &BatchedContext::CmdSetSOBuffers::pBuffers);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetRenderTargets::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetRenderTargets>(pCommandData, pVisitor, &BatchedContext::CmdSetRenderTargets::pRTVs, &BatchedContext::CmdSetRenderTargets::pDSV);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetUAV::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetUAV>(pCommandData, pVisitor, &BatchedContext::CmdSetUAV::pUAV);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetStencilRef::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetStencilRef>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetBlendFactor::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetBlendFactor>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetViewport::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetViewport>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetNumViewports::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetNumViewports>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetScissorRect::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetScissorRect>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetNumScissorRects::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetNumScissorRects>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetScissorEnable::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetScissorEnable>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdClearRenderTargetView::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdClearRenderTargetView, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdClearRenderTargetView::numRects, &BatchedContext::CmdClearRenderTargetView::pView);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdClearDepthStencilView::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdClearDepthStencilView, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdClearDepthStencilView::numRects, &BatchedContext::CmdClearDepthStencilView::pView);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdClearUnorderedAccessViewUint::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdClearUnorderedAccessViewUint, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdClearUnorderedAccessViewUint::numRects, &BatchedContext::CmdClearUnorderedAccessViewUint::pView);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdClearUnorderedAccessViewFloat::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdClearUnorderedAccessViewFloat, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdClearUnorderedAccessViewFloat::numRects, &BatchedContext::CmdClearUnorderedAccessViewFloat::pView);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdClearVideoDecoderOutputView::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdClearVideoDecoderOutputView, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdClearVideoDecoderOutputView::numRects, &BatchedContext::CmdClearVideoDecoderOutputView::pView);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdClearVideoProcessorInputView::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdClearVideoProcessorInputView, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdClearVideoProcessorInputView::numRects, &BatchedContext::CmdClearVideoProcessorInputView::pView);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdClearVideoProcessorOutputView::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdClearVideoProcessorOutputView, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdClearVideoProcessorOutputView::numRects, &BatchedContext::CmdClearVideoProcessorOutputView::pView);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDiscardView::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdDiscardView, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdDiscardView::numRects, &BatchedContext::CmdDiscardView::pView);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdDiscardResource::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdDiscardResource, D3D12_RECT>(pCommandData, pVisitor, &BatchedContext::CmdDiscardResource::numRects, &BatchedContext::CmdDiscardResource::pResource);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdGenMips::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdGenMips>(pCommandData, pVisitor, &BatchedContext::CmdGenMips::pSRV);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdFinalizeUpdateSubresources::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdFinalizeUpdateSubresources>(pCommandData, pVisitor, &BatchedContext::CmdFinalizeUpdateSubresources::pDst);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdFinalizeUpdateSubresourcesWithLocalPlacement::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdFinalizeUpdateSubresourcesWithLocalPlacement>(pCommandData, pVisitor, &BatchedContext::CmdFinalizeUpdateSubresourcesWithLocalPlacement::pDst);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdRename::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdRename>(pCommandData, pVisitor, &BatchedContext::CmdRename::pResource, &BatchedContext::CmdRename::pRenameResource);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdRenameViaCopy::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdRenameViaCopy>(pCommandData, pVisitor, &BatchedContext::CmdRenameViaCopy::pResource, &BatchedContext::CmdRenameViaCopy::pRenameResource);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdQueryBegin::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdQueryBegin>(pCommandData, pVisitor, &BatchedContext::CmdQueryBegin::pQuery);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdQueryEnd::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdQueryEnd>(pCommandData, pVisitor, &BatchedContext::CmdQueryEnd::pQuery);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetPredication::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetPredication>(pCommandData, pVisitor, &BatchedContext::CmdSetPredication::pPredicate);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdResourceCopy::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdResourceCopy>(pCommandData, pVisitor, &BatchedContext::CmdResourceCopy::pDst, &BatchedContext::CmdResourceCopy::pSrc);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdResolveSubresource::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdResolveSubresource>(pCommandData, pVisitor, &BatchedContext::CmdResolveSubresource::pDst, &BatchedContext::CmdResolveSubresource::pSrc);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdResourceCopyRegion::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdResourceCopyRegion>(pCommandData, pVisitor, &BatchedContext::CmdResourceCopyRegion::pDst, &BatchedContext::CmdResourceCopyRegion::pSrc);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetResourceMinLOD::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetResourceMinLOD>(pCommandData, pVisitor, &BatchedContext::CmdSetResourceMinLOD::pResource);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdCopyStructureCount::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdCopyStructureCount>(pCommandData, pVisitor, &BatchedContext::CmdCopyStructureCount::pDst, &BatchedContext::CmdCopyStructureCount::pSrc);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdRotateResourceIdentities::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdRotateResourceIdentities, Resource*>(pCommandData, pVisitor, &BatchedContext::CmdRotateResourceIdentities::NumResources);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdExtension::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        auto pData = const_cast<BatchedContext::CmdExtension*>(reinterpret_cast<BatchedContext::CmdExtension const*>(pCommandData));
+        const void* pExtensionData = BatchedContext::AlignPtr(pData + 1);
+        pCommandData = reinterpret_cast<const BYTE*>(pExtensionData) + pData->DataSize;
+        // Extension data is opaque, so only the extension itself is visited.
+        if (pVisitor)
+        {
+            (*pVisitor)(pData->pExt);
+        }
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetHardwareProtection::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetHardwareProtection>(pCommandData, pVisitor, &BatchedContext::CmdSetHardwareProtection::pResource);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetHardwareProtectionState::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdSetHardwareProtectionState>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdClearState::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdClearState>(pCommandData, pVisitor);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdUpdateTileMappings::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        struct Temp { BatchedContext::CmdUpdateTileMappings Cmd; D3D12_TILED_RESOURCE_COORDINATE Coords; } const* pTemp = reinterpret_cast<Temp const*>(pCommandData);
+        auto pCmd = const_cast<BatchedContext::CmdUpdateTileMappings*>(&pTemp->Cmd);
+        auto pRegions = reinterpret_cast<D3D12_TILE_REGION_SIZE const*>(&pTemp->Coords + pCmd->NumTiledResourceRegions);
+        auto pRangeFlags = reinterpret_cast<ImmediateContext::TILE_RANGE_FLAG const*>(pRegions + pCmd->NumTiledResourceRegions);
+        pCommandData = BatchedContext::AlignPtr(reinterpret_cast<const UINT*>(pRangeFlags + pCmd->NumRanges) + 2 * pCmd->NumRanges);
+        if (pVisitor)
+        {
+            (*pVisitor)(pCmd->pTiledResource);
+            (*pVisitor)(pCmd->pTilePool);
+        }
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdCopyTileMappings::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdCopyTileMappings>(pCommandData, pVisitor, &BatchedContext::CmdCopyTileMappings::pDstTiledResource, &BatchedContext::CmdCopyTileMappings::pSrcTiledResource);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdCopyTiles::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdCopyTiles>(pCommandData, pVisitor, &BatchedContext::CmdCopyTiles::pResource, &BatchedContext::CmdCopyTiles::pBuffer);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdTiledResourceBarrier::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdTiledResourceBarrier>(pCommandData, pVisitor, &BatchedContext::CmdTiledResourceBarrier::pBefore, &BatchedContext::CmdTiledResourceBarrier::pAfter);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdResizeTilePool::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdResizeTilePool>(pCommandData, pVisitor, &BatchedContext::CmdResizeTilePool::pTilePool);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdExecuteNestedBatch::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        // Nested batches are flattened by the capture writer, so they never need their objects visited.
+        assert(!pVisitor);
+        (void)GetCommandData<BatchedContext::CmdExecuteNestedBatch>(pCommandData);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdSetMarker::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdSetMarker, wchar_t>(pCommandData, pVisitor, &BatchedContext::CmdSetMarker::NumChars);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdBeginEvent::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommandVariableSize<BatchedContext::CmdBeginEvent, wchar_t>(pCommandData, pVisitor, &BatchedContext::CmdBeginEvent::NumChars);
+    }
+};
+template <> struct CommandVisitor<BatchedContext::CmdEndEvent::CmdValue>
+{
+    static void Visit(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+    {
+        VisitCommand<BatchedContext::CmdEndEvent>(pCommandData, pVisitor);
+    }
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Same as DispatchArrayImpl, for the visitors.
+template <int N, int... Rest>
+struct VisitArrayImpl
+{
+    static constexpr auto& value = VisitArrayImpl<N - 1, N, Rest...>::value;
+};
+
+template <int... Rest>
+struct VisitArrayImpl<0, Rest...>
+{
+    static constexpr BatchedContext::CommandVisitorFunction value[] = { &CommandVisitor<0>::Visit, &CommandVisitor<Rest>::Visit... };
+};
+
+template <int... Rest>
+constexpr BatchedContext::CommandVisitorFunction VisitArrayImpl<0, Rest...>::value[];
+
+constexpr auto& VisitArray = VisitArrayImpl<BatchedContext::c_LastCommand>::value;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+UINT BatchedContext::VisitCommandObjects(const void*& pCommandData, CapturedObjectVisitor* pVisitor)
+{
+    const UINT CmdValue = *reinterpret_cast<UINT const*>(pCommandData);
+    ASSUME(CmdValue <= c_LastCommand);
+    VisitArray[CmdValue](pCommandData, pVisitor); // throws
+    return CmdValue;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+BatchedContext::DispatcherFunction const* BatchedContext::GetDispatchTable() noexcept
+{
+    return DispatchArray;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+BatchedContext::BatchStorage const& BatchedContext::GetNestedBatchCommands(const void* pCommandData) noexcept
+{
+    auto& Data = GetCommandData<CmdExecuteNestedBatch>(pCommandData);
+    return Data.pBatch->m_BatchCommands;
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 BatchedContext::BatchedContext(ImmediateContext& ImmCtx, CreationArgs args, Callbacks const& callbacks)
     : m_ImmCtx(ImmCtx) // WARNING: ImmCtx might not be initialized yet, avoid any access to it during this constructor.
@@ -647,13 +1177,43 @@ BatchedContext::BatchedContext(ImmediateContext& ImmCtx, CreationArgs args, Call
     , m_DispatchTable(DispatchArray)
     , m_Callbacks(callbacks)
 {
+    if (args.pKickoffPolicy)
+    {
+        m_pKickoffPolicy = args.pKickoffPolicy;
+    }
+    else
+    {
+        if (args.UseAdaptiveBatchKickoff)
+        {
+            m_spOwnedKickoffPolicy.reset(new AdaptiveBatchKickoffPolicy); // throw( bad_alloc )
+        }
+        else
+        {
+            m_spOwnedKickoffPolicy.reset(new FixedBatchKickoffPolicy(c_CommandKickoffMinThreshold, c_MaxOutstandingBatches)); // throw( bad_alloc )
+        }
+        m_pKickoffPolicy = m_spOwnedKickoffPolicy.get();
+    }
+    m_NextKickoffCheckCommandCount = m_pKickoffPolicy->GetKickoffThreshold();
+
+    QueryPerformanceFrequency(&m_TimerFrequency);
+    QueryPerformanceCounter(&m_CreationTime);
+
     if (args.SubmitBatchesToWorkerThread)
     {
-        m_BatchSubmittedSemaphore.m_h = CreateSemaphore(nullptr, 0, c_MaxOutstandingBatches, nullptr);
-        ThrowIfHandleNull(m_BatchSubmittedSemaphore);
+        if (args.UseLockFreeBatchQueue)
+        {
+            m_BatchRing.emplace();
+            m_BatchSubmittedSignal.emplace(); // throw( bad_alloc )
+            m_BatchConsumedSignal.emplace(); // throw( bad_alloc )
+        }
+        else
+        {
+            m_BatchSubmittedSemaphore.m_h = CreateSemaphore(nullptr, 0, c_MaxOutstandingBatches, nullptr);
+            ThrowIfHandleNull(m_BatchSubmittedSemaphore);
 
-        m_BatchConsumedSemaphore.m_h = CreateSemaphore(nullptr, 0, c_MaxOutstandingBatches, nullptr);
-        ThrowIfHandleNull(m_BatchConsumedSemaphore);
+            m_BatchConsumedSemaphore.m_h = CreateSemaphore(nullptr, 0, c_MaxOutstandingBatches, nullptr);
+            ThrowIfHandleNull(m_BatchConsumedSemaphore);
+        }
 
         m_BatchThread.m_h = CreateThread(
             nullptr, 0,
@@ -678,13 +1238,11 @@ BatchedContext::~BatchedContext()
     }
     if (m_CreationArgs.SubmitBatchesToWorkerThread)
     {
-        assert(m_NumOutstandingBatches == 0 && m_QueuedBatches.empty());
+        assert(m_NumOutstandingBatches == 0 && QueuedBatchesEmpty());
 
         // When the batch thread wakes up after consuming a semaphore value, and
         // sees that the queue is empty, it will exit.
-        BOOL value = ReleaseSemaphore(m_BatchSubmittedSemaphore, 1, nullptr);
-        assert(value == TRUE);
-        UNREFERENCED_PARAMETER(value);
+        SignalBatchSubmitted();
 
         // Wait for it to exit.
         WaitForSingleObject(m_BatchThread, INFINITE);
@@ -726,10 +1284,12 @@ void BatchedContext::AddToBatchVariableSize(TCmd const& command, UINT NumEntries
         throw std::bad_alloc();
     }
 
+    const UINT64 SampleStartTime = BeginRecordingSample();
     Temp* pPtr = reinterpret_cast<Temp*>(m_CurrentBatch.append_contiguous_manually(TotalSizeInElements));
     pPtr->CommandValue = TCmd::CmdValue;
     pPtr->Command = command;
     std::copy(entries, entries + NumEntries, &pPtr->FirstEntry);
+    EndRecordingSample(SampleStartTime);
 
     ++m_CurrentCommandCount;
     SubmitBatchIfIdle();
@@ -751,8 +1311,10 @@ void BatchedContext::EmplaceInBatch(Args&&... args)
         throw std::bad_alloc();
     }
 
+    const UINT64 SampleStartTime = BeginRecordingSample();
     void* pPtr = m_CurrentBatch.append_contiguous_manually(CommandSize / sizeof(BatchPrimitive));
     new (pPtr) TCmd(std::forward<Args>(args)...);
+    EndRecordingSample(SampleStartTime);
 
     ++m_CurrentCommandCount;
     SubmitBatchIfIdle();
@@ -761,6 +1323,13 @@ void BatchedContext::EmplaceInBatch(Args&&... args)
 //----------------------------------------------------------------------------------------------------------------------------------
 void TRANSLATION_API BatchedContext::SetPipelineState(PipelineState* pPSO)
 {
+    // Pipeline states can be destroyed from other threads, which clears them from the filter.
+    auto Lock = m_RecordingLock.TakeLock();
+    if (!m_BindFilter.FilterPipelineState(pPSO))
+    {
+        m_NumElidedCommands.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
     AddToBatch(CmdSetPipelineState{ pPSO });
 }
 
@@ -807,15 +1376,161 @@ void TRANSLATION_API BatchedContext::DispatchIndirect(Resource* pBuffer, UINT of
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
-void TRANSLATION_API BatchedContext::IaSetTopology(D3D12_PRIMITIVE_TOPOLOGY topology)
+void TRANSLATION_API BatchedContext::IaSetTopology(D3D12_PRIMITIVE_TOPOLOGY topology)
+{
+    AddToBatch(CmdSetTopology{ topology });
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Narrows a bind of NumEntries slots down to [First, Last), the smallest range containing every slot that
+// differs from the shadowed state. Returns false if no slot differs.
+template <typename TDiffers>
+static bool FindChangedRange(UINT NumEntries, TDiffers&& Differs, UINT& First, UINT& Last) noexcept
+{
+    First = 0;
+    while (First < NumEntries && !Differs(First))
+    {
+        ++First;
+    }
+    if (First == NumEntries)
+    {
+        return false;
+    }
+    Last = NumEntries;
+    while (!Differs(Last - 1))
+    {
+        --Last;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchedBindFilter::FilterPipelineState(PipelineState* pPSO) noexcept
+{
+    if (pPSO == m_pPSO)
+    {
+        return false;
+    }
+    m_pPSO = pPSO;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchedBindFilter::FilterShaderResources(EShaderStage Stage, UINT StartSlot, UINT NumSRVs, SRV* const* ppSRVs, UINT& First, UINT& Last) noexcept
+{
+    SRV** ppShadowSRVs = m_StageState[Stage].m_SRVs + StartSlot;
+    if (!FindChangedRange(NumSRVs, [&](UINT i) { return ppShadowSRVs[i] != ppSRVs[i]; }, First, Last))
+    {
+        return false;
+    }
+    std::copy(ppSRVs + First, ppSRVs + Last, ppShadowSRVs + First);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchedBindFilter::FilterSamplers(EShaderStage Stage, UINT StartSlot, UINT NumSamplers, Sampler* const* ppSamplers, UINT& First, UINT& Last) noexcept
+{
+    Sampler** ppShadowSamplers = m_StageState[Stage].m_Samplers + StartSlot;
+    if (!FindChangedRange(NumSamplers, [&](UINT i) { return ppShadowSamplers[i] != ppSamplers[i]; }, First, Last))
+    {
+        return false;
+    }
+    std::copy(ppSamplers + First, ppSamplers + Last, ppShadowSamplers + First);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchedBindFilter::FilterConstantBuffers(EShaderStage Stage, UINT StartSlot, UINT NumBuffers, Resource* const* ppCBs,
+                                              const UINT* pFirstConstant, const UINT* pNumConstants, UINT& First, UINT& Last) noexcept
+{
+    auto GetFirstConstant = [pFirstConstant](UINT i) { return pFirstConstant ? pFirstConstant[i] : 0; };
+    auto GetNumConstants = [pNumConstants](UINT i) { return pNumConstants ? pNumConstants[i] : D3D10_REQ_CONSTANT_BUFFER_ELEMENT_COUNT; };
+
+    SStageShadowState& Shadow = m_StageState[Stage];
+    if (!FindChangedRange(NumBuffers, [&](UINT i)
+        {
+            UINT slot = StartSlot + i;
+            return Shadow.m_CBs[slot] != ppCBs[i] ||
+                Shadow.m_CBFirstConstant[slot] != GetFirstConstant(i) ||
+                Shadow.m_CBNumConstants[slot] != GetNumConstants(i);
+        }, First, Last))
+    {
+        return false;
+    }
+
+    for (UINT i = First; i < Last; ++i)
+    {
+        UINT slot = StartSlot + i;
+        Shadow.m_CBs[slot] = ppCBs[i];
+        Shadow.m_CBFirstConstant[slot] = GetFirstConstant(i);
+        Shadow.m_CBNumConstants[slot] = GetNumConstants(i);
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchedBindFilter::FilterVertexBuffers(UINT StartSlot, UINT NumBuffers, Resource* const* ppVBs, const UINT* pStrides, const UINT* pOffsets,
+                                            UINT& First, UINT& Last) noexcept
+{
+    if (!FindChangedRange(NumBuffers, [&](UINT i)
+        {
+            UINT slot = StartSlot + i;
+            return m_VBs[slot] != ppVBs[i] || m_VBStrides[slot] != pStrides[i] || m_VBOffsets[slot] != pOffsets[i];
+        }, First, Last))
+    {
+        return false;
+    }
+
+    std::copy(ppVBs + First, ppVBs + Last, m_VBs + StartSlot + First);
+    std::copy(pStrides + First, pStrides + Last, m_VBStrides + StartSlot + First);
+    std::copy(pOffsets + First, pOffsets + Last, m_VBOffsets + StartSlot + First);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchedBindFilter::FilterBlendFactor(const FLOAT BlendFactor[4]) noexcept
+{
+    if (memcmp(BlendFactor, m_BlendFactor, sizeof(m_BlendFactor)) == 0)
+    {
+        return false;
+    }
+    std::copy(BlendFactor, BlendFactor + 4, m_BlendFactor);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedBindFilter::ObjectDestroyed(PipelineState* pPSO) noexcept
+{
+    if (pPSO == m_pPSO)
+    {
+        m_pPSO = nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedBindFilter::Clear() noexcept
 {
-    AddToBatch(CmdSetTopology{ topology });
+    for (auto& Stage : m_StageState)
+    {
+        Stage = {};
+    }
+    ZeroMemory(m_VBs, sizeof(m_VBs));
+    ZeroMemory(m_VBStrides, sizeof(m_VBStrides));
+    ZeroMemory(m_VBOffsets, sizeof(m_VBOffsets));
+    m_pPSO = nullptr;
+    ZeroMemory(m_BlendFactor, sizeof(m_BlendFactor));
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
 void TRANSLATION_API BatchedContext::IaSetVertexBuffers(UINT StartSlot, __in_range(0, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT) UINT NumBuffers, Resource** pVBs, const UINT*pStrides, const UINT* pOffsets)
 {
-    EmplaceInBatch<CmdSetVertexBuffers>(StartSlot, NumBuffers, pVBs, pStrides, pOffsets);
+    UINT First, Last;
+    if (!m_BindFilter.FilterVertexBuffers(StartSlot, NumBuffers, pVBs, pStrides, pOffsets, First, Last))
+    {
+        m_NumElidedCommands.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    EmplaceInBatch<CmdSetVertexBuffers>(StartSlot + First, Last - First, pVBs + First, pStrides + First, pOffsets + First);
 }
 
 BatchedContext::CmdSetVertexBuffers::CmdSetVertexBuffers(UINT _startSlot, UINT _numVBs, Resource* const* _ppVBs, UINT const* _pStrides, UINT const* _pOffsets)
@@ -848,7 +1563,13 @@ void TRANSLATION_API BatchedContext::IaSetIndexBuffer(Resource* pBuffer, DXGI_FO
 template <EShaderStage ShaderStage>
 void TRANSLATION_API BatchedContext::SetShaderResources(UINT StartSlot, __in_range(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT) UINT NumSRVs, SRV* const* ppSRVs)
 {
-    AddToBatchVariableSize(CmdSetShaderResources{ ShaderStage, StartSlot, NumSRVs }, NumSRVs, ppSRVs);
+    UINT First, Last;
+    if (!m_BindFilter.FilterShaderResources(ShaderStage, StartSlot, NumSRVs, ppSRVs, First, Last))
+    {
+        m_NumElidedCommands.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    AddToBatchVariableSize(CmdSetShaderResources{ ShaderStage, StartSlot + First, Last - First }, Last - First, ppSRVs + First);
 }
 template void TRANSLATION_API BatchedContext::SetShaderResources<e_VS>(UINT, UINT, SRV* const*);
 template void TRANSLATION_API BatchedContext::SetShaderResources<e_PS>(UINT, UINT, SRV* const*);
@@ -861,7 +1582,13 @@ template void TRANSLATION_API BatchedContext::SetShaderResources<e_CS>(UINT, UIN
 template <EShaderStage ShaderStage>
 void TRANSLATION_API BatchedContext::SetSamplers(UINT StartSlot, __in_range(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT) UINT NumSamplers, Sampler** ppSamplers)
 {
-    AddToBatchVariableSize(CmdSetSamplers{ ShaderStage, StartSlot, NumSamplers }, NumSamplers, ppSamplers );
+    UINT First, Last;
+    if (!m_BindFilter.FilterSamplers(ShaderStage, StartSlot, NumSamplers, ppSamplers, First, Last))
+    {
+        m_NumElidedCommands.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    AddToBatchVariableSize(CmdSetSamplers{ ShaderStage, StartSlot + First, Last - First }, Last - First, ppSamplers + First);
 }
 template void TRANSLATION_API BatchedContext::SetSamplers<e_VS>(UINT, UINT, Sampler**);
 template void TRANSLATION_API BatchedContext::SetSamplers<e_PS>(UINT, UINT, Sampler**);
@@ -874,13 +1601,20 @@ template void TRANSLATION_API BatchedContext::SetSamplers<e_CS>(UINT, UINT, Samp
 template <EShaderStage ShaderStage>
 void TRANSLATION_API BatchedContext::SetConstantBuffers(UINT StartSlot, __in_range(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_HW_SLOT_COUNT) UINT NumBuffers, Resource** ppCBs, __in_ecount_opt(NumBuffers) CONST UINT* pFirstConstant, __in_ecount_opt(NumBuffers) CONST UINT* pNumConstants)
 {
+    UINT First, Last;
+    if (!m_BindFilter.FilterConstantBuffers(ShaderStage, StartSlot, NumBuffers, ppCBs, pFirstConstant, pNumConstants, First, Last))
+    {
+        m_NumElidedCommands.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
     if (pFirstConstant)
     {
-        EmplaceInBatch<CmdSetConstantBuffers>(ShaderStage, StartSlot, NumBuffers, ppCBs, pFirstConstant, pNumConstants);
+        EmplaceInBatch<CmdSetConstantBuffers>(ShaderStage, StartSlot + First, Last - First, ppCBs + First, pFirstConstant + First, pNumConstants + First);
     }
     else
     {
-        AddToBatchVariableSize(CmdSetConstantBuffersNullOffsetSize{ ShaderStage, StartSlot, NumBuffers }, NumBuffers, ppCBs);
+        AddToBatchVariableSize(CmdSetConstantBuffersNullOffsetSize{ ShaderStage, StartSlot + First, Last - First }, Last - First, ppCBs + First);
     }
 }
 template void TRANSLATION_API BatchedContext::SetConstantBuffers<e_VS>(UINT, UINT, Resource** ppCBs, CONST UINT* pFirstConstant, CONST UINT* pNumConstants);
@@ -960,6 +1694,11 @@ void TRANSLATION_API BatchedContext::OMSetStencilRef(UINT StencilRef)
 //----------------------------------------------------------------------------------------------------------------------------------
 void TRANSLATION_API BatchedContext::OMSetBlendFactor(const FLOAT BlendFactor[4])
 {
+    if (!m_BindFilter.FilterBlendFactor(BlendFactor))
+    {
+        m_NumElidedCommands.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
     AddToBatch(CmdSetBlendFactor{ {BlendFactor[0], BlendFactor[1], BlendFactor[2], BlendFactor[3]} });
 }
 
@@ -1158,7 +1897,7 @@ bool TRANSLATION_API BatchedContext::RenameAndMapBuffer(BatchedResource* pResour
     
         ThrowFailure(pResource->m_LastRenamedResource.Map(0, &ReadRange, &pData));
         AddToBatch(CmdRename{ pResource->m_pResource, cookie.Get() });
-        AddPostBatchFunction([cleanup = cookie.Detach(), &immCtx = GetImmediateContextNoFlush()](){ immCtx.DeleteRenameCookie(cleanup); });
+        AddPostBatchFunction([cleanup = cookie.Detach(), &immCtx = GetImmediateContextNoFlush()](){ immCtx.DeleteRenameCookie(cleanup); }, pRenameResource);
     
         pMappedSubresource->pData = pData;
         pMappedSubresource->RowPitch = pResource->m_pResource->GetSubresourcePlacement(0).Footprint.RowPitch;
@@ -1283,8 +2022,9 @@ void TRANSLATION_API BatchedContext::UnmapAndRenameViaCopy(BatchedResource* pRes
 
         pResource->m_LastRenamedResource.Unmap(0, &WriteRange);
 
-        AddToBatch(CmdRenameViaCopy{ pResource->m_pResource, pResource->m_PendingRenameViaCopyCookie.Get(), pResource->m_DynamicTexturePlaneData.m_DirtyPlaneMask });
-        AddPostBatchFunction([cleanup = pResource->m_PendingRenameViaCopyCookie.Detach(), &immCtx = GetImmediateContextNoFlush()](){ immCtx.DeleteRenameCookie(cleanup); });
+        Resource* pRenameResource = pResource->m_PendingRenameViaCopyCookie.Get();
+        AddToBatch(CmdRenameViaCopy{ pResource->m_pResource, pRenameResource, pResource->m_DynamicTexturePlaneData.m_DirtyPlaneMask });
+        AddPostBatchFunction([cleanup = pResource->m_PendingRenameViaCopyCookie.Detach(), &immCtx = GetImmediateContextNoFlush()](){ immCtx.DeleteRenameCookie(cleanup); }, pRenameResource);
 
         pResource->m_DynamicTexturePlaneData = {};
         pResource->m_LastRenamedResource.Reset();
@@ -1368,19 +2108,14 @@ bool BatchedContext::SyncWithBatch(uint64_t& BatchID, bool DoNotFlush, TFunc&& G
     {
         if (!DoNotFlush)
         {
-            assert(!m_QueuedBatches.empty());
+            assert(!QueuedBatchesEmpty());
 
             // Make sure it's marked to flush when it's done.
-            auto iter = std::find_if(m_QueuedBatches.begin(), m_QueuedBatches.end(),
-                                     [&BatchID](std::unique_ptr<Batch> const& p)
-            {
-                return p->m_BatchID > BatchID;
-            });
-            assert(iter != m_QueuedBatches.begin());
-            --iter;
+            Batch* pBatch = FindQueuedBatch(BatchID);
+            assert(pBatch);
 
             // We don't know what command list types to use on this timeline, so just request all.
-            (*iter)->m_FlushRequestedMask |= COMMAND_LIST_TYPE_ALL_MASK;
+            pBatch->m_FlushRequestedMask |= COMMAND_LIST_TYPE_ALL_MASK;
         }
         return false;
     }
@@ -1406,13 +2141,13 @@ bool BatchedContext::SyncWithBatch(uint64_t& BatchID, bool DoNotFlush, TFunc&& G
         if (FlushMask != 0)
         {
             // Not checking thread idle bit as we're already under the lock.
-            if (m_QueuedBatches.empty())
+            if (QueuedBatchesEmpty())
             {
                 m_ImmCtx.PrepForCommandQueueSync(FlushMask);
             }
             else
             {
-                m_QueuedBatches.front()->m_FlushRequestedMask |= FlushMask;
+                GetFrontQueuedBatch()->m_FlushRequestedMask |= FlushMask;
             }
             return false;
         }
@@ -1551,6 +2286,8 @@ void BatchedContext::ClearStateImpl()
     m_NumViewports = 0;
     ZeroMemory(m_Scissors, sizeof(m_Scissors));
     ZeroMemory(m_Viewports, sizeof(m_Viewports));
+
+    m_BindFilter.Clear();
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -1730,13 +2467,15 @@ bool TRANSLATION_API BatchedContext::ProcessBatch()
         auto Lock = m_RecordingLock.TakeLock();
         auto FunctionExit = MakeScopeExit([this]()
         {
-            for (auto& fn : m_PostBatchFunctions)
+            m_PostBatchActions.Execute();
+
+            if (m_CurrentCommandCount)
             {
-                fn();
+                m_NumBatchesSubmitted.fetch_add(1, std::memory_order_relaxed);
+                m_NumCommandsSubmitted.fetch_add(m_CurrentCommandCount, std::memory_order_relaxed);
             }
-            m_PostBatchFunctions.clear();
-
             m_CurrentCommandCount = 0;
+            (void)TakeRecordingTicks();
             m_PendingDestructionMemorySize = 0;
             m_CompletedBatchID = m_RecordingBatchID;
 
@@ -1748,7 +2487,8 @@ bool TRANSLATION_API BatchedContext::ProcessBatch()
             }
         });
 
-        bool bRet = !m_CurrentBatch.empty() || !m_PostBatchFunctions.empty();
+        bool bRet = !m_CurrentBatch.empty() || !m_PostBatchActions.empty();
+        CaptureBatch(m_CurrentBatch, m_PostBatchActions, m_RecordingBatchID);
         ProcessBatchWork(m_CurrentBatch); // throws
         return bRet;
     }
@@ -1774,27 +2514,37 @@ std::unique_ptr<BatchedContext::Batch> BatchedContext::FinishBatch(bool bFlushIm
 {
     assert(!IsBatchThread());
     BatchStorage NewBatch(m_BatchStorageAllocator);
-    std::vector<std::function<void()>> NewPostBatchFunctions;
+    PostBatchActionList NewPostBatchActions(std::nothrow, m_BatchStorageAllocator);
     std::unique_ptr<Batch> pRet;
 
     // Synchronize with threads recording to the batch
     {
         auto Lock = m_RecordingLock.TakeLock();
-        if (m_CurrentBatch.empty() && m_PostBatchFunctions.empty())
+        const bool bHasPostBatchActions = !m_PostBatchActions.empty();
+        if (m_CurrentBatch.empty() && !bHasPostBatchActions)
         {
             return nullptr;
         }
-        std::swap(m_CurrentBatch, NewBatch);
-        std::swap(m_PostBatchFunctions, NewPostBatchFunctions);
 
-        // Synchronize with the worker thread potentially retiring batches
+        // Anything that can throw happens before recorded work is moved out, so a failure leaves it in place.
         {
+            // Synchronize with the worker thread potentially retiring batches
             auto SubmissionLock = m_SubmissionLock.TakeLock();
-            pRet = GetIdleBatch();
+            pRet = GetIdleBatch(); // throw( bad_alloc )
         }
+        if (bHasPostBatchActions)
+        {
+            // Batches without actions don't hold on to a page for them.
+            PostBatchActionList FreshPostBatchActions(m_BatchStorageAllocator); // throw( bad_alloc )
+            m_PostBatchActions.swap(FreshPostBatchActions);
+            NewPostBatchActions.swap(FreshPostBatchActions);
+        }
+        std::swap(m_CurrentBatch, NewBatch);
 
-        pRet->PrepareToSubmit(std::move(NewBatch), std::move(NewPostBatchFunctions), m_RecordingBatchID, m_CurrentCommandCount, bFlushImmCtxAfterBatch);
+        pRet->PrepareToSubmit(std::move(NewBatch), std::move(NewPostBatchActions), m_RecordingBatchID, m_CurrentCommandCount, bFlushImmCtxAfterBatch);
+        pRet->m_RecordingTicks = TakeRecordingTicks();
         m_CurrentCommandCount = 0;
+        m_NextKickoffCheckCommandCount = m_pKickoffPolicy->GetKickoffThreshold();
         m_PendingDestructionMemorySize = 0;
 
         ++m_RecordingBatchID;
@@ -1824,7 +2574,7 @@ void TRANSLATION_API BatchedContext::SubmitCommandListBatch(Batch* pBatch)
     constexpr uint64_t GenerationIDMask = 0xffffffff00000000ull;
     m_RecordingBatchID = (m_RecordingBatchID & GenerationIDMask) + (1ull << 32ull) + 1;
 
-    SubmitBatchIfIdle(pBatch->m_NumCommands >= c_CommandKickoffMinThreshold);
+    SubmitBatchIfIdle(pBatch->m_NumCommands >= m_pKickoffPolicy->GetKickoffThreshold());
 
     // It's guaranteed that a command list both begins and ends with a ClearState command, so we'll
     // clear our own tracked state here.
@@ -1835,10 +2585,7 @@ void TRANSLATION_API BatchedContext::SubmitCommandListBatch(Batch* pBatch)
 void TRANSLATION_API BatchedContext::RetireBatch(std::unique_ptr<Batch> pBatch)
 {
     // Note: Only used for command list batches - implicit batches have slightly different retiring semantics
-    for (auto& fn : pBatch->m_PostBatchFunctions)
-    {
-        fn();
-    }
+    pBatch->m_PostBatchActions.Execute();
 
     auto Lock = m_SubmissionLock.TakeLock();
 
@@ -1857,47 +2604,87 @@ bool TRANSLATION_API BatchedContext::SubmitBatch(bool bFlushImmCtxAfterBatch)
         return ProcessBatch();
     }
 
+    // The lock-free ring only supports a single producer, so keep batches from
+    // concurrent submitters ordered by holding the recording lock throughout.
+    std::unique_lock<std::recursive_mutex> ProducerLock;
+    if (m_BatchRing)
+    {
+        ProducerLock = m_RecordingLock.TakeLock();
+    }
+
     auto pBatch = FinishBatch(bFlushImmCtxAfterBatch);
     if (!pBatch)
     {
         return false;
     }
 
-    {
-        auto Lock = m_SubmissionLock.TakeLock();
-        m_QueuedBatches.emplace_back(std::move(pBatch));
-    }
+    const UINT NumCommands = pBatch->m_NumCommands;
+    const UINT64 RecordingTicks = pBatch->m_RecordingTicks;
+    EnqueueBatch(std::move(pBatch));
 
     {
         auto Lock = m_RecordingLock.TakeLock();
 
         // Check if there's room in the semaphores.
         assert(m_NumOutstandingBatches <= c_MaxOutstandingBatches);
-        if (m_NumOutstandingBatches == c_MaxOutstandingBatches)
+        const UINT MaxOutstandingBatches = GetMaxOutstandingBatches();
+        while (m_NumOutstandingBatches >= MaxOutstandingBatches)
         {
-            WaitForSingleBatch(INFINITE);
-            assert(m_NumOutstandingBatches < c_MaxOutstandingBatches);
+            WaitForSingleBatchAndRecordStall();
         }
+        assert(m_NumOutstandingBatches < c_MaxOutstandingBatches);
 
         // Wake up the batch thread
-        BOOL value = ReleaseSemaphore(m_BatchSubmittedSemaphore, 1, nullptr);
-        assert(value == TRUE);
-        UNREFERENCED_PARAMETER(value);
+        SignalBatchSubmitted();
 
         ++m_NumOutstandingBatches;
+
+        m_pKickoffPolicy->OnBatchSubmitted(NumCommands, m_NumOutstandingBatches, RecordingTicks);
+
+        m_NumBatchesSubmitted.fetch_add(1, std::memory_order_relaxed);
+        m_NumCommandsSubmitted.fetch_add(NumCommands, std::memory_order_relaxed);
     }
     return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------
+UINT64 BatchedContext::TakeRecordingTicks() noexcept
+{
+    const UINT64 RecordingTicks = m_NumRecordingSamples ?
+        m_SampledRecordingTicks * m_NumRecordedCommands / m_NumRecordingSamples : 0;
+    m_NumRecordedCommands = 0;
+    m_NumRecordingSamples = 0;
+    m_SampledRecordingTicks = 0;
+    return RecordingTicks;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+UINT BatchedContext::GetMaxOutstandingBatches()
+{
+    return std::clamp(m_pKickoffPolicy->GetMaxOutstandingBatches(), 1u, c_MaxOutstandingBatches);
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 void TRANSLATION_API BatchedContext::SubmitBatchIfIdle(bool bSkipFrequencyCheck)
 {
     assert(!IsBatchThread());
     assert(m_CurrentCommandCount > 0);
-    if (m_CreationArgs.SubmitBatchesToWorkerThread && // Don't do work on the app thread.
-        (bSkipFrequencyCheck ||
-            m_CurrentCommandCount % c_CommandKickoffMinThreshold == 0) && // Avoid checking for idle all the time, it's not free.
-        IsBatchThreadIdle())
+    if (!m_CreationArgs.SubmitBatchesToWorkerThread) // Don't do work on the app thread.
+    {
+        return;
+    }
+
+    if (!bSkipFrequencyCheck)
+    {
+        // Avoid checking for idle all the time, it's not free.
+        if (m_CurrentCommandCount < m_NextKickoffCheckCommandCount)
+        {
+            return;
+        }
+        m_NextKickoffCheckCommandCount = m_CurrentCommandCount + m_pKickoffPolicy->GetKickoffThreshold();
+    }
+
+    if (IsBatchThreadIdle())
     {
         SubmitBatch();
     }
@@ -1911,11 +2698,21 @@ bool BatchedContext::WaitForBatchThreadIdle()
     while (m_NumOutstandingBatches)
     {
         bRet = true;
-        WaitForSingleBatch(INFINITE);
+        WaitForSingleBatchAndRecordStall();
     }
     return bRet;
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::WaitForSingleBatchAndRecordStall()
+{
+    LARGE_INTEGER StartTime, EndTime;
+    QueryPerformanceCounter(&StartTime);
+    WaitForSingleBatch(INFINITE);
+    QueryPerformanceCounter(&EndTime);
+    m_RecorderStallTicks.fetch_add(EndTime.QuadPart - StartTime.QuadPart, std::memory_order_relaxed);
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 bool BatchedContext::IsBatchThreadIdle()
 {
@@ -1928,7 +2725,7 @@ bool BatchedContext::IsBatchThreadIdle()
 bool BatchedContext::WaitForSingleBatch(DWORD timeout)
 {
     assert(!IsBatchThread());
-    if (WaitForSingleObject(m_BatchConsumedSemaphore, timeout) == WAIT_OBJECT_0)
+    if (WaitForBatchConsumed(timeout))
     {
         --m_NumOutstandingBatches;
         if (m_bFlushPendingCallback.exchange(false))
@@ -1951,6 +2748,44 @@ void BatchedContext::ProcessBatchImpl(Batch* pBatchToProcess)
     catch (std::bad_alloc&) { m_Callbacks.ThreadErrorCallback(E_OUTOFMEMORY); }
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------
+void TRANSLATION_API BatchedContext::BeginCapture(const wchar_t* pFileName, UINT64 MaxFileSize)
+{
+    assert(m_CreationArgs.pParentContext == nullptr);
+    std::unique_ptr<BatchCaptureWriter> spWriter(new BatchCaptureWriter(pFileName, MaxFileSize)); // throws
+
+    std::lock_guard<std::mutex> Lock(m_CaptureLock);
+    m_spCaptureWriter = std::move(spWriter);
+    m_bCapturing.store(true, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void TRANSLATION_API BatchedContext::EndCapture()
+{
+    // Make sure everything recorded so far makes it into the capture.
+    ProcessBatch();
+
+    std::lock_guard<std::mutex> Lock(m_CaptureLock);
+    m_bCapturing.store(false, std::memory_order_relaxed);
+    m_spCaptureWriter.reset();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::CaptureBatch(BatchStorage const& batch, PostBatchActionList const& PostBatchActions, uint64_t BatchID) noexcept
+{
+    if (!m_bCapturing.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> Lock(m_CaptureLock);
+    if (m_spCaptureWriter)
+    {
+        // Once the file fills up, further batches are dropped until EndCapture.
+        (void)m_spCaptureWriter->WriteBatch(batch, PostBatchActions, BatchID);
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 void BatchedContext::BatchThread()
 {
@@ -1965,16 +2800,14 @@ void BatchedContext::BatchThread()
     while (true)
     {
         // Wait for work
-        WaitForSingleObject(m_BatchSubmittedSemaphore, INFINITE);
+        WaitForBatchSubmitted();
 
         // Figure out what we're supposed to be working on
         Batch* pBatchToProcess = nullptr;
         {
-            auto Lock = m_SubmissionLock.TakeLock();
-            if (!m_QueuedBatches.empty())
-            {
-                pBatchToProcess = m_QueuedBatches.front().get();
-            }
+            // The ring's front entry can only be retired by this thread, so it can be read without the lock.
+            auto Lock = m_BatchRing ? std::unique_lock<std::mutex>() : m_SubmissionLock.TakeLock();
+            pBatchToProcess = GetFrontQueuedBatch();
         }
 
         // Semaphore was signaled but there's no work to be done, exit thread.
@@ -1984,13 +2817,15 @@ void BatchedContext::BatchThread()
         }
 
         // Do the work
+        LARGE_INTEGER StartTime, EndTime;
+        QueryPerformanceCounter(&StartTime);
+        CaptureBatch(pBatchToProcess->m_BatchCommands, pBatchToProcess->m_PostBatchActions, pBatchToProcess->m_BatchID);
         ProcessBatchImpl(pBatchToProcess);
+        QueryPerformanceCounter(&EndTime);
+        m_pKickoffPolicy->OnBatchProcessed(pBatchToProcess->m_NumCommands, EndTime.QuadPart - StartTime.QuadPart);
 
         // Retire the batch
-        for (auto& fn : pBatchToProcess->m_PostBatchFunctions)
-        {
-            fn();
-        }
+        pBatchToProcess->m_PostBatchActions.Execute();
 
         {
             auto Lock = m_SubmissionLock.TakeLock();
@@ -1999,18 +2834,155 @@ void BatchedContext::BatchThread()
             m_CompletedBatchID = pBatchToProcess->m_BatchID;
 
             pBatchToProcess->Retire(m_FreePages);
-            m_FreeBatches.emplace_back(std::move(m_QueuedBatches.front()));
-            m_QueuedBatches.pop_front();
+            RetireFrontQueuedBatch();
 
             m_ImmCtx.Flush(FlushRequestedMask);
         }
 
+        SignalBatchConsumed();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::EnqueueBatch(std::unique_ptr<Batch> pBatch)
+{
+    if (m_BatchRing)
+    {
+        // Capacity is guaranteed by the outstanding batch limit, see c_BatchRingSize.
+        bool bPushed = m_BatchRing->TryPush(pBatch.get());
+        assert(bPushed);
+        UNREFERENCED_PARAMETER(bPushed);
+        pBatch.release();
+    }
+    else
+    {
+        auto Lock = m_SubmissionLock.TakeLock();
+        m_QueuedBatches.emplace_back(std::move(pBatch));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+BatchedContext::Batch* BatchedContext::GetFrontQueuedBatch()
+{
+    // Assumed m_SubmissionLock is held, unless called from the batch thread in lock-free mode.
+    if (m_BatchRing)
+    {
+        Batch* const* ppBatch = m_BatchRing->Front();
+        return ppBatch ? *ppBatch : nullptr;
+    }
+    return m_QueuedBatches.empty() ? nullptr : m_QueuedBatches.front().get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+BatchedContext::Batch* BatchedContext::FindQueuedBatch(uint64_t BatchID)
+{
+    // Assumed m_SubmissionLock is held.
+    // Returns the last batch that was submitted at or before the requested ID.
+    Batch* pFound = nullptr;
+    if (m_BatchRing)
+    {
+        for (UINT64 i = 0, Size = m_BatchRing->size(); i < Size; ++i)
+        {
+            Batch* pBatch = (*m_BatchRing)[i];
+            if (pBatch->m_BatchID > BatchID)
+            {
+                break;
+            }
+            pFound = pBatch;
+        }
+    }
+    else
+    {
+        for (auto& pBatch : m_QueuedBatches)
+        {
+            if (pBatch->m_BatchID > BatchID)
+            {
+                break;
+            }
+            pFound = pBatch.get();
+        }
+    }
+    return pFound;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchedContext::QueuedBatchesEmpty()
+{
+    return m_BatchRing ? m_BatchRing->empty() : m_QueuedBatches.empty();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::RetireFrontQueuedBatch()
+{
+    // Assumed m_SubmissionLock is held.
+    assert(IsBatchThread());
+    if (m_BatchRing)
+    {
+        m_FreeBatches.emplace_back(*m_BatchRing->Front());
+        m_BatchRing->Pop();
+    }
+    else
+    {
+        m_FreeBatches.emplace_back(std::move(m_QueuedBatches.front()));
+        m_QueuedBatches.pop_front();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::SignalBatchSubmitted()
+{
+    if (m_BatchSubmittedSignal)
+    {
+        m_BatchSubmittedSignal->Release();
+    }
+    else
+    {
+        BOOL value = ReleaseSemaphore(m_BatchSubmittedSemaphore, 1, nullptr);
+        assert(value == TRUE);
+        UNREFERENCED_PARAMETER(value);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::WaitForBatchSubmitted()
+{
+    assert(IsBatchThread());
+    if (m_BatchSubmittedSignal)
+    {
+        (void)m_BatchSubmittedSignal->Wait(INFINITE);
+    }
+    else
+    {
+        WaitForSingleObject(m_BatchSubmittedSemaphore, INFINITE);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::SignalBatchConsumed()
+{
+    assert(IsBatchThread());
+    if (m_BatchConsumedSignal)
+    {
+        m_BatchConsumedSignal->Release();
+    }
+    else
+    {
         BOOL value = ReleaseSemaphore(m_BatchConsumedSemaphore, 1, nullptr);
         assert(value == TRUE);
         UNREFERENCED_PARAMETER(value);
     }
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------
+bool BatchedContext::WaitForBatchConsumed(DWORD timeout)
+{
+    if (m_BatchConsumedSignal)
+    {
+        return m_BatchConsumedSignal->Wait(timeout);
+    }
+    return WaitForSingleObject(m_BatchConsumedSemaphore, timeout) == WAIT_OBJECT_0;
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 bool BatchedContext::IsBatchThread()
 {
@@ -2034,25 +3006,125 @@ void TRANSLATION_API BatchedContext::PostSubmit()
     }
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------
+BatchedContext::BatchStatistics TRANSLATION_API BatchedContext::GetBatchStatistics() const
+{
+    LARGE_INTEGER CurrentTime;
+    QueryPerformanceCounter(&CurrentTime);
+
+    BatchStatistics Stats = {};
+    Stats.NumBatchesSubmitted = m_NumBatchesSubmitted.load(std::memory_order_relaxed);
+    Stats.NumCommandsSubmitted = m_NumCommandsSubmitted.load(std::memory_order_relaxed);
+    Stats.RecorderStallTicks = m_RecorderStallTicks.load(std::memory_order_relaxed);
+    Stats.NumElidedCommands = m_NumElidedCommands.load(std::memory_order_relaxed);
+    Stats.ElapsedTicks = CurrentTime.QuadPart - m_CreationTime.QuadPart;
+    Stats.TicksPerSecond = m_TimerFrequency.QuadPart;
+    return Stats;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+AdaptiveBatchKickoffPolicy::AdaptiveBatchKickoffPolicy() noexcept
+{
+    LARGE_INTEGER Frequency;
+    QueryPerformanceFrequency(&Frequency);
+    m_TicksPerSecond = double(Frequency.QuadPart);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void AdaptiveBatchKickoffPolicy::OnBatchProcessed(UINT NumCommands, UINT64 ProcessingTicks) noexcept
+{
+    if (NumCommands == 0)
+    {
+        return;
+    }
+    const double Sample = double(ProcessingTicks) / NumCommands;
+    const double Previous = m_DispatchTicksPerCommand.load(std::memory_order_relaxed);
+    m_DispatchTicksPerCommand.store(Previous == 0.0 ? Sample : Previous + (Sample - Previous) * c_EWMAWeight, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void AdaptiveBatchKickoffPolicy::OnBatchSubmitted(UINT NumCommands, UINT NumOutstandingBatches, UINT64 RecordingTicks) noexcept
+{
+    if (NumCommands == 0)
+    {
+        return;
+    }
+    auto UpdateAverage = [](double& Average, double Sample)
+    {
+        Average = Average == 0.0 ? Sample : Average + (Sample - Average) * c_EWMAWeight;
+    };
+    if (RecordingTicks)
+    {
+        UpdateAverage(m_RecordingTicksPerCommand, double(RecordingTicks) / NumCommands);
+    }
+    UpdateAverage(m_CommandsPerBatch, double(NumCommands));
+    UpdateAverage(m_OutstandingBatches, double(NumOutstandingBatches));
+
+    const double DispatchTicksPerCommand = m_DispatchTicksPerCommand.load(std::memory_order_relaxed);
+    if (DispatchTicksPerCommand == 0.0)
+    {
+        // Nothing has been measured on the worker yet.
+        return;
+    }
+
+    // Hand the worker enough work per check to amortize waking it up, measured in whichever
+    // thread is the bottleneck. If batches are backing up, the worker is already busy, so
+    // checking for idle more often just wastes time on the recording thread.
+    const double CommandTicks = max(DispatchTicksPerCommand, m_RecordingTicksPerCommand);
+    const double Threshold = (c_TargetBatchSeconds * m_TicksPerSecond / CommandTicks) * (1.0 + m_OutstandingBatches);
+    m_KickoffThreshold = UINT(std::clamp(Threshold, double(c_MinKickoffThreshold), double(c_MaxKickoffThreshold)));
+
+    // Bound the amount of queued-up work, so that the app can't get too far ahead of the worker.
+    const double BatchTicks = DispatchTicksPerCommand * m_CommandsPerBatch;
+    const double MaxOutstanding = c_MaxQueuedSeconds * m_TicksPerSecond / BatchTicks;
+    m_MaxOutstandingBatches = UINT(std::clamp(MaxOutstanding, double(c_MinOutstandingBatches), double(c_MaxOutstandingBatches)));
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 void* FreePageContainer::RemovePage() noexcept
 {
-    auto Lock = m_CS.TakeLock();
-    if (m_FreePageHead != nullptr)
+    PSLIST_ENTRY pEntry = InterlockedPopEntrySList(&m_FreePages);
+    if (pEntry == nullptr)
     {
-        void* pPage = m_FreePageHead;
-        m_FreePageHead = *reinterpret_cast<void**>(pPage);
-        return pPage;
+        m_LowWaterMark.store(0, std::memory_order_relaxed);
+        return nullptr;
     }
-    return nullptr;
+
+    const USHORT Depth = QueryDepthSList(&m_FreePages);
+    USHORT LowWaterMark = m_LowWaterMark.load(std::memory_order_relaxed);
+    while (Depth < LowWaterMark &&
+           !m_LowWaterMark.compare_exchange_weak(LowWaterMark, Depth, std::memory_order_relaxed))
+    {
+    }
+    return pEntry;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void FreePageContainer::Trim() noexcept
+{
+    // Pages below the low-water mark weren't needed at any point during the last period. Racing with concurrent
+    // pops or pushes only makes this approximate; the next period corrects for it.
+    for (USHORT i = m_LowWaterMark.load(std::memory_order_relaxed); i > 0; --i)
+    {
+        PSLIST_ENTRY pEntry = InterlockedPopEntrySList(&m_FreePages);
+        if (pEntry == nullptr)
+        {
+            break;
+        }
+        operator delete(pEntry);
+    }
+    m_LowWaterMark.store(QueryDepthSList(&m_FreePages), std::memory_order_relaxed);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
 FreePageContainer::~FreePageContainer()
 {
-    while (void* pPage = RemovePage())
+    PSLIST_ENTRY pEntry = InterlockedFlushSList(&m_FreePages);
+    while (pEntry != nullptr)
     {
-        operator delete(pPage);
+        PSLIST_ENTRY pNext = pEntry->Next;
+        operator delete(pEntry);
+        pEntry = pNext;
     }
 }
 
@@ -2067,29 +3139,112 @@ void* BatchedContext::BatchStorageAllocator::operator()(bool bAllocSuccess) noex
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
-void FreePageContainer::LockedAdder::AddPage(void* pPage) noexcept
+void FreePageContainer::Adder::AddPage(void* pPage) noexcept
+{
+    // Pages come from operator new, which satisfies the interlocked list's alignment requirement.
+    assert(reinterpret_cast<uintptr_t>(pPage) % MEMORY_ALLOCATION_ALIGNMENT == 0);
+    auto pEntry = static_cast<PSLIST_ENTRY>(pPage);
+    pEntry->Next = m_pFirst;
+    m_pFirst = pEntry;
+    if (m_pLast == nullptr)
+    {
+        m_pLast = pEntry;
+    }
+    ++m_Count;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+FreePageContainer::Adder::~Adder()
+{
+    if (m_Count == 0)
+    {
+        return;
+    }
+    InterlockedPushListSListEx(&m_Container.m_FreePages, m_pFirst, m_pLast, m_Count);
+
+    if (m_Container.m_NumChainsAdded.fetch_add(1, std::memory_order_relaxed) % c_TrimPeriod == c_TrimPeriod - 1)
+    {
+        m_Container.Trim();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::PostBatchActionList::Execute()
+{
+    try
+    {
+        for (auto segmentIter = m_Storage.segments_begin();
+             segmentIter != m_Storage.segments_end();
+             ++segmentIter)
+        {
+            BatchPrimitive* pEntry = segmentIter->begin();
+            while (pEntry < segmentIter->end())
+            {
+                auto pHeader = reinterpret_cast<ActionHeader*>(pEntry);
+                pEntry = reinterpret_cast<BatchPrimitive*>(pHeader + 1) + pHeader->PayloadSize;
+                pHeader->pfnDestroy = nullptr;
+                pHeader->pfnInvoke(pHeader + 1);
+            }
+        }
+    }
+    catch (...)
+    {
+        // Ensure the list is emptied, without leaking what the remaining actions own.
+        DestroyPending();
+        throw;
+    }
+    m_Storage.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::PostBatchActionList::DestroyPending() noexcept
+{
+    // Walk every segment rather than up to the last one, since moved-from storage doesn't have a valid last segment.
+    for (auto& segment : m_Storage.m_segments)
+    {
+        BatchPrimitive* pEntry = segment.begin();
+        while (pEntry < segment.end())
+        {
+            auto pHeader = reinterpret_cast<ActionHeader*>(pEntry);
+            pEntry = reinterpret_cast<BatchPrimitive*>(pHeader + 1) + pHeader->PayloadSize;
+            if (pHeader->pfnDestroy)
+            {
+                pHeader->pfnDestroy(pHeader + 1);
+            }
+        }
+    }
+    m_Storage.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void BatchedContext::PostBatchActionList::ReturnPages(FreePageContainer::Adder& Adder) noexcept
 {
-    *reinterpret_cast<void**>(pPage) = m_FreePageHead;
-    m_FreePageHead = pPage;
+    DestroyPending();
+    for (auto& segment : m_Storage.m_segments)
+    {
+        Adder.AddPage(segment.begin());
+    }
+    m_Storage.m_segments.clear();
+    m_Storage.m_last_segment = m_Storage.m_segments.begin();
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
 void BatchedContext::Batch::Retire(FreePageContainer& FreePages) noexcept
 {
-    FreePageContainer::LockedAdder Adder(FreePages);
+    FreePageContainer::Adder Adder(FreePages);
     for (auto& segment : m_BatchCommands.m_segments)
     {
         Adder.AddPage(segment.begin());
     }
     m_BatchCommands.m_segments.clear();
-    m_PostBatchFunctions.clear();
+    m_PostBatchActions.ReturnPages(Adder);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
-void BatchedContext::Batch::PrepareToSubmit(BatchStorage BatchCommands, std::vector<std::function<void()>> PostBatchFunctions, uint64_t BatchID, UINT NumCommands, bool bFlushImmCtxAfterBatch)
+void BatchedContext::Batch::PrepareToSubmit(BatchStorage BatchCommands, PostBatchActionList PostBatchActions, uint64_t BatchID, UINT NumCommands, bool bFlushImmCtxAfterBatch)
 {
     m_BatchCommands = std::move(BatchCommands);
-    m_PostBatchFunctions = std::move(PostBatchFunctions);
+    m_PostBatchActions = std::move(PostBatchActions);
     m_BatchID = BatchID;
     m_NumCommands = NumCommands;
     m_FlushRequestedMask = bFlushImmCtxAfterBatch ? COMMAND_LIST_TYPE_ALL_MASK : 0;
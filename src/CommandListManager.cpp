@@ -88,6 +88,75 @@ namespace D3D12TranslationLayer
         m_UploadHeapSpaceAllocated += heapSize;
     }
 
+    //----------------------------------------------------------------------------------------------------------------------------------
+    bool CommandListManager::TryAllocateFromUploadRing(UINT64 Size, _Out_ UINT64& Offset) noexcept
+    {
+        Offset = 0;
+        if (Size == 0 || Size > cUploadRingMaxAllocationSize)
+        {
+            return false;
+        }
+
+        if (!m_pUploadRing)
+        {
+            try
+            {
+                m_pUploadRing = m_pParent->AllocateHeap(cUploadRingSize, 0, AllocatorHeapType::Upload); // throw( _com_error )
+            }
+            catch (_com_error&)
+            {
+                return false;
+            }
+            m_UploadRingLedger = CUploadRingLedger(UINT32(cUploadRingSize / cUploadRingAlignment));
+            m_UploadRingSize.store(cUploadRingSize, std::memory_order_relaxed);
+        }
+
+        const UINT32 NumItems = UINT32(Align(Size, cUploadRingAlignment) / cUploadRingAlignment);
+        UINT32 ItemOffset = 0;
+        if (FAILED(m_UploadRingLedger.Allocate(NumItems, m_commandListID, ItemOffset)))
+        {
+            // Reclaim space from command lists which completed since the last submit, rather than waiting on the GPU.
+            ReclaimUploadRingSpace();
+            if (FAILED(m_UploadRingLedger.Allocate(NumItems, m_commandListID, ItemOffset)))
+            {
+                m_NumUploadRingFullFallbacks.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        m_NumUploadRingAllocations.fetch_add(1, std::memory_order_relaxed);
+        m_UploadRingBytesInUse.store(UINT64(m_UploadRingLedger.GetNumItemsInUse()) * cUploadRingAlignment, std::memory_order_relaxed);
+        Offset = UINT64(ItemOffset) * cUploadRingAlignment;
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void CommandListManager::ReleaseUploadRingAllocation(UINT64 FenceValue) noexcept
+    {
+        m_UploadRingLedger.Release(FenceValue);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void CommandListManager::ReclaimUploadRingSpace() noexcept
+    {
+        if (m_pUploadRing)
+        {
+            m_UploadRingLedger.Deallocate(GetCompletedFenceValue());
+            m_UploadRingBytesInUse.store(UINT64(m_UploadRingLedger.GetNumItemsInUse()) * cUploadRingAlignment, std::memory_order_relaxed);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    UploadRingStatistics CommandListManager::GetUploadRingStatistics() const noexcept
+    {
+        UploadRingStatistics Stats = {};
+        Stats.SizeInBytes = m_UploadRingSize.load(std::memory_order_relaxed);
+        Stats.BytesInUse = m_UploadRingBytesInUse.load(std::memory_order_relaxed);
+        Stats.NumAllocations = m_NumUploadRingAllocations.load(std::memory_order_relaxed);
+        Stats.NumRingFullFallbacks = m_NumUploadRingFullFallbacks.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
     void CommandListManager::SubmitCommandListIfNeeded()
     {
         // TODO: Heuristics below haven't been heavily profiled, we'll likely want to re-visit and tune
@@ -178,6 +247,15 @@ namespace D3D12TranslationLayer
                 m_pCommandAllocator.get(),
                 nullptr,
                 IID_PPV_ARGS(&m_pCommandList));
+            if (SUCCEEDED(hr) && m_type == COMMAND_LIST_TYPE::GRAPHICS && m_pParent->m_ResourceStateManager.UsesEnhancedBarriers())
+            {
+                hr = m_pCommandList->QueryInterface(&m_pGraphicsCommandList7);
+                if (FAILED(hr))
+                {
+                    // Don't recycle a command list which barriers can't be recorded on.
+                    m_pCommandList = nullptr;
+                }
+            }
         }
         ThrowFailure(hr); // throw( _com_error )
 
@@ -231,6 +309,12 @@ namespace D3D12TranslationLayer
             pAsync->Suspend();
         }
 
+        if (m_type == COMMAND_LIST_TYPE::GRAPHICS)
+        {
+            // Split barriers can't span command lists
+            m_pParent->m_ResourceStateManager.EndAllSplitBarriers(); // throws
+        }
+
         CloseCommandList(m_pCommandList.get()); // throws
 
         m_pResidencySet->Close();
@@ -266,6 +350,9 @@ namespace D3D12TranslationLayer
             m_pParent->m_StatesToReassert |= e_ReassertOnNewCommandList;
         }
         m_pParent->PostSubmitNotification();
+
+        // Reported once the submit is complete, so that this command list manager is left in a usable state
+        ThrowFailure(m_pParent->GetResidencyManager().TakeMakeResidentError()); // throws
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
@@ -386,6 +473,8 @@ namespace D3D12TranslationLayer
     void CommandListManager::SubmitFence() noexcept
     {
         m_pCommandQueue->Signal(m_Fence.Get(), m_commandListID);
+        // Uploads which haven't been copied out of the ring yet will be by the next command list.
+        m_UploadRingLedger.Submitted(m_commandListID);
         IncrementFence();
         m_bNeedSubmitFence = false;
     }
@@ -540,6 +629,11 @@ namespace D3D12TranslationLayer
     {
         ResetCommandListTrackingData();
         m_pCommandList = nullptr;
+        m_pGraphicsCommandList7 = nullptr;
+        if (m_type == COMMAND_LIST_TYPE::GRAPHICS)
+        {
+            m_pParent->m_ResourceStateManager.DiscardSplitBarriers();
+        }
 
         m_pParent->GetResidencyManager().DiscardResidencySet(m_pResidencySet.get());
     }
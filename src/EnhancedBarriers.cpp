@@ -0,0 +1,330 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+
+namespace D3D12TranslationLayer
+{
+
+static const D3D12_RESOURCE_STATES g_cWriteStates =
+    D3D12_RESOURCE_STATE_RENDER_TARGET |
+    D3D12_RESOURCE_STATE_UNORDERED_ACCESS |
+    D3D12_RESOURCE_STATE_DEPTH_WRITE |
+    D3D12_RESOURCE_STATE_STREAM_OUT |
+    D3D12_RESOURCE_STATE_COPY_DEST |
+    D3D12_RESOURCE_STATE_RESOLVE_DEST |
+    D3D12_RESOURCE_STATE_VIDEO_DECODE_WRITE |
+    D3D12_RESOURCE_STATE_VIDEO_PROCESS_WRITE |
+    D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE;
+
+struct LegacyStateScope
+{
+    D3D12_RESOURCE_STATES State;
+    D3D12_BARRIER_SYNC Sync;
+    D3D12_BARRIER_ACCESS Access;
+};
+
+// Sync is the narrowest scope covering every operation the translation layer performs on a resource in that state.
+static const LegacyStateScope g_cLegacyStateScopes[] =
+{
+    { D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, D3D12_BARRIER_SYNC_ALL_SHADING, D3D12_BARRIER_ACCESS_VERTEX_BUFFER | D3D12_BARRIER_ACCESS_CONSTANT_BUFFER },
+    { D3D12_RESOURCE_STATE_INDEX_BUFFER, D3D12_BARRIER_SYNC_INDEX_INPUT, D3D12_BARRIER_ACCESS_INDEX_BUFFER },
+    { D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_BARRIER_SYNC_RENDER_TARGET, D3D12_BARRIER_ACCESS_RENDER_TARGET },
+    { D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_BARRIER_SYNC_ALL_SHADING | D3D12_BARRIER_SYNC_CLEAR_UNORDERED_ACCESS_VIEW, D3D12_BARRIER_ACCESS_UNORDERED_ACCESS },
+    { D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_BARRIER_SYNC_DEPTH_STENCIL, D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE },
+    { D3D12_RESOURCE_STATE_DEPTH_READ, D3D12_BARRIER_SYNC_DEPTH_STENCIL, D3D12_BARRIER_ACCESS_DEPTH_STENCIL_READ },
+    { D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_BARRIER_SYNC_NON_PIXEL_SHADING, D3D12_BARRIER_ACCESS_SHADER_RESOURCE },
+    { D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_BARRIER_SYNC_PIXEL_SHADING, D3D12_BARRIER_ACCESS_SHADER_RESOURCE },
+    { D3D12_RESOURCE_STATE_STREAM_OUT, D3D12_BARRIER_SYNC_VERTEX_SHADING, D3D12_BARRIER_ACCESS_STREAM_OUTPUT },
+    // Also PREDICATION, which shares its bits with INDIRECT_ARGUMENT in all three enums
+    { D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT, D3D12_BARRIER_SYNC_EXECUTE_INDIRECT, D3D12_BARRIER_ACCESS_INDIRECT_ARGUMENT },
+    { D3D12_RESOURCE_STATE_COPY_DEST, D3D12_BARRIER_SYNC_COPY, D3D12_BARRIER_ACCESS_COPY_DEST },
+    { D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_BARRIER_SYNC_COPY, D3D12_BARRIER_ACCESS_COPY_SOURCE },
+    { D3D12_RESOURCE_STATE_RESOLVE_DEST, D3D12_BARRIER_SYNC_RESOLVE, D3D12_BARRIER_ACCESS_RESOLVE_DEST },
+    { D3D12_RESOURCE_STATE_RESOLVE_SOURCE, D3D12_BARRIER_SYNC_RESOLVE, D3D12_BARRIER_ACCESS_RESOLVE_SOURCE },
+    { D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE, D3D12_BARRIER_SYNC_PIXEL_SHADING, D3D12_BARRIER_ACCESS_SHADING_RATE_SOURCE },
+    { D3D12_RESOURCE_STATE_VIDEO_DECODE_READ, D3D12_BARRIER_SYNC_VIDEO_DECODE, D3D12_BARRIER_ACCESS_VIDEO_DECODE_READ },
+    { D3D12_RESOURCE_STATE_VIDEO_DECODE_WRITE, D3D12_BARRIER_SYNC_VIDEO_DECODE, D3D12_BARRIER_ACCESS_VIDEO_DECODE_WRITE },
+    { D3D12_RESOURCE_STATE_VIDEO_PROCESS_READ, D3D12_BARRIER_SYNC_VIDEO_PROCESS, D3D12_BARRIER_ACCESS_VIDEO_PROCESS_READ },
+    { D3D12_RESOURCE_STATE_VIDEO_PROCESS_WRITE, D3D12_BARRIER_SYNC_VIDEO_PROCESS, D3D12_BARRIER_ACCESS_VIDEO_PROCESS_WRITE },
+    { D3D12_RESOURCE_STATE_VIDEO_ENCODE_READ, D3D12_BARRIER_SYNC_VIDEO_ENCODE, D3D12_BARRIER_ACCESS_VIDEO_ENCODE_READ },
+    { D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE, D3D12_BARRIER_SYNC_VIDEO_ENCODE, D3D12_BARRIER_ACCESS_VIDEO_ENCODE_WRITE },
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// The layout a legacy barrier leaves a texture in.
+static D3D12_BARRIER_LAYOUT GetLegacyLayout(D3D12_RESOURCE_STATES State) noexcept
+{
+    switch (State)
+    {
+    case D3D12_RESOURCE_STATE_COMMON: return D3D12_BARRIER_LAYOUT_COMMON;
+    case D3D12_RESOURCE_STATE_RENDER_TARGET: return D3D12_BARRIER_LAYOUT_RENDER_TARGET;
+    case D3D12_RESOURCE_STATE_UNORDERED_ACCESS: return D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS;
+    case D3D12_RESOURCE_STATE_DEPTH_WRITE: return D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE;
+    case D3D12_RESOURCE_STATE_COPY_DEST: return D3D12_BARRIER_LAYOUT_COPY_DEST;
+    case D3D12_RESOURCE_STATE_COPY_SOURCE: return D3D12_BARRIER_LAYOUT_COPY_SOURCE;
+    case D3D12_RESOURCE_STATE_RESOLVE_DEST: return D3D12_BARRIER_LAYOUT_RESOLVE_DEST;
+    case D3D12_RESOURCE_STATE_RESOLVE_SOURCE: return D3D12_BARRIER_LAYOUT_RESOLVE_SOURCE;
+    case D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE: return D3D12_BARRIER_LAYOUT_SHADING_RATE_SOURCE;
+    case D3D12_RESOURCE_STATE_VIDEO_DECODE_READ: return D3D12_BARRIER_LAYOUT_VIDEO_DECODE_READ;
+    case D3D12_RESOURCE_STATE_VIDEO_DECODE_WRITE: return D3D12_BARRIER_LAYOUT_VIDEO_DECODE_WRITE;
+    case D3D12_RESOURCE_STATE_VIDEO_PROCESS_READ: return D3D12_BARRIER_LAYOUT_VIDEO_PROCESS_READ;
+    case D3D12_RESOURCE_STATE_VIDEO_PROCESS_WRITE: return D3D12_BARRIER_LAYOUT_VIDEO_PROCESS_WRITE;
+    case D3D12_RESOURCE_STATE_VIDEO_ENCODE_READ: return D3D12_BARRIER_LAYOUT_VIDEO_ENCODE_READ;
+    case D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE: return D3D12_BARRIER_LAYOUT_VIDEO_ENCODE_WRITE;
+    }
+
+    // Combinations of read states
+    assert((State & g_cWriteStates) == 0);
+    if (State & D3D12_RESOURCE_STATE_DEPTH_READ)
+    {
+        return D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ;
+    }
+    if ((State & ~D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE) == 0)
+    {
+        return D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+    }
+    return D3D12_BARRIER_LAYOUT_GENERIC_READ;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Stages which are included in a broader one.
+static D3D12_BARRIER_SYNC ExpandSync(D3D12_BARRIER_SYNC Sync) noexcept
+{
+    if (Sync & D3D12_BARRIER_SYNC_ALL_SHADING)
+    {
+        Sync |= D3D12_BARRIER_SYNC_VERTEX_SHADING | D3D12_BARRIER_SYNC_PIXEL_SHADING |
+            D3D12_BARRIER_SYNC_NON_PIXEL_SHADING | D3D12_BARRIER_SYNC_COMPUTE_SHADING;
+    }
+    return Sync;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Reads which are added to ones that are already in flight don't need a barrier if the one which made the earlier reads wait
+// for the last write also covers the stages and caches of the new ones. The earlier reads remain covered by the next barrier,
+// which is built from the later, larger state.
+static bool IsRedundantTransition(D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After,
+                                  EnhancedBarrierScope const& BeforeScope, EnhancedBarrierScope const& AfterScope) noexcept
+{
+    return Before != D3D12_RESOURCE_STATE_COMMON &&
+        (Before & g_cWriteStates) == 0 &&
+        (After & g_cWriteStates) == 0 &&
+        (Before & ~After) == 0 &&
+        BeforeScope.Layout == AfterScope.Layout &&
+        (AfterScope.Sync & ~ExpandSync(BeforeScope.Sync)) == 0 &&
+        (AfterScope.Access & ~BeforeScope.Access) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+EnhancedBarrierScope EnhancedBarrierTranslator::GetScope(D3D12_RESOURCE_STATES State, EnhancedBarrierResourceType Type) noexcept
+{
+    EnhancedBarrierScope Scope = { D3D12_BARRIER_SYNC_NONE, D3D12_BARRIER_ACCESS_COMMON, D3D12_BARRIER_LAYOUT_UNDEFINED };
+    switch (Type)
+    {
+    case EnhancedBarrierResourceType::Texture: Scope.Layout = GetLegacyLayout(State); break;
+    case EnhancedBarrierResourceType::SimultaneousAccessTexture: Scope.Layout = D3D12_BARRIER_LAYOUT_COMMON; break;
+    default: break;
+    }
+
+    D3D12_RESOURCE_STATES Remaining = State;
+    for (auto& Mapping : g_cLegacyStateScopes)
+    {
+        if (State & Mapping.State)
+        {
+            Scope.Sync |= Mapping.Sync;
+            Scope.Access |= Mapping.Access;
+            Remaining &= ~Mapping.State;
+        }
+    }
+
+    // COMMON covers any access, e.g. from the CPU or other queues. Anything else the state manager shouldn't
+    // generate is treated the same way.
+    assert(Remaining == D3D12_RESOURCE_STATE_COMMON);
+    if (State == D3D12_RESOURCE_STATE_COMMON || Remaining != D3D12_RESOURCE_STATE_COMMON)
+    {
+        Scope.Sync = D3D12_BARRIER_SYNC_ALL;
+        Scope.Access = D3D12_BARRIER_ACCESS_COMMON;
+    }
+    return Scope;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+EnhancedBarrierResourceType EnhancedBarrierTranslator::GetResourceType(ID3D12Resource* pResource) noexcept
+{
+    D3D12_RESOURCE_DESC Desc = pResource->GetDesc();
+    if (Desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        return EnhancedBarrierResourceType::Buffer;
+    }
+    return (Desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_SIMULTANEOUS_ACCESS) ?
+        EnhancedBarrierResourceType::SimultaneousAccessTexture : EnhancedBarrierResourceType::Texture;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+ID3D12Resource* EnhancedBarrierTranslator::GetResource(D3D12_RESOURCE_BARRIER const& Barrier) noexcept
+{
+    switch (Barrier.Type)
+    {
+    case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION: return Barrier.Transition.pResource;
+    case D3D12_RESOURCE_BARRIER_TYPE_UAV: return Barrier.UAV.pResource;
+    default: return nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void EnhancedBarrierTranslator::Reset() noexcept
+{
+    m_GlobalBarriers.clear();
+    m_TextureBarriers.clear();
+    m_BufferBarriers.clear();
+    m_Groups.clear();
+    m_NumElided = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void EnhancedBarrierTranslator::AddToGroup(D3D12_BARRIER_TYPE Type) noexcept(false)
+{
+    if (m_Groups.empty() || m_Groups.back().Type != Type)
+    {
+        D3D12_BARRIER_GROUP Group = {};
+        Group.Type = Type;
+        m_Groups.push_back(Group); // throw( bad_alloc )
+    }
+    ++m_Groups.back().NumBarriers;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void EnhancedBarrierTranslator::ResolveGroups() noexcept
+{
+    UINT NumGlobal = 0, NumTexture = 0, NumBuffer = 0;
+    for (auto& Group : m_Groups)
+    {
+        switch (Group.Type)
+        {
+        case D3D12_BARRIER_TYPE_GLOBAL:
+            Group.pGlobalBarriers = m_GlobalBarriers.data() + NumGlobal;
+            NumGlobal += Group.NumBarriers;
+            break;
+        case D3D12_BARRIER_TYPE_TEXTURE:
+            Group.pTextureBarriers = m_TextureBarriers.data() + NumTexture;
+            NumTexture += Group.NumBarriers;
+            break;
+        case D3D12_BARRIER_TYPE_BUFFER:
+            Group.pBufferBarriers = m_BufferBarriers.data() + NumBuffer;
+            NumBuffer += Group.NumBarriers;
+            break;
+        }
+    }
+    assert(NumGlobal == m_GlobalBarriers.size() && NumTexture == m_TextureBarriers.size() && NumBuffer == m_BufferBarriers.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void EnhancedBarrierTranslator::AddBarrier(D3D12_RESOURCE_BARRIER const& Barrier, EnhancedBarrierResourceType Type) noexcept(false)
+{
+    switch (Barrier.Type)
+    {
+    case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+        AddTransition(Barrier, Type); // throw( bad_alloc )
+        break;
+
+    case D3D12_RESOURCE_BARRIER_TYPE_UAV:
+        AddUAVBarrier(Barrier, Type); // throw( bad_alloc )
+        break;
+
+    default:
+    {
+        // Aliasing barriers aren't generated by the state manager. Fully serialize rather than guess at the accesses involved.
+        assert(false);
+        D3D12_GLOBAL_BARRIER Global = { D3D12_BARRIER_SYNC_ALL, D3D12_BARRIER_SYNC_ALL, D3D12_BARRIER_ACCESS_COMMON, D3D12_BARRIER_ACCESS_COMMON };
+        m_GlobalBarriers.push_back(Global); // throw( bad_alloc )
+        AddToGroup(D3D12_BARRIER_TYPE_GLOBAL); // throw( bad_alloc )
+        break;
+    }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void EnhancedBarrierTranslator::AddTransition(D3D12_RESOURCE_BARRIER const& Barrier, EnhancedBarrierResourceType Type) noexcept(false)
+{
+    auto& Transition = Barrier.Transition;
+    EnhancedBarrierScope Before = GetScope(Transition.StateBefore, Type);
+    EnhancedBarrierScope After = GetScope(Transition.StateAfter, Type);
+
+    if (Barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+        IsRedundantTransition(Transition.StateBefore, Transition.StateAfter, Before, After))
+    {
+        ++m_NumElided;
+        return;
+    }
+
+    // The halves of a split transition are tied together by the SPLIT sync on the side of the other half.
+    if (Barrier.Flags & D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY)
+    {
+        After.Sync = D3D12_BARRIER_SYNC_SPLIT;
+    }
+    else if (Barrier.Flags & D3D12_RESOURCE_BARRIER_FLAG_END_ONLY)
+    {
+        Before.Sync = D3D12_BARRIER_SYNC_SPLIT;
+    }
+
+    if (Type == EnhancedBarrierResourceType::Buffer)
+    {
+        D3D12_BUFFER_BARRIER BufferBarrier = {};
+        BufferBarrier.SyncBefore = Before.Sync;
+        BufferBarrier.SyncAfter = After.Sync;
+        BufferBarrier.AccessBefore = Before.Access;
+        BufferBarrier.AccessAfter = After.Access;
+        BufferBarrier.pResource = Transition.pResource;
+        BufferBarrier.Offset = 0;
+        BufferBarrier.Size = UINT64_MAX;
+        m_BufferBarriers.push_back(BufferBarrier); // throw( bad_alloc )
+        AddToGroup(D3D12_BARRIER_TYPE_BUFFER); // throw( bad_alloc )
+    }
+    else
+    {
+        D3D12_TEXTURE_BARRIER TextureBarrier = {};
+        TextureBarrier.SyncBefore = Before.Sync;
+        TextureBarrier.SyncAfter = After.Sync;
+        TextureBarrier.AccessBefore = Before.Access;
+        TextureBarrier.AccessAfter = After.Access;
+        TextureBarrier.LayoutBefore = Before.Layout;
+        TextureBarrier.LayoutAfter = After.Layout;
+        TextureBarrier.pResource = Transition.pResource;
+        // With NumMipLevels of 0, IndexOrFirstMipLevel is a subresource index, and ALL_SUBRESOURCES has the same value in both.
+        TextureBarrier.Subresources.IndexOrFirstMipLevel = Transition.Subresource;
+        TextureBarrier.Flags = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+        m_TextureBarriers.push_back(TextureBarrier); // throw( bad_alloc )
+        AddToGroup(D3D12_BARRIER_TYPE_TEXTURE); // throw( bad_alloc )
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void EnhancedBarrierTranslator::AddUAVBarrier(D3D12_RESOURCE_BARRIER const& Barrier, EnhancedBarrierResourceType Type) noexcept(false)
+{
+    EnhancedBarrierScope Scope = GetScope(D3D12_RESOURCE_STATE_UNORDERED_ACCESS, Type);
+    if (Barrier.UAV.pResource == nullptr)
+    {
+        D3D12_GLOBAL_BARRIER Global = { Scope.Sync, Scope.Sync, Scope.Access, Scope.Access };
+        m_GlobalBarriers.push_back(Global); // throw( bad_alloc )
+        AddToGroup(D3D12_BARRIER_TYPE_GLOBAL); // throw( bad_alloc )
+    }
+    else if (Type == EnhancedBarrierResourceType::Buffer)
+    {
+        D3D12_BUFFER_BARRIER BufferBarrier = { Scope.Sync, Scope.Sync, Scope.Access, Scope.Access, Barrier.UAV.pResource, 0, UINT64_MAX };
+        m_BufferBarriers.push_back(BufferBarrier); // throw( bad_alloc )
+        AddToGroup(D3D12_BARRIER_TYPE_BUFFER); // throw( bad_alloc )
+    }
+    else
+    {
+        D3D12_TEXTURE_BARRIER TextureBarrier = {};
+        TextureBarrier.SyncBefore = TextureBarrier.SyncAfter = Scope.Sync;
+        TextureBarrier.AccessBefore = TextureBarrier.AccessAfter = Scope.Access;
+        TextureBarrier.LayoutBefore = TextureBarrier.LayoutAfter = Scope.Layout;
+        TextureBarrier.pResource = Barrier.UAV.pResource;
+        TextureBarrier.Subresources.IndexOrFirstMipLevel = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        TextureBarrier.Flags = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+        m_TextureBarriers.push_back(TextureBarrier); // throw( bad_alloc )
+        AddToGroup(D3D12_BARRIER_TYPE_TEXTURE); // throw( bad_alloc )
+    }
+}
+
+}
@@ -63,6 +63,8 @@ ImmediateContext::ImmediateContext(UINT nodeIndex, D3D12_FEATURE_DATA_D3D12_OPTI
     , m_RTVAllocator(pDevice, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 64, args.CreatesAndDestroysAreMultithreaded, 1 << nodeIndex)
     , m_DSVAllocator(pDevice, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 64, args.CreatesAndDestroysAreMultithreaded, 1 << nodeIndex)
     , m_SamplerAllocator(pDevice, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, 64, args.CreatesAndDestroysAreMultithreaded, 1 << nodeIndex)
+    , m_BindlessViewIndices(args.CreatesAndDestroysAreMultithreaded)
+    , m_BindlessSamplerIndices(args.CreatesAndDestroysAreMultithreaded)
     , m_ResourceCache(*this)
     , m_DirtyStates(e_DirtyOnFirstCommandList)
     , m_StatesToReassert(e_ReassertOnNewCommandList)
@@ -129,6 +131,8 @@ ImmediateContext::ImmediateContext(UINT nodeIndex, D3D12_FEATURE_DATA_D3D12_OPTI
     if (m_CreationArgs.UseThreadpoolForPSOCreates)
     {
         m_spPSOCompilationThreadPool.reset(new CThreadPool);
+        // Queued compiles are speculative, GetForUse compiles anything a draw needs itself if no worker has started it yet.
+        m_spPSOCompilationThreadPool->SetDefaultPriority(CThreadPool::EPriority::Low);
     }
 
     if (m_CreationArgs.CreatesAndDestroysAreMultithreaded)
@@ -166,22 +170,75 @@ ImmediateContext::ImmediateContext(UINT nodeIndex, D3D12_FEATURE_DATA_D3D12_OPTI
 
     m_residencyManager.Initialize(nodeIndex, m_pDXCoreAdapter.get(), m_pDXGIAdapter.get());
 
+    if (m_CreationArgs.PipelineStateCacheFileName)
+    {
+        PipelineStateCacheDeviceIdentity CacheDevice = {};
+        if (m_pDXCoreAdapter)
+        {
+            DXCoreHardwareID HardwareID = {};
+            if (SUCCEEDED(m_pDXCoreAdapter->GetProperty(DXCoreAdapterProperty::HardwareID, &HardwareID)))
+            {
+                CacheDevice.VendorID = HardwareID.vendorID;
+                CacheDevice.DeviceID = HardwareID.deviceID;
+            }
+            (void)m_pDXCoreAdapter->GetProperty(DXCoreAdapterProperty::DriverVersion, &CacheDevice.DriverVersion);
+        }
+        else
+        {
+            DXGI_ADAPTER_DESC1 AdapterDesc;
+            if (SUCCEEDED(m_pDXGIAdapter->GetDesc1(&AdapterDesc)))
+            {
+                CacheDevice.VendorID = AdapterDesc.VendorId;
+                CacheDevice.DeviceID = AdapterDesc.DeviceId;
+            }
+            LARGE_INTEGER UMDVersion;
+            if (SUCCEEDED(m_pDXGIAdapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &UMDVersion)))
+            {
+                CacheDevice.DriverVersion = UMDVersion.QuadPart;
+            }
+        }
+        if (CacheDevice.IsKnown())
+        {
+            m_spPipelineStateCache.reset(new PipelineStateCache(m_CreationArgs.PipelineStateCacheFileName, m_CreationArgs.MaxPipelineStateCacheSize, CacheDevice)); // throw( bad_alloc )
+        }
+    }
+
     m_UAVDeclScratch.reserve(D3D11_1_UAV_SLOT_COUNT); // throw( bad_alloc )
-    m_vUAVBarriers.reserve(D3D11_1_UAV_SLOT_COUNT); // throw( bad_alloc )
+    m_ResourceStateManager.SetUseSplitBarriers(m_CreationArgs.UseSplitBarriers);
+    if (m_CreationArgs.UseEnhancedBarriers && !ComputeOnly())
+    {
+        D3D12_FEATURE_DATA_D3D12_OPTIONS12 Options12 = {};
+        m_ResourceStateManager.SetUseEnhancedBarriers(
+            SUCCEEDED(pDevice->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &Options12, sizeof(Options12))) &&
+            Options12.EnhancedBarriersSupported);
+    }
+
+#ifdef USE_BINDLESS_DESCRIPTORS
+    if (m_CreationArgs.UseBindlessDescriptors && !ComputeOnly() && m_caps.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_3)
+    {
+        // Shaders need to index ResourceDescriptorHeap/SamplerDescriptorHeap directly
+        D3D12_FEATURE_DATA_SHADER_MODEL ShaderModel = { D3D_SHADER_MODEL_6_6 };
+        m_bUseBindlessDescriptors =
+            SUCCEEDED(pDevice->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &ShaderModel, sizeof(ShaderModel))) &&
+            ShaderModel.HighestShaderModel >= D3D_SHADER_MODEL_6_6;
+    }
+#endif
 
     m_ViewHeap.m_MaxHeapSize = min((DWORD) D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_1, m_CreationArgs.MaxSRVHeapSize);
     if (m_ViewHeap.m_MaxHeapSize == 0)
         m_ViewHeap.m_MaxHeapSize = D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_1;
-    const UINT32 viewHeapStartingCount = m_bUseRingBufferDescriptorHeaps ? 4096 : m_ViewHeap.m_MaxHeapSize;
-    m_ViewHeap.m_DescriptorRingBuffer = CFencedRingBuffer(viewHeapStartingCount);
+    if (m_bUseBindlessDescriptors)
+        m_ViewHeap.m_MaxHeapSize = D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_2;
+    const UINT32 viewHeapStartingCount = (m_bUseRingBufferDescriptorHeaps && !m_bUseBindlessDescriptors) ? 4096 : m_ViewHeap.m_MaxHeapSize;
+    m_ViewHeap.m_DescriptorRingBuffer = CFencedRingBuffer(m_bUseBindlessDescriptors ? c_BindlessViewRingSize : viewHeapStartingCount);
     m_ViewHeap.m_Desc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
     m_ViewHeap.m_Desc.NumDescriptors = viewHeapStartingCount;
     m_ViewHeap.m_Desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
     m_ViewHeap.m_Desc.NodeMask = GetNodeMask();
 
     m_SamplerHeap.m_MaxHeapSize = D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE;
-    const UINT32 samplerHeapStartingCount = m_bUseRingBufferDescriptorHeaps ? 512 : m_SamplerHeap.m_MaxHeapSize;
-    m_SamplerHeap.m_DescriptorRingBuffer = CFencedRingBuffer(samplerHeapStartingCount);
+    const UINT32 samplerHeapStartingCount = (m_bUseRingBufferDescriptorHeaps && !m_bUseBindlessDescriptors) ? 512 : m_SamplerHeap.m_MaxHeapSize;
+    m_SamplerHeap.m_DescriptorRingBuffer = CFencedRingBuffer(m_bUseBindlessDescriptors ? c_BindlessSamplerRingSize : samplerHeapStartingCount);
     m_SamplerHeap.m_Desc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER;
     m_SamplerHeap.m_Desc.NumDescriptors = samplerHeapStartingCount;
     m_SamplerHeap.m_Desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
@@ -209,6 +266,12 @@ ImmediateContext::ImmediateContext(UINT nodeIndex, D3D12_FEATURE_DATA_D3D12_OPTI
         m_SamplerHeap.m_BitsToSetOnNewHeap = e_SamplersDirty;
     }
 
+    if (m_bUseBindlessDescriptors)
+    {
+        m_BindlessViewIndices.Initialize(c_BindlessViewRingSize, m_ViewHeap.m_Desc.NumDescriptors - c_BindlessViewRingSize);
+        m_BindlessSamplerIndices.Initialize(c_BindlessSamplerRingSize, m_SamplerHeap.m_Desc.NumDescriptors - c_BindlessSamplerRingSize);
+    }
+
     for (UINT i = 0; i <= (UINT)RESOURCE_DIMENSION::TEXTURECUBEARRAY; ++i)
     {
         auto ResourceDimension = ComputeOnly() ? RESOURCE_DIMENSION::BUFFER : (RESOURCE_DIMENSION)i;
@@ -370,6 +433,17 @@ ImmediateContext::ImmediateContext(UINT nodeIndex, D3D12_FEATURE_DATA_D3D12_OPTI
 
     m_CommandLists[(UINT)COMMAND_LIST_TYPE::GRAPHICS].reset(new CommandListManager(this, pQueue, COMMAND_LIST_TYPE::GRAPHICS)); // throw( bad_alloc )
     m_CommandLists[(UINT)COMMAND_LIST_TYPE::GRAPHICS]->InitCommandList();
+
+    if (m_bUseBindlessDescriptors)
+    {
+        // Unbound slots index the null descriptors. Dimensions without a null view of their own can't be declared.
+        for (UINT i = 0; i <= (UINT)RESOURCE_DIMENSION::TEXTURECUBEARRAY; ++i)
+        {
+            m_NullSRVBindlessIndices[i] = m_NullSRVs[i].ptr ? CopyToBindlessIndex(m_BindlessViewIndices, m_ViewHeap, m_NullSRVs[i]) : m_NullSRVBindlessIndices[0];
+            m_NullUAVBindlessIndices[i] = m_NullUAVs[i].ptr ? CopyToBindlessIndex(m_BindlessViewIndices, m_ViewHeap, m_NullUAVs[i]) : m_NullUAVBindlessIndices[0];
+        }
+        m_NullSamplerBindlessIndex = CopyToBindlessIndex(m_BindlessSamplerIndices, m_SamplerHeap, m_NullSampler);
+    }
 }
 
 bool ImmediateContext::Shutdown() noexcept
@@ -523,6 +597,15 @@ bool ImmediateContext::TrimResourcePools()
     m_ReadbackBufferPool.Trim(GetCompletedFenceValue(CommandListType(AllocatorHeapType::Readback)));
     m_DecoderBufferPool.Trim(GetCompletedFenceValue(CommandListType(AllocatorHeapType::Decoder)));
 
+    if (m_CreationArgs.TrimDescriptorHeaps)
+    {
+        m_SRVAllocator.TrimFreeHeaps();
+        m_UAVAllocator.TrimFreeHeaps();
+        m_RTVAllocator.TrimFreeHeaps();
+        m_DSVAllocator.TrimFreeHeaps();
+        m_SamplerAllocator.TrimFreeHeaps();
+    }
+
     return true;
 }
 
@@ -537,16 +620,38 @@ void TRANSLATION_API ImmediateContext::PostSubmitNotification()
 
     const UINT64 completedFence = GetCompletedFenceValue(COMMAND_LIST_TYPE::GRAPHICS);
 
-    if (m_bUseRingBufferDescriptorHeaps)
+    if (m_bUseRingBufferDescriptorHeaps || m_bUseBindlessDescriptors)
     {
         m_ViewHeap.m_DescriptorRingBuffer.Deallocate(completedFence);
         m_SamplerHeap.m_DescriptorRingBuffer.Deallocate(completedFence);
     }
+
+    m_CommandLists[(UINT)COMMAND_LIST_TYPE::GRAPHICS]->ReclaimUploadRingSpace();
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
 void ImmediateContext::RollOverHeap(OnlineDescriptorHeap& Heap) noexcept(false)
 {
+    Heap.m_NumRollOvers.fetch_add(1, std::memory_order_relaxed);
+
+    // Cached tables found for this draw live in the space which is being given up, so they have to be written again
+    m_CachedDescriptorTables &= ~Heap.m_BitsToSetOnNewHeap;
+
+    if (m_bUseBindlessDescriptors)
+    {
+        // Persistent descriptors live in the same heap, so it can't be replaced. Reclaim the ring from command lists
+        // which have already been submitted instead. PostRender keeps the current command list to about half of the
+        // ring, so that frees enough space without waiting on the current command list in the middle of a draw.
+        const UINT64 CommandListID = GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS);
+        const UINT RingSize = (&Heap == &m_ViewHeap) ? c_BindlessViewRingSize : c_BindlessSamplerRingSize;
+        assert(Heap.m_DescriptorRingBuffer.GetNumItemsAllocatedAt(CommandListID) <= RingSize / 2 + c_MaxBindlessRingSlotsPerOperation);
+        UNREFERENCED_PARAMETER(RingSize);
+
+        WaitForFenceValue(COMMAND_LIST_TYPE::GRAPHICS, CommandListID - 1); // throws
+        Heap.m_DescriptorRingBuffer.Deallocate(GetCompletedFenceValue(COMMAND_LIST_TYPE::GRAPHICS));
+        return;
+    }
+
     auto pfnCreateNew = [this](D3D12_DESCRIPTOR_HEAP_DESC const& Desc) -> unique_comptr<ID3D12DescriptorHeap>
     {
         unique_comptr<ID3D12DescriptorHeap> spHeap;
@@ -641,6 +746,105 @@ UINT ImmediateContext::ReserveSlotsForBindings(OnlineDescriptorHeap& Heap, UINT
     return offset;
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------
+void ImmediateContext::PrepareBindlessBindings() noexcept(false)
+{
+    // Ring allocations and uploaded index tables are retired along with the command list which wrote them
+    if (m_BindlessCommandListID != GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS))
+    {
+        m_DirtyStates |= e_HeapBindingsDirty;
+        m_BindlessCommandListID = GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS);
+    }
+
+    m_NumBindlessIndices = 0;
+    m_NumBindlessIndexTables = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+UINT ImmediateContext::CopyToBindlessIndex(CBindlessIndexAllocator& Allocator, OnlineDescriptorHeap& Heap, D3D12_CPU_DESCRIPTOR_HANDLE Descriptor) noexcept(false)
+{
+    UINT Index = Allocator.Allocate(GetCompletedFenceValue(COMMAND_LIST_TYPE::GRAPHICS));
+    if (Index == CBindlessIndexAllocator::c_InvalidIndex)
+    {
+        // Waiting on a command list which has already been submitted is safe in the middle of a draw,
+        // but indices retired by the current command list can't be recovered until it's submitted.
+        const UINT64 OldestRetiredFenceValue = Allocator.GetOldestRetiredFenceValue();
+        if (OldestRetiredFenceValue < GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS))
+        {
+            WaitForFenceValue(COMMAND_LIST_TYPE::GRAPHICS, OldestRetiredFenceValue); // throws
+            Index = Allocator.Allocate(GetCompletedFenceValue(COMMAND_LIST_TYPE::GRAPHICS));
+        }
+        if (Index == CBindlessIndexAllocator::c_InvalidIndex)
+        {
+            ThrowFailure(E_OUTOFMEMORY);
+        }
+    }
+
+    m_pDevice12->CopyDescriptorsSimple(1, Heap.CPUHandle(Index), Descriptor, Heap.m_Desc.Type);
+    return Index;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+UINT ImmediateContext::GetBindlessIndex(Sampler* pSampler) noexcept(false)
+{
+    // Samplers are immutable, so the index is only ever copied once
+    if (pSampler->m_BindlessIndex == CBindlessIndexAllocator::c_InvalidIndex)
+    {
+        pSampler->m_BindlessIndex = CopyToBindlessIndex(m_BindlessSamplerIndices, m_SamplerHeap, pSampler->m_Descriptor); // throw( _com_error )
+    }
+    pSampler->MarkUsedInCommandListIfNewer(COMMAND_LIST_TYPE::GRAPHICS, GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS));
+    return pSampler->m_BindlessIndex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+UINT* ImmediateContext::AppendBindlessIndexTable(UINT NumIndices, D3D12_GPU_DESCRIPTOR_HANDLE& Table) noexcept
+{
+    assert(m_NumBindlessIndexTables < c_MaxBindlessIndexTables);
+    assert(m_NumBindlessIndices + NumIndices <= _countof(m_BindlessIndexScratch));
+
+    m_pBindlessIndexTables[m_NumBindlessIndexTables] = &Table;
+    m_BindlessIndexTableOffsets[m_NumBindlessIndexTables++] = m_NumBindlessIndices;
+
+    UINT* pIndices = m_BindlessIndexScratch + m_NumBindlessIndices;
+    m_NumBindlessIndices += Align(NumIndices, c_BindlessIndexTableAlignment);
+    return pIndices;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void ImmediateContext::UploadBindlessIndexTables() noexcept(false)
+{
+    if (m_NumBindlessIndexTables == 0)
+    {
+        return;
+    }
+
+    const UINT64 DataSize = m_NumBindlessIndices * sizeof(UINT);
+    auto UploadHeap = AcquireSuballocatedHeap(AllocatorHeapType::Upload, DataSize, ResourceAllocationContext::ImmediateContextThreadTemporary); // throw( _com_error )
+    const UINT64 UploadCommandListID = GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS);
+
+    void* pMapped;
+    CD3DX12_RANGE ReadRange(0, 0);
+    HRESULT hr = UploadHeap.Map(0, &ReadRange, &pMapped);
+    ThrowFailure(hr); // throw( _com_error )
+
+    memcpy(pMapped, m_BindlessIndexScratch, SIZE_T(DataSize));
+
+    CD3DX12_RANGE WrittenRange(0, SIZE_T(DataSize));
+    UploadHeap.Unmap(0, &WrittenRange);
+
+    const D3D12_GPU_VIRTUAL_ADDRESS BaseAddress = UploadHeap.GetResource()->GetGPUVirtualAddress() + UploadHeap.GetOffset();
+    assert(BaseAddress % D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT == 0);
+    for (UINT i = 0; i < m_NumBindlessIndexTables; ++i)
+    {
+        m_pBindlessIndexTables[i]->ptr = BaseAddress + m_BindlessIndexTableOffsets[i] * sizeof(UINT);
+    }
+
+    ReleaseSuballocatedHeap(AllocatorHeapType::Upload, UploadHeap, UploadCommandListID, COMMAND_LIST_TYPE::GRAPHICS);
+
+    m_NumBindlessIndices = 0;
+    m_NumBindlessIndexTables = 0;
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 RootSignature* ImmediateContext::CreateOrRetrieveRootSignature(RootSignatureDesc const& desc) noexcept(false)
 {
@@ -813,7 +1017,21 @@ void ImmediateContext::PostRender(COMMAND_LIST_TYPE type, UINT64 ReassertBitsToA
 {
     m_StatesToReassert |= ReassertBitsToAdd;
     AdditionalCommandsAdded(type);
-    GetCommandListManager(type)->SubmitCommandListIfNeeded();
+
+    // Bindless mode keeps each command list to about half of each ring, so that a full ring can always be recovered in
+    // RollOverHeap by waiting for command lists which have already been submitted. Every operation which reserves ring
+    // space ends here, and none of them reserves more than a few slots, so checking after each one is enough.
+    const UINT64 CommandListID = GetCommandListID(type);
+    if (type == COMMAND_LIST_TYPE::GRAPHICS && m_bUseBindlessDescriptors &&
+        (m_ViewHeap.m_DescriptorRingBuffer.GetNumItemsAllocatedAt(CommandListID) > c_BindlessViewRingSize / 2 ||
+         m_SamplerHeap.m_DescriptorRingBuffer.GetNumItemsAllocatedAt(CommandListID) > c_BindlessSamplerRingSize / 2))
+    {
+        SubmitCommandList(type); // throws
+    }
+    else
+    {
+        GetCommandListManager(type)->SubmitCommandListIfNeeded();
+    }
 
 #if DBG
     if (m_DebugFlags & Debug_FlushOnRender  && HasCommands(type))
@@ -1081,7 +1299,7 @@ void ImmediateContext::ConstantBufferBound(Resource* pBuffer, UINT slot, EShader
 {
     if (pBuffer == nullptr) return;
     pBuffer->m_currentBindings.ConstantBufferBound(stage, slot);
-    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForBindings(pBuffer);
+    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForChangedBindings(pBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -1089,7 +1307,7 @@ void ImmediateContext::ConstantBufferUnbound(Resource* pBuffer, UINT slot, EShad
 {
     if (pBuffer == nullptr) return;
     pBuffer->m_currentBindings.ConstantBufferUnbound(stage, slot);
-    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForBindings(pBuffer);
+    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForChangedBindings(pBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -1097,7 +1315,7 @@ void ImmediateContext::VertexBufferBound(Resource* pBuffer, UINT slot) noexcept
 {
     if (pBuffer == nullptr) return;
     pBuffer->m_currentBindings.VertexBufferBound(slot);
-    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForBindings(pBuffer);
+    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForChangedBindings(pBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -1105,7 +1323,7 @@ void ImmediateContext::VertexBufferUnbound(Resource* pBuffer, UINT slot) noexcep
 {
     if (pBuffer == nullptr) return;
     pBuffer->m_currentBindings.VertexBufferUnbound(slot);
-    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForBindings(pBuffer);
+    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForChangedBindings(pBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -1113,7 +1331,7 @@ void ImmediateContext::IndexBufferBound(Resource* pBuffer) noexcept
 {
     if (pBuffer == nullptr) return;
     pBuffer->m_currentBindings.IndexBufferBound();
-    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForBindings(pBuffer);
+    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForChangedBindings(pBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -1121,7 +1339,7 @@ void ImmediateContext::IndexBufferUnbound(Resource* pBuffer) noexcept
 {
     if (pBuffer == nullptr) return;
     pBuffer->m_currentBindings.IndexBufferUnbound();
-    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForBindings(pBuffer);
+    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForChangedBindings(pBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -1129,7 +1347,7 @@ void ImmediateContext::StreamOutputBufferBound(Resource* pBuffer, UINT slot) noe
 {
     if (pBuffer == nullptr) return;
     pBuffer->m_currentBindings.StreamOutputBufferBound(slot);
-    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForBindings(pBuffer);
+    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForChangedBindings(pBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -1137,7 +1355,7 @@ void ImmediateContext::StreamOutputBufferUnbound(Resource* pBuffer, UINT slot) n
 {
     if (pBuffer == nullptr) return;
     pBuffer->m_currentBindings.StreamOutputBufferUnbound(slot);
-    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForBindings(pBuffer);
+    pBuffer->m_pParent->m_ResourceStateManager.TransitionResourceForChangedBindings(pBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -2422,6 +2640,8 @@ void ImmediateContext::UAVBarrier() noexcept
     BarrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
 
     GetGraphicsCommandList()->ResourceBarrier(1, &BarrierDesc);
+    m_UAVBarriers.AllUAVBarrierRecorded();
+    m_ResourceStateManager.AddUAVBarrierStatistics(1, 0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -2752,43 +2972,18 @@ void ImmediateContext::UploadDataToMappedBuffer(_In_reads_bytes_(Placement.Depth
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
-template<typename TInterleaved, typename TPlanar, TInterleaved Mask, TPlanar Shift>
-void DeInterleaving2DCopy(
-    _In_reads_(_Inexpressible_(sizeof(TInterleaved) * Width + SrcRowPitch * (Height - 1))) const BYTE* pSrcData,
+// Runs a PixelCopyKernels row kernel over each row of a 2D region.
+template<typename TSrc, typename TDst>
+void RowKernel2DCopy(
+    void (*pfnRowKernel)(const TSrc*, TDst*, UINT) noexcept,
+    _In_reads_(_Inexpressible_(sizeof(TSrc) * Width + SrcRowPitch * (Height - 1))) const BYTE* pSrcData,
     UINT SrcRowPitch,
-    _Out_writes_(_Inexpressible_(sizeof(TPlanar) * Width + DstRowPitch * (Height - 1))) BYTE* pDstData,
+    _Inout_updates_(_Inexpressible_(sizeof(TDst) * Width + DstRowPitch * (Height - 1))) BYTE* pDstData,
     UINT DstRowPitch, UINT Width, UINT Height)
 {
-    static_assert(sizeof(TInterleaved) >= sizeof(TPlanar), "Invalid types used for interleaving copy.");
-
     for (UINT y = 0; y < Height; ++y)
     {
-        const TInterleaved* pSrcRow = reinterpret_cast<const TInterleaved*>(pSrcData + SrcRowPitch * y);
-        TPlanar* pDstRow = reinterpret_cast<TPlanar*>(pDstData + DstRowPitch * y);
-        for (UINT x = 0; x < Width; ++x)
-        {
-            pDstRow[x] = static_cast<TPlanar>((pSrcRow[x] & Mask) >> Shift);
-        }
-    }
-}
-
-template<typename TInterleaved, typename TPlanar, TPlanar Mask, TPlanar Shift>
-void Interleaving2DCopy(
-    _In_reads_(_Inexpressible_(sizeof(TPlanar) * Width + SrcRowPitch * (Height - 1))) const BYTE* pSrcData,
-    UINT SrcRowPitch,
-    _Out_writes_(_Inexpressible_(sizeof(TInterleaved) * Width + DstRowPitch * (Height - 1))) BYTE* pDstData,
-    UINT DstRowPitch, UINT Width, UINT Height)
-{
-    static_assert(sizeof(TInterleaved) >= sizeof(TPlanar), "Invalid types used for interleaving copy.");
-
-    for (UINT y = 0; y < Height; ++y)
-    {
-        const TPlanar* pSrcRow = reinterpret_cast<const TPlanar*>(pSrcData + SrcRowPitch * y);
-        TInterleaved* pDstRow = reinterpret_cast<TInterleaved*>(pDstData + DstRowPitch * y);
-        for (UINT x = 0; x < Width; ++x)
-        {
-            pDstRow[x] |= (static_cast<TInterleaved>(pSrcRow[x] & Mask) << Shift);
-        }
+        pfnRowKernel(reinterpret_cast<const TSrc*>(pSrcData + SrcRowPitch * y), reinterpret_cast<TDst*>(pDstData + DstRowPitch * y), Width);
     }
 }
 
@@ -2796,21 +2991,22 @@ void Interleaving2DCopy(
 void DepthStencilDeInterleavingUpload(DXGI_FORMAT ParentFormat, UINT PlaneIndex, const BYTE* pSrcData, UINT SrcRowPitch, BYTE* pDstData, UINT DstRowPitch, UINT Width, UINT Height)
 {
     ASSUME(PlaneIndex == 0 || PlaneIndex == 1);
+    PixelCopyKernels const& Kernels = GetPixelCopyKernels();
     switch (ParentFormat)
     {
         case DXGI_FORMAT_R24G8_TYPELESS:
         {
             if (PlaneIndex == 0)
-                DeInterleaving2DCopy<UINT, UINT, 0x00ffffff, 0>(pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
+                RowKernel2DCopy(Kernels.pfnDeInterleaveR24Depth, pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
             else
-                DeInterleaving2DCopy<UINT, UINT8, 0xff000000, 24>(pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
+                RowKernel2DCopy(Kernels.pfnDeInterleaveR24Stencil, pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
         } break;
         case DXGI_FORMAT_R32G8X24_TYPELESS:
         {
             if (PlaneIndex == 0)
-                DeInterleaving2DCopy<UINT64, UINT, 0x00000000ffffffff, 0>(pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
+                RowKernel2DCopy(Kernels.pfnDeInterleaveR32Depth, pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
             else
-                DeInterleaving2DCopy<UINT64, UINT8, 0x000000ff00000000, 32>(pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
+                RowKernel2DCopy(Kernels.pfnDeInterleaveR32Stencil, pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
         } break;
         default: ASSUME(false);
     }
@@ -2820,56 +3016,36 @@ void DepthStencilDeInterleavingUpload(DXGI_FORMAT ParentFormat, UINT PlaneIndex,
 void DepthStencilInterleavingReadback(DXGI_FORMAT ParentFormat, UINT PlaneIndex, const BYTE* pSrcData, UINT SrcRowPitch, BYTE* pDstData, UINT DstRowPitch, UINT Width, UINT Height)
 {
     ASSUME(PlaneIndex == 0 || PlaneIndex == 1);
+    PixelCopyKernels const& Kernels = GetPixelCopyKernels();
     switch (ParentFormat)
     {
         case DXGI_FORMAT_R24G8_TYPELESS:
         {
             if (PlaneIndex == 0)
-                Interleaving2DCopy<UINT, UINT, 0x00ffffff, 0>(pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
+                RowKernel2DCopy(Kernels.pfnInterleaveR24Depth, pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
             else
-                Interleaving2DCopy<UINT, UINT8, 0xff, 24>(pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
+                RowKernel2DCopy(Kernels.pfnInterleaveR24Stencil, pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
         } break;
         case DXGI_FORMAT_R32G8X24_TYPELESS:
         {
             if (PlaneIndex == 0)
-                Interleaving2DCopy<UINT64, UINT, 0xffffffff, 0>(pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
+                RowKernel2DCopy(Kernels.pfnInterleaveR32Depth, pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
             else
-                Interleaving2DCopy<UINT64, UINT8, 0xff, 32>(pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
+                RowKernel2DCopy(Kernels.pfnInterleaveR32Stencil, pSrcData, SrcRowPitch, pDstData, DstRowPitch, Width, Height);
         } break;
         default: ASSUME(false);
     }
 }
 
-//----------------------------------------------------------------------------------------------------------------------------------
-inline UINT Swap10bitRBPixel(UINT pixel)
-{
-    constexpr UINT alphaMask = 3u << 30u;
-    constexpr UINT blueMask = 0x3FFu << 20u;
-    constexpr UINT greenMask = 0x3FFu << 10u;
-    constexpr UINT redMask = 0x3FFu;
-    return (pixel & (alphaMask | greenMask)) |
-        ((pixel & blueMask) >> 20u) |
-        ((pixel & redMask) << 20u);
-}
-
 //----------------------------------------------------------------------------------------------------------------------------------
 inline void Swap10bitRBUpload(const BYTE* pSrcData, UINT SrcRowPitch, UINT SrcDepthPitch,
                               BYTE* pDstData, UINT DstRowPitch, UINT DstDepthPitch,
                               UINT Width, UINT Height, UINT Depth)
 {
+    auto pfnSwap10bitRB = GetPixelCopyKernels().pfnSwap10bitRB;
     for (UINT z = 0; z < Depth; ++z)
     {
-        auto pSrcSlice = pSrcData + SrcDepthPitch * z;
-        auto pDstSlice = pDstData + DstDepthPitch * z;
-        for (UINT y = 0; y < Height; ++y)
-        {
-            auto pSrcRow = pSrcSlice + SrcRowPitch * y;
-            auto pDstRow = pDstSlice + DstRowPitch * y;
-            for (UINT x = 0; x < Width; ++x)
-            {
-                reinterpret_cast<UINT*>(pDstRow)[x] = Swap10bitRBPixel(reinterpret_cast<const UINT*>(pSrcRow)[x]);
-            }
-        }
+        RowKernel2DCopy(pfnSwap10bitRB, pSrcData + SrcDepthPitch * z, SrcRowPitch, pDstData + DstDepthPitch * z, DstRowPitch, Width, Height);
     }
 }
 
@@ -2892,6 +3068,8 @@ void ImmediateContext::FinalizeUpdateSubresources(Resource* pDst, PreparedUpdate
 
     m_ResourceStateManager.TransitionSubresources(pDst, SubresourceIteration, D3D12_RESOURCE_STATE_COPY_DEST);
     m_ResourceStateManager.ApplyAllResourceTransitions();
+    // The transitions above and PostUpload below may submit, so this is the ID of the command list the copies are recorded to.
+    const UINT64 UploadCommandListID = GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS);
 
     auto DoFinalize = [&]()
     {
@@ -2947,7 +3125,7 @@ void ImmediateContext::FinalizeUpdateSubresources(Resource* pDst, PreparedUpdate
     AdditionalCommandsAdded(COMMAND_LIST_TYPE::GRAPHICS);
     PostUpload();
 
-    ReleaseSuballocatedHeap(AllocatorHeapType::Upload, mappableResource, GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS), COMMAND_LIST_TYPE::GRAPHICS);
+    ReleaseSuballocatedHeap(AllocatorHeapType::Upload, mappableResource, UploadCommandListID, COMMAND_LIST_TYPE::GRAPHICS);
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------
@@ -3901,6 +4079,7 @@ void TRANSLATION_API ImmediateContext::UpdateTiles(Resource* pResource, _In_ con
 
     UINT64 DataSize = (UINT64)pRegion->NumTiles * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
     auto UploadHeap = AcquireSuballocatedHeap(AllocatorHeapType::Upload, DataSize, ResourceAllocationContext::ImmediateContextThreadTemporary); // throw( _com_error )
+    const UINT64 UploadCommandListID = GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS);
 
     void* pMapped;
     CD3DX12_RANGE ReadRange(0, 0);
@@ -3922,7 +4101,7 @@ void TRANSLATION_API ImmediateContext::UpdateTiles(Resource* pResource, _In_ con
         D3D12_TILE_COPY_FLAGS(Flags) | D3D12_TILE_COPY_FLAG_LINEAR_BUFFER_TO_SWIZZLED_TILED_RESOURCE
         );
 
-    ReleaseSuballocatedHeap(AllocatorHeapType::Upload, UploadHeap, GetCommandListID(COMMAND_LIST_TYPE::GRAPHICS), COMMAND_LIST_TYPE::GRAPHICS);
+    ReleaseSuballocatedHeap(AllocatorHeapType::Upload, UploadHeap, UploadCommandListID, COMMAND_LIST_TYPE::GRAPHICS);
 
     PostUpload();
 }
@@ -4066,6 +4245,18 @@ D3D12ResourceSuballocation ImmediateContext::AcquireSuballocatedHeap(AllocatorHe
 {
     if (threadingContext == ResourceAllocationContext::ImmediateContextThreadTemporary)
     {
+        // Temporary uploads are consumed by the command list currently being recorded, or a later one if it's submitted before
+        // they're released, so small ones can come from its upload ring.
+        if (HeapType == AllocatorHeapType::Upload && !bCannotBeOffset)
+        {
+            CommandListManager* pCommandListManager = m_CommandLists[(UINT)CommandListType(HeapType)].get();
+            UINT64 RingOffset;
+            if (pCommandListManager && pCommandListManager->TryAllocateFromUploadRing(Size, RingOffset))
+            {
+                return D3D12ResourceSuballocation(pCommandListManager->GetUploadRingResource(), HeapSuballocationBlock(RingOffset, Size, nullptr, true));
+            }
+        }
+
         UploadHeapSpaceAllocated(CommandListType(HeapType), Size);
     }
 
@@ -4234,6 +4425,15 @@ void ImmediateContext::ReturnTransitionableBufferToPool(AllocatorHeapType HeapTy
 //----------------------------------------------------------------------------------------------------------------------------------
 void ImmediateContext::ReleaseSuballocatedHeap(AllocatorHeapType HeapType, D3D12ResourceSuballocation &resource, UINT64 FenceValue, COMMAND_LIST_TYPE commandListType) noexcept
 {
+    if (resource.GetBufferSuballocation().IsRingAllocation())
+    {
+        // Recycled by the upload ring's fence ledger, which kept it past any submits since it was acquired.
+        assert(commandListType == CommandListType(HeapType));
+        m_CommandLists[(UINT)commandListType]->ReleaseUploadRingAllocation(FenceValue);
+        resource.Reset();
+        return;
+    }
+
     auto &allocator = GetAllocator(HeapType);
 
     m_DeferredDeletionQueueManager.GetLocked()->AddSuballocationToQueue(resource.GetBufferSuballocation(), allocator, commandListType, FenceValue);
@@ -4243,12 +4443,57 @@ void ImmediateContext::ReleaseSuballocatedHeap(AllocatorHeapType HeapType, D3D12
 //----------------------------------------------------------------------------------------------------------------------------------
 void ImmediateContext::ReleaseSuballocatedHeap(AllocatorHeapType HeapType, D3D12ResourceSuballocation &resource, const UINT64 FenceValues[]) noexcept
 {
+    if (resource.GetBufferSuballocation().IsRingAllocation())
+    {
+        const COMMAND_LIST_TYPE commandListType = CommandListType(HeapType);
+        m_CommandLists[(UINT)commandListType]->ReleaseUploadRingAllocation(FenceValues[(UINT)commandListType]);
+        resource.Reset();
+        return;
+    }
+
     auto &allocator = GetAllocator(HeapType);
 
     m_DeferredDeletionQueueManager.GetLocked()->AddSuballocationToQueue(resource.GetBufferSuballocation(), allocator, FenceValues);
     resource.Reset();
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------
+UploadRingStatistics ImmediateContext::GetUploadRingStatistics() noexcept
+{
+    return m_CommandLists[(UINT)COMMAND_LIST_TYPE::GRAPHICS]->GetUploadRingStatistics();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+MemoryTelemetry ImmediateContext::GetMemoryTelemetry() noexcept
+{
+    MemoryTelemetry Telemetry = {};
+    Telemetry.Residency = m_residencyManager.GetStatistics();
+    Telemetry.UploadRing = GetUploadRingStatistics();
+
+    Telemetry.PooledUploadBufferBytes = m_UploadBufferPool.GetPooledSize();
+    Telemetry.PooledReadbackBufferBytes = m_ReadbackBufferPool.GetPooledSize();
+    Telemetry.PooledDecoderBufferBytes = m_DecoderBufferPool.GetPooledSize();
+
+    Telemetry.UploadHeapSuballocator = m_UploadHeapSuballocator.GetSuballocatorUsage();
+    Telemetry.ReadbackHeapSuballocator = m_ReadbackHeapSuballocator.GetSuballocatorUsage();
+    Telemetry.DecoderHeapSuballocator = m_DecoderHeapSuballocator.GetSuballocatorUsage();
+
+    Telemetry.NumViewHeapRollOvers = m_ViewHeap.m_NumRollOvers.load(std::memory_order_relaxed);
+    Telemetry.NumSamplerHeapRollOvers = m_SamplerHeap.m_NumRollOvers.load(std::memory_order_relaxed);
+    return Telemetry;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void TRANSLATION_API ImmediateContext::SetResidencyPriority(Resource* pResource, D3D12_RESIDENCY_PRIORITY Priority)
+{
+    // Shared and suballocated resources aren't tracked, and keep the default priority
+    ManagedObject* pObject = pResource->GetResidencyHandle();
+    if (pObject)
+    {
+        ThrowFailure(m_residencyManager.SetResidencyPriority(pObject, Priority)); // throws
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 Resource* TRANSLATION_API ImmediateContext::CreateRenameCookie(Resource* pResource, ResourceAllocationContext threadingContext)
 {
@@ -5366,6 +5611,12 @@ void ImmediateContext::TransitionResourceForBindings(Resource* pResource) noexce
     m_ResourceStateManager.TransitionResourceForBindings(pResource);
 }
 
+//----------------------------------------------------------------------------------------------------------------------------------
+void ImmediateContext::TransitionResourceForChangedBindings(ViewBase* pView) noexcept
+{
+    m_ResourceStateManager.TransitionSubresourcesForChangedBindings(pView->m_pResource, pView->m_subresources);
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------
 HRESULT TRANSLATION_API ImmediateContext::ResolveSharedResource(Resource* pResource)
 {
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+
+namespace D3D12TranslationLayer
+{
+
+//----------------------------------------------------------------------------------------------------------------------------------
+MappedFile::MappedFile(const wchar_t* pFileName, UINT64 MaxSizeInBytes)
+    : m_Size(MaxSizeInBytes)
+    , m_bWritable(true)
+{
+    HANDLE hFile = CreateFileW(pFileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        ThrowFailure(HRESULT_FROM_WIN32(GetLastError()));
+    }
+    m_hFile.m_h = hFile;
+
+    // Creating the mapping grows the file to the requested size.
+    m_hMapping.m_h = CreateFileMappingW(m_hFile, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(MaxSizeInBytes >> 32), static_cast<DWORD>(MaxSizeInBytes), nullptr);
+    ThrowIfHandleNull(m_hMapping);
+
+    m_pData = static_cast<BYTE*>(MapViewOfFile(m_hMapping, FILE_MAP_WRITE, 0, 0, 0));
+    if (!m_pData)
+    {
+        ThrowFailure(HRESULT_FROM_WIN32(GetLastError()));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+MappedFile::MappedFile(const wchar_t* pFileName)
+    : m_bWritable(false)
+{
+    HANDLE hFile = CreateFileW(pFileName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        ThrowFailure(HRESULT_FROM_WIN32(GetLastError()));
+    }
+    m_hFile.m_h = hFile;
+
+    LARGE_INTEGER FileSize;
+    if (!GetFileSizeEx(m_hFile, &FileSize))
+    {
+        ThrowFailure(HRESULT_FROM_WIN32(GetLastError()));
+    }
+    m_Size = m_UsedSize = FileSize.QuadPart;
+
+    m_hMapping.m_h = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ThrowIfHandleNull(m_hMapping);
+
+    m_pData = static_cast<BYTE*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_pData)
+    {
+        ThrowFailure(HRESULT_FROM_WIN32(GetLastError()));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    if (m_pData)
+    {
+        UnmapViewOfFile(m_pData);
+    }
+    if (m_hMapping)
+    {
+        CloseHandle(m_hMapping.release());
+    }
+    if (m_bWritable && m_hFile)
+    {
+        // Drop the unused tail of the preallocated file.
+        LARGE_INTEGER UsedSize;
+        UsedSize.QuadPart = m_UsedSize;
+        if (SetFilePointerEx(m_hFile, UsedSize, nullptr, FILE_BEGIN))
+        {
+            (void)SetEndOfFile(m_hFile);
+        }
+    }
+}
+
+}
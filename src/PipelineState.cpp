@@ -13,7 +13,8 @@ namespace D3D12TranslationLayer
                               desc.pGeometryShader,
                               desc.pHullShader,
                               desc.pDomainShader,
-                              pContext->RequiresBufferOutofBoundsHandling())))
+                              pContext->RequiresBufferOutofBoundsHandling(),
+                              pContext->UseBindlessDescriptors())))
     {
         Graphics.m_Desc = desc;
         Graphics.m_Desc.pRootSignature = m_pRootSignature->GetForImmediateUse();
@@ -51,7 +52,8 @@ namespace D3D12TranslationLayer
         , m_PipelineStateType(e_Dispatch)
         , m_pRootSignature(pContext->CreateOrRetrieveRootSignature(
             RootSignatureDesc(desc.pCompute,
-                              pContext->RequiresBufferOutofBoundsHandling())))
+                              pContext->RequiresBufferOutofBoundsHandling(),
+                              pContext->UseBindlessDescriptors())))
     {
         Compute.m_Desc = desc;
         Compute.m_Desc.pRootSignature = m_pRootSignature->GetForImmediateUse();
@@ -66,6 +68,7 @@ namespace D3D12TranslationLayer
         {
             m_pParent->SetPipelineState(nullptr);
         }
+        DetachFromCompile();
     }
 
     template<EPipelineType Type> struct PSOTraits;
@@ -85,21 +88,40 @@ namespace D3D12TranslationLayer
     template<EPipelineType Type>
     inline void PipelineState::Create()
     {
-        if (m_pParent->m_spPSOCompilationThreadPool)
+        typedef PSOTraits<Type> PSOTraits;
+        auto& Scheduler = m_pParent->m_PSOCompileScheduler;
+
+        bool bAdded = false;
+        m_spCompile = Scheduler.FindOrAdd(ComputePipelineStateCacheKey(PSOTraits::GetDesc(*this), m_pRootSignature->m_Desc), this, bAdded); // throw( bad_alloc )
+        if (!bAdded)
+        {
+            Scheduler.m_NumDeduplicated.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        try
         {
-            m_pParent->m_spPSOCompilationThreadPool->QueueThreadpoolWork(m_ThreadpoolWork,
-            [this]()
+            if (m_pParent->m_spPSOCompilationThreadPool)
             {
-                try
+                PipelineStateCompile* pCompile = m_spCompile.get();
+                m_pParent->m_spPSOCompilationThreadPool->QueueThreadpoolWork(pCompile->m_Work,
+                [pCompile]()
                 {
-                    CreateImpl<Type>();
-                }
-                catch (_com_error&) {}
-            });
+                    RunBackgroundCompile(*pCompile);
+                }); // throw( _com_error )
+            }
+            else
+            {
+                (void)CompileOrWait();
+                m_bCompileResolved = true;
+                ThrowFailure(m_spCompile->m_hr); // throw( _com_error )
+            }
         }
-        else
+        catch (...)
         {
-            CreateImpl<Type>();
+            // The destructor won't run, but identical pipeline states may already share the compile.
+            DetachFromCompile();
+            throw;
         }
     }
 
@@ -108,23 +130,53 @@ namespace D3D12TranslationLayer
     {
         typedef PSOTraits<Type> PSOTraits;
 
-        HRESULT hr = (m_pParent->m_pDevice12.get()->*PSOTraits::GetCreate())(&PSOTraits::GetDesc(*this), IID_PPV_ARGS(GetForCreate()));
-        if (FAILED(hr))
+        PipelineStateCache* pCache = m_pParent->GetPipelineStateCache();
+        PipelineStateCacheKey CacheKey = {};
+        bool bCreatedFromCache = false;
+        if (pCache)
+        {
+            CacheKey = ComputePipelineStateCacheKey(PSOTraits::GetDesc(*this), m_pRootSignature->m_Desc);
+
+            D3D12_CACHED_PIPELINE_STATE& CachedPSO = GetCachedPSO();
+            if (pCache->Find(CacheKey, CachedPSO.pCachedBlob, CachedPSO.CachedBlobSizeInBytes))
+            {
+                // If the driver rejects the blob (e.g. D3D12_ERROR_DRIVER_VERSION_MISMATCH), compile from scratch and replace it.
+                HRESULT hr = (m_pParent->m_pDevice12.get()->*PSOTraits::GetCreate())(&PSOTraits::GetDesc(*this), IID_PPV_ARGS(GetForCreate()));
+                CachedPSO = {};
+                bCreatedFromCache = SUCCEEDED(hr);
+            }
+        }
+
+        if (!bCreatedFromCache)
         {
-            MICROSOFT_TELEMETRY_ASSERT(hr != E_INVALIDARG);
-            if (g_hTracelogging)
+            HRESULT hr = (m_pParent->m_pDevice12.get()->*PSOTraits::GetCreate())(&PSOTraits::GetDesc(*this), IID_PPV_ARGS(GetForCreate()));
+            if (FAILED(hr))
+            {
+                MICROSOFT_TELEMETRY_ASSERT(hr != E_INVALIDARG);
+                if (g_hTracelogging)
+                {
+                    TraceLoggingWrite(g_hTracelogging,
+                                      "PSOCreationFailure",
+                                      TraceLoggingInt32(0, "SchemaVersion"),
+                                      TraceLoggingHResult(hr, "HResult"),
+                                      TraceLoggingInt32(Type, "PSOType"),
+                                      TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+                                      TraceLoggingLevel(TRACE_LEVEL_ERROR));
+                }
+            }
+            ThrowFailure(hr); // throw( _com_error )
+
+            if (pCache)
             {
-                TraceLoggingWrite(g_hTracelogging,
-                                  "PSOCreationFailure",
-                                  TraceLoggingInt32(0, "SchemaVersion"),
-                                  TraceLoggingHResult(hr, "HResult"),
-                                  TraceLoggingInt32(Type, "PSOType"),
-                                  TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
-                                  TraceLoggingLevel(TRACE_LEVEL_ERROR));
+                CComPtr<ID3DBlob> spBlob;
+                if (SUCCEEDED(GetForImmediateUse()->GetCachedBlob(&spBlob)))
+                {
+                    pCache->Store(CacheKey, spBlob->GetBufferPointer(), spBlob->GetBufferSize());
+                }
             }
         }
-        ThrowFailure(hr); // throw( _com_error )
 
+        // Applies to pipeline states created from the disk cache too
         if (m_pParent->UseRoundTripPSOs())
         {
             CComPtr<ID3DBlob> spBlob;
@@ -141,8 +193,186 @@ namespace D3D12TranslationLayer
                 Compute.m_Desc.CachedPSO.CachedBlobSizeInBytes = spBlob->GetBufferSize();
             }
 
-            hr = (m_pParent->m_pDevice12.get()->*PSOTraits::GetCreate())(&PSOTraits::GetDesc(*this), IID_PPV_ARGS(GetForCreate()));
+            HRESULT hr = (m_pParent->m_pDevice12.get()->*PSOTraits::GetCreate())(&PSOTraits::GetDesc(*this), IID_PPV_ARGS(GetForCreate()));
             ThrowFailure(hr); // throw( _com_error )
         }
     }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    HRESULT PipelineState::CompileNow() noexcept
+    {
+        m_pParent->m_PSOCompileScheduler.m_NumCompiles.fetch_add(1, std::memory_order_relaxed);
+        try
+        {
+            if (m_PipelineStateType == e_Draw)
+            {
+                CreateImpl<e_Draw>(); // throw( _com_error )
+            }
+            else
+            {
+                CreateImpl<e_Dispatch>(); // throw( _com_error )
+            }
+        }
+        catch (_com_error& hrEx)
+        {
+            return hrEx.Error();
+        }
+        catch (std::bad_alloc&)
+        {
+            return E_OUTOFMEMORY;
+        }
+        return S_OK;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void PipelineState::RunBackgroundCompile(PipelineStateCompile& Compile) noexcept
+    {
+        std::unique_lock<std::mutex> Lock(Compile.m_Lock);
+        PipelineState* pSource = Compile.m_pSource;
+        if (Compile.m_State != PipelineStateCompile::EState::Pending || !pSource)
+        {
+            // Already claimed by GetForUse, or abandoned
+            return;
+        }
+        Compile.m_State = PipelineStateCompile::EState::Running;
+        Compile.m_pCompiler = pSource;
+        Lock.unlock();
+
+        // The source can't be destroyed while it's the compiler, see DetachFromCompile.
+        HRESULT hr = pSource->CompileNow();
+
+        Lock.lock();
+        Compile.Complete(hr, pSource->GetForImmediateUse());
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    PipelineState::ECompileResolution PipelineState::CompileOrWait() noexcept
+    {
+        PipelineStateCompile& Compile = *m_spCompile;
+        std::unique_lock<std::mutex> Lock(Compile.m_Lock);
+
+        ECompileResolution Resolution = ECompileResolution::AlreadyDone;
+        if (Compile.m_State == PipelineStateCompile::EState::Pending)
+        {
+            // Nobody has started it yet, so compile it here rather than wait for a worker to get to it.
+            Compile.m_State = PipelineStateCompile::EState::Running;
+            Compile.m_pCompiler = this;
+            Lock.unlock();
+
+            HRESULT hr = CompileNow();
+
+            Lock.lock();
+            Compile.Complete(hr, GetForImmediateUse());
+            return ECompileResolution::CompiledInline;
+        }
+        if (Compile.m_State == PipelineStateCompile::EState::Running)
+        {
+            Compile.m_Completed.wait(Lock, [&Compile]() { return Compile.m_State == PipelineStateCompile::EState::Done; });
+            Resolution = ECompileResolution::Waited;
+        }
+
+        // Compiled by an identical pipeline state, share its PSO.
+        if (!Created() && Compile.m_spPSO)
+        {
+            ID3D12PipelineState** ppPSO = GetForCreate();
+            *ppPSO = Compile.m_spPSO.get();
+            (*ppPSO)->AddRef();
+        }
+        return Resolution;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void PipelineState::ResolveCompile() noexcept
+    {
+        auto& Scheduler = m_pParent->m_PSOCompileScheduler;
+
+        LARGE_INTEGER StartTime;
+        QueryPerformanceCounter(&StartTime);
+        const ECompileResolution Resolution = CompileOrWait();
+        if (Resolution != ECompileResolution::AlreadyDone)
+        {
+            LARGE_INTEGER EndTime;
+            QueryPerformanceCounter(&EndTime);
+            Scheduler.m_BlockedTicks.fetch_add(EndTime.QuadPart - StartTime.QuadPart, std::memory_order_relaxed);
+            (Resolution == ECompileResolution::CompiledInline ? Scheduler.m_NumInlineCompiles : Scheduler.m_NumBlockingWaits).fetch_add(1, std::memory_order_relaxed);
+        }
+        m_bCompileResolved = true;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void PipelineState::DetachFromCompile() noexcept
+    {
+        if (!m_spCompile)
+        {
+            return;
+        }
+        {
+            PipelineStateCompile& Compile = *m_spCompile;
+            std::unique_lock<std::mutex> Lock(Compile.m_Lock);
+            if (Compile.m_pSource == this)
+            {
+                Compile.m_pSource = nullptr;
+            }
+            Compile.m_Completed.wait(Lock, [this, &Compile]() { return Compile.m_pCompiler != this; });
+        }
+        m_pParent->m_PSOCompileScheduler.Release(m_spCompile);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    PipelineStateCompileScheduler::PipelineStateCompileScheduler() noexcept
+    {
+        LARGE_INTEGER Frequency;
+        QueryPerformanceFrequency(&Frequency);
+        m_TicksPerSecond = Frequency.QuadPart;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    std::shared_ptr<PipelineStateCompile> PipelineStateCompileScheduler::FindOrAdd(PipelineStateCacheKey const& Key, PipelineState* pSource, bool& bAdded) noexcept(false)
+    {
+        std::lock_guard<std::mutex> Lock(m_Lock);
+        auto& wpCompile = m_Compiles[Key]; // throw( bad_alloc )
+        if (auto spExisting = wpCompile.lock())
+        {
+            std::lock_guard<std::mutex> CompileLock(spExisting->m_Lock);
+            const bool bShareable = spExisting->m_State == PipelineStateCompile::EState::Done ?
+                SUCCEEDED(spExisting->m_hr) :
+                (spExisting->m_State == PipelineStateCompile::EState::Running || spExisting->m_pSource != nullptr);
+            if (bShareable)
+            {
+                bAdded = false;
+                return spExisting;
+            }
+        }
+
+        auto spCompile = std::make_shared<PipelineStateCompile>(Key, pSource); // throw( bad_alloc )
+        wpCompile = spCompile;
+        bAdded = true;
+        return spCompile;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void PipelineStateCompileScheduler::Release(std::shared_ptr<PipelineStateCompile>& spCompile) noexcept
+    {
+        const PipelineStateCacheKey Key = spCompile->m_Key;
+        std::lock_guard<std::mutex> Lock(m_Lock);
+        spCompile.reset();
+
+        auto iter = m_Compiles.find(Key);
+        if (iter != m_Compiles.end() && iter->second.expired())
+        {
+            m_Compiles.erase(iter);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    PipelineStateCompileStatistics PipelineStateCompileScheduler::GetStatistics() const noexcept
+    {
+        PipelineStateCompileStatistics Stats = {};
+        Stats.NumCompiles = m_NumCompiles.load(std::memory_order_relaxed);
+        Stats.NumDeduplicated = m_NumDeduplicated.load(std::memory_order_relaxed);
+        Stats.NumInlineCompiles = m_NumInlineCompiles.load(std::memory_order_relaxed);
+        Stats.NumBlockingWaits = m_NumBlockingWaits.load(std::memory_order_relaxed);
+        Stats.BlockedTimeUs = TicksToMicroseconds(m_BlockedTicks.load(std::memory_order_relaxed), m_TicksPerSecond);
+        return Stats;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,426 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+
+namespace D3D12TranslationLayer
+{
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::AddBytes(const void* pData, SIZE_T Size) noexcept
+{
+    // Lane 0 is FNV-1a, lane 1 is a rotate-multiply hash, so a collision in one is unlikely to also collide in the other.
+    UINT64 Lane0 = m_Lanes[0];
+    UINT64 Lane1 = m_Lanes[1];
+    for (BYTE const* pByte = static_cast<BYTE const*>(pData), *pEnd = pByte + Size; pByte != pEnd; ++pByte)
+    {
+        Lane0 = (Lane0 ^ *pByte) * 0x100000001b3ull;
+        Lane1 = (((Lane1 << 23) | (Lane1 >> 41)) ^ *pByte) * 0x9e3779b97f4a7c15ull;
+    }
+    m_Lanes[0] = Lane0;
+    m_Lanes[1] = Lane1;
+    m_Size += Size;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::AddString(const char* pString) noexcept
+{
+    Add<UINT8>(pString != nullptr);
+    if (pString)
+    {
+        AddBytes(pString, strlen(pString) + 1);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::Add(D3D12_SHADER_BYTECODE const& ByteCode) noexcept
+{
+    const SIZE_T Size = ByteCode.pShaderBytecode ? ByteCode.BytecodeLength : 0;
+    Add<UINT64>(Size);
+    AddBytes(ByteCode.pShaderBytecode, Size);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::Add(D3D12_STREAM_OUTPUT_DESC const& StreamOutput) noexcept
+{
+    Add(StreamOutput.NumEntries);
+    for (UINT i = 0; i < StreamOutput.NumEntries; ++i)
+    {
+        auto& Entry = StreamOutput.pSODeclaration[i];
+        Add(Entry.Stream);
+        AddString(Entry.SemanticName);
+        Add(Entry.SemanticIndex);
+        Add(Entry.StartComponent);
+        Add(Entry.ComponentCount);
+        Add(Entry.OutputSlot);
+    }
+    const UINT NumStrides = StreamOutput.pBufferStrides ? StreamOutput.NumStrides : 0;
+    Add(NumStrides);
+    for (UINT i = 0; i < NumStrides; ++i)
+    {
+        Add(StreamOutput.pBufferStrides[i]);
+    }
+    Add(StreamOutput.RasterizedStream);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::Add(D3D12_BLEND_DESC const& BlendState) noexcept
+{
+    Add(BlendState.AlphaToCoverageEnable);
+    Add(BlendState.IndependentBlendEnable);
+    for (auto& RT : BlendState.RenderTarget)
+    {
+        Add(RT.BlendEnable);
+        Add(RT.LogicOpEnable);
+        Add(RT.SrcBlend);
+        Add(RT.DestBlend);
+        Add(RT.BlendOp);
+        Add(RT.SrcBlendAlpha);
+        Add(RT.DestBlendAlpha);
+        Add(RT.BlendOpAlpha);
+        Add(RT.LogicOp);
+        Add(RT.RenderTargetWriteMask);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::Add(D3D12_RASTERIZER_DESC const& RasterizerState) noexcept
+{
+    Add(RasterizerState.FillMode);
+    Add(RasterizerState.CullMode);
+    Add(RasterizerState.FrontCounterClockwise);
+    Add(RasterizerState.DepthBias);
+    Add(RasterizerState.DepthBiasClamp);
+    Add(RasterizerState.SlopeScaledDepthBias);
+    Add(RasterizerState.DepthClipEnable);
+    Add(RasterizerState.MultisampleEnable);
+    Add(RasterizerState.AntialiasedLineEnable);
+    Add(RasterizerState.ForcedSampleCount);
+    Add(RasterizerState.ConservativeRaster);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::Add(D3D12_DEPTH_STENCIL_DESC const& DepthStencilState) noexcept
+{
+    Add(DepthStencilState.DepthEnable);
+    Add(DepthStencilState.DepthWriteMask);
+    Add(DepthStencilState.DepthFunc);
+    Add(DepthStencilState.StencilEnable);
+    Add(DepthStencilState.StencilReadMask);
+    Add(DepthStencilState.StencilWriteMask);
+    for (auto& Face : { DepthStencilState.FrontFace, DepthStencilState.BackFace })
+    {
+        Add(Face.StencilFailOp);
+        Add(Face.StencilDepthFailOp);
+        Add(Face.StencilPassOp);
+        Add(Face.StencilFunc);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::Add(D3D12_INPUT_LAYOUT_DESC const& InputLayout) noexcept
+{
+    Add(InputLayout.NumElements);
+    for (UINT i = 0; i < InputLayout.NumElements; ++i)
+    {
+        auto& Element = InputLayout.pInputElementDescs[i];
+        AddString(Element.SemanticName);
+        Add(Element.SemanticIndex);
+        Add(Element.Format);
+        Add(Element.InputSlot);
+        Add(Element.AlignedByteOffset);
+        Add(Element.InputSlotClass);
+        Add(Element.InstanceDataStepRate);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCacheKeyBuilder::Add(RootSignatureDesc const& RootSignature) noexcept
+{
+    // Mirrors RootSignatureDesc::operator==
+    Add(RootSignature.GetAsUINT64());
+    if (RootSignature.m_Flags & RootSignatureDesc::UsesShaderInterfaces)
+    {
+        for (UINT NumSRVSpaces : RootSignature.m_NumSRVSpacesUsed)
+        {
+            Add(NumSRVSpaces);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+PipelineStateCacheKey PipelineStateCacheKeyBuilder::GetKey() const noexcept
+{
+    auto Finalize = [](UINT64 h)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    };
+    return { { Finalize(m_Lanes[0] ^ m_Size), Finalize(m_Lanes[1] + m_Size) } };
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+PipelineStateCacheKey ComputePipelineStateCacheKey(D3D12_GRAPHICS_PIPELINE_STATE_DESC const& Desc, RootSignatureDesc const& RootSignature) noexcept
+{
+    PipelineStateCacheKeyBuilder Builder;
+    Builder.Add<UINT>(e_Draw);
+    Builder.Add(Desc.VS);
+    Builder.Add(Desc.PS);
+    Builder.Add(Desc.DS);
+    Builder.Add(Desc.HS);
+    Builder.Add(Desc.GS);
+    Builder.Add(Desc.StreamOutput);
+    Builder.Add(Desc.BlendState);
+    Builder.Add(Desc.SampleMask);
+    Builder.Add(Desc.RasterizerState);
+    Builder.Add(Desc.DepthStencilState);
+    Builder.Add(Desc.InputLayout);
+    Builder.Add(Desc.IBStripCutValue);
+    Builder.Add(Desc.PrimitiveTopologyType);
+    Builder.Add(Desc.NumRenderTargets);
+    for (UINT i = 0; i < std::min<UINT>(Desc.NumRenderTargets, _countof(Desc.RTVFormats)); ++i)
+    {
+        Builder.Add(Desc.RTVFormats[i]);
+    }
+    Builder.Add(Desc.DSVFormat);
+    Builder.Add(Desc.SampleDesc.Count);
+    Builder.Add(Desc.SampleDesc.Quality);
+    Builder.Add(Desc.NodeMask);
+    Builder.Add(Desc.Flags);
+    Builder.Add(RootSignature);
+    return Builder.GetKey();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+PipelineStateCacheKey ComputePipelineStateCacheKey(D3D12_COMPUTE_PIPELINE_STATE_DESC const& Desc, RootSignatureDesc const& RootSignature) noexcept
+{
+    PipelineStateCacheKeyBuilder Builder;
+    Builder.Add<UINT>(e_Dispatch);
+    Builder.Add(Desc.CS);
+    Builder.Add(Desc.NodeMask);
+    Builder.Add(Desc.Flags);
+    Builder.Add(RootSignature);
+    return Builder.GetKey();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool PipelineStateCache::ParseFile(BYTE const* pData, UINT64 Size, PipelineStateCacheDeviceIdentity const& Device, UINT64& Generation, EntryVisitor const& Visitor) noexcept(false)
+{
+    if (Size < sizeof(PipelineStateCacheFileHeader))
+    {
+        return false;
+    }
+    PipelineStateCacheFileHeader Header;
+    memcpy(&Header, pData, sizeof(Header));
+    if (Header.Magic != PipelineStateCacheFileHeader::c_Magic ||
+        Header.Version != PipelineStateCacheFileHeader::c_Version ||
+        Header.Device.VendorID != Device.VendorID ||
+        Header.Device.DeviceID != Device.DeviceID ||
+        Header.Device.DriverVersion != Device.DriverVersion)
+    {
+        return false;
+    }
+
+    // Validate every entry before visiting any, so that a truncated file is dropped as a whole.
+    UINT64 Offset = sizeof(Header);
+    for (UINT i = 0; i < Header.NumEntries; ++i)
+    {
+        if (Size - Offset < sizeof(PipelineStateCacheEntryHeader))
+        {
+            return false;
+        }
+        PipelineStateCacheEntryHeader Entry;
+        memcpy(&Entry, pData + Offset, sizeof(Entry));
+        if (Entry.BlobSize > Size - Offset - sizeof(Entry))
+        {
+            return false;
+        }
+        Offset += std::min(GetEntrySize(Entry.BlobSize), Size - Offset);
+    }
+
+    Offset = sizeof(Header);
+    for (UINT i = 0; i < Header.NumEntries; ++i)
+    {
+        PipelineStateCacheEntryHeader Entry;
+        memcpy(&Entry, pData + Offset, sizeof(Entry));
+        Visitor(Entry, pData + Offset + sizeof(Entry));
+        Offset += GetEntrySize(Entry.BlobSize);
+    }
+
+    Generation = Header.Generation;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+BYTE* PipelineStateCache::WriteEntry(BYTE* pDest, PipelineStateCacheEntryHeader const& Entry, const void* pBlob) noexcept
+{
+    memcpy(pDest, &Entry, sizeof(Entry));
+    memcpy(pDest + sizeof(Entry), pBlob, static_cast<size_t>(Entry.BlobSize));
+    const UINT64 EntrySize = GetEntrySize(Entry.BlobSize);
+    memset(pDest + sizeof(Entry) + Entry.BlobSize, 0, static_cast<size_t>(EntrySize - sizeof(Entry) - Entry.BlobSize));
+    return pDest + EntrySize;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+PipelineStateCache::PipelineStateCache(const wchar_t* pFileName, UINT64 MaxSizeInBytes, PipelineStateCacheDeviceIdentity const& Device)
+    : m_FileName(pFileName) // throw( bad_alloc )
+    , m_MaxSize(MaxSizeInBytes ? MaxSizeInBytes : c_DefaultMaxSize)
+    , m_Device(Device)
+{
+    try
+    {
+        m_spFile.reset(new MappedFile(pFileName)); // throw( bad_alloc, _com_error )
+    }
+    catch (_com_error&)
+    {
+        // No usable file yet, one is written when the cache is destroyed.
+        return;
+    }
+
+    // Blobs are used in place from the mapping, which stays open until write back.
+    UINT64 Generation = 0;
+    if (ParseFile(m_spFile->GetData(), m_spFile->GetSize(), m_Device, Generation,
+        [this](PipelineStateCacheEntryHeader const& Header, BYTE const* pBlob)
+        {
+            m_Entries.emplace(Header.Key, Entry{ pBlob, static_cast<SIZE_T>(Header.BlobSize), Header.LastUsedGeneration, nullptr }); // throw( bad_alloc )
+        }))
+    {
+        m_Generation = Generation + 1;
+    }
+    else
+    {
+        // Stale or corrupt, it's replaced wholesale on write back.
+        m_spFile.reset();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+PipelineStateCache::~PipelineStateCache()
+{
+    if (m_bDirty)
+    {
+        try
+        {
+            WriteBack(); // throw( bad_alloc, _com_error )
+        }
+        catch (_com_error&) {}
+        catch (std::bad_alloc&) {}
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+bool PipelineStateCache::Find(PipelineStateCacheKey const& Key, const void*& pBlob, SIZE_T& BlobSize) noexcept
+{
+    std::lock_guard<std::mutex> Lock(m_Lock);
+    auto iter = m_Entries.find(Key);
+    if (iter == m_Entries.end())
+    {
+        return false;
+    }
+    if (iter->second.LastUsedGeneration != m_Generation)
+    {
+        iter->second.LastUsedGeneration = m_Generation;
+        m_bDirty = true;
+    }
+    pBlob = iter->second.pBlob;
+    BlobSize = iter->second.BlobSize;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCache::Store(PipelineStateCacheKey const& Key, const void* pBlob, SIZE_T BlobSize) noexcept
+{
+    try
+    {
+        std::unique_ptr<BYTE[]> spBlob(new BYTE[BlobSize]); // throw( bad_alloc )
+        memcpy(spBlob.get(), pBlob, BlobSize);
+
+        std::lock_guard<std::mutex> Lock(m_Lock);
+        auto& Entry = m_Entries[Key]; // throw( bad_alloc )
+        if (Entry.spOwnedBlob)
+        {
+            m_RetiredBlobs.emplace_back(std::move(Entry.spOwnedBlob)); // throw( bad_alloc )
+        }
+        Entry.pBlob = spBlob.get();
+        Entry.BlobSize = BlobSize;
+        Entry.LastUsedGeneration = m_Generation;
+        Entry.spOwnedBlob = std::move(spBlob);
+        m_bDirty = true;
+    }
+    catch (std::bad_alloc&)
+    {
+        // Caching is best-effort.
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+void PipelineStateCache::WriteBack() noexcept(false)
+{
+    // Keep the most recently used entries which fit.
+    std::vector<std::pair<PipelineStateCacheKey, Entry const*>> SortedEntries;
+    SortedEntries.reserve(m_Entries.size()); // throw( bad_alloc )
+    for (auto& [Key, CacheEntry] : m_Entries)
+    {
+        SortedEntries.emplace_back(Key, &CacheEntry);
+    }
+    std::stable_sort(SortedEntries.begin(), SortedEntries.end(),
+        [](auto const& a, auto const& b) { return a.second->LastUsedGeneration > b.second->LastUsedGeneration; });
+
+    UINT64 FileSize = sizeof(PipelineStateCacheFileHeader);
+    size_t NumEntries = 0;
+    for (; NumEntries < SortedEntries.size() && NumEntries < UINT_MAX; ++NumEntries)
+    {
+        const UINT64 EntrySize = GetEntrySize(SortedEntries[NumEntries].second->BlobSize);
+        if (FileSize + EntrySize > m_MaxSize)
+        {
+            break;
+        }
+        FileSize += EntrySize;
+    }
+
+    // Write to the side and swap it in, the existing file is still mapped and a failure shouldn't lose it.
+    const std::wstring TempFileName = m_FileName + L".tmp"; // throw( bad_alloc )
+    {
+        MappedFile File(TempFileName.c_str(), FileSize); // throw( _com_error )
+
+        PipelineStateCacheFileHeader Header = {};
+        Header.Magic = PipelineStateCacheFileHeader::c_Magic;
+        Header.Version = PipelineStateCacheFileHeader::c_Version;
+        Header.NumEntries = static_cast<UINT>(NumEntries);
+        Header.Device = m_Device;
+        Header.Generation = m_Generation;
+        memcpy(File.GetData(), &Header, sizeof(Header));
+
+        BYTE* pDest = File.GetData() + sizeof(Header);
+        for (size_t i = 0; i < NumEntries; ++i)
+        {
+            Entry const& CacheEntry = *SortedEntries[i].second;
+            pDest = WriteEntry(pDest, { SortedEntries[i].first, CacheEntry.LastUsedGeneration, CacheEntry.BlobSize }, CacheEntry.pBlob);
+        }
+        File.SetUsedSize(FileSize);
+    }
+
+    m_Entries.clear();
+    m_spFile.reset();
+    if (!MoveFileExW(TempFileName.c_str(), m_FileName.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        // E.g. another process has the file open without FILE_SHARE_DELETE. The existing file is kept.
+        const HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+        if (g_hTracelogging)
+        {
+            TraceLoggingWrite(g_hTracelogging,
+                              "PipelineStateCacheWriteBackFailure",
+                              TraceLoggingInt32(0, "SchemaVersion"),
+                              TraceLoggingHResult(hr, "HResult"),
+                              TraceLoggingUInt64(FileSize, "FileSize"),
+                              TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+                              TraceLoggingLevel(TRACE_LEVEL_WARNING));
+        }
+        (void)DeleteFileW(TempFileName.c_str());
+    }
+}
+
+}
@@ -0,0 +1,657 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define PIXEL_COPY_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+// The NEON kernels haven't been run on ARM64 hardware yet, so they're opt-in until PixelCopyKernelsTests has passed there.
+#elif (defined(_M_ARM64) || defined(__aarch64__)) && defined(USE_NEON_PIXEL_COPY_KERNELS)
+#define PIXEL_COPY_NEON 1
+#include <arm_neon.h>
+#endif
+
+// MSVC allows any intrinsic in any function, other compilers need the functions using them to opt in.
+#if defined(__GNUC__) || defined(__clang__)
+#define PIXEL_COPY_TARGET(Target) __attribute__((target(Target)))
+#else
+#define PIXEL_COPY_TARGET(Target)
+#endif
+
+namespace D3D12TranslationLayer
+{
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Scalar kernels. These define the results the vectorized kernels must match, and handle the tail of each row for them.
+//----------------------------------------------------------------------------------------------------------------------------------
+template<typename TInterleaved, typename TPlanar, TInterleaved Mask, UINT Shift>
+static void DeInterleaveRow(const TInterleaved* pSrc, TPlanar* pDst, UINT Count) noexcept
+{
+    static_assert(sizeof(TInterleaved) >= sizeof(TPlanar), "Invalid types used for interleaving copy.");
+    for (UINT x = 0; x < Count; ++x)
+    {
+        pDst[x] = static_cast<TPlanar>((pSrc[x] & Mask) >> Shift);
+    }
+}
+
+template<typename TInterleaved, typename TPlanar, TPlanar Mask, UINT Shift>
+static void InterleaveRow(const TPlanar* pSrc, TInterleaved* pDst, UINT Count) noexcept
+{
+    static_assert(sizeof(TInterleaved) >= sizeof(TPlanar), "Invalid types used for interleaving copy.");
+    for (UINT x = 0; x < Count; ++x)
+    {
+        pDst[x] |= (static_cast<TInterleaved>(pSrc[x] & Mask) << Shift);
+    }
+}
+
+static constexpr auto DeInterleaveR24Depth_Scalar = DeInterleaveRow<UINT, UINT, 0x00ffffff, 0>;
+static constexpr auto DeInterleaveR24Stencil_Scalar = DeInterleaveRow<UINT, UINT8, 0xff000000, 24>;
+static constexpr auto DeInterleaveR32Depth_Scalar = DeInterleaveRow<UINT64, UINT, 0x00000000ffffffff, 0>;
+static constexpr auto DeInterleaveR32Stencil_Scalar = DeInterleaveRow<UINT64, UINT8, 0x000000ff00000000, 32>;
+static constexpr auto InterleaveR24Depth_Scalar = InterleaveRow<UINT, UINT, 0x00ffffff, 0>;
+static constexpr auto InterleaveR24Stencil_Scalar = InterleaveRow<UINT, UINT8, 0xff, 24>;
+static constexpr auto InterleaveR32Depth_Scalar = InterleaveRow<UINT64, UINT, 0xffffffff, 0>;
+static constexpr auto InterleaveR32Stencil_Scalar = InterleaveRow<UINT64, UINT8, 0xff, 32>;
+
+static const UINT g_c10bitAlphaGreenMask = (3u << 30u) | (0x3FFu << 10u);
+static const UINT g_c10bitChannelMask = 0x3FFu;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static void Swap10bitRB_Scalar(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    for (UINT x = 0; x < Count; ++x)
+    {
+        const UINT Pixel = pSrc[x];
+        pDst[x] = (Pixel & g_c10bitAlphaGreenMask) |
+            ((Pixel >> 20u) & g_c10bitChannelMask) |
+            ((Pixel & g_c10bitChannelMask) << 20u);
+    }
+}
+
+static const PixelCopyKernels g_cScalarKernels =
+{
+    DeInterleaveR24Depth_Scalar,
+    DeInterleaveR24Stencil_Scalar,
+    DeInterleaveR32Depth_Scalar,
+    DeInterleaveR32Stencil_Scalar,
+    InterleaveR24Depth_Scalar,
+    InterleaveR24Stencil_Scalar,
+    InterleaveR32Depth_Scalar,
+    InterleaveR32Stencil_Scalar,
+    Swap10bitRB_Scalar,
+};
+
+#if PIXEL_COPY_X86
+//----------------------------------------------------------------------------------------------------------------------------------
+// SSE4.1 kernels. Rows have no alignment guarantees beyond that of their elements, so all loads and stores are unaligned.
+//----------------------------------------------------------------------------------------------------------------------------------
+// Small loads which are only as large as the data they read, so the last vector of a row doesn't read past it.
+static inline __m128i LoadU16(const void* p) noexcept { UINT16 v; memcpy(&v, p, sizeof(v)); return _mm_cvtsi32_si128(v); }
+static inline __m128i LoadU32(const void* p) noexcept { UINT v; memcpy(&v, p, sizeof(v)); return _mm_cvtsi32_si128(static_cast<int>(v)); }
+static inline __m128i LoadU64(const void* p) noexcept { return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)); }
+
+PIXEL_COPY_TARGET("sse4.1")
+static void DeInterleaveR24Depth_SSE41(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const __m128i Mask = _mm_set1_epi32(0x00ffffff);
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        __m128i Src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), _mm_and_si128(Src, Mask));
+    }
+    DeInterleaveR24Depth_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("sse4.1")
+static void DeInterleaveR24Stencil_SSE41(const UINT* pSrc, UINT8* pDst, UINT Count) noexcept
+{
+    // Gathers byte 3 of each pixel into the dword selected by the shuffle, and zeroes the rest.
+    const __m128i Shuffle0 = _mm_setr_epi8(3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i Shuffle1 = _mm_setr_epi8(-1, -1, -1, -1, 3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i Shuffle2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 3, 7, 11, 15, -1, -1, -1, -1);
+    const __m128i Shuffle3 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 3, 7, 11, 15);
+    UINT x = 0;
+    for (; x + 16 <= Count; x += 16)
+    {
+        const __m128i* pSrcVec = reinterpret_cast<const __m128i*>(pSrc + x);
+        __m128i Stencil01 = _mm_or_si128(
+            _mm_shuffle_epi8(_mm_loadu_si128(pSrcVec + 0), Shuffle0),
+            _mm_shuffle_epi8(_mm_loadu_si128(pSrcVec + 1), Shuffle1));
+        __m128i Stencil23 = _mm_or_si128(
+            _mm_shuffle_epi8(_mm_loadu_si128(pSrcVec + 2), Shuffle2),
+            _mm_shuffle_epi8(_mm_loadu_si128(pSrcVec + 3), Shuffle3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), _mm_or_si128(Stencil01, Stencil23));
+    }
+    DeInterleaveR24Stencil_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("sse4.1")
+static void DeInterleaveR32Depth_SSE41(const UINT64* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        __m128 Src0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x)));
+        __m128 Src1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x + 2)));
+        __m128 Depth = _mm_shuffle_ps(Src0, Src1, _MM_SHUFFLE(2, 0, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), _mm_castps_si128(Depth));
+    }
+    DeInterleaveR32Depth_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("sse4.1")
+static void DeInterleaveR32Stencil_SSE41(const UINT64* pSrc, UINT8* pDst, UINT Count) noexcept
+{
+    // Gathers byte 4 of each pixel, leaving the X24 bits behind.
+    const __m128i Shuffle0 = _mm_setr_epi8(4, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i Shuffle1 = _mm_setr_epi8(-1, -1, 4, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i Shuffle2 = _mm_setr_epi8(-1, -1, -1, -1, 4, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i Shuffle3 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 4, 12, -1, -1, -1, -1, -1, -1, -1, -1);
+    UINT x = 0;
+    for (; x + 8 <= Count; x += 8)
+    {
+        const __m128i* pSrcVec = reinterpret_cast<const __m128i*>(pSrc + x);
+        __m128i Stencil01 = _mm_or_si128(
+            _mm_shuffle_epi8(_mm_loadu_si128(pSrcVec + 0), Shuffle0),
+            _mm_shuffle_epi8(_mm_loadu_si128(pSrcVec + 1), Shuffle1));
+        __m128i Stencil23 = _mm_or_si128(
+            _mm_shuffle_epi8(_mm_loadu_si128(pSrcVec + 2), Shuffle2),
+            _mm_shuffle_epi8(_mm_loadu_si128(pSrcVec + 3), Shuffle3));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + x), _mm_or_si128(Stencil01, Stencil23));
+    }
+    DeInterleaveR32Stencil_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("sse4.1")
+static void InterleaveR24Depth_SSE41(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const __m128i Mask = _mm_set1_epi32(0x00ffffff);
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        __m128i* pDstVec = reinterpret_cast<__m128i*>(pDst + x);
+        __m128i Depth = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x)), Mask);
+        _mm_storeu_si128(pDstVec, _mm_or_si128(_mm_loadu_si128(pDstVec), Depth));
+    }
+    InterleaveR24Depth_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("sse4.1")
+static void InterleaveR24Stencil_SSE41(const UINT8* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        __m128i* pDstVec = reinterpret_cast<__m128i*>(pDst + x);
+        __m128i Stencil = _mm_slli_epi32(_mm_cvtepu8_epi32(LoadU32(pSrc + x)), 24);
+        _mm_storeu_si128(pDstVec, _mm_or_si128(_mm_loadu_si128(pDstVec), Stencil));
+    }
+    InterleaveR24Stencil_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("sse4.1")
+static void InterleaveR32Depth_SSE41(const UINT* pSrc, UINT64* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 2 <= Count; x += 2)
+    {
+        __m128i* pDstVec = reinterpret_cast<__m128i*>(pDst + x);
+        __m128i Depth = _mm_cvtepu32_epi64(LoadU64(pSrc + x));
+        _mm_storeu_si128(pDstVec, _mm_or_si128(_mm_loadu_si128(pDstVec), Depth));
+    }
+    InterleaveR32Depth_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("sse4.1")
+static void InterleaveR32Stencil_SSE41(const UINT8* pSrc, UINT64* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 2 <= Count; x += 2)
+    {
+        __m128i* pDstVec = reinterpret_cast<__m128i*>(pDst + x);
+        __m128i Stencil = _mm_slli_epi64(_mm_cvtepu8_epi64(LoadU16(pSrc + x)), 32);
+        _mm_storeu_si128(pDstVec, _mm_or_si128(_mm_loadu_si128(pDstVec), Stencil));
+    }
+    InterleaveR32Stencil_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("sse4.1")
+static void Swap10bitRB_SSE41(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const __m128i AlphaGreenMask = _mm_set1_epi32(static_cast<int>(g_c10bitAlphaGreenMask));
+    const __m128i ChannelMask = _mm_set1_epi32(static_cast<int>(g_c10bitChannelMask));
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        __m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x));
+        __m128i Result = _mm_or_si128(
+            _mm_and_si128(Pixels, AlphaGreenMask),
+            _mm_or_si128(
+                _mm_and_si128(_mm_srli_epi32(Pixels, 20), ChannelMask),
+                _mm_slli_epi32(_mm_and_si128(Pixels, ChannelMask), 20)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), Result);
+    }
+    Swap10bitRB_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static const PixelCopyKernels g_cSSE41Kernels =
+{
+    DeInterleaveR24Depth_SSE41,
+    DeInterleaveR24Stencil_SSE41,
+    DeInterleaveR32Depth_SSE41,
+    DeInterleaveR32Stencil_SSE41,
+    InterleaveR24Depth_SSE41,
+    InterleaveR24Stencil_SSE41,
+    InterleaveR32Depth_SSE41,
+    InterleaveR32Stencil_SSE41,
+    Swap10bitRB_SSE41,
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// AVX2 kernels. Byte shuffles and packs only operate within 128-bit lanes, so results gathered per lane are put back in pixel
+// order with a cross-lane permute. Rows shorter than a vector fall back to the SSE4.1 kernels rather than straight to scalar.
+//----------------------------------------------------------------------------------------------------------------------------------
+PIXEL_COPY_TARGET("avx2")
+static void DeInterleaveR24Depth_AVX2(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const __m256i Mask = _mm256_set1_epi32(0x00ffffff);
+    UINT x = 0;
+    for (; x + 8 <= Count; x += 8)
+    {
+        __m256i Src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + x));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + x), _mm256_and_si256(Src, Mask));
+    }
+    DeInterleaveR24Depth_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("avx2")
+static void DeInterleaveR24Stencil_AVX2(const UINT* pSrc, UINT8* pDst, UINT Count) noexcept
+{
+    // Each lane gathers the stencil bytes of its 4 pixels into the dword selected by the shuffle. After combining,
+    // lane 0 holds pixels 0-3 of each source vector and lane 1 pixels 4-7.
+    const __m256i Shuffle0 = _mm256_setr_epi8(
+        3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i Shuffle1 = _mm256_setr_epi8(
+        -1, -1, -1, -1, 3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, 3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i Shuffle2 = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, 3, 7, 11, 15, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, 3, 7, 11, 15, -1, -1, -1, -1);
+    const __m256i Shuffle3 = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 3, 7, 11, 15,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 3, 7, 11, 15);
+    const __m256i Order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    UINT x = 0;
+    for (; x + 32 <= Count; x += 32)
+    {
+        const __m256i* pSrcVec = reinterpret_cast<const __m256i*>(pSrc + x);
+        __m256i Stencil01 = _mm256_or_si256(
+            _mm256_shuffle_epi8(_mm256_loadu_si256(pSrcVec + 0), Shuffle0),
+            _mm256_shuffle_epi8(_mm256_loadu_si256(pSrcVec + 1), Shuffle1));
+        __m256i Stencil23 = _mm256_or_si256(
+            _mm256_shuffle_epi8(_mm256_loadu_si256(pSrcVec + 2), Shuffle2),
+            _mm256_shuffle_epi8(_mm256_loadu_si256(pSrcVec + 3), Shuffle3));
+        __m256i Stencil = _mm256_permutevar8x32_epi32(_mm256_or_si256(Stencil01, Stencil23), Order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + x), Stencil);
+    }
+    DeInterleaveR24Stencil_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("avx2")
+static void DeInterleaveR32Depth_AVX2(const UINT64* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 8 <= Count; x += 8)
+    {
+        __m256 Src0 = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + x)));
+        __m256 Src1 = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + x + 4)));
+        // Pixels 0, 1, 4, 5 | 2, 3, 6, 7
+        __m256i Depth = _mm256_castps_si256(_mm256_shuffle_ps(Src0, Src1, _MM_SHUFFLE(2, 0, 2, 0)));
+        Depth = _mm256_permute4x64_epi64(Depth, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + x), Depth);
+    }
+    DeInterleaveR32Depth_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("avx2")
+static void DeInterleaveR32Stencil_AVX2(const UINT64* pSrc, UINT8* pDst, UINT Count) noexcept
+{
+    // Lane 0 gathers pixels 0-1 of each source vector into the low half of the dword selected by the shuffle, lane 1
+    // gathers pixels 2-3 into the high half, so folding the lanes together leaves 4 pixels per dword.
+    const __m256i Shuffle0 = _mm256_setr_epi8(
+        4, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, 4, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i Shuffle1 = _mm256_setr_epi8(
+        -1, -1, -1, -1, 4, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, 4, 12, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i Shuffle2 = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, 4, 12, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 12, -1, -1, -1, -1);
+    const __m256i Shuffle3 = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 12, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 12);
+    UINT x = 0;
+    for (; x + 16 <= Count; x += 16)
+    {
+        const __m256i* pSrcVec = reinterpret_cast<const __m256i*>(pSrc + x);
+        __m256i Stencil01 = _mm256_or_si256(
+            _mm256_shuffle_epi8(_mm256_loadu_si256(pSrcVec + 0), Shuffle0),
+            _mm256_shuffle_epi8(_mm256_loadu_si256(pSrcVec + 1), Shuffle1));
+        __m256i Stencil23 = _mm256_or_si256(
+            _mm256_shuffle_epi8(_mm256_loadu_si256(pSrcVec + 2), Shuffle2),
+            _mm256_shuffle_epi8(_mm256_loadu_si256(pSrcVec + 3), Shuffle3));
+        __m256i Stencil = _mm256_or_si256(Stencil01, Stencil23);
+        __m128i Folded = _mm_or_si128(_mm256_castsi256_si128(Stencil), _mm256_extracti128_si256(Stencil, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), Folded);
+    }
+    DeInterleaveR32Stencil_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("avx2")
+static void InterleaveR24Depth_AVX2(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const __m256i Mask = _mm256_set1_epi32(0x00ffffff);
+    UINT x = 0;
+    for (; x + 8 <= Count; x += 8)
+    {
+        __m256i* pDstVec = reinterpret_cast<__m256i*>(pDst + x);
+        __m256i Depth = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + x)), Mask);
+        _mm256_storeu_si256(pDstVec, _mm256_or_si256(_mm256_loadu_si256(pDstVec), Depth));
+    }
+    InterleaveR24Depth_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("avx2")
+static void InterleaveR24Stencil_AVX2(const UINT8* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 8 <= Count; x += 8)
+    {
+        __m256i* pDstVec = reinterpret_cast<__m256i*>(pDst + x);
+        __m256i Stencil = _mm256_slli_epi32(_mm256_cvtepu8_epi32(LoadU64(pSrc + x)), 24);
+        _mm256_storeu_si256(pDstVec, _mm256_or_si256(_mm256_loadu_si256(pDstVec), Stencil));
+    }
+    InterleaveR24Stencil_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("avx2")
+static void InterleaveR32Depth_AVX2(const UINT* pSrc, UINT64* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        __m256i* pDstVec = reinterpret_cast<__m256i*>(pDst + x);
+        __m256i Depth = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x)));
+        _mm256_storeu_si256(pDstVec, _mm256_or_si256(_mm256_loadu_si256(pDstVec), Depth));
+    }
+    InterleaveR32Depth_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("avx2")
+static void InterleaveR32Stencil_AVX2(const UINT8* pSrc, UINT64* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        __m256i* pDstVec = reinterpret_cast<__m256i*>(pDst + x);
+        __m256i Stencil = _mm256_slli_epi64(_mm256_cvtepu8_epi64(LoadU32(pSrc + x)), 32);
+        _mm256_storeu_si256(pDstVec, _mm256_or_si256(_mm256_loadu_si256(pDstVec), Stencil));
+    }
+    InterleaveR32Stencil_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+PIXEL_COPY_TARGET("avx2")
+static void Swap10bitRB_AVX2(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const __m256i AlphaGreenMask = _mm256_set1_epi32(static_cast<int>(g_c10bitAlphaGreenMask));
+    const __m256i ChannelMask = _mm256_set1_epi32(static_cast<int>(g_c10bitChannelMask));
+    UINT x = 0;
+    for (; x + 8 <= Count; x += 8)
+    {
+        __m256i Pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + x));
+        __m256i Result = _mm256_or_si256(
+            _mm256_and_si256(Pixels, AlphaGreenMask),
+            _mm256_or_si256(
+                _mm256_and_si256(_mm256_srli_epi32(Pixels, 20), ChannelMask),
+                _mm256_slli_epi32(_mm256_and_si256(Pixels, ChannelMask), 20)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + x), Result);
+    }
+    Swap10bitRB_SSE41(pSrc + x, pDst + x, Count - x);
+}
+
+static const PixelCopyKernels g_cAVX2Kernels =
+{
+    DeInterleaveR24Depth_AVX2,
+    DeInterleaveR24Stencil_AVX2,
+    DeInterleaveR32Depth_AVX2,
+    DeInterleaveR32Stencil_AVX2,
+    InterleaveR24Depth_AVX2,
+    InterleaveR24Stencil_AVX2,
+    InterleaveR32Depth_AVX2,
+    InterleaveR32Stencil_AVX2,
+    Swap10bitRB_AVX2,
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+struct X86Features
+{
+    bool SSE41 = false;
+    bool AVX2 = false;
+};
+
+static X86Features QueryX86Features() noexcept
+{
+    X86Features Features;
+#if defined(_MSC_VER)
+    int Info[4];
+    __cpuid(Info, 0);
+    const int MaxLeaf = Info[0];
+    __cpuid(Info, 1);
+    Features.SSE41 = (Info[2] & (1 << 19)) != 0;
+    // AVX state must also be enabled by the OS
+    const bool bOSXSave = (Info[2] & (1 << 27)) != 0;
+    const bool bAVX = (Info[2] & (1 << 28)) != 0;
+    if (MaxLeaf >= 7 && bOSXSave && bAVX && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(Info, 7, 0);
+        Features.AVX2 = (Info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    Features.SSE41 = __builtin_cpu_supports("sse4.1") != 0;
+    Features.AVX2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+    // The AVX2 kernels fall back to the SSE4.1 ones for the end of each row
+    Features.AVX2 = Features.AVX2 && Features.SSE41;
+    return Features;
+}
+
+static X86Features const& GetX86Features() noexcept
+{
+    static const X86Features s_Features = QueryX86Features();
+    return s_Features;
+}
+#endif // PIXEL_COPY_X86
+
+#if PIXEL_COPY_NEON
+//----------------------------------------------------------------------------------------------------------------------------------
+// NEON kernels. NEON is part of the ARM64 baseline, and its structured loads and stores do the (de)interleaving directly.
+//----------------------------------------------------------------------------------------------------------------------------------
+static void DeInterleaveR24Depth_NEON(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const uint32x4_t Mask = vdupq_n_u32(0x00ffffff);
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        vst1q_u32(pDst + x, vandq_u32(vld1q_u32(pSrc + x), Mask));
+    }
+    DeInterleaveR24Depth_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static void DeInterleaveR24Stencil_NEON(const UINT* pSrc, UINT8* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 16 <= Count; x += 16)
+    {
+        // Byte 3 of each pixel
+        uint8x16x4_t Pixels = vld4q_u8(reinterpret_cast<const uint8_t*>(pSrc + x));
+        vst1q_u8(pDst + x, Pixels.val[3]);
+    }
+    DeInterleaveR24Stencil_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static void DeInterleaveR32Depth_NEON(const UINT64* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        uint32x4x2_t Pixels = vld2q_u32(reinterpret_cast<const uint32_t*>(pSrc + x));
+        vst1q_u32(pDst + x, Pixels.val[0]);
+    }
+    DeInterleaveR32Depth_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static void DeInterleaveR32Stencil_NEON(const UINT64* pSrc, UINT8* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 8 <= Count; x += 8)
+    {
+        // Narrowing the high dword of each pixel to its low byte drops the X24 bits.
+        uint32x4x2_t Pixels0 = vld2q_u32(reinterpret_cast<const uint32_t*>(pSrc + x));
+        uint32x4x2_t Pixels1 = vld2q_u32(reinterpret_cast<const uint32_t*>(pSrc + x + 4));
+        uint16x8_t Stencil = vcombine_u16(vmovn_u32(Pixels0.val[1]), vmovn_u32(Pixels1.val[1]));
+        vst1_u8(pDst + x, vmovn_u16(Stencil));
+    }
+    DeInterleaveR32Stencil_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static void InterleaveR24Depth_NEON(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const uint32x4_t Mask = vdupq_n_u32(0x00ffffff);
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        uint32x4_t Depth = vandq_u32(vld1q_u32(pSrc + x), Mask);
+        vst1q_u32(pDst + x, vorrq_u32(vld1q_u32(pDst + x), Depth));
+    }
+    InterleaveR24Depth_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static void InterleaveR24Stencil_NEON(const UINT8* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 16 <= Count; x += 16)
+    {
+        uint8_t* pDstBytes = reinterpret_cast<uint8_t*>(pDst + x);
+        uint8x16x4_t Pixels = vld4q_u8(pDstBytes);
+        Pixels.val[3] = vorrq_u8(Pixels.val[3], vld1q_u8(pSrc + x));
+        vst4q_u8(pDstBytes, Pixels);
+    }
+    InterleaveR24Stencil_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static void InterleaveR32Depth_NEON(const UINT* pSrc, UINT64* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        uint32_t* pDstDwords = reinterpret_cast<uint32_t*>(pDst + x);
+        uint32x4x2_t Pixels = vld2q_u32(pDstDwords);
+        Pixels.val[0] = vorrq_u32(Pixels.val[0], vld1q_u32(pSrc + x));
+        vst2q_u32(pDstDwords, Pixels);
+    }
+    InterleaveR32Depth_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static void InterleaveR32Stencil_NEON(const UINT8* pSrc, UINT64* pDst, UINT Count) noexcept
+{
+    UINT x = 0;
+    for (; x + 8 <= Count; x += 8)
+    {
+        uint16x8_t Stencil = vmovl_u8(vld1_u8(pSrc + x));
+        uint32_t* pDstDwords0 = reinterpret_cast<uint32_t*>(pDst + x);
+        uint32_t* pDstDwords1 = reinterpret_cast<uint32_t*>(pDst + x + 4);
+        uint32x4x2_t Pixels0 = vld2q_u32(pDstDwords0);
+        uint32x4x2_t Pixels1 = vld2q_u32(pDstDwords1);
+        Pixels0.val[1] = vorrq_u32(Pixels0.val[1], vmovl_u16(vget_low_u16(Stencil)));
+        Pixels1.val[1] = vorrq_u32(Pixels1.val[1], vmovl_u16(vget_high_u16(Stencil)));
+        vst2q_u32(pDstDwords0, Pixels0);
+        vst2q_u32(pDstDwords1, Pixels1);
+    }
+    InterleaveR32Stencil_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static void Swap10bitRB_NEON(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    const uint32x4_t AlphaGreenMask = vdupq_n_u32(g_c10bitAlphaGreenMask);
+    const uint32x4_t ChannelMask = vdupq_n_u32(g_c10bitChannelMask);
+    UINT x = 0;
+    for (; x + 4 <= Count; x += 4)
+    {
+        uint32x4_t Pixels = vld1q_u32(pSrc + x);
+        uint32x4_t Result = vorrq_u32(
+            vandq_u32(Pixels, AlphaGreenMask),
+            vorrq_u32(
+                vandq_u32(vshrq_n_u32(Pixels, 20), ChannelMask),
+                vshlq_n_u32(vandq_u32(Pixels, ChannelMask), 20)));
+        vst1q_u32(pDst + x, Result);
+    }
+    Swap10bitRB_Scalar(pSrc + x, pDst + x, Count - x);
+}
+
+static const PixelCopyKernels g_cNEONKernels =
+{
+    DeInterleaveR24Depth_NEON,
+    DeInterleaveR24Stencil_NEON,
+    DeInterleaveR32Depth_NEON,
+    DeInterleaveR32Stencil_NEON,
+    InterleaveR24Depth_NEON,
+    InterleaveR24Stencil_NEON,
+    InterleaveR32Depth_NEON,
+    InterleaveR32Stencil_NEON,
+    Swap10bitRB_NEON,
+};
+#endif // PIXEL_COPY_NEON
+
+//----------------------------------------------------------------------------------------------------------------------------------
+PixelCopyKernels const* GetPixelCopyKernels(PixelCopyKernelLevel Level) noexcept
+{
+    switch (Level)
+    {
+        case PixelCopyKernelLevel::Scalar: return &g_cScalarKernels;
+#if PIXEL_COPY_X86
+        case PixelCopyKernelLevel::SSE41: return GetX86Features().SSE41 ? &g_cSSE41Kernels : nullptr;
+        case PixelCopyKernelLevel::AVX2: return GetX86Features().AVX2 ? &g_cAVX2Kernels : nullptr;
+#endif
+#if PIXEL_COPY_NEON
+        case PixelCopyKernelLevel::NEON: return &g_cNEONKernels;
+#endif
+        default: return nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+PixelCopyKernels const& GetPixelCopyKernels() noexcept
+{
+    static PixelCopyKernels const* const s_pKernels = []() noexcept
+    {
+        for (PixelCopyKernelLevel Level : { PixelCopyKernelLevel::AVX2, PixelCopyKernelLevel::NEON, PixelCopyKernelLevel::SSE41 })
+        {
+            if (PixelCopyKernels const* pKernels = GetPixelCopyKernels(Level))
+            {
+                return pKernels;
+            }
+        }
+        return &g_cScalarKernels;
+    }();
+    return *s_pKernels;
+}
+
+}
@@ -6,61 +6,81 @@
 namespace D3D12TranslationLayer
 {
 
-void Internal::LRUCache::TrimToSyncPointInclusive(INT64 CurrentUsage, INT64 CurrentBudget, std::vector<ID3D12Pageable*> &EvictionList, UINT64 FenceValues[])
+static bool UsedAfterSyncPoint(ManagedObject* pObject, UINT64 FenceValues[])
 {
-    LIST_ENTRY* pResourceEntry = ResidentObjectListHead.Flink;
-    while (pResourceEntry != &ResidentObjectListHead)
+    for (UINT i = 0; i < (UINT)COMMAND_LIST_TYPE::MAX_VALID; ++i)
     {
-        ManagedObject* pObject = CONTAINING_RECORD(pResourceEntry, ManagedObject, ListEntry);
-        pResourceEntry = pResourceEntry->Flink;
-
-        if (CurrentUsage < CurrentBudget)
+        if (pObject->LastUsedFenceValues[i] > FenceValues[i])
         {
-            return;
+            return true;
         }
-        for (UINT i = 0; i < (UINT)COMMAND_LIST_TYPE::MAX_VALID; ++i)
+    }
+    return false;
+}
+
+static UINT64 GetEvictionGracePeriod(UINT64 MinDelta, ManagedObject::PRIORITY_CLASS PriorityClass)
+{
+    switch (PriorityClass)
+    {
+    case ManagedObject::PRIORITY_CLASS::LOW: return MinDelta / 2;
+    case ManagedObject::PRIORITY_CLASS::HIGH: return MinDelta > MAXUINT64 / 2 ? MAXUINT64 : MinDelta * 2;
+    default: return MinDelta;
+    }
+}
+
+void Internal::LRUCache::TrimToSyncPointInclusive(INT64 CurrentUsage, INT64 CurrentBudget, std::vector<ID3D12Pageable*> &EvictionList, UINT64 FenceValues[])
+{
+    // Each pass considers one more priority class, so lower priority objects are evicted first
+    for (UINT MaxPriorityClass = 0; MaxPriorityClass < ManagedObject::NumPriorityClasses && CurrentUsage >= CurrentBudget; ++MaxPriorityClass)
+    {
+        // Walk until the budget is met or the list is exhausted
+        ManagedObject* pNextObject = GetResidentListHead();
+        while (pNextObject && CurrentUsage >= CurrentBudget)
         {
-            if (pObject->LastUsedFenceValues[i] > FenceValues[i])
+            ManagedObject* pObject = pNextObject;
+            pNextObject = GetResidentObjectAfter(&pObject->ListEntry);
+
+            if (UsedAfterSyncPoint(pObject, FenceValues))
             {
-                return;
+                break;
             }
-        }
 
-        assert(pObject->ResidencyStatus == ManagedObject::RESIDENCY_STATUS::RESIDENT);
+            assert(pObject->ResidencyStatus == ManagedObject::RESIDENCY_STATUS::RESIDENT);
 
-        if (!pObject->IsPinned())
-        {
-            EvictionList.push_back(pObject->pUnderlying);
-            Evict(pObject);
+            if ((UINT)pObject->PriorityClass <= MaxPriorityClass && !pObject->IsPinned())
+            {
+                EvictionList.push_back(pObject->pUnderlying);
+                Evict(pObject);
 
-            CurrentUsage -= pObject->Size;
+                CurrentUsage -= pObject->Size;
+            }
         }
     }
 }
 
 void Internal::LRUCache::TrimAgedAllocations(UINT64 FenceValues[], std::vector<ID3D12Pageable*> &EvictionList, UINT64 CurrentTimeStamp, UINT64 MinDelta)
 {
-    LIST_ENTRY* pResourceEntry = ResidentObjectListHead.Flink;
-    while (pResourceEntry != &ResidentObjectListHead)
+    const UINT64 ShortestGracePeriod = GetEvictionGracePeriod(MinDelta, ManagedObject::PRIORITY_CLASS::LOW);
+
+    ManagedObject* pNextObject = GetResidentListHead();
+    while (pNextObject)
     {
-        ManagedObject* pObject = CONTAINING_RECORD(pResourceEntry, ManagedObject, ListEntry);
-        pResourceEntry = pResourceEntry->Flink;
+        ManagedObject* pObject = pNextObject;
+        pNextObject = GetResidentObjectAfter(&pObject->ListEntry);
 
-        if (CurrentTimeStamp - pObject->LastUsedTimestamp <= MinDelta) // Don't evict things which have been used recently
+        const UINT64 TimeSinceLastUse = CurrentTimeStamp - pObject->LastUsedTimestamp;
+        if (TimeSinceLastUse <= ShortestGracePeriod) // Don't evict things which have been used recently
         {
             return;
         }
-        for (UINT i = 0; i < (UINT)COMMAND_LIST_TYPE::MAX_VALID; ++i)
+        if (UsedAfterSyncPoint(pObject, FenceValues))
         {
-            if (pObject->LastUsedFenceValues[i] > FenceValues[i])
-            {
-                return;
-            }
+            return;
         }
 
         assert(pObject->ResidencyStatus == ManagedObject::RESIDENCY_STATUS::RESIDENT);
 
-        if (!pObject->IsPinned())
+        if (TimeSinceLastUse > GetEvictionGracePeriod(MinDelta, pObject->PriorityClass) && !pObject->IsPinned())
         {
             EvictionList.push_back(pObject->pUnderlying);
             Evict(pObject);
@@ -70,19 +90,16 @@ void Internal::LRUCache::TrimAgedAllocations(UINT64 FenceValues[], std::vector<I
 
 void Internal::LRUCache::TrimUnusedAllocationsSinceLastNotificationPeriod(UINT64 CurrentPeriodicTrimNotificationIndex, UINT64 FenceValues[], std::vector<ID3D12Pageable*>& EvictionList, UINT64& BytesToEvict)
 {
-    LIST_ENTRY* pResourceEntry = ResidentObjectListHead.Flink;
-    while (pResourceEntry != &ResidentObjectListHead)
+    ManagedObject* pNextObject = GetResidentListHead();
+    while (pNextObject)
     {
-        ManagedObject* pObject = CONTAINING_RECORD(pResourceEntry, ManagedObject, ListEntry);
-        pResourceEntry = pResourceEntry->Flink;
+        ManagedObject* pObject = pNextObject;
+        pNextObject = GetResidentObjectAfter(&pObject->ListEntry);
 
         // List is LRU-sorted, this object is still in use on any command queue fence, so we're done
-        for (UINT i = 0; i < (UINT)COMMAND_LIST_TYPE::MAX_VALID; ++i)
+        if (UsedAfterSyncPoint(pObject, FenceValues))
         {
-            if (pObject->LastUsedFenceValues[i] > FenceValues[i])
-            {
-                return;
-            }
+            return;
         }
 
         assert(pObject->ResidencyStatus == ManagedObject::RESIDENCY_STATUS::RESIDENT);
@@ -98,6 +115,203 @@ void Internal::LRUCache::TrimUnusedAllocationsSinceLastNotificationPeriod(UINT64
     }
 }
 
+HRESULT Internal::PagingQueue::Initialize(ID3D12Device3* pDevice, ID3D12Fence* pPagingFence)
+{
+    Device = pDevice;
+    PagingFence = pPagingFence;
+
+    WorkAvailableEvent.m_h = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    FenceEvent.m_h = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    if (!WorkAvailableEvent.m_h || !FenceEvent.m_h)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    Thread.m_h = CreateThread(
+        nullptr, 0,
+        [](void* pContext) -> DWORD
+    {
+        reinterpret_cast<PagingQueue*>(pContext)->PagingThread();
+        return 0;
+    }, this, 0, nullptr);
+    if (!Thread.m_h)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    return S_OK;
+}
+
+void Internal::PagingQueue::Shutdown() noexcept
+{
+    if (!Thread.m_h)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard Lock(QueueLock);
+        bShutdown = true;
+    }
+    SetEvent(WorkAvailableEvent);
+
+    // Queues may be waiting on paging fence values, so the thread drains the queue before exiting.
+    WaitForSingleObject(Thread, INFINITE);
+    CloseHandle(Thread.release());
+}
+
+void Internal::PagingQueue::ReserveEvict(EvictReservation& Reservation, size_t MaxObjects)
+{
+    if (Reservation.Work.empty())
+    {
+        Reservation.Work.emplace_back(); // throw( bad_alloc )
+    }
+    Reservation.Work.front().Objects.reserve(MaxObjects); // throw( bad_alloc )
+}
+
+void Internal::PagingQueue::QueueEvict(EvictReservation& Reservation,
+                                       std::vector<ID3D12Pageable*> const& Objects,
+                                       ID3D12Fence* const WaitFences[],
+                                       const UINT64 WaitFenceValues[]) noexcept
+{
+    assert(!Reservation.Work.empty());
+    PagingWork& Work = Reservation.Work.front();
+    assert(Work.Objects.capacity() >= Objects.size());
+
+    // Fits in the reserved capacity, so this doesn't allocate
+    Work.Objects.assign(Objects.begin(), Objects.end());
+    for (UINT i = 0; i < (UINT)COMMAND_LIST_TYPE::MAX_VALID; ++i)
+    {
+        Work.WaitFences[i] = WaitFences[i];
+    }
+    std::copy(WaitFenceValues, WaitFenceValues + (UINT)COMMAND_LIST_TYPE::MAX_VALID, Work.WaitFenceValues);
+    Work.SignalValue = 0;
+    Enqueue(Reservation.Work);
+}
+
+void Internal::PagingQueue::QueueMakeResident(UINT NumObjects, _In_reads_(NumObjects) ID3D12Pageable* const* ppObjects, UINT64 SignalValue)
+{
+    assert(SignalValue > 0);
+
+    std::list<PagingWork> Work(1); // throw( bad_alloc )
+    Work.front().Objects.assign(ppObjects, ppObjects + NumObjects); // throw( bad_alloc )
+    std::fill(Work.front().WaitFenceValues, std::end(Work.front().WaitFenceValues), 0ull);
+    Work.front().SignalValue = SignalValue;
+    Enqueue(Work);
+}
+
+void Internal::PagingQueue::Enqueue(std::list<PagingWork>& Work) noexcept
+{
+    assert(Work.size() == 1);
+    for (auto pObject : Work.front().Objects)
+    {
+        pObject->AddRef();
+    }
+
+    {
+        std::lock_guard Lock(QueueLock);
+        assert(!bShutdown);
+        Queue.splice(Queue.end(), Work);
+    }
+    SetEvent(WorkAvailableEvent);
+}
+
+void Internal::PagingQueue::PagingThread()
+{
+    while (true)
+    {
+        std::list<PagingWork> Work;
+        {
+            std::unique_lock Lock(QueueLock);
+            if (Queue.empty())
+            {
+                if (bShutdown)
+                {
+                    return;
+                }
+                Lock.unlock();
+                WaitForSingleObject(WorkAvailableEvent, INFINITE);
+                continue;
+            }
+            Work.splice(Work.end(), Queue, Queue.begin());
+        }
+
+        Execute(Work.front());
+
+        for (auto pObject : Work.front().Objects)
+        {
+            pObject->Release();
+        }
+    }
+}
+
+void Internal::PagingQueue::Execute(PagingWork& Work)
+{
+    if (Work.SignalValue == 0)
+    {
+        // The GPU must be done with the objects before they can be evicted
+        LARGE_INTEGER WaitStart;
+        QueryPerformanceCounter(&WaitStart);
+        bool bWaited = false;
+        for (UINT i = 0; i < (UINT)COMMAND_LIST_TYPE::MAX_VALID; ++i)
+        {
+            if (Work.WaitFences[i])
+            {
+                bWaited |= WaitForFenceValue(Work.WaitFences[i], Work.WaitFenceValues[i]);
+            }
+        }
+        if (bWaited)
+        {
+            LARGE_INTEGER WaitEnd;
+            QueryPerformanceCounter(&WaitEnd);
+            NumSyncPointWaits.fetch_add(1, std::memory_order_relaxed);
+            SyncPointWaitTicks.fetch_add(WaitEnd.QuadPart - WaitStart.QuadPart, std::memory_order_relaxed);
+        }
+
+        [[maybe_unused]] HRESULT hrEvict = Device->Evict((UINT)Work.Objects.size(), Work.Objects.data());
+        assert(SUCCEEDED(hrEvict));
+        return;
+    }
+
+    HRESULT hr = Device->EnqueueMakeResident(D3D12_RESIDENCY_FLAG_NONE,
+                                             (UINT)Work.Objects.size(),
+                                             Work.Objects.data(),
+                                             PagingFence,
+                                             Work.SignalValue);
+    if (FAILED(hr))
+    {
+        // Queues are already waiting on this value, so it has to be signaled regardless. Fall back to a synchronous
+        // MakeResident, once earlier requests have signaled so that the fence doesn't go backwards.
+        WaitForFenceValue(PagingFence, Work.SignalValue - 1);
+        hr = Device->MakeResident((UINT)Work.Objects.size(), Work.Objects.data());
+        if (FAILED(hr))
+        {
+            // The app is using more memory in 1 command list than the system can make resident. The command list has
+            // already been submitted, so the best that can be done is to let it run and report the failure on the next submit.
+            HRESULT hrNone = S_OK;
+            MakeResidentError.compare_exchange_strong(hrNone, hr);
+        }
+
+        [[maybe_unused]] HRESULT hrSignal = PagingFence->Signal(Work.SignalValue);
+        assert(SUCCEEDED(hrSignal));
+    }
+}
+
+bool Internal::PagingQueue::WaitForFenceValue(ID3D12Fence* pFence, UINT64 Value)
+{
+    if (pFence->GetCompletedValue() >= Value)
+    {
+        return false;
+    }
+
+    HRESULT hr = pFence->SetEventOnCompletion(Value, FenceEvent);
+    assert(SUCCEEDED(hr));
+    if (SUCCEEDED(hr))
+    {
+        WaitForSingleObject(FenceEvent, INFINITE);
+    }
+    return true;
+}
+
 void APIENTRY ResidencyManager::PeriodicTrimNotificationCallback(const D3D12_TRIM_NOTIFICATION* pData)
 {
     ResidencyManager* pResidencyManager = reinterpret_cast<ResidencyManager*>(pData->pContext);
@@ -125,6 +339,18 @@ void APIENTRY ResidencyManager::PeriodicTrimNotificationCallback(const D3D12_TRI
     pResidencyManager->EvictionList.clear();
     UINT64 BytesToEvict = 0u;
 
+    // Allocate before the LRU is updated, since objects it marks as evicted must be queued for eviction
+    try
+    {
+        pResidencyManager->EvictionList.reserve(pResidencyManager->LRU.NumResidentObjects); // throw( bad_alloc )
+        pResidencyManager->Paging.ReserveEvict(pResidencyManager->EvictStorage, pResidencyManager->LRU.NumResidentObjects); // throw( bad_alloc )
+    }
+    catch (std::bad_alloc&)
+    {
+        // Trimming is only an optimization, so skip this notification
+        return;
+    }
+
     if (pData->Flags & D3D12_TRIM_NOTIFICATION_FLAG_PERIODIC_TRIM)
     {
         pResidencyManager->LRU.TrimUnusedAllocationsSinceLastNotificationPeriod(
@@ -158,16 +384,26 @@ void APIENTRY ResidencyManager::PeriodicTrimNotificationCallback(const D3D12_TRI
         }
     }
 
-    // If there are any objects to evict, do so now
-	// and clear the eviction list afterwards.
+    // If there are any objects to evict, queue them to the paging thread, which keeps them ordered
+	// with respect to pending MakeResident work, and clear the eviction list afterwards.
     if (!pResidencyManager->EvictionList.empty())
     {
-        [[maybe_unused]] HRESULT hrEvict = pResidencyManager->Device->Evict((UINT)pResidencyManager->EvictionList.size(), pResidencyManager->EvictionList.data());
-        assert(SUCCEEDED(hrEvict));
+        ID3D12Fence* WaitFences[(UINT)COMMAND_LIST_TYPE::MAX_VALID];
+        pResidencyManager->GetQueueFences(WaitFences);
+        pResidencyManager->Paging.QueueEvict(pResidencyManager->EvictStorage, pResidencyManager->EvictionList, WaitFences, WaitedFenceValues);
         pResidencyManager->EvictionList.clear();
     }
 }
 
+void ResidencyManager::GetQueueFences(ID3D12Fence* Fences[]) noexcept
+{
+    for (UINT i = 0; i < (UINT)COMMAND_LIST_TYPE::MAX_VALID; ++i)
+    {
+        auto pFence = ImmCtx.GetFence((COMMAND_LIST_TYPE)i);
+        Fences[i] = pFence ? pFence->Get() : nullptr;
+    }
+}
+
 ResidencyManager::~ResidencyManager()
 {
     if (PeriodicTrimCallbackCookie != c_PeriodicTrimCallbackCookie_Unregistered)
@@ -175,6 +411,8 @@ ResidencyManager::~ResidencyManager()
         [[maybe_unused]] HRESULT hr = Device15->UnregisterTrimNotificationCallback(PeriodicTrimCallbackCookie);
         assert(SUCCEEDED(hr));
     }
+
+    Paging.Shutdown();
 }
 
 HRESULT ResidencyManager::Initialize(UINT DeviceNodeIndex, IDXCoreAdapter *ParentAdapterDXCore, IDXGIAdapter3 *ParentAdapterDXGI)
@@ -182,6 +420,7 @@ HRESULT ResidencyManager::Initialize(UINT DeviceNodeIndex, IDXCoreAdapter *Paren
     NodeIndex = DeviceNodeIndex;
     AdapterDXCore = ParentAdapterDXCore;
     AdapterDXGI = ParentAdapterDXGI;
+    bPredictiveEviction = ImmCtx.m_CreationArgs.UsePredictiveEviction;
 
     if (FAILED(ImmCtx.m_pDevice12->QueryInterface(&Device)))
     {
@@ -190,6 +429,7 @@ HRESULT ResidencyManager::Initialize(UINT DeviceNodeIndex, IDXCoreAdapter *Paren
 
     LARGE_INTEGER Frequency;
     QueryPerformanceFrequency(&Frequency);
+    TicksPerSecond = Frequency.QuadPart;
 
     // Calculate how many QPC ticks are equivalent to the given time in seconds
     MinEvictionGracePeriodTicks = UINT64(Frequency.QuadPart * cMinEvictionGracePeriod);
@@ -198,6 +438,10 @@ HRESULT ResidencyManager::Initialize(UINT DeviceNodeIndex, IDXCoreAdapter *Paren
 
     HRESULT hr = S_OK;
     hr = AsyncThreadFence.Initialize(Device);
+    if (SUCCEEDED(hr))
+    {
+        hr = Paging.Initialize(Device, AsyncThreadFence.pFence);
+    }
 
     // Register for Trim Notification Callback if supported by the OS
     // or ignore the failure and just not do periodic trims on OS that don't support it.
@@ -228,6 +472,16 @@ HRESULT ResidencyManager::ProcessPagingWork(UINT CommandListIndex, ResidencySet
 
         MakeResidentList.reserve(pMasterSet->Set.size());
         EvictionList.reserve(LRU.NumResidentObjects);
+        // Evictions are queued once the LRU has marked the objects evicted, at which point they can't fail
+        Paging.ReserveEvict(EvictStorage, LRU.NumResidentObjects); // throw( bad_alloc )
+
+        ID3D12Fence* WaitFences[(UINT)COMMAND_LIST_TYPE::MAX_VALID];
+        GetQueueFences(WaitFences);
+
+        LRU.BeginEpoch();
+
+        const UINT64 MadeResidentSizeBefore = LRU.TotalMadeResidentSize.load(std::memory_order_relaxed);
+        const UINT64 EvictedSizeBefore = LRU.TotalEvictedSize.load(std::memory_order_relaxed);
 
         // Mark the objects used by this command list to be made resident
         for (auto pObject : pMasterSet->Set)
@@ -266,12 +520,24 @@ HRESULT ResidencyManager::ProcessPagingWork(UINT CommandListIndex, ResidencySet
             LastSubmittedFenceValues[i] = ImmCtx.GetCommandListID((COMMAND_LIST_TYPE)i) - 1;
             WaitedFenceValues[i] = ImmCtx.GetCompletedFenceValue((COMMAND_LIST_TYPE)i);
         }
+        const UINT64 ResidentSizeBeforeTrim = LRU.ResidentSize;
         LRU.TrimAgedAllocations(WaitedFenceValues, EvictionList, CurrentTime.QuadPart, EvictionGracePeriod);
 
+        WorkingSetGrowth.AddSubmission(SizeToMakeResident);
+        if (bPredictiveEviction)
+        {
+            // Only objects the GPU is already done with are considered, so this never waits.
+            INT64 ProjectedUsage = WorkingSetGrowth.ProjectUsage(INT64(LocalMemory.currentUsage) - INT64(ResidentSizeBeforeTrim - LRU.ResidentSize)
+                + INT64(SizeToMakeResident));
+            if (ProjectedUsage >= INT64(LocalMemory.budget))
+            {
+                LRU.TrimToSyncPointInclusive(ProjectedUsage, INT64(LocalMemory.budget), EvictionList, WaitedFenceValues);
+            }
+        }
+
         if (!EvictionList.empty())
         {
-            [[maybe_unused]] HRESULT hrEvict = Device->Evict((UINT)EvictionList.size(), EvictionList.data());
-            assert(SUCCEEDED(hrEvict));
+            Paging.QueueEvict(EvictStorage, EvictionList, WaitFences, WaitedFenceValues);
             EvictionList.clear();
         }
 
@@ -312,24 +578,19 @@ HRESULT ResidencyManager::ProcessPagingWork(UINT CommandListIndex, ResidencySet
                         }
                     }
 
-                    hr = Device->EnqueueMakeResident(D3D12_RESIDENCY_FLAG_NONE,
-                                                     NumObjectsInBatch,
-                                                     &MakeResidentList[BatchStart].pUnderlying,
-                                                     AsyncThreadFence.pFence,
-                                                     AsyncThreadFence.FenceValue + 1);
-                    if (SUCCEEDED(hr))
-                    {
-                        AsyncThreadFence.Increment();
-                        SizeToMakeResident -= BatchSize;
-                    }
+                    Paging.QueueMakeResident(NumObjectsInBatch,
+                                             &MakeResidentList[BatchStart].pUnderlying,
+                                             AsyncThreadFence.FenceValue + 1); // throw( bad_alloc )
+                    AsyncThreadFence.Increment();
+                    SizeToMakeResident -= BatchSize;
                 }
 
-                if (FAILED(hr) || ObjectsMadeResident != MakeResidentList.size())
+                if (ObjectsMadeResident != MakeResidentList.size())
                 {
                     ManagedObject *pResidentHead = LRU.GetResidentListHead();
                     while (pResidentHead && pResidentHead->IsPinned())
                     {
-                        pResidentHead = CONTAINING_RECORD(pResidentHead->ListEntry.Flink, ManagedObject, ListEntry);
+                        pResidentHead = LRU.GetResidentObjectAfter(&pResidentHead->ListEntry);
                     }
 
                     // If there is nothing to trim OR the only objects 'Resident' are the ones about to be used by this execute.
@@ -349,34 +610,26 @@ HRESULT ResidencyManager::ProcessPagingWork(UINT CommandListIndex, ResidencySet
                             MakeResidentList[i].pUnderlying = MakeResidentList[i].pManagedObject->pUnderlying;
                         }
 
-                        hr = Device->EnqueueMakeResident(D3D12_RESIDENCY_FLAG_NONE,
-                                                         NumObjects,
-                                                         &MakeResidentList[MakeResidentIndex].pUnderlying,
-                                                         AsyncThreadFence.pFence,
-                                                         AsyncThreadFence.FenceValue + 1);
-                        if (SUCCEEDED(hr))
-                        {
-                            AsyncThreadFence.Increment();
-                        }
-                        if (FAILED(hr))
-                        {
-                            // TODO: What should we do if this fails? This is a catastrophic failure in which the app is trying to use more memory
-                            //       in 1 command list than can possibly be made resident by the system.
-                            assert(SUCCEEDED(hr));
-                        }
+                        Paging.QueueMakeResident(NumObjects,
+                                                 &MakeResidentList[MakeResidentIndex].pUnderlying,
+                                                 AsyncThreadFence.FenceValue + 1); // throw( bad_alloc )
+                        AsyncThreadFence.Increment();
                         break;
                     }
 
-                    // Wait until the GPU is done
+                    // Rather than waiting here until the GPU is done, the paging thread waits before evicting,
+                    // and the queue waits for the paging thread before executing.
                     UINT64 *FenceValuesToWaitFor = pResidentHead ? pResidentHead->LastUsedFenceValues : LastSubmittedFenceValues;
-                    WaitForSyncPoint(FenceValuesToWaitFor);
                     std::copy(FenceValuesToWaitFor, FenceValuesToWaitFor + (UINT)COMMAND_LIST_TYPE::MAX_VALID, WaitedFenceValues);
 
                     EvictionList.clear();
+                    Paging.ReserveEvict(EvictStorage, LRU.NumResidentObjects); // throw( bad_alloc )
                     LRU.TrimToSyncPointInclusive(TotalUsage + INT64(SizeToMakeResident), TotalBudget, EvictionList, WaitedFenceValues);
 
-                    [[maybe_unused]] HRESULT hrEvict = Device->Evict((UINT)EvictionList.size(), EvictionList.data());
-                    assert(SUCCEEDED(hrEvict));
+                    if (!EvictionList.empty())
+                    {
+                        Paging.QueueEvict(EvictStorage, EvictionList, WaitFences, WaitedFenceValues);
+                    }
                 }
                 else
                 {
@@ -388,10 +641,39 @@ HRESULT ResidencyManager::ProcessPagingWork(UINT CommandListIndex, ResidencySet
 
         MakeResidentList.clear();
         EvictionList.clear();
+
+        LastSubmitBytesMadeResident.store(LRU.TotalMadeResidentSize.load(std::memory_order_relaxed) - MadeResidentSizeBefore, std::memory_order_relaxed);
+        LastSubmitBytesEvicted.store(LRU.TotalEvictedSize.load(std::memory_order_relaxed) - EvictedSizeBefore, std::memory_order_relaxed);
+        NumSubmits.fetch_add(1, std::memory_order_relaxed);
         return hr;
     }
 }
 
+ResidencyStatistics ResidencyManager::GetStatistics() const noexcept
+{
+    ResidencyStatistics Stats = {};
+    Stats.NumSubmits = NumSubmits.load(std::memory_order_relaxed);
+    Stats.BytesMadeResident = LRU.TotalMadeResidentSize.load(std::memory_order_relaxed);
+    Stats.BytesEvicted = LRU.TotalEvictedSize.load(std::memory_order_relaxed);
+    Stats.LastSubmitBytesMadeResident = LastSubmitBytesMadeResident.load(std::memory_order_relaxed);
+    Stats.LastSubmitBytesEvicted = LastSubmitBytesEvicted.load(std::memory_order_relaxed);
+    Stats.NumEvictionWaits = Paging.GetNumSyncPointWaits();
+    Stats.EvictionWaitTimeUs = TicksToMicroseconds(Paging.GetSyncPointWaitTicks(), TicksPerSecond);
+    return Stats;
+}
+
+HRESULT ResidencyManager::SetResidencyPriority(ManagedObject* pObject, D3D12_RESIDENCY_PRIORITY Priority)
+{
+    {
+        std::lock_guard Lock(Mutex);
+        pObject->PriorityClass =
+            Priority >= D3D12_RESIDENCY_PRIORITY_HIGH ? ManagedObject::PRIORITY_CLASS::HIGH :
+            Priority <= D3D12_RESIDENCY_PRIORITY_LOW ? ManagedObject::PRIORITY_CLASS::LOW :
+            ManagedObject::PRIORITY_CLASS::NORMAL;
+    }
+    return SetDevicePriority(pObject, Priority);
+}
+
 static void GetDXCoreBudget(IDXCoreAdapter *AdapterDXCore, UINT NodeIndex, DXCoreAdapterMemoryBudget *InfoOut, DXCoreSegmentGroup Segment)
 {
     DXCoreAdapterMemoryBudgetNodeSegmentGroup InputParams = {};
@@ -431,12 +713,4 @@ void ResidencyManager::GetCurrentBudget(UINT64 Timestamp, DXCoreAdapterMemoryBud
     }
     *InfoOut = CachedBudget;
 }
-
-void ResidencyManager::WaitForSyncPoint(UINT64 FenceValues[])
-{
-    for (UINT i = 0; i < (UINT)COMMAND_LIST_TYPE::MAX_VALID; ++i)
-    {
-        ImmCtx.WaitForFenceValue((COMMAND_LIST_TYPE)i, FenceValues[i]);
-    }
-}
 }
@@ -373,6 +373,21 @@ namespace D3D12TranslationLayer
         m_isValid = false; // Tag deleted resources for easy inspection in a debugger
     }
 
+    // Targets written by the GPU are the most expensive to page back in mid-frame, and objects which can't be
+    // bound at all (staging, upload and readback) are the cheapest to lose.
+    static ManagedObject::PRIORITY_CLASS GetResidencyPriorityClass(UINT BindFlags)
+    {
+        if (BindFlags & (RESOURCE_BIND_RENDER_TARGET | RESOURCE_BIND_DEPTH_STENCIL | RESOURCE_BIND_UNORDERED_ACCESS))
+        {
+            return ManagedObject::PRIORITY_CLASS::HIGH;
+        }
+        if (BindFlags == RESOURCE_BIND_NONE)
+        {
+            return ManagedObject::PRIORITY_CLASS::LOW;
+        }
+        return ManagedObject::PRIORITY_CLASS::NORMAL;
+    }
+
     void Resource::AddToResidencyManager(bool bIsResident)
     {
         if (m_Identity 
@@ -386,7 +401,8 @@ namespace D3D12TranslationLayer
             D3D12_RESOURCE_DESC resourceDesc12 = m_creationArgs.m_desc12;
             D3D12_RESOURCE_ALLOCATION_INFO allocInfo = m_pParent->m_pDevice12->GetResourceAllocationInfo(m_pParent->GetNodeMask(), 1, &resourceDesc12);
 
-            m_Identity->m_pResidencyHandle->Initialize(m_Identity->GetResource(), allocInfo.SizeInBytes, bIsResident);
+            m_Identity->m_pResidencyHandle->Initialize(m_Identity->GetResource(), allocInfo.SizeInBytes, bIsResident,
+                GetResidencyPriorityClass(m_creationArgs.m_appDesc.BindFlags()));
         }
     }
 
@@ -645,6 +661,7 @@ namespace D3D12TranslationLayer
         ResetLastUsedInCommandList();
 
         m_DesiredState.Reset();
+        ++m_DesiredStateVersion;
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
@@ -15,6 +15,23 @@ namespace D3D12TranslationLayer
         return m_spSubresourceInfo[SubresourceIndex];
     }
 
+    //----------------------------------------------------------------------------------------------------------------------------------
+    UINT CDesiredResourceState::GetSubresourceRunEnd(UINT SubresourceIndex, UINT MaxEnd) const noexcept
+    {
+        if (AreAllSubresourcesSame())
+        {
+            return UINT_MAX;
+        }
+        SubresourceInfo const& Info = m_spSubresourceInfo[SubresourceIndex];
+        const UINT ScanEnd = static_cast<UINT>(std::min<size_t>(MaxEnd, m_spSubresourceInfo.size()));
+        UINT End = SubresourceIndex + 1;
+        while (End < ScanEnd && m_spSubresourceInfo[End] == Info)
+        {
+            ++End;
+        }
+        return End;
+    }
+
     //----------------------------------------------------------------------------------------------------------------------------------
     void CDesiredResourceState::SetResourceState(SubresourceInfo const & Info) noexcept
     {
@@ -44,28 +61,14 @@ namespace D3D12TranslationLayer
         SetResourceState(SubresourceInfo{});
     }
 
-    //----------------------------------------------------------------------------------------------------------------------------------
-    void CCurrentResourceState::ConvertToSubresourceTracking() noexcept
-    {
-        if (m_bAllSubresourcesSame && m_spExclusiveState.size() > 1)
-        {
-            static_assert(std::extent_v<decltype(m_spExclusiveState.m_InlineArray)> == 1, "Otherwise this fill doesn't work");
-            std::fill(m_spExclusiveState.m_Extra.begin(), m_spExclusiveState.m_Extra.end(), m_spExclusiveState[0]);
-            if (!m_pSharedState.empty())
-            {
-                static_assert(std::extent_v<decltype(m_pSharedState.m_InlineArray)> == 1, "Otherwise this fill doesn't work");
-                std::fill(m_pSharedState.m_Extra.begin(), m_pSharedState.m_Extra.end(), m_pSharedState[0]);
-            }
-            m_bAllSubresourcesSame = false;
-        }
-    }
-
     //----------------------------------------------------------------------------------------------------------------------------------
     CCurrentResourceState::CCurrentResourceState(UINT SubresourceCount, bool bSimultaneousAccess, void*& pPreallocatedMemory) noexcept
         : m_bSimultaneousAccess(bSimultaneousAccess)
         , m_spExclusiveState(SubresourceCount, pPreallocatedMemory)
         , m_pSharedState(bSimultaneousAccess ? SubresourceCount : 0u, pPreallocatedMemory)
+        , m_spRunStart(SubresourceCount, pPreallocatedMemory)
     {
+        m_spRunStart[0] = 0;
         m_spExclusiveState[0] = ExclusiveState{};
         if (bSimultaneousAccess)
         {
@@ -74,6 +77,110 @@ namespace D3D12TranslationLayer
         }
     }
 
+    //----------------------------------------------------------------------------------------------------------------------------------
+    UINT CCurrentResourceState::FindRun(UINT SubresourceIndex) const noexcept
+    {
+        if (m_NumRuns == 1)
+        {
+            return 0;
+        }
+        assert(SubresourceIndex < GetNumSubresources());
+
+        // Find the last run which starts at or before the subresource.
+        UINT Low = 0, High = m_NumRuns;
+        while (High - Low > 1)
+        {
+            UINT Mid = Low + (High - Low) / 2;
+            if (m_spRunStart[Mid] <= SubresourceIndex)
+            {
+                Low = Mid;
+            }
+            else
+            {
+                High = Mid;
+            }
+        }
+        return Low;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    bool CCurrentResourceState::AreRunsEqual(UINT RunA, UINT RunB) const noexcept
+    {
+        ExclusiveState const& A = m_spExclusiveState[RunA];
+        ExclusiveState const& B = m_spExclusiveState[RunB];
+        if (A.FenceValue != B.FenceValue ||
+            A.State != B.State ||
+            A.CommandListType != B.CommandListType ||
+            A.IsMostRecentlyExclusiveState != B.IsMostRecentlyExclusiveState)
+        {
+            return false;
+        }
+        if (!m_pSharedState.empty())
+        {
+            SharedState const& SharedA = m_pSharedState[RunA];
+            SharedState const& SharedB = m_pSharedState[RunB];
+            return std::equal(std::begin(SharedA.FenceValues), std::end(SharedA.FenceValues), std::begin(SharedB.FenceValues)) &&
+                   std::equal(std::begin(SharedA.State), std::end(SharedA.State), std::begin(SharedB.State));
+        }
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void CCurrentResourceState::CopyRun(UINT DestRun, UINT SrcRun) noexcept
+    {
+        m_spRunStart[DestRun] = m_spRunStart[SrcRun];
+        m_spExclusiveState[DestRun] = m_spExclusiveState[SrcRun];
+        if (!m_pSharedState.empty())
+        {
+            m_pSharedState[DestRun] = m_pSharedState[SrcRun];
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    UINT CCurrentResourceState::SplitRun(UINT SubresourceIndex) noexcept
+    {
+        if (SubresourceIndex >= GetNumSubresources())
+        {
+            return m_NumRuns;
+        }
+        UINT Run = FindRun(SubresourceIndex);
+        if (m_spRunStart[Run] == SubresourceIndex)
+        {
+            return Run;
+        }
+
+        // Runs are never empty, so there's always room for another one while any run spans multiple subresources.
+        assert(m_NumRuns < GetNumSubresources());
+        for (UINT i = m_NumRuns; i > Run + 1; --i)
+        {
+            CopyRun(i, i - 1);
+        }
+        ++m_NumRuns;
+        CopyRun(Run + 1, Run);
+        m_spRunStart[Run + 1] = SubresourceIndex;
+        return Run + 1;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void CCurrentResourceState::MergeRuns(UINT FirstRun, UINT EndRun) noexcept
+    {
+        // Compact in place: runs in the affected window fold into the last kept run when identical,
+        // and the tail is shifted down once.
+        UINT Kept = FirstRun > 0 ? FirstRun - 1 : 0;
+        for (UINT Run = Kept + 1; Run < m_NumRuns; ++Run)
+        {
+            if (Run <= EndRun && AreRunsEqual(Kept, Run))
+            {
+                continue;
+            }
+            if (++Kept != Run)
+            {
+                CopyRun(Kept, Run);
+            }
+        }
+        m_NumRuns = Kept + 1;
+    }
+
     //----------------------------------------------------------------------------------------------------------------------------------
     bool CCurrentResourceState::IsExclusiveState(UINT SubresourceIndex) const noexcept
     {
@@ -81,17 +188,13 @@ namespace D3D12TranslationLayer
         {
             return true;
         }
-        if (AreAllSubresourcesSame())
-        {
-            SubresourceIndex = 0;
-        }
-        return m_spExclusiveState[SubresourceIndex].IsMostRecentlyExclusiveState;
+        return m_spExclusiveState[FindRun(SubresourceIndex)].IsMostRecentlyExclusiveState;
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
     void CCurrentResourceState::SetExclusiveResourceState(ExclusiveState const& State) noexcept
     {
-        m_bAllSubresourcesSame = true;
+        m_NumRuns = 1;
         m_spExclusiveState[0] = State;
         if (!m_pSharedState.empty())
         {
@@ -103,66 +206,65 @@ namespace D3D12TranslationLayer
     void CCurrentResourceState::SetSharedResourceState(COMMAND_LIST_TYPE Type, UINT64 FenceValue, D3D12_RESOURCE_STATES State) noexcept
     {
         assert(!IsD3D12WriteState(State, SubresourceTransitionFlags::None));
-        m_bAllSubresourcesSame = true;
+        m_NumRuns = 1;
         m_spExclusiveState[0].IsMostRecentlyExclusiveState = false;
         m_pSharedState[0].FenceValues[(UINT)Type] = FenceValue;
         m_pSharedState[0].State[(UINT)Type] = State;
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
-    void CCurrentResourceState::SetExclusiveSubresourceState(UINT SubresourceIndex, ExclusiveState const& State) noexcept
+    void CCurrentResourceState::SetExclusiveSubresourceRangeState(UINT FirstSubresource, UINT NumSubresources, ExclusiveState const& State) noexcept
     {
-        ConvertToSubresourceTracking();
-        m_spExclusiveState[SubresourceIndex] = State;
-        if (!m_pSharedState.empty())
+        assert(NumSubresources > 0 && FirstSubresource + NumSubresources <= GetNumSubresources());
+        UINT FirstRun = SplitRun(FirstSubresource);
+        UINT EndRun = SplitRun(FirstSubresource + NumSubresources);
+        for (UINT Run = FirstRun; Run < EndRun; ++Run)
         {
-            m_pSharedState[SubresourceIndex] = SharedState{};
+            m_spExclusiveState[Run] = State;
+            if (!m_pSharedState.empty())
+            {
+                m_pSharedState[Run] = SharedState{};
+            }
         }
+        MergeRuns(FirstRun, EndRun);
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
-    void CCurrentResourceState::SetSharedSubresourceState(UINT SubresourceIndex, COMMAND_LIST_TYPE Type, UINT64 FenceValue, D3D12_RESOURCE_STATES State) noexcept
+    void CCurrentResourceState::SetSharedSubresourceRangeState(UINT FirstSubresource, UINT NumSubresources, COMMAND_LIST_TYPE Type, UINT64 FenceValue, D3D12_RESOURCE_STATES State) noexcept
     {
         assert(!IsD3D12WriteState(State, SubresourceTransitionFlags::None));
-        ConvertToSubresourceTracking();
-        m_spExclusiveState[SubresourceIndex].IsMostRecentlyExclusiveState = false;
-        m_pSharedState[SubresourceIndex].FenceValues[(UINT)Type] = FenceValue;
-        m_pSharedState[SubresourceIndex].State[(UINT)Type] = State;
+        assert(NumSubresources > 0 && FirstSubresource + NumSubresources <= GetNumSubresources());
+        UINT FirstRun = SplitRun(FirstSubresource);
+        UINT EndRun = SplitRun(FirstSubresource + NumSubresources);
+        for (UINT Run = FirstRun; Run < EndRun; ++Run)
+        {
+            m_spExclusiveState[Run].IsMostRecentlyExclusiveState = false;
+            m_pSharedState[Run].FenceValues[(UINT)Type] = FenceValue;
+            m_pSharedState[Run].State[(UINT)Type] = State;
+        }
+        MergeRuns(FirstRun, EndRun);
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
     auto CCurrentResourceState::GetExclusiveSubresourceState(UINT SubresourceIndex) const noexcept -> ExclusiveState const&
     {
-        if (AreAllSubresourcesSame())
-        {
-            SubresourceIndex = 0;
-        }
-        return m_spExclusiveState[SubresourceIndex];
+        return m_spExclusiveState[FindRun(SubresourceIndex)];
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
     auto CCurrentResourceState::GetSharedSubresourceState(UINT SubresourceIndex) const noexcept -> SharedState const&
     {
         assert(!IsExclusiveState(SubresourceIndex));
-        if (AreAllSubresourcesSame())
-        {
-            SubresourceIndex = 0;
-        }
-        return m_pSharedState[SubresourceIndex];
+        return m_pSharedState[FindRun(SubresourceIndex)];
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
     UINT CCurrentResourceState::GetCommandListTypeMask() const noexcept
     {
-        if (AreAllSubresourcesSame())
-        {
-            return GetCommandListTypeMask(0);
-        }
         UINT TypeMask = 0;
-        assert(m_spExclusiveState.size() < MAXUINT);
-        for (UINT i = 0; i < static_cast<UINT>(m_spExclusiveState.size()); ++i)
+        for (UINT Run = 0; Run < m_NumRuns; ++Run)
         {
-            TypeMask |= GetCommandListTypeMask(i);
+            TypeMask |= GetCommandListTypeMask(m_spRunStart[Run]);
         }
         return TypeMask;
     }
@@ -177,7 +279,7 @@ namespace D3D12TranslationLayer
         UINT TypeMask = 0;
         for (auto range : Subresources)
         {
-            for (UINT i = range.first; i < range.second; ++i)
+            for (UINT i = range.first; i < range.second; i = GetSubresourceRunEnd(i))
             {
                 TypeMask |= GetCommandListTypeMask(i);
             }
@@ -210,7 +312,7 @@ namespace D3D12TranslationLayer
     //----------------------------------------------------------------------------------------------------------------------------------
     void CCurrentResourceState::Reset() noexcept
     {
-        m_bAllSubresourcesSame = true;
+        m_NumRuns = 1;
         m_spExclusiveState[0] = ExclusiveState{};
         if (!m_pSharedState.empty())
         {
@@ -218,6 +320,45 @@ namespace D3D12TranslationLayer
         }
     }
 
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void UAVBarrierTracker::AddAccess(ID3D12Resource* pResource, AccessStamp const& LastAccess, UINT64 CommandListID) noexcept
+    {
+        if (LastAccess.CommandListID != CommandListID || LastAccess.BarrierEpoch != m_BarrierEpoch)
+        {
+            return;
+        }
+        if (std::any_of(m_vBarriers.begin(), m_vBarriers.end(), [pResource](D3D12_RESOURCE_BARRIER const& Barrier) { return Barrier.UAV.pResource == pResource; }))
+        {
+            ++m_NumElided;
+            return;
+        }
+        assert(m_vBarriers.size() < m_vBarriers.capacity());
+        m_vBarriers.push_back({ D3D12_RESOURCE_BARRIER_TYPE_UAV });
+        m_vBarriers.back().UAV.pResource = pResource;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    std::vector<D3D12_RESOURCE_BARRIER>& UAVBarrierTracker::TakeBarriers(UINT& NumElided) noexcept
+    {
+        if (m_vBarriers.size() > 1)
+        {
+            m_NumElided += (UINT)m_vBarriers.size() - 1;
+            m_vBarriers.resize(1);
+            m_vBarriers[0].UAV.pResource = nullptr;
+        }
+        if (!m_vBarriers.empty() && m_vBarriers[0].UAV.pResource == nullptr)
+        {
+            // Accesses stamped after this barrier are in the new epoch, and need barriers again.
+            ++m_BarrierEpoch;
+        }
+
+        NumElided = m_NumElided;
+        m_NumElided = 0;
+        std::swap(m_vBarriers, m_vTakenBarriers);
+        m_vBarriers.clear();
+        return m_vTakenBarriers;
+    }
+
     //----------------------------------------------------------------------------------------------------------------------------------
     ResourceStateManagerBase::ResourceStateManagerBase() noexcept(false)
     {
@@ -243,10 +384,21 @@ namespace D3D12TranslationLayer
                (NewState.Flags & SubresourceTransitionFlags::TransitionPreDraw) != SubresourceTransitionFlags::None;
     }
 
+    //----------------------------------------------------------------------------------------------------------------------------------
+    static void UpdateDesiredStateVersion(TransitionableResourceBase& Resource,
+                                          CDesiredResourceState::SubresourceInfo const& State) noexcept
+    {
+        if ((State.Flags & SubresourceTransitionFlags::TransitionPreDraw) == SubresourceTransitionFlags::None)
+        {
+            ++Resource.m_DesiredStateVersion;
+        }
+    }
+
     //----------------------------------------------------------------------------------------------------------------------------------
     void ResourceStateManagerBase::TransitionResource(TransitionableResourceBase& Resource,
                                                       CDesiredResourceState::SubresourceInfo const& State) noexcept
     {
+        UpdateDesiredStateVersion(Resource, State);
         if (ShouldIgnoreTransitionRequest(Resource.m_DesiredState.GetSubresourceInfo(0), State))
         {
             return;
@@ -263,6 +415,7 @@ namespace D3D12TranslationLayer
                                                           CViewSubresourceSubset const& Subresources,
                                                           CDesiredResourceState::SubresourceInfo const& State) noexcept
     {
+        UpdateDesiredStateVersion(Resource, State);
         if (Subresources.IsWholeResource())
         {
             if (ShouldIgnoreTransitionRequest(Resource.m_DesiredState.GetSubresourceInfo(0), State))
@@ -296,6 +449,7 @@ namespace D3D12TranslationLayer
                                                          UINT SubresourceIndex,
                                                          CDesiredResourceState::SubresourceInfo const& State) noexcept
     {
+        UpdateDesiredStateVersion(Resource, State);
         Resource.m_DesiredState.SetSubresourceState(SubresourceIndex, State);
         if (!Resource.IsTransitionPending())
         {
@@ -303,6 +457,86 @@ namespace D3D12TranslationLayer
         }
     }
 
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManagerBase::TransitionResourceForUniformBindings(TransitionableResourceBase& Resource, D3D12_RESOURCE_STATES State) noexcept
+    {
+        CDesiredResourceState::SubresourceInfo DesiredState = { State, COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::TransitionPreDraw };
+        TransitionResource(Resource, DesiredState);
+
+        // The request is ignored while a transition which opts out of binding transitions is pending.
+        auto& DestinationState = Resource.m_DesiredState;
+        const bool bApplied = DestinationState.AreAllSubresourcesSame() && DestinationState.GetSubresourceInfo(0) == DesiredState;
+        Resource.m_BindingTransitionVersion = bApplied ? Resource.m_DesiredStateVersion : 0;
+        Resource.m_BindingTransitionState = State;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManagerBase::TransitionResourceForBindings(TransitionableResourceBase& Resource, CResourceBindings const& Bindings) noexcept
+    {
+        if (Bindings.AreAllSubresourcesTheSame())
+        {
+            TransitionResourceForUniformBindings(Resource, Bindings.GetD3D12ResourceUsageFromBindings(0));
+        }
+        else
+        {
+            Resource.m_BindingTransitionVersion = 0;
+            for (UINT i = 0; i < Bindings.GetNumSubresources(); ++i)
+            {
+                CDesiredResourceState::SubresourceInfo DesiredState = { Bindings.GetD3D12ResourceUsageFromBindings(i), COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::TransitionPreDraw };
+                TransitionSubresource(Resource, i, DesiredState);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManagerBase::TransitionSubresourcesForBindings(TransitionableResourceBase& Resource,
+                                                                     CResourceBindings const& Bindings,
+                                                                     CViewSubresourceSubset const& Subresources) noexcept
+    {
+        if (Bindings.AreAllSubresourcesTheSame())
+        {
+            TransitionResourceForUniformBindings(Resource, Bindings.GetD3D12ResourceUsageFromBindings(0));
+        }
+        else
+        {
+            Resource.m_BindingTransitionVersion = 0;
+            for (auto range : Subresources)
+            {
+                for (UINT i = range.first; i < range.second; ++i)
+                {
+                    CDesiredResourceState::SubresourceInfo DesiredState = { Bindings.GetD3D12ResourceUsageFromBindings(i), COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::TransitionPreDraw };
+                    TransitionSubresource(Resource, i, DesiredState);
+                }
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    bool ResourceStateManagerBase::TransitionResourceForChangedBindings(TransitionableResourceBase& Resource, CResourceBindings const& Bindings) noexcept
+    {
+        if (Bindings.AreAllSubresourcesTheSame() &&
+            IsBindingTransitionCurrent(Resource, Bindings.GetD3D12ResourceUsageFromBindings(0)))
+        {
+            return false;
+        }
+        TransitionResourceForBindings(Resource, Bindings);
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    bool ResourceStateManagerBase::TransitionSubresourcesForChangedBindings(TransitionableResourceBase& Resource,
+                                                                            CResourceBindings const& Bindings,
+                                                                            CViewSubresourceSubset const& Subresources) noexcept
+    {
+        if (Bindings.AreAllSubresourcesTheSame() &&
+            IsBindingTransitionCurrent(Resource, Bindings.GetD3D12ResourceUsageFromBindings(0)))
+        {
+            return false;
+        }
+        TransitionSubresourcesForBindings(Resource, Bindings, Subresources);
+        return true;
+    }
+
     //----------------------------------------------------------------------------------------------------------------------------------
     void ResourceStateManagerBase::AddDeferredWait(std::shared_ptr<Fence> const& spFence, UINT64 Value) noexcept(false)
     {
@@ -319,6 +553,7 @@ namespace D3D12TranslationLayer
         m_vDstResourceBarriers.clear();
         m_vTentativeResourceBarriers.clear();
         m_vPostApplyUpdates.clear();
+        m_vSplitBarrierCandidates.clear();
 
         m_DestinationCommandListType = COMMAND_LIST_TYPE::UNKNOWN;
         m_bApplySwapchainDeferredWaits = false;
@@ -362,17 +597,177 @@ namespace D3D12TranslationLayer
     void ResourceStateManagerBase::AddCurrentStateUpdate(TransitionableResourceBase& Resource,
                                                          CCurrentResourceState& CurrentState,
                                                          UINT SubresourceIndex,
+                                                         UINT NumSubresources,
                                                          D3D12_RESOURCE_STATES NewState,
                                                          PostApplyExclusiveState ExclusiveState,
                                                          bool IsGoingToDestinationType) noexcept(false)
     {
         PostApplyUpdate Update =
         {
-            Resource, CurrentState, SubresourceIndex, NewState, ExclusiveState, IsGoingToDestinationType
+            Resource, CurrentState, SubresourceIndex, NumSubresources, NewState, ExclusiveState, IsGoingToDestinationType
         };
         m_vPostApplyUpdates.push_back(Update); // throw( bad_alloc )
     }
 
+    //----------------------------------------------------------------------------------------------------------------------------------
+    /*static*/ void ResourceStateManagerBase::AddTransitionBarriers(std::vector<D3D12_RESOURCE_BARRIER>& Barriers,
+                                                                    D3D12_RESOURCE_BARRIER const& Desc,
+                                                                    UINT NumSubresources) noexcept(false)
+    {
+        if (Desc.Transition.Subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+        {
+            Barriers.push_back(Desc); // throw( bad_alloc )
+            return;
+        }
+
+        Barriers.reserve(Barriers.size() + NumSubresources); // throw( bad_alloc )
+        D3D12_RESOURCE_BARRIER SubresourceDesc = Desc;
+        for (UINT i = 0; i < NumSubresources; ++i)
+        {
+            SubresourceDesc.Transition.Subresource = Desc.Transition.Subresource + i;
+            Barriers.push_back(SubresourceDesc);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManagerBase::RecordBarrierStatistics(std::vector<D3D12_RESOURCE_BARRIER> const& Barriers) noexcept
+    {
+        UINT64 NumSplitBegin = 0, NumSplitEnd = 0;
+        for (auto& Barrier : Barriers)
+        {
+            if (Barrier.Flags & D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY)
+            {
+                ++NumSplitBegin;
+            }
+            else if (Barrier.Flags & D3D12_RESOURCE_BARRIER_FLAG_END_ONLY)
+            {
+                ++NumSplitEnd;
+            }
+        }
+        m_NumSplitBeginBarriers.fetch_add(NumSplitBegin, std::memory_order_relaxed);
+        m_NumSplitEndBarriers.fetch_add(NumSplitEnd, std::memory_order_relaxed);
+        m_NumTransitionBarriers.fetch_add(Barriers.size() - NumSplitBegin - NumSplitEnd, std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    ResourceBarrierStatistics ResourceStateManagerBase::GetBarrierStatistics() const noexcept
+    {
+        ResourceBarrierStatistics Stats = {};
+        Stats.NumTransitionBarriers = m_NumTransitionBarriers.load(std::memory_order_relaxed);
+        Stats.NumSplitBeginBarriers = m_NumSplitBeginBarriers.load(std::memory_order_relaxed);
+        Stats.NumSplitEndBarriers = m_NumSplitEndBarriers.load(std::memory_order_relaxed);
+        Stats.NumUAVBarriers = m_NumUAVBarriers.load(std::memory_order_relaxed);
+        Stats.NumElidedUAVBarriers = m_NumElidedUAVBarriers.load(std::memory_order_relaxed);
+        Stats.NumElidedTransitionBarriers = m_NumElidedTransitionBarriers.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManagerBase::AddSplitBarrierCandidate(TransitionableResourceBase& TransitionableResource,
+                                                            CCurrentResourceState& CurrentState,
+                                                            UINT i,
+                                                            UINT NumSubresources,
+                                                            CDesiredResourceState::SubresourceInfo const& SubresourceDestinationInfo,
+                                                            D3D12_RESOURCE_BARRIER const& TransitionDesc) noexcept(false)
+    {
+        // Only plain same-queue transitions out of a write state into a read state are split. Simultaneous access resources
+        // don't need barriers to change queues, and resources with deferred waits need their waits before their barriers.
+        if (CurrentState.SupportsSimultaneousAccess() ||
+            SubresourceDestinationInfo.CommandListType != COMMAND_LIST_TYPE::GRAPHICS ||
+            SubresourceDestinationInfo.State == UNKNOWN_RESOURCE_STATE ||
+            TransitionableResource.m_bTriggersSwapchainDeferredWaits ||
+            !TransitionableResource.m_ResourceDeferredWaits.empty())
+        {
+            return;
+        }
+
+        auto& CurrentExclusiveState = CurrentState.GetExclusiveSubresourceState(i);
+        D3D12_RESOURCE_STATES after = SubresourceDestinationInfo.State;
+        if (CurrentExclusiveState.CommandListType != COMMAND_LIST_TYPE::GRAPHICS ||
+            !IsD3D12WriteState(CurrentExclusiveState.State, SubresourceTransitionFlags::None) ||
+            IsD3D12WriteState(after, SubresourceDestinationInfo.Flags) ||
+            !TransitionRequired(CurrentExclusiveState.State, /*inout*/ after, SubresourceDestinationInfo.Flags))
+        {
+            return;
+        }
+
+        SplitBarrier Candidate = { TransitionDesc, NumSubresources, SubresourceDestinationInfo, &TransitionableResource, &CurrentState };
+        Candidate.Desc.Transition.StateBefore = CurrentExclusiveState.State;
+        Candidate.Desc.Transition.StateAfter = after;
+        m_vSplitBarrierCandidates.push_back(Candidate); // throw( bad_alloc )
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManagerBase::BeginSplitBarrierCandidates() noexcept(false)
+    {
+        assert(m_DestinationCommandListType == COMMAND_LIST_TYPE::GRAPHICS);
+        m_vPendingSplitBarriers.reserve(m_vPendingSplitBarriers.size() + m_vSplitBarrierCandidates.size()); // throw( bad_alloc )
+        for (auto& Candidate : m_vSplitBarrierCandidates)
+        {
+            Candidate.Desc.Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+            AddTransitionBarriers(m_vDstResourceBarriers, Candidate.Desc, Candidate.NumSubresources); // throw( bad_alloc )
+            AddCurrentStateUpdate(*Candidate.pResource,
+                                  *Candidate.pCurrentState,
+                                  Candidate.Desc.Transition.Subresource,
+                                  Candidate.NumSubresources,
+                                  Candidate.Desc.Transition.StateAfter,
+                                  PostApplyExclusiveState::Exclusive,
+                                  true); // throw( bad_alloc )
+
+            Candidate.pResource = nullptr;
+            Candidate.pCurrentState = nullptr;
+            m_vPendingSplitBarriers.push_back(Candidate);
+        }
+        m_vSplitBarrierCandidates.clear();
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManagerBase::EndSplitBarriers(ID3D12Resource* pTransitioningResource,
+                                                    CDesiredResourceState const& DestinationState,
+                                                    bool bIsPreDraw) noexcept(false)
+    {
+        for (size_t i = 0; i < m_vPendingSplitBarriers.size();)
+        {
+            SplitBarrier& Split = m_vPendingSplitBarriers[i];
+            if (Split.Desc.Transition.pResource != pTransitioningResource)
+            {
+                ++i;
+                continue;
+            }
+
+            // Outside of draws, leave the transition in flight as long as the draw it was begun for is still coming.
+            const UINT FirstSubresource = Split.Desc.Transition.Subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES ?
+                0 : Split.Desc.Transition.Subresource;
+            if (!bIsPreDraw &&
+                DestinationState.GetSubresourceInfo(FirstSubresource) == Split.DesiredInfo &&
+                DestinationState.GetSubresourceRunEnd(FirstSubresource, FirstSubresource + Split.NumSubresources) >= FirstSubresource + Split.NumSubresources)
+            {
+                ++i;
+                continue;
+            }
+
+            // The current state already reflects the end of the transition.
+            Split.Desc.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+            AddTransitionBarriers(m_vSrcResourceBarriers[(UINT)COMMAND_LIST_TYPE::GRAPHICS], Split.Desc, Split.NumSubresources); // throw( bad_alloc )
+            Split = m_vPendingSplitBarriers.back();
+            m_vPendingSplitBarriers.pop_back();
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    std::vector<D3D12_RESOURCE_BARRIER>& ResourceStateManagerBase::TakeSplitEndBarriers() noexcept(false)
+    {
+        m_vSplitEndBarriers.clear();
+        for (auto& Split : m_vPendingSplitBarriers)
+        {
+            Split.Desc.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+            AddTransitionBarriers(m_vSplitEndBarriers, Split.Desc, Split.NumSubresources); // throw( bad_alloc )
+        }
+        m_vPendingSplitBarriers.clear();
+        RecordBarrierStatistics(m_vSplitEndBarriers);
+        return m_vSplitEndBarriers;
+    }
+
     //----------------------------------------------------------------------------------------------------------------------------------
     auto ResourceStateManagerBase::ProcessTransitioningResource(ID3D12Resource* pTransitioningResource,
                                                                 TransitionableResourceBase& TransitionableResource,
@@ -387,7 +782,6 @@ namespace D3D12TranslationLayer
 
         // Figure out the set of subresources that are transitioning
         auto& DestinationState = TransitionableResource.m_DesiredState;
-        bool bAllSubresourcesAtOnce = CurrentState.AreAllSubresourcesSame() && DestinationState.AreAllSubresourcesSame();
         bool bNeedsTransitionToBindState = false;
 
         D3D12_RESOURCE_BARRIER TransitionDesc;
@@ -395,19 +789,44 @@ namespace D3D12TranslationLayer
         TransitionDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
         TransitionDesc.Transition.pResource = pTransitioningResource;
 
-        UINT numSubresources = bAllSubresourcesAtOnce ? 1 : NumTotalSubresources;
-        for (UINT i = 0; i < numSubresources; ++i)
+        if (!m_vPendingSplitBarriers.empty())
+        {
+            EndSplitBarriers(pTransitioningResource, DestinationState, bIsPreDraw); // throw( bad_alloc )
+        }
+
+        // Walk spans of subresources which share both their current and desired state, so that the cost of a transition
+        // scales with the number of distinct ranges rather than the number of subresources. Desired state runs are found by
+        // scanning, so the end of the current one is kept until the walk leaves it.
+        UINT SpanEnd = 0;
+        UINT DesiredRunEnd = 0;
+        for (UINT i = 0; i < NumTotalSubresources; i = SpanEnd)
         {
+            if (i >= DesiredRunEnd)
+            {
+                DesiredRunEnd = DestinationState.GetSubresourceRunEnd(i);
+            }
+            SpanEnd = std::min({ CurrentState.GetSubresourceRunEnd(i), DesiredRunEnd, NumTotalSubresources });
+            const UINT SpanSize = SpanEnd - i;
+
             CDesiredResourceState::SubresourceInfo SubresourceDestinationInfo = DestinationState.GetSubresourceInfo(i);
-            TransitionDesc.Transition.Subresource = bAllSubresourcesAtOnce ? D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES : i;
+            TransitionDesc.Transition.Subresource = (SpanSize == NumTotalSubresources) ? D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES : i;
 
             // Is this subresource relevant for the current transition?
             if ((SubresourceDestinationInfo.Flags & SubresourceTransitionFlags::TransitionPreDraw) != SubresourceTransitionFlags::None &&
                 !bIsPreDraw)
             {
-                // Nope, we'll go to the next subresource, and also indicate to leave this resource in the transition list so that
+                // Nope, we'll go to the next span, and also indicate to leave this resource in the transition list so that
                 // we come back to it on the next draw operation.
                 result = TransitionResult::Keep;
+                if (m_bUseSplitBarriers)
+                {
+                    AddSplitBarrierCandidate(TransitionableResource,
+                                             CurrentState,
+                                             i,
+                                             SpanSize,
+                                             SubresourceDestinationInfo,
+                                             TransitionDesc); // throw( bad_alloc )
+                }
                 continue;
             }
 
@@ -419,20 +838,22 @@ namespace D3D12TranslationLayer
                 (curCmdListType == COMMAND_LIST_TYPE::UNKNOWN &&
                  (Flags & SubresourceTransitionFlags::StateMatchExact) == SubresourceTransitionFlags::None))
             {
-                // This subresource doesn't have any transition requested - move on to the next.
+                // These subresources don't have any transition requested - move on to the next span.
                 continue;
             }
 
 #if DBG
             std::vector<D3D12_RESOURCE_BARRIER>* pBarrierVectors[2 + _countof(m_vSrcResourceBarriers)] = { &m_vTentativeResourceBarriers, &m_vDstResourceBarriers };
             std::transform(m_vSrcResourceBarriers, std::end(m_vSrcResourceBarriers), &pBarrierVectors[2], [](auto& vec) { return &vec; });
-            // This subresource should not already be in any transition list
+            // These subresources should not already be in any transition list, other than to end a split transition
             for (auto pVec : pBarrierVectors)
             {
                 for (auto& desc : *pVec)
                 {
                     assert(!(desc.Transition.pResource == pTransitioningResource &&
-                             desc.Transition.Subresource == TransitionDesc.Transition.Subresource));
+                             desc.Flags != D3D12_RESOURCE_BARRIER_FLAG_END_ONLY &&
+                             (desc.Transition.Subresource == TransitionDesc.Transition.Subresource ||
+                              (desc.Transition.Subresource >= i && desc.Transition.Subresource < SpanEnd))));
                 }
             }
 #endif
@@ -461,10 +882,14 @@ namespace D3D12TranslationLayer
             if ((Flags & SubresourceTransitionFlags::NoBindingTransitions) == SubresourceTransitionFlags::None &&
                 !bIsPreDraw)
             {
-                D3D12_RESOURCE_STATES stateFromBindings = BindingState.GetD3D12ResourceUsageFromBindings(i);
-                if (stateFromBindings != UNKNOWN_RESOURCE_STATE && after != stateFromBindings)
+                const UINT BindingsEnd = BindingState.AreAllSubresourcesTheSame() ? i + 1 : SpanEnd;
+                for (UINT j = i; j < BindingsEnd && !bNeedsTransitionToBindState; ++j)
                 {
-                    bNeedsTransitionToBindState = true;
+                    D3D12_RESOURCE_STATES stateFromBindings = BindingState.GetD3D12ResourceUsageFromBindings(j);
+                    if (stateFromBindings != UNKNOWN_RESOURCE_STATE && after != stateFromBindings)
+                    {
+                        bNeedsTransitionToBindState = true;
+                    }
                 }
             }
             // The NoBindingTransition flag should be set on the whole resource or not at all.
@@ -489,6 +914,7 @@ namespace D3D12TranslationLayer
                 ProcessTransitioningSubresourceExclusive(
                     CurrentState,
                     i,
+                    SpanSize,
                     curCmdListType,
                     CurrentFenceValues,
                     SubresourceDestinationInfo,
@@ -502,6 +928,7 @@ namespace D3D12TranslationLayer
                 ProcessTransitioningSubresourceShared(
                     CurrentState,
                     i,
+                    SpanSize,
                     after,
                     Flags,
                     CurrentFenceValues,
@@ -520,8 +947,8 @@ namespace D3D12TranslationLayer
         if (bNeedsTransitionToBindState)
         {
             result = TransitionResult::Keep;
-            bAllSubresourcesAtOnce = BindingState.AreAllSubresourcesTheSame();
-            numSubresources = bAllSubresourcesAtOnce ? 1 : NumTotalSubresources;
+            bool bAllSubresourcesAtOnce = BindingState.AreAllSubresourcesTheSame();
+            UINT numSubresources = bAllSubresourcesAtOnce ? 1 : NumTotalSubresources;
 
             for (UINT i = 0; i < numSubresources; ++i)
             {
@@ -551,8 +978,8 @@ namespace D3D12TranslationLayer
             assert(!DestinationState.AreAllSubresourcesSame() ||
                 (DestinationState.GetSubresourceInfo(0).Flags & SubresourceTransitionFlags::TransitionPreDraw) != SubresourceTransitionFlags::None);
 
-            bAllSubresourcesAtOnce = DestinationState.AreAllSubresourcesSame();
-            numSubresources = bAllSubresourcesAtOnce ? 1 : NumTotalSubresources;
+            bool bAllSubresourcesAtOnce = DestinationState.AreAllSubresourcesSame();
+            UINT numSubresources = bAllSubresourcesAtOnce ? 1 : NumTotalSubresources;
 
             for (UINT i = 0; i < numSubresources; ++i)
             {
@@ -577,6 +1004,7 @@ namespace D3D12TranslationLayer
     void ResourceStateManagerBase::ProcessTransitioningSubresourceExclusive(
         CCurrentResourceState& CurrentState,
         UINT i,
+        UINT NumSubresources,
         COMMAND_LIST_TYPE curCmdListType,
         _In_reads_((UINT)COMMAND_LIST_TYPE::MAX_VALID) const UINT64* CurrentFenceValues,
         CDesiredResourceState::SubresourceInfo& SubresourceDestinationInfo,
@@ -630,7 +1058,7 @@ namespace D3D12TranslationLayer
 
             if (TransitionRequired(CurrentExclusiveState.State, /*inout*/ after, SubresourceDestinationInfo.Flags))
             {
-                // Case 1: Insert a single concrete barrier.
+                // Case 1: Insert a concrete barrier per subresource.
                 // Note: For simultaneous access resources, barriers go into a tentative list
                 // because further barrier processing may cause us to flush this command queue,
                 // making all simultaneous access resource states decay and then implicitly promote.
@@ -644,7 +1072,7 @@ namespace D3D12TranslationLayer
                 TransitionDesc.Transition.StateBefore = D3D12_RESOURCE_STATES(CurrentExclusiveState.State);
                 TransitionDesc.Transition.StateAfter = D3D12_RESOURCE_STATES(after);
                 assert(TransitionDesc.Transition.StateBefore != TransitionDesc.Transition.StateAfter);
-                TransitionVector.push_back(TransitionDesc); // throw( bad_alloc )
+                AddTransitionBarriers(TransitionVector, TransitionDesc, NumSubresources); // throw( bad_alloc )
 
                 PostExclusiveState = (CurrentState.SupportsSimultaneousAccess() && !IsD3D12WriteState(after, Flags)) ?
                     PostApplyExclusiveState::SharedIfFlushed : PostApplyExclusiveState::Exclusive;
@@ -667,7 +1095,7 @@ namespace D3D12TranslationLayer
                 {
                     TransitionDesc.Transition.StateBefore = D3D12_RESOURCE_STATES(CurrentExclusiveState.State);
                     TransitionDesc.Transition.StateAfter = D3D12_RESOURCE_STATE_COMMON;
-                    m_vSrcResourceBarriers[(UINT)CurrentExclusiveState.CommandListType].push_back(TransitionDesc); // throw( bad_alloc )
+                    AddTransitionBarriers(m_vSrcResourceBarriers[(UINT)CurrentExclusiveState.CommandListType], TransitionDesc, NumSubresources); // throw( bad_alloc )
                 }
 
                 if (after != D3D12_RESOURCE_STATE_COMMON)
@@ -675,7 +1103,7 @@ namespace D3D12TranslationLayer
                     // TODO: Don't do this for SRV or copy src/dest.
                     TransitionDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
                     TransitionDesc.Transition.StateAfter = D3D12_RESOURCE_STATES(after);
-                    m_vDstResourceBarriers.push_back(TransitionDesc); // throw( bad_alloc )
+                    AddTransitionBarriers(m_vDstResourceBarriers, TransitionDesc, NumSubresources); // throw( bad_alloc )
                     bQueueStateUpdate = true;
                 }
             }
@@ -699,6 +1127,7 @@ namespace D3D12TranslationLayer
             AddCurrentStateUpdate(TransitionableResource,
                                   CurrentState,
                                   TransitionDesc.Transition.Subresource,
+                                  NumSubresources,
                                   after,
                                   PostExclusiveState,
                                   SubresourceDestinationInfo.CommandListType != COMMAND_LIST_TYPE::UNKNOWN); // throw( bad_alloc )
@@ -709,6 +1138,7 @@ namespace D3D12TranslationLayer
     void ResourceStateManagerBase::ProcessTransitioningSubresourceShared(
         CCurrentResourceState& CurrentState,
         UINT i,
+        UINT NumSubresources,
         D3D12_RESOURCE_STATES after,
         SubresourceTransitionFlags Flags,
         _In_reads_((UINT)COMMAND_LIST_TYPE::MAX_VALID) const UINT64* CurrentFenceValues,
@@ -743,7 +1173,7 @@ namespace D3D12TranslationLayer
                             TransitionDesc.Transition.StateBefore = D3D12_RESOURCE_STATES(SharedState.State[CommandListType]);
                             TransitionDesc.Transition.StateAfter = D3D12_RESOURCE_STATES(after);
                             assert(TransitionDesc.Transition.StateBefore != TransitionDesc.Transition.StateAfter);
-                            m_vTentativeResourceBarriers.push_back(TransitionDesc); // throw( bad_alloc )
+                            AddTransitionBarriers(m_vTentativeResourceBarriers, TransitionDesc, NumSubresources); // throw( bad_alloc )
                             bQueueStateUpdate = true;
                         }
                     }
@@ -780,6 +1210,7 @@ namespace D3D12TranslationLayer
             AddCurrentStateUpdate(TransitionableResource,
                                   CurrentState,
                                   TransitionDesc.Transition.Subresource,
+                                  NumSubresources,
                                   after,
                                   PostExclusiveState,
                                   curCmdListType != COMMAND_LIST_TYPE::UNKNOWN); // throw( bad_alloc )
@@ -787,12 +1218,24 @@ namespace D3D12TranslationLayer
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
-    void ResourceStateManagerBase::SubmitResourceBarriers(_In_reads_(Count) D3D12_RESOURCE_BARRIER const * pBarriers, UINT Count, _In_ CommandListManager * pManager) noexcept
+    void ResourceStateManagerBase::SubmitResourceBarriers(_In_reads_(Count) D3D12_RESOURCE_BARRIER const * pBarriers, UINT Count, _In_ CommandListManager * pManager) noexcept(false)
     {
         switch (pManager->GetCommandListType())
         {
         case COMMAND_LIST_TYPE::GRAPHICS:
-            pManager->GetGraphicsCommandList()->ResourceBarrier(Count, pBarriers);
+            if (m_bUseEnhancedBarriers)
+            {
+                m_EnhancedBarriers.Translate(pBarriers, Count, EnhancedBarrierTranslator::GetResourceType); // throw( bad_alloc )
+                m_NumElidedTransitionBarriers.fetch_add(m_EnhancedBarriers.GetNumElided(), std::memory_order_relaxed);
+                if (m_EnhancedBarriers.GetNumGroups())
+                {
+                    pManager->GetGraphicsCommandList7()->Barrier(m_EnhancedBarriers.GetNumGroups(), m_EnhancedBarriers.GetGroups());
+                }
+            }
+            else
+            {
+                pManager->GetGraphicsCommandList()->ResourceBarrier(Count, pBarriers);
+            }
             break;
 
         case COMMAND_LIST_TYPE::VIDEO_DECODE:
@@ -841,6 +1284,7 @@ namespace D3D12TranslationLayer
 
                 // Submitting any barriers on a command list indicates it needs to be submitted before we're done.
                 m_bFlushQueues[i] = true;
+                RecordBarrierStatistics(m_vSrcResourceBarriers[i]);
                 SubmitBarriersImpl(m_vSrcResourceBarriers[i], (COMMAND_LIST_TYPE)i);
             }
         }
@@ -885,6 +1329,7 @@ namespace D3D12TranslationLayer
             if (!SrcVec.empty())
             {
                 // TODO: Consider converting these into split barriers and putting ends in m_vDstResourceBarriers.
+                RecordBarrierStatistics(SrcVec);
                 SubmitBarriersImpl(SrcVec, m_DestinationCommandListType);
             }
 
@@ -914,9 +1359,14 @@ namespace D3D12TranslationLayer
             }
         }
 
-        // Step 5: Insert destination barriers
+        // Step 5: Insert destination barriers, and begin split transitions now that we know they're on the graphics queue.
+        if (!m_vSplitBarrierCandidates.empty() && m_DestinationCommandListType == COMMAND_LIST_TYPE::GRAPHICS)
+        {
+            BeginSplitBarrierCandidates(); // throw( bad_alloc )
+        }
         if (!m_vDstResourceBarriers.empty())
         {
+            RecordBarrierStatistics(m_vDstResourceBarriers);
             SubmitBarriersImpl(m_vDstResourceBarriers, m_DestinationCommandListType);
         }
     }
@@ -1013,38 +1463,42 @@ namespace D3D12TranslationLayer
     //----------------------------------------------------------------------------------------------------------------------------------
     void ResourceStateManager::TransitionResourceForBindings(Resource* pResource) noexcept
     {
-        auto& Bindings = pResource->GetBindingState();
-        if (Bindings.AreAllSubresourcesTheSame())
-        {
-            TransitionResource(pResource, Bindings.GetD3D12ResourceUsageFromBindings(0), COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::TransitionPreDraw);
-        }
-        else
-        {
-            for (UINT i = 0; i < pResource->NumSubresources(); ++i)
-            {
-                TransitionSubresource(pResource, i, Bindings.GetD3D12ResourceUsageFromBindings(i), COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::TransitionPreDraw);
-            }
-        }
+        ResourceStateManagerBase::TransitionResourceForBindings(*pResource, pResource->GetBindingState());
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
     void ResourceStateManager::TransitionSubresourcesForBindings(Resource* pResource, CViewSubresourceSubset const & Subresources) noexcept
     {
-        auto& Bindings = pResource->GetBindingState();
-        if (Bindings.AreAllSubresourcesTheSame())
-        {
-            TransitionResource(pResource, Bindings.GetD3D12ResourceUsageFromBindings(0), COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::TransitionPreDraw);
-        }
-        else
+        ResourceStateManagerBase::TransitionSubresourcesForBindings(*pResource, pResource->GetBindingState(), Subresources);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManager::TransitionResourceForChangedBindings(Resource* pResource) noexcept
+    {
+        ResourceStateManagerBase::TransitionResourceForChangedBindings(*pResource, pResource->GetBindingState());
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManager::TransitionSubresourcesForChangedBindings(Resource* pResource, CViewSubresourceSubset const & Subresources) noexcept
+    {
+        ResourceStateManagerBase::TransitionSubresourcesForChangedBindings(*pResource, pResource->GetBindingState(), Subresources);
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManager::EndAllSplitBarriers() noexcept(false)
+    {
+        if (m_vPendingSplitBarriers.empty())
         {
-            for (auto range : Subresources)
-            {
-                for (UINT i = range.first; i < range.second; ++i)
-                {
-                    TransitionSubresource(pResource, i, Bindings.GetD3D12ResourceUsageFromBindings(i), COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::TransitionPreDraw);
-                }
-            }
+            return;
         }
+        auto& Barriers = TakeSplitEndBarriers(); // throw( bad_alloc )
+        SubmitGraphicsBarriers(Barriers.data(), (UINT)Barriers.size()); // throw( bad_alloc )
+    }
+
+    //----------------------------------------------------------------------------------------------------------------------------------
+    void ResourceStateManager::SubmitGraphicsBarriers(_In_reads_(Count) D3D12_RESOURCE_BARRIER const* pBarriers, UINT Count) noexcept(false)
+    {
+        SubmitResourceBarriers(pBarriers, Count, m_ImmCtx.GetCommandListManager(COMMAND_LIST_TYPE::GRAPHICS)); // throw( bad_alloc )
     }
 
     //----------------------------------------------------------------------------------------------------------------------------------
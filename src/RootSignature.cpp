@@ -37,6 +37,8 @@ namespace D3D12TranslationLayer
     void RootSignatureDesc::GetAsD3D12Desc(VersionedRootSignatureDescWithStorage& Storage, ImmediateContext* pParent) const
     {
         const bool bGraphics = (m_Flags & Compute) == 0;
+        const bool bBindless = IsBindless();
+        static constexpr D3D12_ROOT_DESCRIPTOR_FLAGS BindlessIndicesFlags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE;
         constexpr UINT MaxShaderStages = std::extent<decltype(m_ShaderStages)>::value;
         const UINT NumShaderStages = bGraphics ? MaxShaderStages : 1;
 
@@ -79,14 +81,26 @@ namespace D3D12TranslationLayer
                 Storage.Parameter[ParameterIndex].DescriptorTable.NumDescriptorRanges++;
             }
             ++ParameterIndex;
-            Storage.Parameter[ParameterIndex].InitAsDescriptorTable(m_NumSRVSpacesUsed[i], pSRVRanges, Visibility);
-            for (UINT range = 0; range < m_NumSRVSpacesUsed[i]; ++range)
+            if (bBindless)
             {
-                pSRVRanges->Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, Stage.GetSRVBindingCount(), 0, range, range == 0 ? RangeFlags : InterfacesRangeFlags, 0);
-                ++pSRVRanges;
+                Storage.Parameter[ParameterIndex].InitAsConstantBufferView(0, c_BindlessIndicesSpace, BindlessIndicesFlags, Visibility);
+            }
+            else
+            {
+                Storage.Parameter[ParameterIndex].InitAsDescriptorTable(m_NumSRVSpacesUsed[i], pSRVRanges, Visibility);
+                for (UINT range = 0; range < m_NumSRVSpacesUsed[i]; ++range)
+                {
+                    pSRVRanges->Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, Stage.GetSRVBindingCount(), 0, range, range == 0 ? RangeFlags : InterfacesRangeFlags, 0);
+                    ++pSRVRanges;
+                }
             }
             ++ParameterIndex;
-            if (pParent->ComputeOnly())
+            if (bBindless)
+            {
+                assert(!pParent->ComputeOnly());
+                Storage.Parameter[ParameterIndex].InitAsConstantBufferView(1, c_BindlessIndicesSpace, BindlessIndicesFlags, Visibility);
+            }
+            else if (pParent->ComputeOnly())
             {
                 // Dummy descriptor range just to make the root parameter constants line up
                 Storage.Parameter[ParameterIndex].InitAsDescriptorTable(1, &Storage.DescriptorRanges[RangeIndex], Visibility);
@@ -105,8 +119,15 @@ namespace D3D12TranslationLayer
             }
             ++ParameterIndex;
         }
-        Storage.Parameter[ParameterIndex].InitAsDescriptorTable(1, &Storage.DescriptorRanges[RangeIndex], D3D12_SHADER_VISIBILITY_ALL);
-        Storage.DescriptorRanges[RangeIndex++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, GetUAVBindingCount(), 0, 0, RangeFlags);
+        if (bBindless)
+        {
+            Storage.Parameter[ParameterIndex].InitAsConstantBufferView(2, c_BindlessIndicesSpace, BindlessIndicesFlags, D3D12_SHADER_VISIBILITY_ALL);
+        }
+        else
+        {
+            Storage.Parameter[ParameterIndex].InitAsDescriptorTable(1, &Storage.DescriptorRanges[RangeIndex], D3D12_SHADER_VISIBILITY_ALL);
+            Storage.DescriptorRanges[RangeIndex++].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, GetUAVBindingCount(), 0, 0, RangeFlags);
+        }
         ++ParameterIndex;
 
         assert(ParameterIndex <= VersionedRootSignatureDescWithStorage::c_NumParameters);
@@ -118,7 +139,8 @@ namespace D3D12TranslationLayer
             D3D12_ROOT_SIGNATURE_FLAG_ALLOW_STREAM_OUTPUT;
 
         D3D12_ROOT_SIGNATURE_FLAGS Flags = BaseFlags |
-            (bCB14 ? ROOT_SIGNATURE_FLAG_ALLOW_LOW_TIER_RESERVED_HW_CB_LIMIT : D3D12_ROOT_SIGNATURE_FLAG_NONE);
+            (bCB14 ? ROOT_SIGNATURE_FLAG_ALLOW_LOW_TIER_RESERVED_HW_CB_LIMIT : D3D12_ROOT_SIGNATURE_FLAG_NONE) |
+            (bBindless ? D3D12_ROOT_SIGNATURE_FLAG_CBV_SRV_UAV_HEAP_DIRECTLY_INDEXED | D3D12_ROOT_SIGNATURE_FLAG_SAMPLER_HEAP_DIRECTLY_INDEXED : D3D12_ROOT_SIGNATURE_FLAG_NONE);
         Storage.RootDesc.Init_1_1(ParameterIndex, Storage.Parameter, 0, NULL, Flags);
     }
 };
\ No newline at end of file
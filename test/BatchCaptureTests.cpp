@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+// Matches the layout commands are recorded with.
+struct alignas(BatchedContext::BatchPrimitive) CapturedSetPipelineState
+{
+    UINT CommandValue;
+    BatchedContext::CmdSetPipelineState Command;
+};
+
+struct ParsedBatch
+{
+    std::vector<UINT64> PSOIDs;
+    std::vector<UINT64> NewObjectIDs;
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// The objects are never dereferenced, so any distinct non-null address will do.
+static PipelineState* FakePSO(UINT_PTR Address)
+{
+    return reinterpret_cast<PipelineState*>(Address);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static std::wstring GetTempCaptureFileName()
+{
+    wchar_t TempPath[MAX_PATH];
+    wchar_t FileName[MAX_PATH];
+    EXPECT_NE(GetTempPathW(MAX_PATH, TempPath), 0u);
+    EXPECT_NE(GetTempFileNameW(TempPath, L"cap", 0, FileName), 0u);
+    return FileName;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static void AppendSetPipelineState(BatchedContext::BatchStorage& Commands, PipelineState* pPSO)
+{
+    constexpr size_t Size = sizeof(CapturedSetPipelineState) / sizeof(BatchedContext::BatchPrimitive);
+    ASSERT_TRUE(Commands.reserve_contiguous(Size));
+    auto pCmd = reinterpret_cast<CapturedSetPipelineState*>(Commands.append_contiguous_manually(Size));
+    pCmd->CommandValue = BatchedContext::CmdSetPipelineState::CmdValue;
+    pCmd->Command.pPSO = pPSO;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static std::vector<ParsedBatch> ParseCapture(const wchar_t* pFileName)
+{
+    std::vector<ParsedBatch> Batches;
+    MappedFile File(pFileName);
+    const BYTE* pData = File.GetData();
+    const BYTE* pEnd = pData + File.GetSize();
+
+    auto& Header = *reinterpret_cast<CaptureFileHeader const*>(pData);
+    EXPECT_EQ(Header.Magic, CaptureFileHeader::c_Magic);
+    EXPECT_EQ(Header.NumCommandTypes, BatchedContext::c_LastCommand + 1);
+    pData += sizeof(CaptureFileHeader);
+
+    while (pData < pEnd)
+    {
+        auto& BatchHeader = *reinterpret_cast<CaptureBatchHeader const*>(pData);
+        pData += sizeof(CaptureBatchHeader);
+
+        ParsedBatch Batch;
+        EXPECT_EQ(BatchHeader.CommandDataSize, BatchHeader.NumCommands * sizeof(CapturedSetPipelineState));
+        auto pCommands = reinterpret_cast<CapturedSetPipelineState const*>(pData);
+        for (UINT i = 0; i < BatchHeader.NumCommands; ++i)
+        {
+            EXPECT_EQ(pCommands[i].CommandValue, BatchedContext::CmdSetPipelineState::CmdValue);
+            Batch.PSOIDs.push_back(reinterpret_cast<UINT_PTR>(pCommands[i].Command.pPSO));
+        }
+        pData += BatchHeader.CommandDataSize;
+
+        auto pNewObjects = reinterpret_cast<CapturedObject const*>(pData);
+        for (UINT i = 0; i < BatchHeader.NumNewObjects; ++i)
+        {
+            EXPECT_EQ(pNewObjects[i].Type, CapturedObjectType::PipelineState);
+            Batch.NewObjectIDs.push_back(pNewObjects[i].ID);
+        }
+        pData += BatchHeader.NumNewObjects * sizeof(CapturedObject);
+
+        Batches.push_back(std::move(Batch));
+    }
+    EXPECT_EQ(pData, pEnd);
+    return Batches;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchCapture, ObjectsGetStableIDs)
+{
+    std::wstring FileName = GetTempCaptureFileName();
+    {
+        BatchCaptureWriter Writer(FileName.c_str(), 64 * 1024);
+        BatchedContext::BatchStorageAllocator Allocator = { nullptr };
+        BatchedContext::PostBatchActionList NoActions(Allocator);
+
+        BatchedContext::BatchStorage Batch1(Allocator);
+        AppendSetPipelineState(Batch1, FakePSO(0x1000));
+        AppendSetPipelineState(Batch1, FakePSO(0x2000));
+        AppendSetPipelineState(Batch1, FakePSO(0x1000));
+        AppendSetPipelineState(Batch1, nullptr);
+        EXPECT_TRUE(Writer.WriteBatch(Batch1, NoActions, 1));
+
+        BatchedContext::BatchStorage Batch2(Allocator);
+        AppendSetPipelineState(Batch2, FakePSO(0x2000));
+        EXPECT_TRUE(Writer.WriteBatch(Batch2, NoActions, 2));
+    }
+
+    auto Batches = ParseCapture(FileName.c_str());
+    DeleteFileW(FileName.c_str());
+
+    ASSERT_EQ(Batches.size(), 2u);
+    EXPECT_EQ(Batches[0].PSOIDs, (std::vector<UINT64>{ 1, 2, 1, 0 }));
+    EXPECT_EQ(Batches[0].NewObjectIDs, (std::vector<UINT64>{ 1, 2 }));
+    EXPECT_EQ(Batches[1].PSOIDs, (std::vector<UINT64>{ 2 }));
+    EXPECT_TRUE(Batches[1].NewObjectIDs.empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchCapture, ReusedAddressGetsNewID)
+{
+    std::wstring FileName = GetTempCaptureFileName();
+    {
+        BatchCaptureWriter Writer(FileName.c_str(), 64 * 1024);
+        BatchedContext::BatchStorageAllocator Allocator = { nullptr };
+
+        // The first object is destroyed after batch 1, and another one created at the same address.
+        BatchedContext::BatchStorage Batch1(Allocator);
+        AppendSetPipelineState(Batch1, FakePSO(0x1000));
+        AppendSetPipelineState(Batch1, FakePSO(0x2000));
+        BatchedContext::PostBatchActionList Actions1(Allocator);
+        Actions1.AddCallable([]() {}, FakePSO(0x1000));
+        EXPECT_TRUE(Writer.WriteBatch(Batch1, Actions1, 1));
+
+        BatchedContext::BatchStorage Batch2(Allocator);
+        AppendSetPipelineState(Batch2, FakePSO(0x1000));
+        AppendSetPipelineState(Batch2, FakePSO(0x2000));
+        BatchedContext::PostBatchActionList NoActions(Allocator);
+        EXPECT_TRUE(Writer.WriteBatch(Batch2, NoActions, 2));
+    }
+
+    auto Batches = ParseCapture(FileName.c_str());
+    DeleteFileW(FileName.c_str());
+
+    ASSERT_EQ(Batches.size(), 2u);
+    EXPECT_EQ(Batches[0].PSOIDs, (std::vector<UINT64>{ 1, 2 }));
+    EXPECT_EQ(Batches[1].PSOIDs, (std::vector<UINT64>{ 3, 2 }));
+    EXPECT_EQ(Batches[1].NewObjectIDs, (std::vector<UINT64>{ 3 }));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchCapture, FullFileEndsAtLastCompleteBatch)
+{
+    constexpr UINT64 BatchSize = sizeof(CaptureBatchHeader) + sizeof(CapturedSetPipelineState) + sizeof(CapturedObject);
+    std::wstring FileName = GetTempCaptureFileName();
+    {
+        BatchCaptureWriter Writer(FileName.c_str(), sizeof(CaptureFileHeader) + BatchSize + BatchSize / 2);
+        BatchedContext::BatchStorageAllocator Allocator = { nullptr };
+        BatchedContext::PostBatchActionList NoActions(Allocator);
+
+        BatchedContext::BatchStorage Batch1(Allocator);
+        AppendSetPipelineState(Batch1, FakePSO(0x1000));
+        EXPECT_TRUE(Writer.WriteBatch(Batch1, NoActions, 1));
+
+        BatchedContext::BatchStorage Batch2(Allocator);
+        AppendSetPipelineState(Batch2, FakePSO(0x2000));
+        EXPECT_FALSE(Writer.WriteBatch(Batch2, NoActions, 2));
+        EXPECT_FALSE(Writer.WriteBatch(Batch1, NoActions, 3));
+    }
+
+    auto Batches = ParseCapture(FileName.c_str());
+    DeleteFileW(FileName.c_str());
+
+    ASSERT_EQ(Batches.size(), 1u);
+    EXPECT_EQ(Batches[0].PSOIDs, (std::vector<UINT64>{ 1 }));
+}
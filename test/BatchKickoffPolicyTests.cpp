@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static UINT64 TicksForSeconds(double Seconds)
+{
+    LARGE_INTEGER Frequency;
+    QueryPerformanceFrequency(&Frequency);
+    return UINT64(double(Frequency.QuadPart) * Seconds);
+}
+
+// Feeds the policy a steady state where each command takes the given time to record and to dispatch.
+static void Train(AdaptiveBatchKickoffPolicy& Policy, double RecordingSecondsPerCommand, double DispatchSecondsPerCommand, UINT NumOutstandingBatches)
+{
+    constexpr UINT c_NumCommands = 100;
+    Policy.OnBatchProcessed(c_NumCommands, TicksForSeconds(DispatchSecondsPerCommand * c_NumCommands));
+    Policy.OnBatchSubmitted(c_NumCommands, NumOutstandingBatches, TicksForSeconds(RecordingSecondsPerCommand * c_NumCommands));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FixedBatchKickoffPolicy, IgnoresMeasurements)
+{
+    FixedBatchKickoffPolicy Policy(10, 5);
+    Policy.OnBatchProcessed(100, TicksForSeconds(1.0));
+    Policy.OnBatchSubmitted(100, 3, TicksForSeconds(1.0));
+    EXPECT_EQ(Policy.GetKickoffThreshold(), 10u);
+    EXPECT_EQ(Policy.GetMaxOutstandingBatches(), 5u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(AdaptiveBatchKickoffPolicy, KeepsDefaultsUntilWorkerIsMeasured)
+{
+    AdaptiveBatchKickoffPolicy Policy;
+    Policy.OnBatchSubmitted(100, 1, TicksForSeconds(1e-3));
+    EXPECT_EQ(Policy.GetKickoffThreshold(), AdaptiveBatchKickoffPolicy::c_InitialKickoffThreshold);
+    EXPECT_EQ(Policy.GetMaxOutstandingBatches(), AdaptiveBatchKickoffPolicy::c_MaxOutstandingBatches);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(AdaptiveBatchKickoffPolicy, ThresholdCoversTargetBatchTime)
+{
+    // 1us per command, so 50us of work is 50 commands.
+    AdaptiveBatchKickoffPolicy Policy;
+    Train(Policy, 0.1e-6, 1e-6, 0);
+    EXPECT_NEAR(double(Policy.GetKickoffThreshold()), 50.0, 1.0);
+    // 100 commands per batch at 1us each is far under the queued time limit.
+    EXPECT_EQ(Policy.GetMaxOutstandingBatches(), AdaptiveBatchKickoffPolicy::c_MaxOutstandingBatches);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(AdaptiveBatchKickoffPolicy, SlowerRecordingThreadSetsThreshold)
+{
+    // Recording at 10us per command dominates, so 50us is 5 commands.
+    AdaptiveBatchKickoffPolicy Policy;
+    Train(Policy, 10e-6, 1e-6, 0);
+    EXPECT_NEAR(double(Policy.GetKickoffThreshold()), 5.0, 1.0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(AdaptiveBatchKickoffPolicy, QueuedBatchesSpreadChecksApart)
+{
+    AdaptiveBatchKickoffPolicy Policy;
+    Train(Policy, 0.1e-6, 1e-6, 1);
+    EXPECT_NEAR(double(Policy.GetKickoffThreshold()), 100.0, 2.0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(AdaptiveBatchKickoffPolicy, ClampsToLimits)
+{
+    AdaptiveBatchKickoffPolicy ExpensivePolicy;
+    Train(ExpensivePolicy, 1e-3, 1e-3, 0);
+    EXPECT_EQ(ExpensivePolicy.GetKickoffThreshold(), AdaptiveBatchKickoffPolicy::c_MinKickoffThreshold);
+    EXPECT_EQ(ExpensivePolicy.GetMaxOutstandingBatches(), AdaptiveBatchKickoffPolicy::c_MinOutstandingBatches);
+
+    AdaptiveBatchKickoffPolicy CheapPolicy;
+    Train(CheapPolicy, 1e-9, 1e-9, 0);
+    EXPECT_EQ(CheapPolicy.GetKickoffThreshold(), AdaptiveBatchKickoffPolicy::c_MaxKickoffThreshold);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(AdaptiveBatchKickoffPolicy, BatchesWithoutRecordingTimeDontSkewRecordingCost)
+{
+    // A batch which only executed nested batches reports no recording time, which mustn't pull the average to 0.
+    AdaptiveBatchKickoffPolicy Policy;
+    Train(Policy, 10e-6, 1e-6, 0);
+    Policy.OnBatchSubmitted(100, 0, 0);
+    EXPECT_NEAR(double(Policy.GetKickoffThreshold()), 5.0, 1.0);
+}
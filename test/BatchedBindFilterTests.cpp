@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+// The filter only compares pointers, so these are never dereferenced.
+template <typename T> static T* FakeObject(UINT_PTR Address) { return reinterpret_cast<T*>(Address * 0x100); }
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchedBindFilter, ElidesRepeatedPipelineState)
+{
+    BatchedBindFilter Filter;
+    EXPECT_FALSE(Filter.FilterPipelineState(nullptr));
+    EXPECT_TRUE(Filter.FilterPipelineState(FakeObject<PipelineState>(1)));
+    EXPECT_FALSE(Filter.FilterPipelineState(FakeObject<PipelineState>(1)));
+    EXPECT_TRUE(Filter.FilterPipelineState(FakeObject<PipelineState>(2)));
+    EXPECT_TRUE(Filter.FilterPipelineState(nullptr));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchedBindFilter, RebindsPipelineStateCreatedAtDestroyedAddress)
+{
+    BatchedBindFilter Filter;
+    PipelineState* pPSO = FakeObject<PipelineState>(1);
+    EXPECT_TRUE(Filter.FilterPipelineState(pPSO));
+
+    // The destroyed pipeline state unbound itself, so a new one at the same address must be bound again.
+    Filter.ObjectDestroyed(pPSO);
+    EXPECT_TRUE(Filter.FilterPipelineState(pPSO));
+
+    // Destroying anything else leaves it bound.
+    Filter.ObjectDestroyed(FakeObject<PipelineState>(2));
+    Filter.ObjectDestroyed(reinterpret_cast<Resource*>(pPSO));
+    EXPECT_FALSE(Filter.FilterPipelineState(pPSO));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchedBindFilter, NarrowsShaderResourcesToChangedRange)
+{
+    BatchedBindFilter Filter;
+    SRV* SRVs[] = { FakeObject<SRV>(1), FakeObject<SRV>(2), FakeObject<SRV>(3), FakeObject<SRV>(4) };
+    UINT First = UINT_MAX, Last = UINT_MAX;
+    EXPECT_TRUE(Filter.FilterShaderResources(e_PS, 2, _countof(SRVs), SRVs, First, Last));
+    EXPECT_EQ(First, 0u);
+    EXPECT_EQ(Last, 4u);
+    EXPECT_FALSE(Filter.FilterShaderResources(e_PS, 2, _countof(SRVs), SRVs, First, Last));
+
+    // Only the middle two entries change.
+    SRV* Changed[] = { SRVs[0], FakeObject<SRV>(5), nullptr, SRVs[3] };
+    EXPECT_TRUE(Filter.FilterShaderResources(e_PS, 2, _countof(Changed), Changed, First, Last));
+    EXPECT_EQ(First, 1u);
+    EXPECT_EQ(Last, 3u);
+
+    // A bind which overlaps the shadowed range only partially is compared slot by slot.
+    SRV* Overlapping[] = { nullptr, nullptr, SRVs[0], FakeObject<SRV>(5) };
+    EXPECT_FALSE(Filter.FilterShaderResources(e_PS, 0, _countof(Overlapping), Overlapping, First, Last));
+    Overlapping[0] = FakeObject<SRV>(6);
+    EXPECT_TRUE(Filter.FilterShaderResources(e_PS, 0, _countof(Overlapping), Overlapping, First, Last));
+    EXPECT_EQ(First, 0u);
+    EXPECT_EQ(Last, 1u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchedBindFilter, TracksStagesIndependently)
+{
+    BatchedBindFilter Filter;
+    SRV* pSRV = FakeObject<SRV>(1);
+    Sampler* pSampler = FakeObject<Sampler>(2);
+    UINT First, Last;
+    EXPECT_TRUE(Filter.FilterShaderResources(e_VS, 0, 1, &pSRV, First, Last));
+    EXPECT_TRUE(Filter.FilterShaderResources(e_PS, 0, 1, &pSRV, First, Last));
+    EXPECT_FALSE(Filter.FilterShaderResources(e_VS, 0, 1, &pSRV, First, Last));
+
+    // Samplers are shadowed separately from shader resources.
+    EXPECT_TRUE(Filter.FilterSamplers(e_CS, 3, 1, &pSampler, First, Last));
+    EXPECT_FALSE(Filter.FilterSamplers(e_CS, 3, 1, &pSampler, First, Last));
+    EXPECT_TRUE(Filter.FilterSamplers(e_GS, 3, 1, &pSampler, First, Last));
+    EXPECT_EQ(First, 0u);
+    EXPECT_EQ(Last, 1u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchedBindFilter, ComparesConstantBufferRanges)
+{
+    BatchedBindFilter Filter;
+    Resource* CBs[] = { FakeObject<Resource>(1), FakeObject<Resource>(2) };
+    UINT FirstConstant[] = { 0, 16 };
+    UINT NumConstants[] = { 16, 32 };
+    UINT First, Last;
+    EXPECT_TRUE(Filter.FilterConstantBuffers(e_VS, 0, 2, CBs, FirstConstant, NumConstants, First, Last));
+    EXPECT_FALSE(Filter.FilterConstantBuffers(e_VS, 0, 2, CBs, FirstConstant, NumConstants, First, Last));
+
+    // Moving the window within the same buffer is a change.
+    FirstConstant[1] = 48;
+    EXPECT_TRUE(Filter.FilterConstantBuffers(e_VS, 0, 2, CBs, FirstConstant, NumConstants, First, Last));
+    EXPECT_EQ(First, 1u);
+    EXPECT_EQ(Last, 2u);
+    NumConstants[0] = 32;
+    EXPECT_TRUE(Filter.FilterConstantBuffers(e_VS, 0, 2, CBs, FirstConstant, NumConstants, First, Last));
+    EXPECT_EQ(First, 0u);
+    EXPECT_EQ(Last, 1u);
+
+    // Null offsets bind the whole buffer, the same as an explicit bind of the maximum size.
+    EXPECT_TRUE(Filter.FilterConstantBuffers(e_VS, 0, 2, CBs, nullptr, nullptr, First, Last));
+    EXPECT_FALSE(Filter.FilterConstantBuffers(e_VS, 0, 2, CBs, nullptr, nullptr, First, Last));
+    UINT WholeFirstConstant[] = { 0, 0 };
+    UINT WholeNumConstants[] = { D3D10_REQ_CONSTANT_BUFFER_ELEMENT_COUNT, D3D10_REQ_CONSTANT_BUFFER_ELEMENT_COUNT };
+    EXPECT_FALSE(Filter.FilterConstantBuffers(e_VS, 0, 2, CBs, WholeFirstConstant, WholeNumConstants, First, Last));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchedBindFilter, ComparesVertexBufferStridesAndOffsets)
+{
+    BatchedBindFilter Filter;
+    Resource* VBs[] = { FakeObject<Resource>(1), FakeObject<Resource>(1), FakeObject<Resource>(2) };
+    UINT Strides[] = { 16, 16, 8 };
+    UINT Offsets[] = { 0, 256, 0 };
+    UINT First, Last;
+    EXPECT_TRUE(Filter.FilterVertexBuffers(1, 3, VBs, Strides, Offsets, First, Last));
+    EXPECT_FALSE(Filter.FilterVertexBuffers(1, 3, VBs, Strides, Offsets, First, Last));
+
+    Strides[2] = 12;
+    EXPECT_TRUE(Filter.FilterVertexBuffers(1, 3, VBs, Strides, Offsets, First, Last));
+    EXPECT_EQ(First, 2u);
+    EXPECT_EQ(Last, 3u);
+
+    Offsets[1] = 512;
+    EXPECT_TRUE(Filter.FilterVertexBuffers(1, 3, VBs, Strides, Offsets, First, Last));
+    EXPECT_EQ(First, 1u);
+    EXPECT_EQ(Last, 2u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchedBindFilter, ComparesBlendFactor)
+{
+    BatchedBindFilter Filter;
+    const FLOAT Zero[4] = {};
+    const FLOAT Half[4] = { 0.5f, 0.5f, 0.5f, 0.5f };
+    EXPECT_FALSE(Filter.FilterBlendFactor(Zero));
+    EXPECT_TRUE(Filter.FilterBlendFactor(Half));
+    EXPECT_FALSE(Filter.FilterBlendFactor(Half));
+    EXPECT_TRUE(Filter.FilterBlendFactor(Zero));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BatchedBindFilter, ClearMatchesClearedState)
+{
+    BatchedBindFilter Filter;
+    PipelineState* pPSO = FakeObject<PipelineState>(1);
+    SRV* pSRV = FakeObject<SRV>(2);
+    Resource* pVB = FakeObject<Resource>(3);
+    UINT Stride = 16, Offset = 0;
+    const FLOAT Half[4] = { 0.5f, 0.5f, 0.5f, 0.5f };
+    UINT First, Last;
+    Filter.FilterPipelineState(pPSO);
+    Filter.FilterShaderResources(e_DS, 5, 1, &pSRV, First, Last);
+    Filter.FilterVertexBuffers(0, 1, &pVB, &Stride, &Offset, First, Last);
+    Filter.FilterBlendFactor(Half);
+
+    Filter.Clear();
+
+    // Everything binds again, and unbinding is redundant.
+    SRV* pNullSRV = nullptr;
+    const FLOAT Zero[4] = {};
+    EXPECT_FALSE(Filter.FilterShaderResources(e_DS, 5, 1, &pNullSRV, First, Last));
+    EXPECT_FALSE(Filter.FilterPipelineState(nullptr));
+    EXPECT_FALSE(Filter.FilterBlendFactor(Zero));
+    EXPECT_TRUE(Filter.FilterPipelineState(pPSO));
+    EXPECT_TRUE(Filter.FilterShaderResources(e_DS, 5, 1, &pSRV, First, Last));
+    EXPECT_TRUE(Filter.FilterVertexBuffers(0, 1, &pVB, &Stride, &Offset, First, Last));
+    EXPECT_TRUE(Filter.FilterBlendFactor(Half));
+}
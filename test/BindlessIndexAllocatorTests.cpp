@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BindlessIndexAllocator, AllocatesEachIndexInItsRangeOnce)
+{
+    CBindlessIndexAllocator Allocator(false);
+    Allocator.Initialize(10, 4);
+
+    for (UINT i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(Allocator.Allocate(0), 10 + i);
+    }
+    EXPECT_EQ(Allocator.Allocate(0), CBindlessIndexAllocator::c_InvalidIndex);
+    EXPECT_EQ(Allocator.GetOldestRetiredFenceValue(), UINT64_MAX);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BindlessIndexAllocator, RecyclesRetiredIndicesOnceTheirFenceCompletes)
+{
+    CBindlessIndexAllocator Allocator(false);
+    Allocator.Initialize(0, 2);
+    EXPECT_EQ(Allocator.Allocate(0), 0u);
+    EXPECT_EQ(Allocator.Allocate(0), 1u);
+
+    // Retired out of order, so the one retired by the earlier command list is recycled first
+    Allocator.Retire(1, 5);
+    Allocator.Retire(0, 3);
+    EXPECT_EQ(Allocator.GetOldestRetiredFenceValue(), 3u);
+
+    EXPECT_EQ(Allocator.Allocate(2), CBindlessIndexAllocator::c_InvalidIndex);
+    EXPECT_EQ(Allocator.Allocate(3), 0u);
+    EXPECT_EQ(Allocator.GetOldestRetiredFenceValue(), 5u);
+    EXPECT_EQ(Allocator.Allocate(4), CBindlessIndexAllocator::c_InvalidIndex);
+    EXPECT_EQ(Allocator.Allocate(5), 1u);
+    EXPECT_EQ(Allocator.GetOldestRetiredFenceValue(), UINT64_MAX);
+    EXPECT_EQ(Allocator.Allocate(5), CBindlessIndexAllocator::c_InvalidIndex);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(BindlessIndexAllocator, PrefersRecycledIndicesToUnusedOnes)
+{
+    CBindlessIndexAllocator Allocator(false);
+    Allocator.Initialize(0, 8);
+    EXPECT_EQ(Allocator.Allocate(0), 0u);
+    EXPECT_EQ(Allocator.Allocate(0), 1u);
+
+    // Keeps the live indices packed at the start of the range
+    Allocator.Retire(0, 1);
+    EXPECT_EQ(Allocator.Allocate(0), 2u);
+    EXPECT_EQ(Allocator.Allocate(1), 0u);
+    EXPECT_EQ(Allocator.Allocate(1), 3u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// With the lock, threads allocating and retiring concurrently never share an index, and no index is lost.
+TEST(BindlessIndexAllocator, MultithreadedIndicesStayUnique)
+{
+    constexpr UINT NumThreads = 8;
+    constexpr UINT NumHeldPerThread = 4;
+    constexpr UINT NumIterations = 20000;
+    constexpr UINT NumIndices = 64;
+    static_assert(NumThreads * NumHeldPerThread <= NumIndices);
+
+    CBindlessIndexAllocator Allocator(true);
+    Allocator.Initialize(0, NumIndices);
+    std::atomic<bool> Owned[NumIndices] = {};
+    std::atomic<UINT> NumFailures{ 0 };
+
+    // Every command list has completed, so retired indices can be recycled straight away
+    std::vector<std::thread> Threads;
+    for (UINT t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]()
+        {
+            UINT Held[NumHeldPerThread];
+            for (UINT i = 0; i < NumIterations; ++i)
+            {
+                for (UINT& Index : Held)
+                {
+                    Index = Allocator.Allocate(UINT64_MAX - 1);
+                    if (Index >= NumIndices || Owned[Index].exchange(true))
+                    {
+                        ++NumFailures;
+                        return;
+                    }
+                }
+                for (UINT Index : Held)
+                {
+                    Owned[Index] = false;
+                    Allocator.Retire(Index, i);
+                }
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+    {
+        Thread.join();
+    }
+    EXPECT_EQ(NumFailures, 0u);
+
+    for (UINT i = 0; i < NumIndices; ++i)
+    {
+        const UINT Index = Allocator.Allocate(UINT64_MAX - 1);
+        ASSERT_LT(Index, NumIndices);
+        EXPECT_FALSE(Owned[Index].exchange(true));
+    }
+    EXPECT_EQ(Allocator.Allocate(UINT64_MAX - 1), CBindlessIndexAllocator::c_InvalidIndex);
+}
@@ -0,0 +1,334 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include "WarpDevice.h"
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Not a multiple of 64, so that the partially used bitmap words are covered
+static constexpr UINT c_NumDescriptorsPerHeap = 100;
+
+struct AllocatedSlot
+{
+    CDescriptorHeapManager::HeapOffset Offset;
+    CDescriptorHeapManager::HeapIndex Index;
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static AllocatedSlot AllocateSlot(CDescriptorHeapManager& Manager)
+{
+    AllocatedSlot Slot;
+    Slot.Offset = Manager.AllocateHeapSlot(&Slot.Index);
+    return Slot;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Allocates from the manager until NumSlots are held, checking that no slot is handed out twice
+static void AllocateUniqueSlots(CDescriptorHeapManager& Manager, UINT NumSlots, std::vector<AllocatedSlot>& Slots)
+{
+    std::set<SIZE_T> Offsets;
+    for (auto& Slot : Slots)
+    {
+        Offsets.insert(Slot.Offset.ptr);
+    }
+    while (Slots.size() < NumSlots)
+    {
+        Slots.push_back(AllocateSlot(Manager));
+        ASSERT_TRUE(Offsets.insert(Slots.back().Offset.ptr).second);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// The free range list that the bitmaps replaced, over plain offsets, as a baseline for the churn benchmark
+class FreeRangeListAllocator
+{
+public:
+    explicit FreeRangeListAllocator(UINT NumSlots) { m_FreeList.push_back({ 0, NumSlots }); }
+
+    UINT Allocate()
+    {
+        FreeRange& Range = m_FreeList.front();
+        UINT Slot = Range.Start++;
+        if (Range.Start == Range.End)
+        {
+            m_FreeList.pop_front();
+        }
+        return Slot;
+    }
+
+    void Free(UINT Slot)
+    {
+        for (auto it = m_FreeList.begin(); it != m_FreeList.end(); ++it)
+        {
+            if (it->Start == Slot + 1)
+            {
+                it->Start = Slot;
+                return;
+            }
+            if (it->End == Slot)
+            {
+                it->End = Slot + 1;
+                return;
+            }
+            if (it->Start > Slot)
+            {
+                m_FreeList.insert(it, { Slot, Slot + 1 });
+                return;
+            }
+        }
+        m_FreeList.push_back({ Slot, Slot + 1 });
+    }
+
+private:
+    struct FreeRange { UINT Start; UINT End; };
+    std::list<FreeRange> m_FreeList;
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(DescriptorHeapManager, AllocatedSlotsAreUnique)
+{
+    auto spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CDescriptorHeapManager Manager(spDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, c_NumDescriptorsPerHeap, false, 1);
+
+    std::vector<AllocatedSlot> Slots;
+    AllocateUniqueSlots(Manager, 3 * c_NumDescriptorsPerHeap, Slots);
+    for (auto& Slot : Slots)
+    {
+        EXPECT_LT(Slot.Index, 3u);
+    }
+
+    // Freed slots are reused before any new heap is created
+    for (auto& Slot : Slots)
+    {
+        Manager.FreeHeapSlot(Slot.Offset, Slot.Index);
+    }
+    Slots.clear();
+    AllocateUniqueSlots(Manager, 3 * c_NumDescriptorsPerHeap, Slots);
+    for (auto& Slot : Slots)
+    {
+        EXPECT_LT(Slot.Index, 3u);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(DescriptorHeapManager, LowestHeapIsPreferred)
+{
+    auto spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CDescriptorHeapManager Manager(spDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, c_NumDescriptorsPerHeap, false, 1);
+
+    std::vector<AllocatedSlot> Slots;
+    AllocateUniqueSlots(Manager, 2 * c_NumDescriptorsPerHeap, Slots);
+
+    // Free the last slot of the second heap, then a slot in the first heap's last bitmap word
+    auto SecondHeapSlot = std::find_if(Slots.rbegin(), Slots.rend(), [](AllocatedSlot const& Slot) { return Slot.Index == 1; });
+    auto FirstHeapSlot = std::find_if(Slots.rbegin(), Slots.rend(), [](AllocatedSlot const& Slot) { return Slot.Index == 0; });
+    ASSERT_NE(SecondHeapSlot, Slots.rend());
+    ASSERT_NE(FirstHeapSlot, Slots.rend());
+    Manager.FreeHeapSlot(SecondHeapSlot->Offset, SecondHeapSlot->Index);
+    Manager.FreeHeapSlot(FirstHeapSlot->Offset, FirstHeapSlot->Index);
+
+    AllocatedSlot First = AllocateSlot(Manager);
+    EXPECT_EQ(First.Index, 0u);
+    EXPECT_EQ(First.Offset.ptr, FirstHeapSlot->Offset.ptr);
+    AllocatedSlot Second = AllocateSlot(Manager);
+    EXPECT_EQ(Second.Index, 1u);
+    EXPECT_EQ(Second.Offset.ptr, SecondHeapSlot->Offset.ptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(DescriptorHeapManager, WriteEpochIsScopedToDescriptorRanges)
+{
+    auto spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CDescriptorHeapManager Manager(spDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, c_NumDescriptorsPerHeap, false, 1);
+
+    // The first and last slots of a heap are more than 64 descriptors apart, so their epochs are kept separately
+    std::vector<AllocatedSlot> Slots;
+    AllocateUniqueSlots(Manager, c_NumDescriptorsPerHeap, Slots);
+    std::sort(Slots.begin(), Slots.end(), [](AllocatedSlot const& a, AllocatedSlot const& b) { return a.Offset.ptr < b.Offset.ptr; });
+    AllocatedSlot First = Slots.front();
+    AllocatedSlot Last = Slots.back();
+    ASSERT_EQ(First.Index, Last.Index);
+
+    const UINT64 FirstEpoch = Manager.GetWriteEpoch(1, &First.Offset);
+    const UINT64 BothEpoch = Manager.GetWriteEpoch(1, &Last.Offset) + FirstEpoch;
+    const CDescriptorHeapManager::HeapOffset Both[] = { First.Offset, Last.Offset };
+    EXPECT_EQ(Manager.GetWriteEpoch(2, Both), BothEpoch);
+
+    Manager.FreeHeapSlot(Last.Offset, Last.Index);
+    EXPECT_EQ(Manager.GetWriteEpoch(1, &First.Offset), FirstEpoch);
+    EXPECT_NE(Manager.GetWriteEpoch(2, Both), BothEpoch);
+
+    Manager.NoteDescriptorRewritten(First.Offset);
+    EXPECT_NE(Manager.GetWriteEpoch(1, &First.Offset), FirstEpoch);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(DescriptorHeapManager, TrimmedHeapEntriesAreReused)
+{
+    auto spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CDescriptorHeapManager Manager(spDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, c_NumDescriptorsPerHeap, true, 1);
+
+    std::vector<AllocatedSlot> Slots;
+    AllocateUniqueSlots(Manager, 4 * c_NumDescriptorsPerHeap, Slots);
+    for (auto& Slot : Slots)
+    {
+        Manager.FreeHeapSlot(Slot.Offset, Slot.Index);
+    }
+
+    // Slots cached in magazines are returned first, so every heap is free, and all but one are released
+    Manager.TrimFreeHeaps();
+
+    Slots.clear();
+    AllocateUniqueSlots(Manager, 4 * c_NumDescriptorsPerHeap, Slots);
+    UINT NumSlotsPerHeap[5] = {};
+    for (auto& Slot : Slots)
+    {
+        ASSERT_LT(Slot.Index, 5u);
+        ++NumSlotsPerHeap[Slot.Index];
+    }
+    for (UINT Count : NumSlotsPerHeap)
+    {
+        EXPECT_LE(Count, c_NumDescriptorsPerHeap);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(DescriptorHeapManager, ConcurrentChurn)
+{
+    auto spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CDescriptorHeapManager Manager(spDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, c_NumDescriptorsPerHeap, true, 1);
+
+    constexpr UINT NumThreads = 8;
+    std::vector<AllocatedSlot> HeldSlots[NumThreads];
+    std::vector<std::thread> Threads;
+    for (UINT t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&Manager, &Slots = HeldSlots[t], t]()
+        {
+            std::mt19937 Random(t);
+            for (UINT i = 0; i < 20000; ++i)
+            {
+                if (Slots.size() < 64 && (Slots.empty() || Random() % 2))
+                {
+                    Slots.push_back(AllocateSlot(Manager));
+                }
+                else
+                {
+                    std::swap(Slots[Random() % Slots.size()], Slots.back());
+                    Manager.FreeHeapSlot(Slots.back().Offset, Slots.back().Index);
+                    Slots.pop_back();
+                }
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+    {
+        Thread.join();
+    }
+
+    std::set<SIZE_T> Offsets;
+    for (auto& Slots : HeldSlots)
+    {
+        for (auto& Slot : Slots)
+        {
+            EXPECT_TRUE(Offsets.insert(Slot.Offset.ptr).second);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(DescriptorHeapManager, ChurnBenchmark)
+{
+    auto spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    using Clock = std::chrono::steady_clock;
+    constexpr UINT NumDescriptorsPerHeap = 4096;
+    constexpr UINT NumLive = 16 * 1024;
+    constexpr UINT BatchSize = 256;
+    constexpr UINT NumBatches = 1000;
+
+    // Same sequence for both: fill, then repeatedly free a batch of random live slots and allocate replacements
+    std::mt19937 Random(1);
+    std::vector<UINT> Indices(NumLive);
+    std::iota(Indices.begin(), Indices.end(), 0);
+    std::vector<UINT> Victims;
+    for (UINT Batch = 0; Batch < NumBatches; ++Batch)
+    {
+        for (UINT i = 0; i < BatchSize; ++i)
+        {
+            std::swap(Indices[i], Indices[i + Random() % (NumLive - i)]);
+        }
+        Victims.insert(Victims.end(), Indices.begin(), Indices.begin() + BatchSize);
+    }
+
+    CDescriptorHeapManager Manager(spDevice, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, NumDescriptorsPerHeap, false, 1);
+    std::vector<AllocatedSlot> Slots;
+    AllocateUniqueSlots(Manager, NumLive, Slots);
+    auto BitmapStart = Clock::now();
+    for (size_t Batch = 0; Batch < Victims.size(); Batch += BatchSize)
+    {
+        for (size_t i = Batch; i < Batch + BatchSize; ++i)
+        {
+            Manager.FreeHeapSlot(Slots[Victims[i]].Offset, Slots[Victims[i]].Index);
+        }
+        for (size_t i = Batch; i < Batch + BatchSize; ++i)
+        {
+            Slots[Victims[i]] = AllocateSlot(Manager);
+        }
+    }
+    auto BitmapEnd = Clock::now();
+
+    FreeRangeListAllocator List(NumLive);
+    std::vector<UINT> ListSlots(NumLive);
+    for (auto& Slot : ListSlots)
+    {
+        Slot = List.Allocate();
+    }
+    auto ListStart = Clock::now();
+    for (size_t Batch = 0; Batch < Victims.size(); Batch += BatchSize)
+    {
+        for (size_t i = Batch; i < Batch + BatchSize; ++i)
+        {
+            List.Free(ListSlots[Victims[i]]);
+        }
+        for (size_t i = Batch; i < Batch + BatchSize; ++i)
+        {
+            ListSlots[Victims[i]] = List.Allocate();
+        }
+    }
+    auto ListEnd = Clock::now();
+
+    const double BitmapNs = std::chrono::duration<double, std::nano>(BitmapEnd - BitmapStart).count() / Victims.size();
+    const double ListNs = std::chrono::duration<double, std::nano>(ListEnd - ListStart).count() / Victims.size();
+    RecordProperty("BitmapNsPerChurn", std::to_string(BitmapNs));
+    RecordProperty("FreeRangeListNsPerChurn", std::to_string(ListNs));
+    std::cout << "CDescriptorHeapManager: " << BitmapNs << " ns/churn, free range list: " << ListNs << " ns/churn\n";
+}
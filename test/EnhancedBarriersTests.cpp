@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+// The translator never dereferences resources, so fake pointers identify them.
+static ID3D12Resource* const c_pTexture = reinterpret_cast<ID3D12Resource*>(0x1000);
+static ID3D12Resource* const c_pSimultaneousTexture = reinterpret_cast<ID3D12Resource*>(0x2000);
+static ID3D12Resource* const c_pBuffer = reinterpret_cast<ID3D12Resource*>(0x3000);
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static EnhancedBarrierResourceType GetTestResourceType(ID3D12Resource* pResource)
+{
+    if (pResource == c_pTexture)
+    {
+        return EnhancedBarrierResourceType::Texture;
+    }
+    if (pResource == c_pSimultaneousTexture)
+    {
+        return EnhancedBarrierResourceType::SimultaneousAccessTexture;
+    }
+    EXPECT_EQ(pResource, c_pBuffer);
+    return EnhancedBarrierResourceType::Buffer;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static D3D12_RESOURCE_BARRIER Transition(ID3D12Resource* pResource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After,
+                                         UINT Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+                                         D3D12_RESOURCE_BARRIER_FLAGS Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE)
+{
+    return CD3DX12_RESOURCE_BARRIER::Transition(pResource, Before, After, Subresource, Flags);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(EnhancedBarrierTranslator, MapsLegacyStatesToScopes)
+{
+    auto Scope = EnhancedBarrierTranslator::GetScope(D3D12_RESOURCE_STATE_RENDER_TARGET, EnhancedBarrierResourceType::Texture);
+    EXPECT_EQ(Scope.Sync, D3D12_BARRIER_SYNC_RENDER_TARGET);
+    EXPECT_EQ(Scope.Access, D3D12_BARRIER_ACCESS_RENDER_TARGET);
+    EXPECT_EQ(Scope.Layout, D3D12_BARRIER_LAYOUT_RENDER_TARGET);
+
+    // Read states accumulate
+    Scope = EnhancedBarrierTranslator::GetScope(D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, EnhancedBarrierResourceType::Texture);
+    EXPECT_EQ(Scope.Sync, D3D12_BARRIER_SYNC_PIXEL_SHADING | D3D12_BARRIER_SYNC_NON_PIXEL_SHADING);
+    EXPECT_EQ(Scope.Access, D3D12_BARRIER_ACCESS_SHADER_RESOURCE);
+    EXPECT_EQ(Scope.Layout, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+
+    Scope = EnhancedBarrierTranslator::GetScope(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_COPY_SOURCE, EnhancedBarrierResourceType::Texture);
+    EXPECT_EQ(Scope.Sync, D3D12_BARRIER_SYNC_PIXEL_SHADING | D3D12_BARRIER_SYNC_COPY);
+    EXPECT_EQ(Scope.Access, D3D12_BARRIER_ACCESS_SHADER_RESOURCE | D3D12_BARRIER_ACCESS_COPY_SOURCE);
+    EXPECT_EQ(Scope.Layout, D3D12_BARRIER_LAYOUT_GENERIC_READ);
+
+    Scope = EnhancedBarrierTranslator::GetScope(D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, EnhancedBarrierResourceType::Texture);
+    EXPECT_EQ(Scope.Layout, D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ);
+
+    // COMMON covers everything
+    Scope = EnhancedBarrierTranslator::GetScope(D3D12_RESOURCE_STATE_COMMON, EnhancedBarrierResourceType::Texture);
+    EXPECT_EQ(Scope.Sync, D3D12_BARRIER_SYNC_ALL);
+    EXPECT_EQ(Scope.Access, D3D12_BARRIER_ACCESS_COMMON);
+    EXPECT_EQ(Scope.Layout, D3D12_BARRIER_LAYOUT_COMMON);
+
+    // Only textures have layouts, and simultaneous access textures stay in COMMON
+    Scope = EnhancedBarrierTranslator::GetScope(D3D12_RESOURCE_STATE_UNORDERED_ACCESS, EnhancedBarrierResourceType::Buffer);
+    EXPECT_EQ(Scope.Access, D3D12_BARRIER_ACCESS_UNORDERED_ACCESS);
+    EXPECT_EQ(Scope.Layout, D3D12_BARRIER_LAYOUT_UNDEFINED);
+    Scope = EnhancedBarrierTranslator::GetScope(D3D12_RESOURCE_STATE_UNORDERED_ACCESS, EnhancedBarrierResourceType::SimultaneousAccessTexture);
+    EXPECT_EQ(Scope.Access, D3D12_BARRIER_ACCESS_UNORDERED_ACCESS);
+    EXPECT_EQ(Scope.Layout, D3D12_BARRIER_LAYOUT_COMMON);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(EnhancedBarrierTranslator, KeepsBarrierOrderAcrossGroups)
+{
+    const D3D12_RESOURCE_BARRIER Barriers[] =
+    {
+        Transition(c_pTexture, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, 0),
+        Transition(c_pTexture, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, 1),
+        Transition(c_pBuffer, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER),
+        CD3DX12_RESOURCE_BARRIER::UAV(c_pSimultaneousTexture),
+    };
+    EnhancedBarrierTranslator Translator;
+    Translator.Translate(Barriers, _countof(Barriers), GetTestResourceType);
+    EXPECT_EQ(Translator.GetNumElided(), 0u);
+    ASSERT_EQ(Translator.GetNumGroups(), 3u);
+    D3D12_BARRIER_GROUP const* pGroups = Translator.GetGroups();
+
+    ASSERT_EQ(pGroups[0].Type, D3D12_BARRIER_TYPE_TEXTURE);
+    ASSERT_EQ(pGroups[0].NumBarriers, 2u);
+    for (UINT i = 0; i < 2; ++i)
+    {
+        D3D12_TEXTURE_BARRIER const& Barrier = pGroups[0].pTextureBarriers[i];
+        EXPECT_EQ(Barrier.pResource, c_pTexture);
+        EXPECT_EQ(Barrier.Subresources.IndexOrFirstMipLevel, i);
+        EXPECT_EQ(Barrier.Subresources.NumMipLevels, 0u);
+        EXPECT_EQ(Barrier.SyncBefore, D3D12_BARRIER_SYNC_RENDER_TARGET);
+        EXPECT_EQ(Barrier.SyncAfter, D3D12_BARRIER_SYNC_PIXEL_SHADING);
+        EXPECT_EQ(Barrier.AccessBefore, D3D12_BARRIER_ACCESS_RENDER_TARGET);
+        EXPECT_EQ(Barrier.AccessAfter, D3D12_BARRIER_ACCESS_SHADER_RESOURCE);
+        EXPECT_EQ(Barrier.LayoutBefore, D3D12_BARRIER_LAYOUT_RENDER_TARGET);
+        EXPECT_EQ(Barrier.LayoutAfter, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+    }
+
+    ASSERT_EQ(pGroups[1].Type, D3D12_BARRIER_TYPE_BUFFER);
+    ASSERT_EQ(pGroups[1].NumBarriers, 1u);
+    EXPECT_EQ(pGroups[1].pBufferBarriers[0].pResource, c_pBuffer);
+    EXPECT_EQ(pGroups[1].pBufferBarriers[0].AccessBefore, D3D12_BARRIER_ACCESS_COPY_DEST);
+    EXPECT_EQ(pGroups[1].pBufferBarriers[0].AccessAfter, D3D12_BARRIER_ACCESS_VERTEX_BUFFER | D3D12_BARRIER_ACCESS_CONSTANT_BUFFER);
+    EXPECT_EQ(pGroups[1].pBufferBarriers[0].Size, UINT64_MAX);
+
+    ASSERT_EQ(pGroups[2].Type, D3D12_BARRIER_TYPE_TEXTURE);
+    ASSERT_EQ(pGroups[2].NumBarriers, 1u);
+    D3D12_TEXTURE_BARRIER const& UAVBarrier = pGroups[2].pTextureBarriers[0];
+    EXPECT_EQ(UAVBarrier.pResource, c_pSimultaneousTexture);
+    EXPECT_EQ(UAVBarrier.AccessBefore, D3D12_BARRIER_ACCESS_UNORDERED_ACCESS);
+    EXPECT_EQ(UAVBarrier.AccessAfter, D3D12_BARRIER_ACCESS_UNORDERED_ACCESS);
+    EXPECT_EQ(UAVBarrier.LayoutBefore, D3D12_BARRIER_LAYOUT_COMMON);
+    EXPECT_EQ(UAVBarrier.LayoutAfter, D3D12_BARRIER_LAYOUT_COMMON);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(EnhancedBarrierTranslator, ElidesReadAdditionsWithinAScope)
+{
+    const D3D12_RESOURCE_BARRIER Barriers[] =
+    {
+        // Elided: constant buffer reads already wait for all shader stages, and pixel shader reads for shader resource accesses
+        Transition(c_pBuffer,
+                   D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+                   D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER | D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE),
+        // Kept: the new reads are in a new stage, or are a new access, the layout changes, COMMON may have been accessed by
+        // anything, and reads are dropped
+        Transition(c_pTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE),
+        Transition(c_pTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_COPY_SOURCE),
+        Transition(c_pBuffer, D3D12_RESOURCE_STATE_INDEX_BUFFER, D3D12_RESOURCE_STATE_INDEX_BUFFER | D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER),
+        Transition(c_pBuffer, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_INDEX_BUFFER),
+        Transition(c_pBuffer, D3D12_RESOURCE_STATE_INDEX_BUFFER | D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_INDEX_BUFFER),
+    };
+    EnhancedBarrierTranslator Translator;
+    Translator.Translate(Barriers, _countof(Barriers), GetTestResourceType);
+    EXPECT_EQ(Translator.GetNumElided(), 1u);
+    ASSERT_EQ(Translator.GetNumGroups(), 2u);
+    ASSERT_EQ(Translator.GetGroups()[0].NumBarriers, 2u);
+    ASSERT_EQ(Translator.GetGroups()[1].NumBarriers, 3u);
+
+    // The new readers wait for the last write along with the earlier ones.
+    D3D12_TEXTURE_BARRIER const& AddedStage = Translator.GetGroups()[0].pTextureBarriers[0];
+    EXPECT_EQ(AddedStage.SyncBefore, D3D12_BARRIER_SYNC_PIXEL_SHADING);
+    EXPECT_EQ(AddedStage.SyncAfter, D3D12_BARRIER_SYNC_PIXEL_SHADING | D3D12_BARRIER_SYNC_NON_PIXEL_SHADING);
+    EXPECT_EQ(AddedStage.LayoutBefore, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+    EXPECT_EQ(AddedStage.LayoutAfter, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+    D3D12_BUFFER_BARRIER const& AddedAccess = Translator.GetGroups()[1].pBufferBarriers[0];
+    EXPECT_EQ(AddedAccess.AccessBefore, D3D12_BARRIER_ACCESS_INDEX_BUFFER);
+    EXPECT_EQ(AddedAccess.AccessAfter, D3D12_BARRIER_ACCESS_INDEX_BUFFER | D3D12_BARRIER_ACCESS_VERTEX_BUFFER | D3D12_BARRIER_ACCESS_CONSTANT_BUFFER);
+
+    // Each translation starts over
+    Translator.Translate(Barriers, 1, GetTestResourceType);
+    EXPECT_EQ(Translator.GetNumElided(), 1u);
+    EXPECT_EQ(Translator.GetNumGroups(), 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(EnhancedBarrierTranslator, SplitHalvesUseSplitSync)
+{
+    // Split transitions are never elided, both halves have to be recorded
+    const D3D12_RESOURCE_BARRIER Barriers[] =
+    {
+        Transition(c_pTexture, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, 3, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY),
+        Transition(c_pTexture, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, 3, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY),
+        Transition(c_pTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, 4, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY),
+    };
+    EnhancedBarrierTranslator Translator;
+    Translator.Translate(Barriers, _countof(Barriers), GetTestResourceType);
+    EXPECT_EQ(Translator.GetNumElided(), 0u);
+    ASSERT_EQ(Translator.GetNumGroups(), 1u);
+    ASSERT_EQ(Translator.GetGroups()[0].NumBarriers, 3u);
+    D3D12_TEXTURE_BARRIER const* pBarriers = Translator.GetGroups()[0].pTextureBarriers;
+
+    EXPECT_EQ(pBarriers[0].SyncBefore, D3D12_BARRIER_SYNC_RENDER_TARGET);
+    EXPECT_EQ(pBarriers[0].SyncAfter, D3D12_BARRIER_SYNC_SPLIT);
+    EXPECT_EQ(pBarriers[1].SyncBefore, D3D12_BARRIER_SYNC_SPLIT);
+    EXPECT_EQ(pBarriers[1].SyncAfter, D3D12_BARRIER_SYNC_PIXEL_SHADING);
+    // The layout transition is the same in both halves
+    for (UINT i = 0; i < 2; ++i)
+    {
+        EXPECT_EQ(pBarriers[i].LayoutBefore, D3D12_BARRIER_LAYOUT_RENDER_TARGET);
+        EXPECT_EQ(pBarriers[i].LayoutAfter, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+    }
+    EXPECT_EQ(pBarriers[2].SyncAfter, D3D12_BARRIER_SYNC_SPLIT);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(EnhancedBarrierTranslator, NullUAVBarrierIsGlobal)
+{
+    const D3D12_RESOURCE_BARRIER Barriers[] = { CD3DX12_RESOURCE_BARRIER::UAV(nullptr), CD3DX12_RESOURCE_BARRIER::UAV(c_pBuffer) };
+    EnhancedBarrierTranslator Translator;
+    Translator.Translate(Barriers, _countof(Barriers), GetTestResourceType);
+    ASSERT_EQ(Translator.GetNumGroups(), 2u);
+
+    D3D12_BARRIER_GROUP const& Global = Translator.GetGroups()[0];
+    ASSERT_EQ(Global.Type, D3D12_BARRIER_TYPE_GLOBAL);
+    ASSERT_EQ(Global.NumBarriers, 1u);
+    EXPECT_EQ(Global.pGlobalBarriers[0].AccessBefore, D3D12_BARRIER_ACCESS_UNORDERED_ACCESS);
+    EXPECT_EQ(Global.pGlobalBarriers[0].AccessAfter, D3D12_BARRIER_ACCESS_UNORDERED_ACCESS);
+    EXPECT_EQ(Global.pGlobalBarriers[0].SyncBefore, D3D12_BARRIER_SYNC_ALL_SHADING | D3D12_BARRIER_SYNC_CLEAR_UNORDERED_ACCESS_VIEW);
+
+    D3D12_BARRIER_GROUP const& Buffer = Translator.GetGroups()[1];
+    ASSERT_EQ(Buffer.Type, D3D12_BARRIER_TYPE_BUFFER);
+    EXPECT_EQ(Buffer.pBufferBarriers[0].pResource, c_pBuffer);
+}
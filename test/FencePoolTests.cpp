@@ -0,0 +1,301 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Pooled objects are fake resources which remember which one they are
+typedef std::unique_ptr<UINT64> TFakeResource;
+
+static TFakeResource CreateFake(UINT64 Value)
+{
+    return std::make_unique<UINT64>(Value);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+class TestMultiLevelPool : public CMultiLevelPool<TFakeResource, 64 * 1024>
+{
+public:
+    using CMultiLevelPool::CMultiLevelPool;
+    using CMultiLevelPool::IndexFromSize;
+    using CMultiLevelPool::SizeFromIndex;
+    static constexpr UINT64 c_SizeMultiple = 64 * 1024;
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Pops every entry, checking that they come out in fence order with the objects they went in with
+static void ExpectDrainsInOrder(CFenceOrderedRing<TFakeResource>& Ring, std::vector<UINT64> const& FenceValues)
+{
+    ASSERT_EQ(Ring.size(), FenceValues.size());
+    for (UINT64 FenceValue : FenceValues)
+    {
+        ASSERT_FALSE(Ring.empty());
+        EXPECT_EQ(Ring.front().first, FenceValue);
+        ASSERT_TRUE(Ring.front().second);
+        EXPECT_EQ(*Ring.front().second, FenceValue);
+        Ring.pop_front();
+    }
+    EXPECT_TRUE(Ring.empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FenceOrderedRing, ReusesInFenceOrderAcrossWrapAndGrowth)
+{
+    CFenceOrderedRing<TFakeResource> Ring;
+    UINT64 NextFence = 1;
+    std::vector<UINT64> Expected;
+
+    // Move the head part way around the initial capacity, so that growing has to unwrap the entries
+    for (UINT i = 0; i < 5; ++i)
+    {
+        Ring.insert(NextFence, CreateFake(NextFence));
+        ++NextFence;
+    }
+    for (UINT i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(Ring.front().first, i + 1u);
+        Ring.pop_front();
+    }
+    for (UINT i = 0; i < 20; ++i)
+    {
+        Ring.insert(NextFence, CreateFake(NextFence));
+        Expected.push_back(NextFence++);
+    }
+    ExpectDrainsInOrder(Ring, Expected);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FenceOrderedRing, SortsOutOfOrderReturns)
+{
+    CFenceOrderedRing<TFakeResource> Ring;
+    Ring.insert(1, CreateFake(1));
+    Ring.insert(2, CreateFake(2));
+    Ring.pop_front();
+    Ring.pop_front();
+
+    // Includes a return behind everything else and ties, which keep their insertion order after the existing ones
+    const UINT64 FenceValues[] = { 7, 4, 9, 3, 7, 12, 5, 10, 11, 8 };
+    for (UINT64 FenceValue : FenceValues)
+    {
+        Ring.insert(FenceValue, CreateFake(FenceValue));
+    }
+    ExpectDrainsInOrder(Ring, { 3, 4, 5, 7, 7, 8, 9, 10, 11, 12 });
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FencePool, RetrievesOnlyOnceTheFenceIsReached)
+{
+    CFencePool<TFakeResource> Pool;
+    UINT NumCreated = 0;
+    auto pfnCreateNew = [&NumCreated]() { ++NumCreated; return CreateFake(0); };
+
+    EXPECT_TRUE(Pool.ReturnToPool(CreateFake(5), 5));
+    EXPECT_TRUE(Pool.ReturnToPool(CreateFake(6), 6));
+
+    TFakeResource Resource = Pool.RetrieveFromPool(4, pfnCreateNew);
+    EXPECT_EQ(NumCreated, 1u);
+    EXPECT_EQ(*Resource, 0u);
+
+    Resource = Pool.RetrieveFromPool(5, pfnCreateNew);
+    EXPECT_EQ(NumCreated, 1u);
+    EXPECT_EQ(*Resource, 5u);
+
+    Resource = Pool.RetrieveFromPool(5, pfnCreateNew);
+    EXPECT_EQ(NumCreated, 2u);
+    Resource = Pool.RetrieveFromPool(10, pfnCreateNew);
+    EXPECT_EQ(NumCreated, 2u);
+    EXPECT_EQ(*Resource, 6u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FencePool, TrimReleasesOneEntryPastTheThreshold)
+{
+    CFencePool<TFakeResource> Pool;
+    Pool.ReturnToPool(CreateFake(1), 1);
+    Pool.ReturnToPool(CreateFake(2), 2);
+
+    EXPECT_FALSE(Pool.Trim(10, 0));
+    EXPECT_FALSE(Pool.Trim(10, 10));
+    EXPECT_TRUE(Pool.Trim(10, 12));
+    EXPECT_TRUE(Pool.Trim(10, 12));
+    EXPECT_FALSE(Pool.Trim(10, 12));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(MultiLevelPool, SizeClassesRoundTrip)
+{
+    constexpr UINT64 Multiple = TestMultiLevelPool::c_SizeMultiple;
+    EXPECT_EQ(TestMultiLevelPool::IndexFromSize(0), 0u);
+
+    // Linear levels hold one multiple each
+    for (UINT64 Size = 1; Size <= 16 * Multiple; Size += Multiple / 4)
+    {
+        EXPECT_EQ(TestMultiLevelPool::IndexFromSize(Size), (Size - 1) / Multiple);
+    }
+
+    // Each level's size maps back to that level, and the first size past the previous level's size starts it
+    for (UINT Index = 0; Index < 200; ++Index)
+    {
+        const UINT64 LevelSize = TestMultiLevelPool::SizeFromIndex(Index);
+        EXPECT_EQ(TestMultiLevelPool::IndexFromSize(LevelSize), Index);
+        if (Index > 0)
+        {
+            const UINT64 PreviousLevelSize = TestMultiLevelPool::SizeFromIndex(Index - 1);
+            ASSERT_GT(LevelSize, PreviousLevelSize);
+            EXPECT_EQ(TestMultiLevelPool::IndexFromSize(PreviousLevelSize + 1), Index);
+        }
+    }
+
+    // Sizes are only rounded up, by less than a multiple plus an eighth
+    std::mt19937_64 Random(1);
+    for (UINT i = 0; i < 10000; ++i)
+    {
+        const UINT64 Size = 1 + Random() % (1ull << (20 + i % 20));
+        const UINT64 LevelSize = TestMultiLevelPool::SizeFromIndex(TestMultiLevelPool::IndexFromSize(Size));
+        ASSERT_GE(LevelSize, Size);
+        ASSERT_LT(LevelSize - Size, Multiple + Size / 8);
+    }
+
+    // A 10 MB buffer doesn't need a level for every 64 KB below it
+    EXPECT_EQ(TestMultiLevelPool::IndexFromSize(10 * 1024 * 1024), 41u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(MultiLevelPool, ReusesWithinASizeClassOnceTheFenceIsReached)
+{
+    TestMultiLevelPool Pool(10, false);
+    std::vector<UINT64> CreatedSizes;
+    auto pfnCreateNew = [&CreatedSizes](UINT64 Size) { CreatedSizes.push_back(Size); return CreateFake(Size); };
+
+    // Created at the level's size, rather than the requested one
+    constexpr UINT64 Size = 10 * 1024 * 1024 + 1;
+    TFakeResource Resource = Pool.RetrieveFromPool(Size, 0, pfnCreateNew);
+    ASSERT_EQ(CreatedSizes.size(), 1u);
+    const UINT64 LevelSize = CreatedSizes[0];
+    EXPECT_GE(LevelSize, Size);
+    EXPECT_EQ(Pool.GetPooledSize(), 0u);
+
+    Pool.ReturnToPool(Size, std::move(Resource), 3);
+    EXPECT_EQ(Pool.GetPooledSize(), LevelSize);
+
+    // Not before its fence, and not for a different size class
+    Resource = Pool.RetrieveFromPool(Size, 2, pfnCreateNew);
+    EXPECT_EQ(CreatedSizes.size(), 2u);
+    Resource = Pool.RetrieveFromPool(LevelSize + 1, 3, pfnCreateNew);
+    EXPECT_EQ(CreatedSizes.size(), 3u);
+    EXPECT_EQ(Pool.GetPooledSize(), LevelSize);
+
+    // Any size in the class gets it back
+    Resource = Pool.RetrieveFromPool(LevelSize, 3, pfnCreateNew);
+    EXPECT_EQ(CreatedSizes.size(), 3u);
+    EXPECT_EQ(*Resource, LevelSize);
+    EXPECT_EQ(Pool.GetPooledSize(), 0u);
+
+    // Trimmed once it's been idle for the threshold
+    Pool.ReturnToPool(LevelSize, std::move(Resource), 4);
+    Pool.Trim(13);
+    EXPECT_EQ(Pool.GetPooledSize(), LevelSize);
+    Pool.Trim(14);
+    EXPECT_EQ(Pool.GetPooledSize(), 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// The list-based pool that the ring and logarithmic levels replaced, as a baseline for the churn benchmark
+class ListMultiLevelPool
+{
+public:
+    void ReturnToPool(UINT64 Size, TFakeResource&& Resource, UINT64 FenceValue)
+    {
+        UINT PoolIndex = IndexFromSize(Size);
+        if (PoolIndex >= m_MultiPool.size())
+        {
+            m_MultiPool.resize(PoolIndex + 1);
+        }
+        m_MultiPool[PoolIndex].emplace_back(FenceValue, std::move(Resource));
+    }
+
+    TFakeResource RetrieveFromPool(UINT64 Size, UINT64 CurrentFenceValue)
+    {
+        UINT PoolIndex = IndexFromSize(Size);
+        if (PoolIndex < m_MultiPool.size())
+        {
+            auto& Pool = m_MultiPool[PoolIndex];
+            if (!Pool.empty() && CurrentFenceValue >= Pool.front().first)
+            {
+                TFakeResource ret = std::move(Pool.front().second);
+                Pool.pop_front();
+                return ret;
+            }
+        }
+        return CreateFake((PoolIndex + 1) * TestMultiLevelPool::c_SizeMultiple);
+    }
+
+private:
+    static UINT IndexFromSize(UINT64 Size) { return (Size == 0) ? 0 : (UINT)((Size - 1) / TestMultiLevelPool::c_SizeMultiple); }
+
+    std::vector<std::list<std::pair<UINT64, TFakeResource>>> m_MultiPool;
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Simulates dynamic buffer renames: every frame retrieves a set of buffers, and returns them on that frame's fence, which
+// completes a few frames later. Sizes are mostly small, with a few large ones, as for constant and vertex data.
+TEST(MultiLevelPool, ChurnBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr UINT NumFrames = 2000;
+    constexpr UINT NumBuffersPerFrame = 256;
+    constexpr UINT FrameLatency = 3;
+
+    std::mt19937_64 Random(1);
+    std::vector<UINT64> Sizes(NumBuffersPerFrame);
+    for (UINT64& Size : Sizes)
+    {
+        Size = (Random() % 8 == 0) ? 1 + Random() % (16 * 1024 * 1024) : 1 + Random() % (256 * 1024);
+    }
+    std::vector<TFakeResource> Resources(NumBuffersPerFrame);
+
+    TestMultiLevelPool Pool(1000, true);
+    UINT NumCreated = 0;
+    auto pfnCreateNew = [&NumCreated](UINT64 Size) { ++NumCreated; return CreateFake(Size); };
+    auto RingStart = Clock::now();
+    for (UINT64 Frame = FrameLatency; Frame < NumFrames; ++Frame)
+    {
+        for (UINT i = 0; i < NumBuffersPerFrame; ++i)
+        {
+            Resources[i] = Pool.RetrieveFromPool(Sizes[i], Frame - FrameLatency, pfnCreateNew);
+        }
+        for (UINT i = 0; i < NumBuffersPerFrame; ++i)
+        {
+            Pool.ReturnToPool(Sizes[i], std::move(Resources[i]), Frame);
+        }
+        Pool.Trim(Frame - FrameLatency);
+    }
+    auto RingEnd = Clock::now();
+    EXPECT_EQ(NumCreated, NumBuffersPerFrame * FrameLatency);
+
+    ListMultiLevelPool List;
+    auto ListStart = Clock::now();
+    for (UINT64 Frame = FrameLatency; Frame < NumFrames; ++Frame)
+    {
+        for (UINT i = 0; i < NumBuffersPerFrame; ++i)
+        {
+            Resources[i] = List.RetrieveFromPool(Sizes[i], Frame - FrameLatency);
+        }
+        for (UINT i = 0; i < NumBuffersPerFrame; ++i)
+        {
+            List.ReturnToPool(Sizes[i], std::move(Resources[i]), Frame);
+        }
+    }
+    auto ListEnd = Clock::now();
+
+    const UINT64 NumChurns = UINT64(NumFrames - FrameLatency) * NumBuffersPerFrame;
+    const double RingNs = std::chrono::duration<double, std::nano>(RingEnd - RingStart).count() / NumChurns;
+    const double ListNs = std::chrono::duration<double, std::nano>(ListEnd - ListStart).count() / NumChurns;
+    RecordProperty("RingNsPerChurn", std::to_string(RingNs));
+    RecordProperty("ListNsPerChurn", std::to_string(ListNs));
+    std::cout << "CMultiLevelPool: " << RingNs << " ns/churn, list-based pool: " << ListNs << " ns/churn\n";
+}
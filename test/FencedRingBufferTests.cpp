@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static UINT32 Allocate(CUploadRingLedger& Ledger, UINT32 NumItems, UINT64 FenceValue)
+{
+    UINT32 Offset = 0;
+    EXPECT_TRUE(SUCCEEDED(Ledger.Allocate(NumItems, FenceValue, Offset)));
+    return Offset;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(UploadRingLedger, ReclaimsAfterTheConsumingCommandList)
+{
+    CUploadRingLedger Ledger(16);
+    EXPECT_EQ(Allocate(Ledger, 4, 1), 0u);
+    EXPECT_EQ(Ledger.GetNumItemsInUse(), 4u);
+
+    Ledger.Release(1);
+    Ledger.Submitted(1);
+    Ledger.Deallocate(0);
+    EXPECT_EQ(Ledger.GetNumItemsInUse(), 4u);
+    Ledger.Deallocate(1);
+    EXPECT_EQ(Ledger.GetNumItemsInUse(), 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(UploadRingLedger, KeepsAllocationsConsumedAfterASubmit)
+{
+    CUploadRingLedger Ledger(16);
+    EXPECT_EQ(Allocate(Ledger, 4, 1), 0u);
+
+    // The command list is submitted before the copy out of the allocation is recorded, so the copy is in the next one.
+    Ledger.Submitted(1);
+    Ledger.Deallocate(1);
+    EXPECT_EQ(Ledger.GetNumItemsInUse(), 4u);
+
+    // Its space isn't handed out again, even once everything else is allocated.
+    EXPECT_EQ(Allocate(Ledger, 7, 2), 4u);
+    EXPECT_EQ(Allocate(Ledger, 5, 2), 11u);
+    UINT32 Offset = 0;
+    EXPECT_TRUE(FAILED(Ledger.Allocate(1, 2, Offset)));
+
+    Ledger.Release(2);
+    Ledger.Release(2);
+    Ledger.Release(2);
+    EXPECT_EQ(Ledger.GetNumOutstanding(), 0u);
+    Ledger.Submitted(2);
+    Ledger.Deallocate(2);
+    EXPECT_EQ(Ledger.GetNumItemsInUse(), 0u);
+    EXPECT_EQ(Allocate(Ledger, 4, 3), 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(UploadRingLedger, KeepsAllocationsAcrossSeveralSubmits)
+{
+    CUploadRingLedger Ledger(16);
+    Allocate(Ledger, 4, 1);
+    Ledger.Release(1);
+    Allocate(Ledger, 4, 1);
+
+    // Submits with no commands, e.g. to signal a fence, move the allocations along as well.
+    Ledger.Submitted(1);
+    Ledger.Submitted(2);
+    Ledger.Deallocate(2);
+    EXPECT_EQ(Ledger.GetNumItemsInUse(), 8u);
+
+    Ledger.Release(3);
+    Ledger.Submitted(3);
+    Ledger.Deallocate(3);
+    EXPECT_EQ(Ledger.GetNumItemsInUse(), 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FencedRingBuffer, DelayedDeallocationKeepsLaterAllocations)
+{
+    CFencedRingBuffer Ring(16);
+    UINT32 Offset = 0;
+    ASSERT_TRUE(SUCCEEDED(Ring.Allocate(4, 1, Offset)));
+    ASSERT_TRUE(SUCCEEDED(Ring.Allocate(4, 2, Offset)));
+
+    Ring.DelayDeallocation(2, 3);
+    EXPECT_EQ(Ring.GetCurrentFenceValue(), 3u);
+    ASSERT_TRUE(SUCCEEDED(Ring.Allocate(4, 3, Offset)));
+    EXPECT_EQ(Offset, 8u);
+
+    Ring.Deallocate(2);
+    EXPECT_EQ(Ring.GetNumItemsInUse(), 8u);
+    Ring.Deallocate(3);
+    EXPECT_EQ(Ring.GetNumItemsInUse(), 0u);
+}
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static void* AllocatePage()
+{
+    return operator new(BatchedContext::BatchSizeInBytes);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FreePageContainer, EmptyContainerHasNoPages)
+{
+    FreePageContainer Pages;
+    EXPECT_EQ(Pages.RemovePage(), nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FreePageContainer, AddedPagesAreReturned)
+{
+    FreePageContainer Pages;
+    std::set<void*> Added;
+    {
+        FreePageContainer::Adder Adder(Pages);
+        for (UINT i = 0; i < 8; ++i)
+        {
+            void* pPage = AllocatePage();
+            Added.insert(pPage);
+            Adder.AddPage(pPage);
+        }
+        // Nothing is published until the adder goes out of scope.
+        EXPECT_EQ(Pages.RemovePage(), nullptr);
+    }
+
+    std::set<void*> Removed;
+    while (void* pPage = Pages.RemovePage())
+    {
+        EXPECT_TRUE(Removed.insert(pPage).second);
+    }
+    EXPECT_EQ(Removed, Added);
+    for (void* pPage : Removed)
+    {
+        operator delete(pPage);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(FreePageContainer, BatchAllocatorFallsBackToHeap)
+{
+    FreePageContainer Pages;
+    BatchedContext::BatchStorageAllocator Allocator = { &Pages };
+    EXPECT_EQ(Allocator(true), nullptr);
+
+    void* pPage = AllocatePage();
+    {
+        FreePageContainer::Adder Adder(Pages);
+        Adder.AddPage(pPage);
+    }
+    EXPECT_EQ(Allocator(false), nullptr); // Failure notifications don't consume pages.
+    EXPECT_EQ(Allocator(true), pPage);
+    operator delete(pPage);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Mirrors the recording thread popping pages while the worker retires batches.
+TEST(FreePageContainer, ConcurrentRemoveAndAdd)
+{
+    constexpr UINT NumPages = 64;
+    constexpr UINT NumRounds = 20000;
+    FreePageContainer Pages;
+    {
+        FreePageContainer::Adder Adder(Pages);
+        for (UINT i = 0; i < NumPages; ++i)
+        {
+            Adder.AddPage(AllocatePage());
+        }
+    }
+
+    // Each thread takes pages and hands them back. A page handed to both at once would be caught by the marker.
+    auto Worker = [&Pages](UINT Marker)
+    {
+        UINT NumCollisions = 0;
+        for (UINT Round = 0; Round < NumRounds; ++Round)
+        {
+            std::vector<void*> Taken;
+            for (UINT i = 0; i < 4; ++i)
+            {
+                if (void* pPage = Pages.RemovePage())
+                {
+                    Taken.push_back(pPage);
+                    static_cast<volatile UINT*>(pPage)[4] = Marker;
+                }
+            }
+            FreePageContainer::Adder Adder(Pages);
+            for (void* pPage : Taken)
+            {
+                NumCollisions += static_cast<volatile UINT*>(pPage)[4] != Marker;
+                Adder.AddPage(pPage);
+            }
+        }
+        return NumCollisions;
+    };
+    UINT OtherCollisions = 0;
+    std::thread Other([&]() { OtherCollisions = Worker(2); });
+    UINT Collisions = Worker(1);
+    Other.join();
+    EXPECT_EQ(Collisions + OtherCollisions, 0u);
+
+    // Trimming may have freed some pages, but none can be duplicated.
+    std::set<void*> Remaining;
+    while (void* pPage = Pages.RemovePage())
+    {
+        EXPECT_TRUE(Remaining.insert(pPage).second);
+    }
+    EXPECT_LE(Remaining.size(), NumPages);
+    for (void* pPage : Remaining)
+    {
+        operator delete(pPage);
+    }
+}
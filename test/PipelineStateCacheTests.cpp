@@ -0,0 +1,303 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+static const PipelineStateCacheDeviceIdentity c_Device = { 0x1414, 0x8c, 0x0001000200030004ull };
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static D3D12_COMPUTE_PIPELINE_STATE_DESC MakeComputeDesc(std::vector<BYTE> const& ByteCode)
+{
+    D3D12_COMPUTE_PIPELINE_STATE_DESC Desc = {};
+    Desc.CS = { ByteCode.data(), ByteCode.size() };
+    return Desc;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static std::wstring GetTempCacheFileName()
+{
+    wchar_t TempPath[MAX_PATH];
+    wchar_t FileName[MAX_PATH];
+    EXPECT_NE(GetTempPathW(MAX_PATH, TempPath), 0u);
+    EXPECT_NE(GetTempFileNameW(TempPath, L"pso", 0, FileName), 0u);
+    return FileName;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Writes a cache file image with one entry per blob, in the same layout as PipelineStateCache::WriteBack
+static std::vector<BYTE> WriteCacheFile(PipelineStateCacheDeviceIdentity const& Device, std::vector<std::vector<BYTE>> const& Blobs)
+{
+    UINT64 Size = sizeof(PipelineStateCacheFileHeader);
+    for (auto& Blob : Blobs)
+    {
+        Size += PipelineStateCache::GetEntrySize(Blob.size());
+    }
+    std::vector<BYTE> File(static_cast<size_t>(Size));
+
+    PipelineStateCacheFileHeader Header = {};
+    Header.Magic = PipelineStateCacheFileHeader::c_Magic;
+    Header.Version = PipelineStateCacheFileHeader::c_Version;
+    Header.NumEntries = static_cast<UINT>(Blobs.size());
+    Header.Device = Device;
+    Header.Generation = 7;
+    memcpy(File.data(), &Header, sizeof(Header));
+
+    BYTE* pDest = File.data() + sizeof(Header);
+    for (UINT i = 0; i < Blobs.size(); ++i)
+    {
+        PipelineStateCacheEntryHeader Entry = { { { i, ~UINT64(i) } }, i, Blobs[i].size() };
+        pDest = PipelineStateCache::WriteEntry(pDest, Entry, Blobs[i].data());
+    }
+    EXPECT_EQ(pDest, File.data() + File.size());
+    return File;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static bool ParseCacheFile(std::vector<BYTE> const& File, PipelineStateCacheDeviceIdentity const& Device, std::vector<std::vector<BYTE>>& Blobs)
+{
+    UINT64 Generation = 0;
+    Blobs.clear();
+    return PipelineStateCache::ParseFile(File.data(), File.size(), Device, Generation,
+        [&Blobs](PipelineStateCacheEntryHeader const& Entry, BYTE const* pBlob)
+        {
+            Blobs.emplace_back(pBlob, pBlob + Entry.BlobSize);
+        });
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheKey, DependsOnBytecodeContentsNotAddress)
+{
+    const RootSignatureDesc RootSignature(nullptr, false, false);
+    std::vector<BYTE> ByteCode(64, 0x5a);
+    std::vector<BYTE> Copy = ByteCode;
+
+    const auto Key = ComputePipelineStateCacheKey(MakeComputeDesc(ByteCode), RootSignature);
+    EXPECT_EQ(ComputePipelineStateCacheKey(MakeComputeDesc(Copy), RootSignature), Key);
+
+    Copy[63] ^= 1;
+    EXPECT_NE(ComputePipelineStateCacheKey(MakeComputeDesc(Copy), RootSignature), Key);
+    Copy[63] ^= 1;
+    Copy.push_back(0);
+    EXPECT_NE(ComputePipelineStateCacheKey(MakeComputeDesc(Copy), RootSignature), Key);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheKey, IgnoresRootSignaturePointerAndCachedBlob)
+{
+    const RootSignatureDesc RootSignature(nullptr, false, false);
+    std::vector<BYTE> ByteCode(16, 1);
+    auto Desc = MakeComputeDesc(ByteCode);
+    const auto Key = ComputePipelineStateCacheKey(Desc, RootSignature);
+
+    Desc.pRootSignature = reinterpret_cast<ID3D12RootSignature*>(0x1000);
+    Desc.CachedPSO = { ByteCode.data(), ByteCode.size() };
+    EXPECT_EQ(ComputePipelineStateCacheKey(Desc, RootSignature), Key);
+
+    Desc.Flags = D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG;
+    EXPECT_NE(ComputePipelineStateCacheKey(Desc, RootSignature), Key);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheKey, DependsOnRootSignatureLayout)
+{
+    std::vector<BYTE> ByteCode(16, 1);
+    const auto Desc = MakeComputeDesc(ByteCode);
+    EXPECT_NE(ComputePipelineStateCacheKey(Desc, RootSignatureDesc(nullptr, false, false)),
+              ComputePipelineStateCacheKey(Desc, RootSignatureDesc(nullptr, true, false)));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheKey, IgnoresPaddingAndUnusedRenderTargets)
+{
+    const RootSignatureDesc RootSignature(nullptr, nullptr, nullptr, nullptr, nullptr, false, false);
+    std::vector<BYTE> ByteCode(16, 1);
+
+    // Fill the descs with different garbage first, so that padding bytes differ
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC Descs[2];
+    memset(&Descs[0], 0x00, sizeof(Descs[0]));
+    memset(&Descs[1], 0xcd, sizeof(Descs[1]));
+    for (auto& Desc : Descs)
+    {
+        Desc.pRootSignature = nullptr;
+        Desc.VS = { ByteCode.data(), ByteCode.size() };
+        Desc.PS = Desc.DS = Desc.HS = Desc.GS = {};
+        Desc.StreamOutput = {};
+        Desc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+        Desc.SampleMask = UINT_MAX;
+        Desc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+        Desc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+        Desc.InputLayout = {};
+        Desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+        Desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+        Desc.NumRenderTargets = 1;
+        Desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+        Desc.DSVFormat = DXGI_FORMAT_UNKNOWN;
+        Desc.SampleDesc = { 1, 0 };
+        Desc.NodeMask = 0;
+        Desc.CachedPSO = {};
+        Desc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+    }
+    EXPECT_EQ(ComputePipelineStateCacheKey(Descs[0], RootSignature), ComputePipelineStateCacheKey(Descs[1], RootSignature));
+
+    Descs[1].RTVFormats[0] = DXGI_FORMAT_B8G8R8A8_UNORM;
+    EXPECT_NE(ComputePipelineStateCacheKey(Descs[0], RootSignature), ComputePipelineStateCacheKey(Descs[1], RootSignature));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheKey, NullStringDiffersFromEmpty)
+{
+    PipelineStateCacheKeyBuilder Null, Empty;
+    Null.AddString(nullptr);
+    Empty.AddString("");
+    EXPECT_NE(Null.GetKey(), Empty.GetKey());
+
+    // Field boundaries are part of the key
+    PipelineStateCacheKeyBuilder AB, A_B;
+    AB.AddString("ab");
+    A_B.AddString("a");
+    A_B.AddString("b");
+    EXPECT_NE(AB.GetKey(), A_B.GetKey());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheFile, RoundTripsEntries)
+{
+    std::vector<std::vector<BYTE>> Blobs = { { 1, 2, 3 }, std::vector<BYTE>(8, 0x11), std::vector<BYTE>(100, 0xee) };
+    std::vector<BYTE> File = WriteCacheFile(c_Device, Blobs);
+
+    std::vector<std::vector<BYTE>> Parsed;
+    ASSERT_TRUE(ParseCacheFile(File, c_Device, Parsed));
+    EXPECT_EQ(Parsed, Blobs);
+
+    UINT64 Generation = 0;
+    UINT NumVisited = 0;
+    EXPECT_TRUE(PipelineStateCache::ParseFile(File.data(), File.size(), c_Device, Generation,
+        [&NumVisited](PipelineStateCacheEntryHeader const& Entry, BYTE const*)
+        {
+            EXPECT_EQ(Entry.Key.Hash[0], NumVisited);
+            EXPECT_EQ(Entry.LastUsedGeneration, NumVisited);
+            ++NumVisited;
+        }));
+    EXPECT_EQ(Generation, 7u);
+    EXPECT_EQ(NumVisited, 3u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheFile, RejectsOtherDevicesAndVersions)
+{
+    std::vector<BYTE> File = WriteCacheFile(c_Device, { { 1, 2, 3 } });
+    std::vector<std::vector<BYTE>> Parsed;
+
+    for (auto Device : { PipelineStateCacheDeviceIdentity{ 0x10de, c_Device.DeviceID, c_Device.DriverVersion },
+                         PipelineStateCacheDeviceIdentity{ c_Device.VendorID, 0x8d, c_Device.DriverVersion },
+                         PipelineStateCacheDeviceIdentity{ c_Device.VendorID, c_Device.DeviceID, c_Device.DriverVersion + 1 } })
+    {
+        EXPECT_FALSE(ParseCacheFile(File, Device, Parsed));
+        EXPECT_TRUE(Parsed.empty());
+    }
+
+    auto pHeader = reinterpret_cast<PipelineStateCacheFileHeader*>(File.data());
+    pHeader->Version = PipelineStateCacheFileHeader::c_Version + 1;
+    EXPECT_FALSE(ParseCacheFile(File, c_Device, Parsed));
+    pHeader->Version = PipelineStateCacheFileHeader::c_Version;
+    pHeader->Magic = 0;
+    EXPECT_FALSE(ParseCacheFile(File, c_Device, Parsed));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheFile, RejectsTruncatedAndCorruptFiles)
+{
+    const std::vector<BYTE> File = WriteCacheFile(c_Device, { { 1, 2, 3 }, std::vector<BYTE>(40, 9) });
+    std::vector<std::vector<BYTE>> Parsed;
+
+    // Truncated anywhere, no entries are visited
+    for (size_t Size = 0; Size < File.size(); ++Size)
+    {
+        std::vector<BYTE> Truncated(File.begin(), File.begin() + Size);
+        EXPECT_FALSE(ParseCacheFile(Truncated, c_Device, Parsed)) << Size;
+        EXPECT_TRUE(Parsed.empty());
+    }
+
+    // A blob size which runs past the end of the file
+    std::vector<BYTE> Corrupt = File;
+    auto pEntry = reinterpret_cast<PipelineStateCacheEntryHeader*>(Corrupt.data() + sizeof(PipelineStateCacheFileHeader));
+    pEntry->BlobSize = UINT64_MAX - 8;
+    EXPECT_FALSE(ParseCacheFile(Corrupt, c_Device, Parsed));
+
+    // More entries than the file holds
+    Corrupt = File;
+    reinterpret_cast<PipelineStateCacheFileHeader*>(Corrupt.data())->NumEntries = 3;
+    EXPECT_FALSE(ParseCacheFile(Corrupt, c_Device, Parsed));
+    EXPECT_TRUE(Parsed.empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCacheFile, UnknownDeviceIdentityDisablesCache)
+{
+    EXPECT_TRUE(c_Device.IsKnown());
+    EXPECT_FALSE(PipelineStateCacheDeviceIdentity{}.IsKnown());
+    EXPECT_FALSE((PipelineStateCacheDeviceIdentity{ c_Device.VendorID, c_Device.DeviceID, 0 }.IsKnown()));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCache, PersistsAcrossInstances)
+{
+    const std::wstring FileName = GetTempCacheFileName();
+    const PipelineStateCacheKey Key = { { 1, 2 } };
+    const BYTE Blob[] = { 10, 20, 30, 40, 50 };
+    {
+        PipelineStateCache Cache(FileName.c_str(), 0, c_Device);
+        const void* pBlob;
+        SIZE_T BlobSize;
+        EXPECT_FALSE(Cache.Find(Key, pBlob, BlobSize));
+        Cache.Store(Key, Blob, sizeof(Blob));
+    }
+    {
+        PipelineStateCache Cache(FileName.c_str(), 0, c_Device);
+        const void* pBlob = nullptr;
+        SIZE_T BlobSize = 0;
+        ASSERT_TRUE(Cache.Find(Key, pBlob, BlobSize));
+        ASSERT_EQ(BlobSize, sizeof(Blob));
+        EXPECT_EQ(memcmp(pBlob, Blob, sizeof(Blob)), 0);
+    }
+    {
+        // A different driver drops the file
+        PipelineStateCache Cache(FileName.c_str(), 0, { c_Device.VendorID, c_Device.DeviceID, c_Device.DriverVersion + 1 });
+        const void* pBlob;
+        SIZE_T BlobSize;
+        EXPECT_FALSE(Cache.Find(Key, pBlob, BlobSize));
+    }
+    DeleteFileW(FileName.c_str());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PipelineStateCache, DropsLeastRecentlyUsedEntriesOverSizeLimit)
+{
+    const std::wstring FileName = GetTempCacheFileName();
+    const std::vector<BYTE> Blob(1000, 0xab);
+    // Room for two entries
+    const UINT64 MaxSize = sizeof(PipelineStateCacheFileHeader) + 2 * PipelineStateCache::GetEntrySize(Blob.size());
+    const PipelineStateCacheKey Keys[3] = { { { 1, 0 } }, { { 2, 0 } }, { { 3, 0 } } };
+    const void* pBlob;
+    SIZE_T BlobSize;
+    {
+        PipelineStateCache Cache(FileName.c_str(), MaxSize, c_Device);
+        Cache.Store(Keys[0], Blob.data(), Blob.size());
+        Cache.Store(Keys[1], Blob.data(), Blob.size());
+    }
+    {
+        // Key 0 is used again in a later generation, and key 2 is new
+        PipelineStateCache Cache(FileName.c_str(), MaxSize, c_Device);
+        EXPECT_TRUE(Cache.Find(Keys[0], pBlob, BlobSize));
+        Cache.Store(Keys[2], Blob.data(), Blob.size());
+    }
+    {
+        PipelineStateCache Cache(FileName.c_str(), MaxSize, c_Device);
+        EXPECT_TRUE(Cache.Find(Keys[0], pBlob, BlobSize));
+        EXPECT_FALSE(Cache.Find(Keys[1], pBlob, BlobSize));
+        EXPECT_TRUE(Cache.Find(Keys[2], pBlob, BlobSize));
+    }
+    DeleteFileW(FileName.c_str());
+}
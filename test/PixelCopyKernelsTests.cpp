@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// The per-pixel loops the kernels replaced, which every level must match bit for bit.
+template <typename TInterleaved, typename TPlanar, TInterleaved Mask, UINT Shift>
+static void DeInterleaveReference(const TInterleaved* pSrc, TPlanar* pDst, UINT Count) noexcept
+{
+    for (UINT x = 0; x < Count; ++x)
+    {
+        pDst[x] = static_cast<TPlanar>((pSrc[x] & Mask) >> Shift);
+    }
+}
+
+template <typename TInterleaved, typename TPlanar, TPlanar Mask, UINT Shift>
+static void InterleaveReference(const TPlanar* pSrc, TInterleaved* pDst, UINT Count) noexcept
+{
+    for (UINT x = 0; x < Count; ++x)
+    {
+        pDst[x] |= (static_cast<TInterleaved>(pSrc[x] & Mask) << Shift);
+    }
+}
+
+static void Swap10bitRBReference(const UINT* pSrc, UINT* pDst, UINT Count) noexcept
+{
+    constexpr UINT alphaMask = 3u << 30u;
+    constexpr UINT blueMask = 0x3FFu << 20u;
+    constexpr UINT greenMask = 0x3FFu << 10u;
+    constexpr UINT redMask = 0x3FFu;
+    for (UINT x = 0; x < Count; ++x)
+    {
+        const UINT pixel = pSrc[x];
+        pDst[x] = (pixel & (alphaMask | greenMask)) | ((pixel & blueMask) >> 20u) | ((pixel & redMask) << 20u);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static const char* GetLevelName(PixelCopyKernelLevel Level)
+{
+    switch (Level)
+    {
+        case PixelCopyKernelLevel::Scalar: return "Scalar";
+        case PixelCopyKernelLevel::SSE41: return "SSE41";
+        case PixelCopyKernelLevel::AVX2: return "AVX2";
+        case PixelCopyKernelLevel::NEON: return "NEON";
+        default: return "Unknown";
+    }
+}
+
+static const PixelCopyKernelLevel c_AllLevels[] =
+{
+    PixelCopyKernelLevel::Scalar,
+    PixelCopyKernelLevel::SSE41,
+    PixelCopyKernelLevel::AVX2,
+    PixelCopyKernelLevel::NEON,
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Runs the kernel and the reference over rows of every length up to a few vectors, at every element offset within a 32-byte
+// vector, from random source data into random destination data. Both destinations must be identical afterwards, including
+// the guard elements past the end of the row.
+template <typename TSrc, typename TDst>
+static void ExpectMatchesReference(const char* pName,
+                                   void (*pfnKernel)(const TSrc*, TDst*, UINT) noexcept,
+                                   void (*pfnReference)(const TSrc*, TDst*, UINT) noexcept,
+                                   std::mt19937& Random)
+{
+    SCOPED_TRACE(pName);
+    constexpr UINT MaxCount = 200;
+    constexpr UINT NumGuardBytes = 64;
+    auto Randomize = [&Random](std::vector<UINT64>& Storage)
+    {
+        for (UINT64& Value : Storage)
+        {
+            Value = (static_cast<UINT64>(Random()) << 32) | Random();
+        }
+    };
+
+    // Backed by UINT64s so that elements of either type can be placed at any offset which is a multiple of their size
+    std::vector<UINT64> SrcStorage((MaxCount * sizeof(TSrc) + NumGuardBytes) / sizeof(UINT64));
+    std::vector<UINT64> DstStorage((MaxCount * sizeof(TDst) + NumGuardBytes) / sizeof(UINT64));
+    std::vector<UINT64> ReferenceStorage(DstStorage.size());
+
+    for (UINT Count = 0; Count <= MaxCount; ++Count)
+    {
+        for (UINT Offset = 0; Offset < 32 / sizeof(TSrc) && Offset < 32 / sizeof(TDst); ++Offset)
+        {
+            Randomize(SrcStorage);
+            Randomize(DstStorage);
+            ReferenceStorage = DstStorage;
+
+            const TSrc* pSrc = reinterpret_cast<const TSrc*>(SrcStorage.data()) + Offset;
+            pfnKernel(pSrc, reinterpret_cast<TDst*>(DstStorage.data()) + Offset, Count);
+            pfnReference(pSrc, reinterpret_cast<TDst*>(ReferenceStorage.data()) + Offset, Count);
+            if (DstStorage != ReferenceStorage)
+            {
+                ADD_FAILURE() << "Mismatch for " << Count << " pixels at element offset " << Offset;
+                return;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PixelCopyKernels, ScalarAndBestLevelsAreAvailable)
+{
+    EXPECT_NE(GetPixelCopyKernels(PixelCopyKernelLevel::Scalar), nullptr);
+
+    bool bBestIsALevel = false;
+    for (PixelCopyKernelLevel Level : c_AllLevels)
+    {
+        bBestIsALevel |= GetPixelCopyKernels(Level) == &GetPixelCopyKernels();
+    }
+    EXPECT_TRUE(bBestIsALevel);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PixelCopyKernels, AllLevelsMatchReference)
+{
+    std::mt19937 Random(1);
+    for (PixelCopyKernelLevel Level : c_AllLevels)
+    {
+        PixelCopyKernels const* pKernels = GetPixelCopyKernels(Level);
+        if (!pKernels)
+        {
+            std::cout << GetLevelName(Level) << " kernels aren't available in this build or on this CPU\n";
+            continue;
+        }
+        SCOPED_TRACE(GetLevelName(Level));
+
+        ExpectMatchesReference("DeInterleaveR24Depth", pKernels->pfnDeInterleaveR24Depth, DeInterleaveReference<UINT, UINT, 0x00ffffff, 0>, Random);
+        ExpectMatchesReference("DeInterleaveR24Stencil", pKernels->pfnDeInterleaveR24Stencil, DeInterleaveReference<UINT, UINT8, 0xff000000, 24>, Random);
+        ExpectMatchesReference("DeInterleaveR32Depth", pKernels->pfnDeInterleaveR32Depth, DeInterleaveReference<UINT64, UINT, 0x00000000ffffffff, 0>, Random);
+        ExpectMatchesReference("DeInterleaveR32Stencil", pKernels->pfnDeInterleaveR32Stencil, DeInterleaveReference<UINT64, UINT8, 0x000000ff00000000, 32>, Random);
+        ExpectMatchesReference("InterleaveR24Depth", pKernels->pfnInterleaveR24Depth, InterleaveReference<UINT, UINT, 0x00ffffff, 0>, Random);
+        ExpectMatchesReference("InterleaveR24Stencil", pKernels->pfnInterleaveR24Stencil, InterleaveReference<UINT, UINT8, 0xff, 24>, Random);
+        ExpectMatchesReference("InterleaveR32Depth", pKernels->pfnInterleaveR32Depth, InterleaveReference<UINT64, UINT, 0xffffffff, 0>, Random);
+        ExpectMatchesReference("InterleaveR32Stencil", pKernels->pfnInterleaveR32Stencil, InterleaveReference<UINT64, UINT8, 0xff, 32>, Random);
+        ExpectMatchesReference("Swap10bitRB", pKernels->pfnSwap10bitRB, Swap10bitRBReference, Random);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Splits and merges a 2048x2048 D32S8 subresource, and swizzles a 10-bit one, at every available level.
+TEST(PixelCopyKernels, BenchmarkLevels)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr UINT Width = 2048;
+    constexpr UINT Height = 2048;
+    std::vector<UINT64> Interleaved(Width);
+    std::vector<UINT> Depth(Width);
+    std::vector<UINT8> Stencil(Width);
+    std::vector<UINT> Swizzled(Width);
+
+    for (PixelCopyKernelLevel Level : c_AllLevels)
+    {
+        PixelCopyKernels const* pKernels = GetPixelCopyKernels(Level);
+        if (!pKernels)
+        {
+            continue;
+        }
+
+        const auto Start = Clock::now();
+        for (UINT y = 0; y < Height; ++y)
+        {
+            pKernels->pfnDeInterleaveR32Depth(Interleaved.data(), Depth.data(), Width);
+            pKernels->pfnDeInterleaveR32Stencil(Interleaved.data(), Stencil.data(), Width);
+            pKernels->pfnInterleaveR32Depth(Depth.data(), Interleaved.data(), Width);
+            pKernels->pfnInterleaveR32Stencil(Stencil.data(), Interleaved.data(), Width);
+            pKernels->pfnSwap10bitRB(Depth.data(), Swizzled.data(), Width);
+        }
+        const double Ms = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        RecordProperty(std::string(GetLevelName(Level)) + "Ms", std::to_string(Ms));
+        std::cout << GetLevelName(Level) << ": " << Ms << " ms for " << Width << "x" << Height << " pixels\n";
+    }
+}
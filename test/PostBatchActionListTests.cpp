@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace D3D12TranslationLayer;
+
+using PostBatchActionList = BatchedContext::PostBatchActionList;
+
+// Counts its own destruction, to check that AddDelete targets are deleted exactly once.
+struct DeleteTracker
+{
+    UINT& m_NumDeleted;
+    DeleteTracker(UINT& NumDeleted) : m_NumDeleted(NumDeleted) {}
+    ~DeleteTracker() { ++m_NumDeleted; }
+};
+
+// Big enough to be boxed on the heap instead of stored inline.
+struct LargeCallable
+{
+    std::shared_ptr<UINT> m_spCount;
+    BYTE m_Padding[512] = {};
+    void operator()() { ++*m_spCount; }
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static BatchedContext::BatchStorageAllocator HeapAllocator()
+{
+    return { nullptr };
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PostBatchActionList, RunsActionsInOrder)
+{
+    std::vector<UINT> Order;
+    auto spLargeCount = std::make_shared<UINT>(0);
+    UINT NumDeleted = 0;
+
+    PostBatchActionList List(HeapAllocator());
+    EXPECT_TRUE(List.empty());
+    for (UINT i = 0; i < 100; ++i)
+    {
+        List.AddCallable([&Order, i]() { Order.push_back(i); });
+    }
+    List.AddCallable(LargeCallable{ spLargeCount });
+    List.AddDelete(new DeleteTracker(NumDeleted));
+    EXPECT_FALSE(List.empty());
+
+    List.Execute();
+    EXPECT_TRUE(List.empty());
+    ASSERT_EQ(Order.size(), 100u);
+    for (UINT i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(Order[i], i);
+    }
+    EXPECT_EQ(*spLargeCount, 1u);
+    EXPECT_EQ(spLargeCount.use_count(), 1);
+    EXPECT_EQ(NumDeleted, 1u);
+
+    // The list is reusable once executed.
+    List.AddCallable([&Order]() { Order.push_back(100); });
+    List.Execute();
+    EXPECT_EQ(Order.size(), 101u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PostBatchActionList, DestroysActionsThatNeverRun)
+{
+    auto spCount = std::make_shared<UINT>(0);
+    UINT NumDeleted = 0;
+    {
+        PostBatchActionList List(HeapAllocator());
+        List.AddCallable([spCount]() { ++*spCount; });
+        List.AddCallable(LargeCallable{ spCount });
+        List.AddDelete(new DeleteTracker(NumDeleted));
+        EXPECT_EQ(spCount.use_count(), 3);
+    }
+
+    // Callables are destroyed without running, but objects owned by the list are still deleted.
+    EXPECT_EQ(*spCount, 0u);
+    EXPECT_EQ(spCount.use_count(), 1);
+    EXPECT_EQ(NumDeleted, 1u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PostBatchActionList, MoveTransfersPendingActions)
+{
+    auto spCount = std::make_shared<UINT>(0);
+    PostBatchActionList Source(HeapAllocator());
+    Source.AddCallable([spCount]() { ++*spCount; });
+
+    PostBatchActionList Dest(std::move(Source));
+    PostBatchActionList Assigned(HeapAllocator());
+    Assigned.AddCallable([spCount]() { ++*spCount; });
+    Assigned = std::move(Dest); // Destroys the action Assigned held.
+    EXPECT_EQ(spCount.use_count(), 2);
+
+    Assigned.Execute();
+    EXPECT_EQ(*spCount, 1u);
+    EXPECT_EQ(spCount.use_count(), 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PostBatchActionList, ThrowingActionDestroysTheRest)
+{
+    auto spCount = std::make_shared<UINT>(0);
+    UINT NumDeleted = 0;
+
+    PostBatchActionList List(HeapAllocator());
+    List.AddCallable([spCount]() { ++*spCount; });
+    List.AddCallable([]() { ThrowFailure(E_INVALIDARG); });
+    List.AddCallable([spCount]() { ++*spCount; });
+    List.AddCallable(LargeCallable{ spCount });
+    List.AddDelete(new DeleteTracker(NumDeleted));
+
+    EXPECT_THROW(List.Execute(), _com_error);
+    EXPECT_TRUE(List.empty());
+    EXPECT_EQ(*spCount, 1u);
+    EXPECT_EQ(spCount.use_count(), 1);
+    EXPECT_EQ(NumDeleted, 1u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PostBatchActionList, ReturnPagesDestroysPendingActions)
+{
+    FreePageContainer Pages;
+    BatchedContext::BatchStorageAllocator Allocator = { &Pages };
+    auto spCount = std::make_shared<UINT>(0);
+    UINT NumDeleted = 0;
+    {
+        PostBatchActionList List(Allocator);
+        List.AddCallable([spCount]() { ++*spCount; });
+        List.AddDelete(new DeleteTracker(NumDeleted));
+
+        FreePageContainer::Adder Adder(Pages);
+        List.ReturnPages(Adder);
+        EXPECT_EQ(spCount.use_count(), 1);
+        EXPECT_EQ(NumDeleted, 1u);
+    }
+    EXPECT_EQ(*spCount, 0u);
+
+    // The returned page is handed out again.
+    void* pPage = Pages.RemovePage();
+    EXPECT_NE(pPage, nullptr);
+    operator delete(pPage);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PostBatchActionList, ForEachDestroyedObject)
+{
+    UINT NumDeleted = 0;
+    auto pTracker = new DeleteTracker(NumDeleted);
+    int Tagged = 0;
+
+    PostBatchActionList List(HeapAllocator());
+    List.AddCallable([]() {});
+    List.AddDelete(pTracker);
+    List.AddCallable([]() {}, &Tagged);
+
+    std::vector<void*> Objects;
+    List.ForEachDestroyedObject([&Objects](void* pObject) { Objects.push_back(pObject); });
+    EXPECT_EQ(Objects, (std::vector<void*>{ pTracker, &Tagged }));
+    EXPECT_EQ(NumDeleted, 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Not a pass/fail test: reports the cost per action against the std::function vector this list replaced.
+TEST(PostBatchActionList, Benchmark)
+{
+    constexpr UINT NumBatches = 2000;
+    constexpr UINT ActionsPerBatch = 64;
+    using Clock = std::chrono::steady_clock;
+    UINT64 Sum = 0;
+
+    FreePageContainer Pages;
+    BatchedContext::BatchStorageAllocator Allocator = { &Pages };
+    auto ListStart = Clock::now();
+    for (UINT Batch = 0; Batch < NumBatches; ++Batch)
+    {
+        PostBatchActionList List(Allocator);
+        for (UINT i = 0; i < ActionsPerBatch; ++i)
+        {
+            List.AddCallable([&Sum, i]() { Sum += i; });
+        }
+        List.Execute();
+        FreePageContainer::Adder Adder(Pages);
+        List.ReturnPages(Adder);
+    }
+    auto ListEnd = Clock::now();
+
+    for (UINT Batch = 0; Batch < NumBatches; ++Batch)
+    {
+        std::vector<std::function<void()>> Functions;
+        for (UINT i = 0; i < ActionsPerBatch; ++i)
+        {
+            Functions.emplace_back([&Sum, i]() { Sum += i; });
+        }
+        for (auto& fn : Functions)
+        {
+            fn();
+        }
+    }
+    auto VectorEnd = Clock::now();
+
+    const UINT64 Expected = 2ull * NumBatches * (ActionsPerBatch * (ActionsPerBatch - 1) / 2);
+    EXPECT_EQ(Sum, Expected);
+
+    const double NumActions = double(NumBatches) * ActionsPerBatch;
+    const double ListNs = std::chrono::duration<double, std::nano>(ListEnd - ListStart).count() / NumActions;
+    const double VectorNs = std::chrono::duration<double, std::nano>(VectorEnd - ListEnd).count() / NumActions;
+    RecordProperty("PostBatchActionListNsPerAction", std::to_string(ListNs));
+    RecordProperty("FunctionVectorNsPerAction", std::to_string(VectorNs));
+    std::cout << "PostBatchActionList: " << ListNs << " ns/action, std::vector<std::function>: " << VectorNs << " ns/action\n";
+}
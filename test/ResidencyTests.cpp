@@ -0,0 +1,513 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <random>
+#include "WarpDevice.h"
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static CComPtr<ID3D12Fence> CreateFence(ID3D12Device3* pDevice)
+{
+    CComPtr<ID3D12Fence> spFence;
+    EXPECT_HRESULT_SUCCEEDED(pDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&spFence)));
+    return spFence;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static CComPtr<ID3D12Heap> CreateHeap(ID3D12Device3* pDevice)
+{
+    CD3DX12_HEAP_DESC Desc(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, D3D12_HEAP_TYPE_DEFAULT);
+    CComPtr<ID3D12Heap> spHeap;
+    EXPECT_HRESULT_SUCCEEDED(pDevice->CreateHeap(&Desc, IID_PPV_ARGS(&spHeap)));
+    return spHeap;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static ULONG GetRefCount(IUnknown* pObject)
+{
+    pObject->AddRef();
+    return pObject->Release();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static void WaitForFence(ID3D12Fence* pFence, UINT64 Value)
+{
+    // A null event blocks until the value is reached
+    ASSERT_HRESULT_SUCCEEDED(pFence->SetEventOnCompletion(Value, nullptr));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PagingQueue, EvictionWaitsForCapturedFences)
+{
+    CComPtr<ID3D12Device3> spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CComPtr<ID3D12Fence> spPagingFence = CreateFence(spDevice);
+    CComPtr<ID3D12Fence> spQueueFence = CreateFence(spDevice);
+    CComPtr<ID3D12Heap> spHeap = CreateHeap(spDevice);
+
+    Internal::PagingQueue Paging;
+    ASSERT_HRESULT_SUCCEEDED(Paging.Initialize(spDevice, spPagingFence));
+
+    Internal::PagingQueue::EvictReservation Reservation;
+    Paging.ReserveEvict(Reservation, 1);
+
+    std::vector<ID3D12Pageable*> Objects = { spHeap.p };
+    ID3D12Fence* WaitFences[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = { spQueueFence.p };
+    UINT64 WaitFenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = { 1 };
+    Paging.QueueEvict(Reservation, Objects, WaitFences, WaitFenceValues);
+
+    // Work queued behind the eviction can't run until the fence it waits on is signaled
+    ID3D12Pageable* pHeap = spHeap.p;
+    Paging.QueueMakeResident(1, &pHeap, 1);
+    Sleep(50);
+    EXPECT_EQ(spPagingFence->GetCompletedValue(), 0u);
+    EXPECT_EQ(GetRefCount(spHeap), 3u);
+
+    ASSERT_HRESULT_SUCCEEDED(spQueueFence->Signal(1));
+    WaitForFence(spPagingFence, 1);
+    Paging.Shutdown();
+
+    EXPECT_EQ(GetRefCount(spHeap), 1u);
+    EXPECT_HRESULT_SUCCEEDED(Paging.TakeMakeResidentError());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PagingQueue, NullFencesAreNotWaitedOn)
+{
+    CComPtr<ID3D12Device3> spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CComPtr<ID3D12Fence> spPagingFence = CreateFence(spDevice);
+    CComPtr<ID3D12Heap> spHeap = CreateHeap(spDevice);
+
+    Internal::PagingQueue Paging;
+    ASSERT_HRESULT_SUCCEEDED(Paging.Initialize(spDevice, spPagingFence));
+
+    Internal::PagingQueue::EvictReservation Reservation;
+    Paging.ReserveEvict(Reservation, 1);
+
+    // Command list types which haven't been created have no fence, regardless of the value
+    std::vector<ID3D12Pageable*> Objects = { spHeap.p };
+    ID3D12Fence* WaitFences[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    UINT64 WaitFenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID];
+    std::fill(std::begin(WaitFenceValues), std::end(WaitFenceValues), UINT64_MAX);
+    Paging.QueueEvict(Reservation, Objects, WaitFences, WaitFenceValues);
+
+    ID3D12Pageable* pHeap = spHeap.p;
+    Paging.QueueMakeResident(1, &pHeap, 1);
+    WaitForFence(spPagingFence, 1);
+    Paging.Shutdown();
+
+    EXPECT_EQ(GetRefCount(spHeap), 1u);
+    EXPECT_EQ(Paging.GetNumSyncPointWaits(), 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PagingQueue, ReservationsAreReusable)
+{
+    CComPtr<ID3D12Device3> spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CComPtr<ID3D12Fence> spPagingFence = CreateFence(spDevice);
+    CComPtr<ID3D12Heap> spHeaps[] = { CreateHeap(spDevice), CreateHeap(spDevice), CreateHeap(spDevice) };
+
+    Internal::PagingQueue Paging;
+    ASSERT_HRESULT_SUCCEEDED(Paging.Initialize(spDevice, spPagingFence));
+
+    ID3D12Fence* WaitFences[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    UINT64 WaitFenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    Internal::PagingQueue::EvictReservation Reservation;
+    for (UINT i = 0; i < 4; ++i)
+    {
+        // Queuing hands the reserved storage to the paging thread, so each eviction reserves again
+        Paging.ReserveEvict(Reservation, _countof(spHeaps));
+        std::vector<ID3D12Pageable*> Objects;
+        for (UINT j = 0; j <= i % _countof(spHeaps); ++j)
+        {
+            Objects.push_back(spHeaps[j].p);
+        }
+        Paging.QueueEvict(Reservation, Objects, WaitFences, WaitFenceValues);
+    }
+    Paging.Shutdown();
+
+    for (auto& spHeap : spHeaps)
+    {
+        EXPECT_EQ(GetRefCount(spHeap), 1u);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(PagingQueue, ShutdownDrainsQueuedWork)
+{
+    CComPtr<ID3D12Device3> spDevice = CreateWarpDevice();
+    if (!spDevice)
+    {
+        GTEST_SKIP() << "WARP is not available";
+    }
+    CComPtr<ID3D12Fence> spPagingFence = CreateFence(spDevice);
+    CComPtr<ID3D12Heap> spHeap = CreateHeap(spDevice);
+    ID3D12Pageable* pHeap = spHeap.p;
+
+    {
+        Internal::PagingQueue Paging;
+        ASSERT_HRESULT_SUCCEEDED(Paging.Initialize(spDevice, spPagingFence));
+        for (UINT64 Value = 1; Value <= 16; ++Value)
+        {
+            Paging.QueueMakeResident(1, &pHeap, Value);
+        }
+    }
+
+    EXPECT_EQ(spPagingFence->GetCompletedValue(), 16u);
+    EXPECT_EQ(GetRefCount(spHeap), 1u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// LRU objects are only compared by address, so they can stand in for their own underlying objects.
+static void AddResidentObject(Internal::LRUCache& LRU, ManagedObject& Object, UINT64 Size)
+{
+    Object.Initialize(reinterpret_cast<ID3D12Pageable*>(&Object), Size);
+    Object.ResidencyStatus = ManagedObject::RESIDENCY_STATUS::EVICTED;
+    LRU.Insert(&Object);
+    LRU.MakeResident(&Object);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static std::vector<ID3D12Pageable*> Underlying(std::initializer_list<ManagedObject*> Objects)
+{
+    std::vector<ID3D12Pageable*> Result;
+    for (auto pObject : Objects)
+    {
+        Result.push_back(pObject->pUnderlying);
+    }
+    return Result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(LRUCache, TrimStopsOnceBudgetIsMet)
+{
+    Internal::LRUCache LRU;
+    ManagedObject Objects[4];
+    for (auto& Object : Objects)
+    {
+        AddResidentObject(LRU, Object, 100);
+    }
+
+    UINT64 FenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    std::vector<ID3D12Pageable*> EvictionList;
+    LRU.TrimToSyncPointInclusive(400, 250, EvictionList, FenceValues);
+
+    EXPECT_EQ(EvictionList, Underlying({ &Objects[0], &Objects[1] }));
+    EXPECT_EQ(LRU.NumResidentObjects, 2u);
+    EXPECT_EQ(LRU.ResidentSize, 200u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(LRUCache, TrimEndsWhenListIsExhausted)
+{
+    Internal::LRUCache LRU;
+    ManagedObject Objects[4];
+    for (auto& Object : Objects)
+    {
+        AddResidentObject(LRU, Object, 100);
+    }
+    LRU.BeginEpoch();
+    LRU.ObjectReferenced(&Objects[1]);
+
+    // The budget can't be met, so every object is evicted, including ones which were moved to the tail during the walk
+    UINT64 FenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    std::vector<ID3D12Pageable*> EvictionList;
+    LRU.TrimToSyncPointInclusive(1000, 0, EvictionList, FenceValues);
+
+    EXPECT_EQ(EvictionList, Underlying({ &Objects[0], &Objects[2], &Objects[3], &Objects[1] }));
+    EXPECT_EQ(LRU.NumResidentObjects, 0u);
+    EXPECT_EQ(LRU.NumEvictedObjects, 4u);
+    EXPECT_EQ(LRU.GetResidentListHead(), nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(LRUCache, ReferencedObjectsAreEvictedLast)
+{
+    Internal::LRUCache LRU;
+    ManagedObject Objects[3];
+    for (auto& Object : Objects)
+    {
+        AddResidentObject(LRU, Object, 100);
+    }
+    LRU.BeginEpoch();
+    LRU.ObjectReferenced(&Objects[0]);
+    LRU.BeginEpoch();
+    LRU.ObjectReferenced(&Objects[1]);
+
+    EXPECT_EQ(LRU.GetResidentListHead(), &Objects[2]);
+
+    UINT64 FenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    std::vector<ID3D12Pageable*> EvictionList;
+    LRU.TrimToSyncPointInclusive(300, 101, EvictionList, FenceValues);
+    EXPECT_EQ(EvictionList, Underlying({ &Objects[2], &Objects[0] }));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(LRUCache, NewObjectsAreEvictedFirst)
+{
+    Internal::LRUCache LRU;
+    ManagedObject Objects[2];
+    AddResidentObject(LRU, Objects[0], 100);
+    LRU.BeginEpoch();
+
+    // Created resident, but not yet used
+    Objects[1].Initialize(reinterpret_cast<ID3D12Pageable*>(&Objects[1]), 100);
+    LRU.Insert(&Objects[1]);
+
+    EXPECT_EQ(LRU.GetResidentListHead(), &Objects[1]);
+    EXPECT_EQ(LRU.GetResidentObjectAfter(&Objects[1].ListEntry), &Objects[0]);
+
+    LRU.BeginEpoch();
+    LRU.ObjectReferenced(&Objects[1]);
+    EXPECT_EQ(LRU.GetResidentListHead(), &Objects[0]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(LRUCache, LowerPriorityClassesAreEvictedFirst)
+{
+    Internal::LRUCache LRU;
+    ManagedObject Objects[3];
+    for (auto& Object : Objects)
+    {
+        AddResidentObject(LRU, Object, 100);
+    }
+    Objects[0].PriorityClass = ManagedObject::PRIORITY_CLASS::HIGH;
+    Objects[2].PriorityClass = ManagedObject::PRIORITY_CLASS::LOW;
+
+    UINT64 FenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    std::vector<ID3D12Pageable*> EvictionList;
+    LRU.TrimToSyncPointInclusive(300, 101, EvictionList, FenceValues);
+    EXPECT_EQ(EvictionList, Underlying({ &Objects[2], &Objects[1] }));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(LRUCache, TrimStopsAtObjectsInUseByTheGPU)
+{
+    Internal::LRUCache LRU;
+    ManagedObject Objects[3];
+    for (auto& Object : Objects)
+    {
+        AddResidentObject(LRU, Object, 100);
+    }
+    Objects[1].LastUsedFenceValues[(UINT)COMMAND_LIST_TYPE::GRAPHICS] = 2;
+
+    // Everything after the first object in use is at least as recent, so the walk stops there
+    UINT64 FenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = { 1 };
+    std::vector<ID3D12Pageable*> EvictionList;
+    LRU.TrimToSyncPointInclusive(300, 0, EvictionList, FenceValues);
+    EXPECT_EQ(EvictionList, Underlying({ &Objects[0] }));
+
+    EvictionList.clear();
+    FenceValues[(UINT)COMMAND_LIST_TYPE::GRAPHICS] = 2;
+    LRU.TrimToSyncPointInclusive(200, 0, EvictionList, FenceValues);
+    EXPECT_EQ(EvictionList, Underlying({ &Objects[1], &Objects[2] }));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(LRUCache, TrimAgedAllocationsKeepsRecentlyUsedObjects)
+{
+    Internal::LRUCache LRU;
+    ManagedObject Objects[3];
+    for (UINT i = 0; i < _countof(Objects); ++i)
+    {
+        AddResidentObject(LRU, Objects[i], 100);
+        Objects[i].LastUsedTimestamp = 100 * i;
+    }
+
+    UINT64 FenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    std::vector<ID3D12Pageable*> EvictionList;
+    LRU.TrimAgedAllocations(FenceValues, EvictionList, 250, 100);
+    EXPECT_EQ(EvictionList, Underlying({ &Objects[0], &Objects[1] }));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(LRUCache, RandomReferencesKeepListOrdered)
+{
+    Internal::LRUCache LRU;
+    std::vector<ManagedObject> Objects(64);
+    for (auto& Object : Objects)
+    {
+        AddResidentObject(LRU, Object, 1);
+    }
+
+    std::mt19937 Random(42);
+    UINT64 FenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+    std::vector<ID3D12Pageable*> EvictionList;
+    for (UINT Epoch = 0; Epoch < 1000; ++Epoch)
+    {
+        LRU.BeginEpoch();
+        for (UINT i = 0; i < 8; ++i)
+        {
+            ManagedObject& Object = Objects[Random() % Objects.size()];
+            if (Object.ResidencyStatus == ManagedObject::RESIDENCY_STATUS::EVICTED)
+            {
+                LRU.MakeResident(&Object);
+            }
+            LRU.ObjectReferenced(&Object);
+        }
+
+        EvictionList.clear();
+        LRU.TrimToSyncPointInclusive(LRU.ResidentSize, 48, EvictionList, FenceValues);
+        ASSERT_LE(LRU.ResidentSize, 48u);
+
+        // Objects referenced in this epoch are at least as recent as anything else, so they're never evicted ahead of others
+        for (auto pUnderlying : EvictionList)
+        {
+            auto pObject = reinterpret_cast<ManagedObject*>(pUnderlying);
+            if (pObject->LastReferencedEpoch == LRU.CurrentEpoch)
+            {
+                EXPECT_EQ(LRU.ResidentSize, 0u);
+            }
+        }
+
+        UINT64 PreviousEpoch = 0;
+        UINT32 NumResident = 0;
+        for (ManagedObject* pObject = LRU.GetResidentListHead(); pObject; pObject = LRU.GetResidentObjectAfter(&pObject->ListEntry))
+        {
+            ASSERT_GE(pObject->ListEpoch, PreviousEpoch);
+            PreviousEpoch = pObject->ListEpoch;
+            ++NumResident;
+        }
+        ASSERT_EQ(NumResident, LRU.NumResidentObjects);
+        ASSERT_EQ(NumResident + LRU.NumEvictedObjects, Objects.size());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+struct EvictionSimulationResult
+{
+    UINT64 PageInBytes;
+    // Evicted while making room for a submission, which delays it until the paging thread has evicted
+    UINT64 OnDemandEvictionBytes;
+    // On demand evictions of objects the GPU might still be using, which also wait for the GPU
+    UINT64 WaitingEvictionBytes;
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Replays a trace through the LRU cache the way ProcessPagingWork does. Each submission uses a window of objects which
+// slides through a pool larger than the budget, and the GPU completes submissions a fixed number of submissions late.
+static EvictionSimulationResult SimulateStreamingTrace(bool bPredictiveEviction)
+{
+    constexpr UINT NumObjects = 256;
+    constexpr UINT WindowSize = 16;
+    constexpr UINT WindowStep = 4;
+    constexpr UINT GPULatency = 2;
+    constexpr UINT64 ObjectSize = 64 * 1024;
+    constexpr INT64 Budget = 48 * ObjectSize;
+    constexpr UINT Graphics = (UINT)COMMAND_LIST_TYPE::GRAPHICS;
+
+    Internal::LRUCache LRU;
+    Internal::WorkingSetGrowthPredictor WorkingSetGrowth;
+    std::vector<ManagedObject> Objects(NumObjects);
+    for (auto& Object : Objects)
+    {
+        Object.Initialize(reinterpret_cast<ID3D12Pageable*>(&Object), ObjectSize);
+        Object.ResidencyStatus = ManagedObject::RESIDENCY_STATUS::EVICTED;
+        LRU.Insert(&Object);
+    }
+
+    EvictionSimulationResult Result = {};
+    std::vector<ID3D12Pageable*> EvictionList;
+    for (UINT64 Submission = 1; Submission <= 1000; ++Submission)
+    {
+        UINT64 CompletedFenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+        UINT64 LastSubmittedFenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID] = {};
+        CompletedFenceValues[Graphics] = Submission > GPULatency ? Submission - 1 - GPULatency : 0;
+        LastSubmittedFenceValues[Graphics] = Submission - 1;
+
+        LRU.BeginEpoch();
+        UINT64 SizeToMakeResident = 0;
+        for (UINT i = 0; i < WindowSize; ++i)
+        {
+            ManagedObject& Object = Objects[(Submission * WindowStep + i) % NumObjects];
+            if (Object.ResidencyStatus == ManagedObject::RESIDENCY_STATUS::EVICTED)
+            {
+                LRU.MakeResident(&Object);
+                SizeToMakeResident += Object.Size;
+            }
+            Object.LastUsedFenceValues[Graphics] = Submission;
+            LRU.ObjectReferenced(&Object);
+        }
+        Result.PageInBytes += SizeToMakeResident;
+
+        WorkingSetGrowth.AddSubmission(SizeToMakeResident);
+        if (bPredictiveEviction)
+        {
+            INT64 ProjectedUsage = WorkingSetGrowth.ProjectUsage(INT64(LRU.ResidentSize));
+            if (ProjectedUsage >= Budget)
+            {
+                EvictionList.clear();
+                LRU.TrimToSyncPointInclusive(ProjectedUsage, Budget, EvictionList, CompletedFenceValues);
+            }
+        }
+
+        if (INT64(LRU.ResidentSize) > Budget)
+        {
+            EvictionList.clear();
+            LRU.TrimToSyncPointInclusive(INT64(LRU.ResidentSize), Budget, EvictionList, LastSubmittedFenceValues);
+            for (auto pUnderlying : EvictionList)
+            {
+                auto pObject = reinterpret_cast<ManagedObject*>(pUnderlying);
+                Result.OnDemandEvictionBytes += pObject->Size;
+                if (pObject->LastUsedFenceValues[Graphics] > CompletedFenceValues[Graphics])
+                {
+                    Result.WaitingEvictionBytes += pObject->Size;
+                }
+            }
+        }
+    }
+    return Result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(WorkingSetGrowthPredictor, ConvergesOnSteadyGrowth)
+{
+    Internal::WorkingSetGrowthPredictor WorkingSetGrowth;
+    EXPECT_EQ(WorkingSetGrowth.ProjectUsage(100), 100);
+
+    for (UINT i = 0; i < 256; ++i)
+    {
+        WorkingSetGrowth.AddSubmission(1000);
+    }
+    EXPECT_NEAR(WorkingSetGrowth.GrowthEstimate, 1000.0, 1.0);
+    EXPECT_NEAR(double(WorkingSetGrowth.ProjectUsage(100)), 100.0 + 1000.0 * Internal::WorkingSetGrowthPredictor::cLookahead, 4.0);
+
+    // A single spike only moves the estimate by the smoothing factor
+    WorkingSetGrowth.AddSubmission(1000 + 16000);
+    EXPECT_NEAR(WorkingSetGrowth.GrowthEstimate, 2000.0, 1.0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(WorkingSetGrowthPredictor, StreamingTraceSimulation)
+{
+    EvictionSimulationResult OnDemand = SimulateStreamingTrace(false);
+    EvictionSimulationResult Predictive = SimulateStreamingTrace(true);
+
+    RecordProperty("OnDemandPageInBytes", std::to_string(OnDemand.PageInBytes));
+    RecordProperty("PredictivePageInBytes", std::to_string(Predictive.PageInBytes));
+    RecordProperty("OnDemandEvictionBytesWithoutPrediction", std::to_string(OnDemand.OnDemandEvictionBytes));
+    RecordProperty("OnDemandEvictionBytesWithPrediction", std::to_string(Predictive.OnDemandEvictionBytes));
+    std::cout << "Page-in bytes: " << OnDemand.PageInBytes << " without prediction, " << Predictive.PageInBytes << " with\n";
+    std::cout << "Bytes evicted while a submission waits: " << OnDemand.OnDemandEvictionBytes << " without prediction, "
+              << Predictive.OnDemandEvictionBytes << " with\n";
+
+    // Predictive trims only evict objects the GPU is done with, so they can't cause waits, and once the estimate has
+    // converged, submissions find room already made for them.
+    EXPECT_EQ(Predictive.WaitingEvictionBytes, 0u);
+    EXPECT_LT(Predictive.OnDemandEvictionBytes, OnDemand.OnDemandEvictionBytes / 4);
+    // Objects are evicted sooner, but not ones that the trace uses again before they'd have been evicted anyway
+    EXPECT_EQ(Predictive.PageInBytes, OnDemand.PageInBytes);
+}
@@ -0,0 +1,645 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Backing memory for one preallocated array, aligned for any of them.
+class PreallocatedMemory
+{
+public:
+    explicit PreallocatedMemory(size_t Size)
+        : m_spMemory(new UINT64[Size / sizeof(UINT64) + 1])
+        , m_pNext(m_spMemory.get())
+    {
+    }
+    void*& Get() { return m_pNext; }
+
+private:
+    std::unique_ptr<UINT64[]> m_spMemory;
+    void* m_pNext;
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// A transitionable resource without a device. Its D3D12 resource pointer is only used to identify it in barriers.
+class TestResource : private PreallocatedMemory, public TransitionableResourceBase
+{
+public:
+    explicit TestResource(UINT NumSubresources)
+        : PreallocatedMemory(TransitionableResourceBase::CalcPreallocationSize(NumSubresources))
+        , TransitionableResourceBase(NumSubresources, false, PreallocatedMemory::Get())
+        , m_NumSubresources(NumSubresources)
+        , m_CurrentStateMemory(CCurrentResourceState::CalcPreallocationSize(NumSubresources, false))
+        , m_CurrentState(NumSubresources, false, m_CurrentStateMemory.Get())
+        , m_BindingsMemory(CResourceBindings::CalcPreallocationSize(NumSubresources))
+        , m_Bindings(NumSubresources, 0, m_BindingsMemory.Get())
+    {
+    }
+
+    ID3D12Resource* GetD3D12Resource() { return reinterpret_cast<ID3D12Resource*>(this); }
+
+    const UINT m_NumSubresources;
+    PreallocatedMemory m_CurrentStateMemory;
+    CCurrentResourceState m_CurrentState;
+    PreallocatedMemory m_BindingsMemory;
+    CResourceBindings m_Bindings;
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+class TestStateManager : public ResourceStateManagerBase
+{
+public:
+    using ResourceStateManagerBase::TransitionResource;
+    using ResourceStateManagerBase::TransitionSubresource;
+    using ResourceStateManagerBase::IsBindingTransitionCurrent;
+    using ResourceStateManagerBase::TransitionResourceForChangedBindings;
+    using ResourceStateManagerBase::TransitionSubresourcesForChangedBindings;
+    using ResourceStateManagerBase::SetUseSplitBarriers;
+    using ResourceStateManagerBase::TakeSplitEndBarriers;
+    using ResourceStateManagerBase::DiscardSplitBarriers;
+    using ResourceStateManagerBase::GetBarrierStatistics;
+
+    // Processes all pending transitions for one graphics operation, and returns the barriers which would be recorded.
+    std::vector<D3D12_RESOURCE_BARRIER> ApplyAllResourceTransitions(bool bIsPreDraw = false)
+    {
+        UINT64 FenceValues[(UINT)COMMAND_LIST_TYPE::MAX_VALID];
+        std::fill(std::begin(FenceValues), std::end(FenceValues), 1ull);
+
+        ApplyResourceTransitionsPreamble();
+        ForEachTransitioningResource([&FenceValues, bIsPreDraw, this](TransitionableResourceBase& ResourceBase) -> TransitionResult
+        {
+            TestResource& Resource = static_cast<TestResource&>(ResourceBase);
+            return ProcessTransitioningResource(
+                Resource.GetD3D12Resource(),
+                Resource,
+                Resource.m_CurrentState,
+                Resource.m_Bindings,
+                Resource.m_NumSubresources,
+                FenceValues,
+                bIsPreDraw);
+        });
+
+        std::vector<D3D12_RESOURCE_BARRIER> Barriers;
+        SimulateSubmitResourceTransitions(
+            [&Barriers](std::vector<D3D12_RESOURCE_BARRIER>& Submitted, COMMAND_LIST_TYPE) { Barriers.insert(Barriers.end(), Submitted.begin(), Submitted.end()); },
+            [](COMMAND_LIST_TYPE) {},
+            [](COMMAND_LIST_TYPE) { return false; },
+            [&FenceValues](COMMAND_LIST_TYPE Type) { return FenceValues[(UINT)Type]; },
+            [](COMMAND_LIST_TYPE) {},
+            [](UINT64, COMMAND_LIST_TYPE, COMMAND_LIST_TYPE) {});
+        PostSubmitUpdateState([](PostApplyUpdate const&, COMMAND_LIST_TYPE, UINT64) {}, FenceValues, FenceValues[(UINT)COMMAND_LIST_TYPE::GRAPHICS]);
+        return Barriers;
+    }
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static CDesiredResourceState::SubresourceInfo GraphicsState(D3D12_RESOURCE_STATES State)
+{
+    return { State, COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::NoBindingTransitions };
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Test resources are single-slice, single-plane textures with one mip per subresource.
+static CViewSubresourceSubset MipSubset(TestResource const& Resource, UINT8 FirstMip, UINT8 NumMips)
+{
+    return CViewSubresourceSubset(CSubresourceSubset(NumMips, 1, 1, FirstMip), static_cast<UINT8>(Resource.m_NumSubresources), 1, 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+static void ExpectBarrier(D3D12_RESOURCE_BARRIER const& Barrier, UINT Subresource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After)
+{
+    EXPECT_EQ(Barrier.Type, D3D12_RESOURCE_BARRIER_TYPE_TRANSITION);
+    EXPECT_EQ(Barrier.Transition.Subresource, Subresource);
+    EXPECT_EQ(Barrier.Transition.StateBefore, Before);
+    EXPECT_EQ(Barrier.Transition.StateAfter, After);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ResourceStateManager, TransitionsSpansOfSubresources)
+{
+    constexpr UINT NumSubresources = 24;
+    TestStateManager Manager;
+    TestResource Resource(NumSubresources);
+
+    Manager.TransitionResource(Resource, GraphicsState(D3D12_RESOURCE_STATE_RENDER_TARGET));
+    auto Barriers = Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_TRUE(Resource.m_CurrentState.AreAllSubresourcesSame());
+    EXPECT_TRUE(Manager.ApplyAllResourceTransitions().empty());
+
+    // Every other subresource diverges
+    for (UINT i = 0; i < NumSubresources; i += 2)
+    {
+        Manager.TransitionSubresource(Resource, i, GraphicsState(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
+    }
+    Barriers = Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Barriers.size(), NumSubresources / 2);
+    for (UINT i = 0; i < Barriers.size(); ++i)
+    {
+        ExpectBarrier(Barriers[i], i * 2, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    }
+    EXPECT_EQ(Resource.m_CurrentState.GetNumRuns(), NumSubresources);
+
+    // Only the subresources which aren't already in the state need barriers, and the state converges again
+    Manager.TransitionResource(Resource, GraphicsState(D3D12_RESOURCE_STATE_RENDER_TARGET));
+    Barriers = Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Barriers.size(), NumSubresources / 2);
+    for (UINT i = 0; i < Barriers.size(); ++i)
+    {
+        ExpectBarrier(Barriers[i], i * 2, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    }
+    EXPECT_TRUE(Resource.m_CurrentState.AreAllSubresourcesSame());
+
+    Manager.TransitionResource(Resource, GraphicsState(D3D12_RESOURCE_STATE_COPY_DEST));
+    Barriers = Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_DEST);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// A 2048-slice array with 12 mips, where every subresource has its own current state, but almost all share a desired state.
+// Finding each span must not rescan the rest of the desired state.
+TEST(ResourceStateManager, BenchmarkManyCurrentRunsWithinOneDesiredRun)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr UINT NumSubresources = 2048 * 12;
+    TestStateManager Manager;
+    TestResource Resource(NumSubresources);
+
+    Manager.TransitionResource(Resource, GraphicsState(D3D12_RESOURCE_STATE_RENDER_TARGET));
+    Manager.ApplyAllResourceTransitions();
+    for (UINT i = 0; i < NumSubresources; i += 2)
+    {
+        Manager.TransitionSubresource(Resource, i, GraphicsState(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
+    }
+    Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Resource.m_CurrentState.GetNumRuns(), NumSubresources);
+
+    Manager.TransitionSubresource(Resource, 0, GraphicsState(D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+    for (UINT i = 1; i < NumSubresources; ++i)
+    {
+        Manager.TransitionSubresource(Resource, i, GraphicsState(D3D12_RESOURCE_STATE_COPY_DEST));
+    }
+
+    const auto Start = Clock::now();
+    auto Barriers = Manager.ApplyAllResourceTransitions();
+    const auto End = Clock::now();
+
+    ASSERT_EQ(Barriers.size(), NumSubresources);
+    ExpectBarrier(Barriers[0], 0, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    for (UINT i = 1; i < NumSubresources; ++i)
+    {
+        EXPECT_EQ(Barriers[i].Transition.Subresource, i);
+        EXPECT_EQ(Barriers[i].Transition.StateAfter, D3D12_RESOURCE_STATE_COPY_DEST);
+    }
+    EXPECT_EQ(Resource.m_CurrentState.GetNumRuns(), 2u);
+
+    const double Us = std::chrono::duration<double, std::micro>(End - Start).count();
+    RecordProperty("ApplyAllUs", std::to_string(Us));
+    std::cout << "ApplyAllResourceTransitions over " << NumSubresources << " subresource runs: " << Us << " us\n";
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ResourceStateManager, SkipsBindingTransitionsWhenStateIsUnchanged)
+{
+    constexpr D3D12_RESOURCE_STATES ShaderResource = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    constexpr D3D12_RESOURCE_STATES AllShaderResource = D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE;
+    TestStateManager Manager;
+    TestResource Resource(4);
+    CResourceBindings& Bindings = Resource.m_Bindings;
+    CViewSubresourceSubset Whole = MipSubset(Resource, 0, 4);
+
+    Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::PixelShaderResourceViewBound);
+    EXPECT_TRUE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+    EXPECT_TRUE(Resource.IsTransitionPending());
+    // Bound to a second slot which needs the same state
+    Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::PixelShaderResourceViewBound);
+    EXPECT_FALSE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+
+    // Binding transitions wait for a draw
+    EXPECT_TRUE(Manager.ApplyAllResourceTransitions().empty());
+    auto Barriers = Manager.ApplyAllResourceTransitions(true);
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_COMMON, ShaderResource);
+    EXPECT_FALSE(Resource.IsTransitionPending());
+
+    // Unbound from one of the slots, so still in the state its bindings need
+    Bindings.ViewUnboundCommon(Whole, &CSubresourceBindings::PixelShaderResourceViewUnbound);
+    EXPECT_FALSE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+    EXPECT_FALSE(Manager.TransitionSubresourcesForChangedBindings(Resource, Bindings, Whole));
+    EXPECT_FALSE(Resource.IsTransitionPending());
+
+    Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::NonPixelShaderResourceViewBound);
+    EXPECT_TRUE(Manager.TransitionSubresourcesForChangedBindings(Resource, Bindings, Whole));
+    Barriers = Manager.ApplyAllResourceTransitions(true);
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, ShaderResource, AllShaderResource);
+
+    // Any other transition may leave the binding state
+    Manager.TransitionSubresource(Resource, 1, { D3D12_RESOURCE_STATE_COPY_DEST, COMMAND_LIST_TYPE::GRAPHICS, SubresourceTransitionFlags::None });
+    EXPECT_FALSE(TestStateManager::IsBindingTransitionCurrent(Resource, AllShaderResource));
+    Barriers = Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], 1, AllShaderResource, D3D12_RESOURCE_STATE_COPY_DEST);
+
+    EXPECT_TRUE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+    Barriers = Manager.ApplyAllResourceTransitions(true);
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], 1, D3D12_RESOURCE_STATE_COPY_DEST, AllShaderResource);
+    EXPECT_TRUE(Resource.m_CurrentState.AreAllSubresourcesSame());
+
+    // Binding requests are ignored while a transition which opts out of them is pending, so they aren't remembered
+    Manager.TransitionResource(Resource, GraphicsState(D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+    EXPECT_TRUE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+    EXPECT_FALSE(TestStateManager::IsBindingTransitionCurrent(Resource, AllShaderResource));
+    Barriers = Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, AllShaderResource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+    EXPECT_TRUE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+    Barriers = Manager.ApplyAllResourceTransitions(true);
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, AllShaderResource);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Views of some of the subresources give each subresource its own binding state. Only the state of uniform bindings is
+// remembered, so these are never skipped.
+TEST(ResourceStateManager, TransitionsSubresourcesForNonUniformBindings)
+{
+    constexpr D3D12_RESOURCE_STATES ShaderResource = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    constexpr D3D12_RESOURCE_STATES NonPixelShaderResource = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+    constexpr D3D12_RESOURCE_STATES AllShaderResource = D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE;
+    TestStateManager Manager;
+    TestResource Resource(4);
+    CResourceBindings& Bindings = Resource.m_Bindings;
+    CViewSubresourceSubset Whole = MipSubset(Resource, 0, 4);
+    CViewSubresourceSubset Mip1 = MipSubset(Resource, 1, 1);
+
+    Bindings.ViewBoundCommon(Mip1, &CSubresourceBindings::PixelShaderResourceViewBound);
+    ASSERT_FALSE(Bindings.AreAllSubresourcesTheSame());
+    EXPECT_TRUE(Manager.TransitionSubresourcesForChangedBindings(Resource, Bindings, Mip1));
+    EXPECT_EQ(Resource.m_BindingTransitionVersion, 0u);
+    auto Barriers = Manager.ApplyAllResourceTransitions(true);
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], 1, D3D12_RESOURCE_STATE_COMMON, ShaderResource);
+
+    // Requested again, though it's already in the state
+    EXPECT_TRUE(Manager.TransitionSubresourcesForChangedBindings(Resource, Bindings, Mip1));
+    EXPECT_TRUE(Resource.IsTransitionPending());
+    EXPECT_TRUE(Manager.ApplyAllResourceTransitions(true).empty());
+
+    // Every subresource goes to the state its own bindings need
+    Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::NonPixelShaderResourceViewBound);
+    EXPECT_TRUE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+    Barriers = Manager.ApplyAllResourceTransitions(true);
+    ASSERT_EQ(Barriers.size(), 4u);
+    for (UINT i = 0; i < Barriers.size(); ++i)
+    {
+        if (i == 1)
+        {
+            ExpectBarrier(Barriers[i], i, ShaderResource, AllShaderResource);
+        }
+        else
+        {
+            ExpectBarrier(Barriers[i], i, D3D12_RESOURCE_STATE_COMMON, NonPixelShaderResource);
+        }
+    }
+
+    // Once the partial view is unbound, the bindings are uniform again, and unchanged state is skipped. Mip 1 keeps its
+    // accumulated read state, which contains the one now needed.
+    Bindings.ViewUnboundCommon(Mip1, &CSubresourceBindings::PixelShaderResourceViewUnbound);
+    ASSERT_TRUE(Bindings.AreAllSubresourcesTheSame());
+    EXPECT_TRUE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+    EXPECT_TRUE(Manager.ApplyAllResourceTransitions(true).empty());
+    EXPECT_FALSE(Manager.TransitionResourceForChangedBindings(Resource, Bindings));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// A draw loop which binds every texture to several slots per draw, without changing the state any of them need.
+TEST(ResourceStateManager, BenchmarkRebindingWithUnchangedState)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr UINT NumResources = 256;
+    constexpr UINT NumSlotsPerResource = 4;
+    constexpr UINT NumDraws = 200;
+    TestStateManager Manager;
+    std::vector<std::unique_ptr<TestResource>> Resources(NumResources);
+    for (auto& spResource : Resources)
+    {
+        spResource.reset(new TestResource(12));
+        CViewSubresourceSubset Whole = MipSubset(*spResource, 0, 12);
+        spResource->m_Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::PixelShaderResourceViewBound);
+    }
+
+    auto DrawLoop = [&](bool bSkipUnchanged)
+    {
+        UINT NumRequested = 0;
+        const auto Start = Clock::now();
+        for (UINT Draw = 0; Draw < NumDraws; ++Draw)
+        {
+            for (auto& spResource : Resources)
+            {
+                for (UINT Slot = 0; Slot < NumSlotsPerResource; ++Slot)
+                {
+                    if (!bSkipUnchanged)
+                    {
+                        // Invalidate the remembered request, as the old path never skipped
+                        spResource->m_BindingTransitionVersion = 0;
+                    }
+                    NumRequested += Manager.TransitionResourceForChangedBindings(*spResource, spResource->m_Bindings) ? 1 : 0;
+                }
+            }
+            Manager.ApplyAllResourceTransitions(true);
+        }
+        const double Us = std::chrono::duration<double, std::micro>(Clock::now() - Start).count();
+        return std::make_pair(NumRequested, Us);
+    };
+
+    const auto Always = DrawLoop(false);
+    const auto Skipped = DrawLoop(true);
+    EXPECT_EQ(Always.first, NumResources * NumSlotsPerResource * NumDraws);
+    EXPECT_EQ(Skipped.first, 0u);
+
+    RecordProperty("AlwaysTransitionUs", std::to_string(Always.second));
+    RecordProperty("SkipUnchangedUs", std::to_string(Skipped.second));
+    std::cout << "Rebinding " << NumResources << " resources to " << NumSlotsPerResource << " slots for " << NumDraws << " draws: "
+              << Always.second << " us always transitioning, " << Skipped.second << " us skipping unchanged state\n";
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Returns the barriers on the resource, in the order they were recorded.
+static std::vector<D3D12_RESOURCE_BARRIER> BarriersOn(std::vector<D3D12_RESOURCE_BARRIER> const& Barriers, TestResource& Resource)
+{
+    std::vector<D3D12_RESOURCE_BARRIER> Result;
+    for (auto& Barrier : Barriers)
+    {
+        if (Barrier.Transition.pResource == Resource.GetD3D12Resource())
+        {
+            Result.push_back(Barrier);
+        }
+    }
+    return Result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Renders to the target, binds it for reading by the next draw, and records an unrelated copy before that draw, which begins a
+// split transition from RENDER_TARGET to PIXEL_SHADER_RESOURCE on the target.
+static void BeginSplitTransition(TestStateManager& Manager, TestResource& Target, TestResource& CopyDest)
+{
+    Manager.TransitionResource(Target, GraphicsState(D3D12_RESOURCE_STATE_RENDER_TARGET));
+    Manager.ApplyAllResourceTransitions(true);
+
+    CViewSubresourceSubset Whole = MipSubset(Target, 0, 1);
+    Target.m_Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::PixelShaderResourceViewBound);
+    Manager.TransitionResourceForChangedBindings(Target, Target.m_Bindings);
+
+    // Nothing is begun by an operation which doesn't record anything on the graphics queue.
+    EXPECT_TRUE(Manager.ApplyAllResourceTransitions().empty());
+    EXPECT_EQ(Manager.GetBarrierStatistics().NumSplitBeginBarriers, 0u);
+
+    Manager.TransitionResource(CopyDest, GraphicsState(D3D12_RESOURCE_STATE_COPY_DEST));
+    auto Barriers = Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Barriers.size(), 2u);
+    auto TargetBarriers = BarriersOn(Barriers, Target);
+    ASSERT_EQ(TargetBarriers.size(), 1u);
+    ExpectBarrier(TargetBarriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    EXPECT_EQ(TargetBarriers[0].Flags, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY);
+    EXPECT_TRUE(Target.IsTransitionPending());
+    EXPECT_EQ(Manager.GetBarrierStatistics().NumSplitBeginBarriers, 1u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ResourceStateManager, SplitTransitionEndsAtTheDrawItWasBegunFor)
+{
+    TestStateManager Manager;
+    Manager.SetUseSplitBarriers(true);
+    TestResource Target(1), CopyDest(1);
+    BeginSplitTransition(Manager, Target, CopyDest);
+    ASSERT_FALSE(HasFailure());
+
+    // Operations before the draw leave the transition in flight.
+    Manager.TransitionResource(CopyDest, GraphicsState(D3D12_RESOURCE_STATE_COPY_SOURCE));
+    auto Barriers = Manager.ApplyAllResourceTransitions();
+    EXPECT_TRUE(BarriersOn(Barriers, Target).empty());
+
+    Barriers = Manager.ApplyAllResourceTransitions(true);
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    EXPECT_EQ(Barriers[0].Flags, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+    EXPECT_FALSE(Target.IsTransitionPending());
+
+    // Each half is counted once, and nothing is left to end when the command list is closed.
+    auto Stats = Manager.GetBarrierStatistics();
+    EXPECT_EQ(Stats.NumSplitBeginBarriers, 1u);
+    EXPECT_EQ(Stats.NumSplitEndBarriers, 1u);
+    EXPECT_TRUE(Manager.TakeSplitEndBarriers().empty());
+    EXPECT_TRUE(Manager.ApplyAllResourceTransitions(true).empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ResourceStateManager, SplitTransitionEndsWhenDesiredStateChanges)
+{
+    TestStateManager Manager;
+    Manager.SetUseSplitBarriers(true);
+    TestResource Target(1), CopyDest(1);
+    BeginSplitTransition(Manager, Target, CopyDest);
+    ASSERT_FALSE(HasFailure());
+
+    // Copying into the target instead ends the transition first, then transitions from where it ended.
+    Manager.TransitionResource(Target, GraphicsState(D3D12_RESOURCE_STATE_COPY_DEST));
+    auto Barriers = Manager.ApplyAllResourceTransitions();
+    ASSERT_EQ(Barriers.size(), 2u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    EXPECT_EQ(Barriers[0].Flags, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+    ExpectBarrier(Barriers[1], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_DEST);
+    EXPECT_EQ(Barriers[1].Flags, D3D12_RESOURCE_BARRIER_FLAG_NONE);
+
+    EXPECT_EQ(Manager.GetBarrierStatistics().NumSplitEndBarriers, 1u);
+    EXPECT_TRUE(Manager.TakeSplitEndBarriers().empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ResourceStateManager, SplitTransitionEndsAtClose)
+{
+    TestStateManager Manager;
+    Manager.SetUseSplitBarriers(true);
+    TestResource Target(1), CopyDest(1);
+    BeginSplitTransition(Manager, Target, CopyDest);
+    ASSERT_FALSE(HasFailure());
+
+    auto& EndBarriers = Manager.TakeSplitEndBarriers();
+    ASSERT_EQ(EndBarriers.size(), 1u);
+    ExpectBarrier(EndBarriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    EXPECT_EQ(EndBarriers[0].Flags, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+    EXPECT_EQ(Manager.GetBarrierStatistics().NumSplitEndBarriers, 1u);
+
+    // The draw in the next command list finds the target already in the state, and doesn't end it again.
+    EXPECT_TRUE(Manager.ApplyAllResourceTransitions(true).empty());
+    EXPECT_TRUE(Manager.TakeSplitEndBarriers().empty());
+    EXPECT_EQ(Manager.GetBarrierStatistics().NumSplitEndBarriers, 1u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ResourceStateManager, SplitTransitionIsDiscardedWithItsCommandList)
+{
+    TestStateManager Manager;
+    Manager.SetUseSplitBarriers(true);
+    TestResource Target(1), CopyDest(1);
+    BeginSplitTransition(Manager, Target, CopyDest);
+    ASSERT_FALSE(HasFailure());
+
+    Manager.DiscardSplitBarriers();
+    EXPECT_TRUE(Manager.TakeSplitEndBarriers().empty());
+    EXPECT_TRUE(Manager.ApplyAllResourceTransitions(true).empty());
+    EXPECT_EQ(Manager.GetBarrierStatistics().NumSplitEndBarriers, 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ResourceStateManager, SplitTransitionsAreOptIn)
+{
+    TestStateManager Manager;
+    TestResource Target(1), CopyDest(1);
+    Manager.TransitionResource(Target, GraphicsState(D3D12_RESOURCE_STATE_RENDER_TARGET));
+    Manager.ApplyAllResourceTransitions(true);
+    CViewSubresourceSubset Whole = MipSubset(Target, 0, 1);
+    Target.m_Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::PixelShaderResourceViewBound);
+    Manager.TransitionResourceForChangedBindings(Target, Target.m_Bindings);
+
+    Manager.TransitionResource(CopyDest, GraphicsState(D3D12_RESOURCE_STATE_COPY_DEST));
+    EXPECT_TRUE(BarriersOn(Manager.ApplyAllResourceTransitions(), Target).empty());
+    auto Barriers = Manager.ApplyAllResourceTransitions(true);
+    ASSERT_EQ(Barriers.size(), 1u);
+    ExpectBarrier(Barriers[0], D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    EXPECT_EQ(Barriers[0].Flags, D3D12_RESOURCE_BARRIER_FLAG_NONE);
+    EXPECT_EQ(Manager.GetBarrierStatistics().NumSplitBeginBarriers, 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Simulates a draw or dispatch which accesses the given resources through its bound UAVs, and returns its barriers.
+static std::vector<D3D12_RESOURCE_BARRIER> AccessUAVs(UAVBarrierTracker& Tracker,
+                                                      std::vector<std::pair<ID3D12Resource*, UAVBarrierTracker::AccessStamp*>> const& UAVs,
+                                                      UINT64 CommandListID,
+                                                      UINT& NumElided)
+{
+    for (auto& UAV : UAVs)
+    {
+        Tracker.AddAccess(UAV.first, *UAV.second, CommandListID);
+    }
+    std::vector<D3D12_RESOURCE_BARRIER> Barriers = Tracker.TakeBarriers(NumElided);
+    for (auto& UAV : UAVs)
+    {
+        Tracker.StampAccess(*UAV.second, CommandListID);
+    }
+    return Barriers;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(UAVBarrierTracker, CoalescesBarriersOnSeveralResources)
+{
+    UAVBarrierTracker Tracker;
+    ID3D12Resource* pA = reinterpret_cast<ID3D12Resource*>(0x1000);
+    ID3D12Resource* pB = reinterpret_cast<ID3D12Resource*>(0x2000);
+    ID3D12Resource* pC = reinterpret_cast<ID3D12Resource*>(0x3000);
+    UAVBarrierTracker::AccessStamp A, B, C;
+    UINT NumElided = 0;
+
+    // First accesses in the command list don't need barriers, even if the resource is bound to several slots.
+    EXPECT_TRUE(AccessUAVs(Tracker, { { pA, &A }, { pA, &A } }, 1, NumElided).empty());
+    EXPECT_EQ(NumElided, 0u);
+
+    // A resource accessed before needs a barrier on just itself, once no matter how many slots it's bound to.
+    auto Barriers = AccessUAVs(Tracker, { { pA, &A }, { pA, &A }, { pB, &B } }, 1, NumElided);
+    ASSERT_EQ(Barriers.size(), 1u);
+    EXPECT_EQ(Barriers[0].Type, D3D12_RESOURCE_BARRIER_TYPE_UAV);
+    EXPECT_EQ(Barriers[0].UAV.pResource, pA);
+    EXPECT_EQ(NumElided, 1u);
+
+    // Several resources share one barrier on all UAVs.
+    EXPECT_TRUE(AccessUAVs(Tracker, { { pC, &C } }, 1, NumElided).empty());
+    Barriers = AccessUAVs(Tracker, { { pA, &A }, { pB, &B }, { pC, &C } }, 1, NumElided);
+    ASSERT_EQ(Barriers.size(), 1u);
+    EXPECT_EQ(Barriers[0].UAV.pResource, nullptr);
+    EXPECT_EQ(NumElided, 2u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(UAVBarrierTracker, BarrierOnAllUAVsCoversEarlierAccesses)
+{
+    UAVBarrierTracker Tracker;
+    ID3D12Resource* pA = reinterpret_cast<ID3D12Resource*>(0x1000);
+    ID3D12Resource* pB = reinterpret_cast<ID3D12Resource*>(0x2000);
+    ID3D12Resource* pC = reinterpret_cast<ID3D12Resource*>(0x3000);
+    UAVBarrierTracker::AccessStamp A, B, C;
+    UINT NumElided = 0;
+
+    AccessUAVs(Tracker, { { pA, &A }, { pB, &B }, { pC, &C } }, 1, NumElided);
+    ASSERT_EQ(AccessUAVs(Tracker, { { pA, &A }, { pB, &B } }, 1, NumElided).size(), 1u);
+
+    // C was accessed before the barrier on all UAVs, so it's synchronized.
+    EXPECT_TRUE(AccessUAVs(Tracker, { { pC, &C } }, 1, NumElided).empty());
+    EXPECT_EQ(NumElided, 0u);
+    // A and B were accessed again at the barrier, so need one again.
+    EXPECT_EQ(AccessUAVs(Tracker, { { pA, &A }, { pB, &B } }, 1, NumElided).size(), 1u);
+
+    // So does an explicit barrier on all UAVs.
+    Tracker.AllUAVBarrierRecorded();
+    EXPECT_TRUE(AccessUAVs(Tracker, { { pA, &A }, { pB, &B }, { pC, &C } }, 1, NumElided).empty());
+
+    // Accesses in earlier command lists are synchronized by the command list boundary.
+    EXPECT_TRUE(AccessUAVs(Tracker, { { pA, &A }, { pB, &B }, { pC, &C } }, 2, NumElided).empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Translates the barriers for the transitions of a texture, as they would be recorded with enhanced barriers.
+static void TranslateForTexture(EnhancedBarrierTranslator& Translator, std::vector<D3D12_RESOURCE_BARRIER> const& Barriers)
+{
+    Translator.Translate(Barriers.data(), (UINT)Barriers.size(), [](ID3D12Resource*) { return EnhancedBarrierResourceType::Texture; });
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ResourceStateManager, TransitionsTranslateToEnhancedBarriers)
+{
+    TestStateManager Manager;
+    EnhancedBarrierTranslator Translator;
+    TestResource Resource(1);
+    CViewSubresourceSubset Whole = MipSubset(Resource, 0, 1);
+
+    Manager.TransitionResource(Resource, GraphicsState(D3D12_RESOURCE_STATE_RENDER_TARGET));
+    TranslateForTexture(Translator, Manager.ApplyAllResourceTransitions(true));
+    ASSERT_EQ(Translator.GetNumGroups(), 1u);
+    ASSERT_EQ(Translator.GetGroups()[0].NumBarriers, 1u);
+    D3D12_TEXTURE_BARRIER const* pBarrier = Translator.GetGroups()[0].pTextureBarriers;
+    EXPECT_EQ(pBarrier->pResource, Resource.GetD3D12Resource());
+    EXPECT_EQ(pBarrier->SyncBefore, D3D12_BARRIER_SYNC_ALL);
+    EXPECT_EQ(pBarrier->SyncAfter, D3D12_BARRIER_SYNC_RENDER_TARGET);
+    EXPECT_EQ(pBarrier->LayoutBefore, D3D12_BARRIER_LAYOUT_COMMON);
+    EXPECT_EQ(pBarrier->LayoutAfter, D3D12_BARRIER_LAYOUT_RENDER_TARGET);
+
+    Resource.m_Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::PixelShaderResourceViewBound);
+    Manager.TransitionResourceForChangedBindings(Resource, Resource.m_Bindings);
+    TranslateForTexture(Translator, Manager.ApplyAllResourceTransitions(true));
+    ASSERT_EQ(Translator.GetNumGroups(), 1u);
+    pBarrier = Translator.GetGroups()[0].pTextureBarriers;
+    EXPECT_EQ(pBarrier->SyncBefore, D3D12_BARRIER_SYNC_RENDER_TARGET);
+    EXPECT_EQ(pBarrier->SyncAfter, D3D12_BARRIER_SYNC_PIXEL_SHADING);
+    EXPECT_EQ(pBarrier->AccessBefore, D3D12_BARRIER_ACCESS_RENDER_TARGET);
+    EXPECT_EQ(pBarrier->AccessAfter, D3D12_BARRIER_ACCESS_SHADER_RESOURCE);
+    EXPECT_EQ(pBarrier->LayoutAfter, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+
+    // Reading in another stage adds to the state, and the new readers have to wait for the render target writes too.
+    Resource.m_Bindings.ViewBoundCommon(Whole, &CSubresourceBindings::NonPixelShaderResourceViewBound);
+    Manager.TransitionResourceForChangedBindings(Resource, Resource.m_Bindings);
+    TranslateForTexture(Translator, Manager.ApplyAllResourceTransitions(true));
+    EXPECT_EQ(Translator.GetNumElided(), 0u);
+    ASSERT_EQ(Translator.GetNumGroups(), 1u);
+    pBarrier = Translator.GetGroups()[0].pTextureBarriers;
+    EXPECT_EQ(pBarrier->SyncBefore, D3D12_BARRIER_SYNC_PIXEL_SHADING);
+    EXPECT_EQ(pBarrier->SyncAfter, D3D12_BARRIER_SYNC_PIXEL_SHADING | D3D12_BARRIER_SYNC_NON_PIXEL_SHADING);
+    EXPECT_EQ(pBarrier->LayoutBefore, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+    EXPECT_EQ(pBarrier->LayoutAfter, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+}
@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(SPSCRing, PushAndPopInOrder)
+{
+    SPSCRing<UINT, 4> Ring;
+    EXPECT_TRUE(Ring.empty());
+    EXPECT_EQ(Ring.Front(), nullptr);
+
+    EXPECT_TRUE(Ring.TryPush(1));
+    EXPECT_TRUE(Ring.TryPush(2));
+    EXPECT_EQ(Ring.size(), 2u);
+    EXPECT_EQ(Ring[0], 1u);
+    EXPECT_EQ(Ring[1], 2u);
+
+    ASSERT_NE(Ring.Front(), nullptr);
+    EXPECT_EQ(*Ring.Front(), 1u);
+    Ring.Pop();
+    EXPECT_EQ(*Ring.Front(), 2u);
+    Ring.Pop();
+    EXPECT_TRUE(Ring.empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(SPSCRing, FullRingRejectsPushUntilPopped)
+{
+    SPSCRing<UINT, 4> Ring;
+    for (UINT i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(Ring.TryPush(i));
+    }
+    EXPECT_FALSE(Ring.TryPush(4));
+    EXPECT_EQ(Ring.size(), 4u);
+
+    Ring.Pop();
+    EXPECT_TRUE(Ring.TryPush(4));
+    EXPECT_FALSE(Ring.TryPush(5));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(SPSCRing, WrapsAround)
+{
+    SPSCRing<UINT, 4> Ring;
+    for (UINT i = 0; i < 37; ++i)
+    {
+        ASSERT_TRUE(Ring.TryPush(i));
+        ASSERT_TRUE(Ring.TryPush(i + 1000));
+        EXPECT_EQ(*Ring.Front(), i);
+        Ring.Pop();
+        EXPECT_EQ(*Ring.Front(), i + 1000);
+        Ring.Pop();
+    }
+    EXPECT_TRUE(Ring.empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(SPSCRing, ConcurrentProducerAndConsumer)
+{
+    constexpr UINT64 c_NumValues = 1000000;
+    SPSCRing<UINT64, 8> Ring;
+
+    std::thread Producer([&Ring]()
+    {
+        for (UINT64 i = 0; i < c_NumValues; )
+        {
+            if (Ring.TryPush(i))
+            {
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    UINT64 Expected = 0;
+    bool bInOrder = true;
+    while (Expected < c_NumValues)
+    {
+        if (UINT64 const* pValue = Ring.Front())
+        {
+            bInOrder = bInOrder && *pValue == Expected;
+            Ring.Pop();
+            ++Expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    Producer.join();
+
+    EXPECT_TRUE(bInOrder);
+    EXPECT_TRUE(Ring.empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(SpinThenParkSemaphore, PollOnlySucceedsAfterRelease)
+{
+    SpinThenParkSemaphore Semaphore;
+    EXPECT_FALSE(Semaphore.Wait(0));
+    Semaphore.Release();
+    Semaphore.Release();
+    EXPECT_TRUE(Semaphore.Wait(0));
+    EXPECT_TRUE(Semaphore.Wait(0));
+    EXPECT_FALSE(Semaphore.Wait(0));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(SpinThenParkSemaphore, TimedOutWaitDoesNotConsumeLaterRelease)
+{
+    SpinThenParkSemaphore Semaphore(0);
+    EXPECT_FALSE(Semaphore.Wait(10));
+    Semaphore.Release();
+    EXPECT_TRUE(Semaphore.Wait(0));
+    EXPECT_FALSE(Semaphore.Wait(0));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(SpinThenParkSemaphore, ReleaseWakesParkedWaiter)
+{
+    // No spinning, so the waiter parks straight away.
+    SpinThenParkSemaphore Semaphore(0);
+    constexpr UINT c_NumRounds = 1000;
+
+    std::thread Waiter([&Semaphore]()
+    {
+        for (UINT i = 0; i < c_NumRounds; ++i)
+        {
+            Semaphore.Wait(INFINITE);
+        }
+    });
+    for (UINT i = 0; i < c_NumRounds; ++i)
+    {
+        Semaphore.Release();
+    }
+    Waiter.join();
+
+    EXPECT_FALSE(Semaphore.Wait(0));
+}
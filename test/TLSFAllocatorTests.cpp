@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace BlockAllocators;
+
+// Stands in for the heaps backing each chunk, and tracks how many are live.
+struct CountingInnerAllocator
+{
+    UINT* m_pNumLive;
+    UINT m_NextID = 1;
+
+    CountingInnerAllocator(UINT* pNumLive) : m_pNumLive(pNumLive) {}
+    UINT Allocate(UINT64) { ++*m_pNumLive; return m_NextID++; }
+    void Deallocate(UINT ID) { EXPECT_NE(ID, 0u); --*m_pNumLive; }
+    void Reset() {}
+};
+
+static constexpr UINT64 c_Granularity = 256;
+static constexpr UINT64 c_ChunkSize = 64 * 1024;
+static constexpr UINT c_NumChunks = 4;
+using Block = CGenericBlock<UINT64>;
+using TLSFAllocator = CDisjointTLSFAllocator<Block, CountingInnerAllocator, UINT64, c_Granularity>;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(TLSFAllocator, RoundsToGranularity)
+{
+    UINT NumLive = 0;
+    TLSFAllocator Allocator(c_ChunkSize * c_NumChunks, c_ChunkSize, &NumLive);
+
+    Block A = Allocator.Allocate(1);
+    Block B = Allocator.Allocate(0);
+    Block C = Allocator.Allocate(c_Granularity + 1);
+    EXPECT_EQ(A.GetSize(), c_Granularity);
+    EXPECT_EQ(B.GetSize(), c_Granularity);
+    EXPECT_EQ(C.GetSize(), 2 * c_Granularity);
+    for (Block const& b : { A, B, C })
+    {
+        EXPECT_EQ(b.GetOffset() % c_Granularity, 0u);
+        EXPECT_TRUE(Allocator.IsOwner(b));
+        EXPECT_EQ(Allocator.GetInnerAllocationOffset(b), b.GetOffset() % c_ChunkSize);
+    }
+    EXPECT_EQ(Allocator.GetAllocatedSize(), 4 * c_Granularity);
+
+    // All three fit in the first chunk, which is backed by a single inner allocation.
+    EXPECT_EQ(NumLive, 1u);
+    EXPECT_EQ(Allocator.GetCommittedSize(), c_ChunkSize);
+    EXPECT_EQ(Allocator.GetInnerAllocation(A), Allocator.GetInnerAllocation(C));
+
+    Allocator.Deallocate(A);
+    Allocator.Deallocate(B);
+    Allocator.Deallocate(C);
+    EXPECT_EQ(NumLive, 0u);
+    EXPECT_EQ(Allocator.GetAllocatedSize(), 0u);
+    EXPECT_EQ(Allocator.GetCommittedSize(), 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(TLSFAllocator, RejectsOversizedAndExhaustedRequests)
+{
+    UINT NumLive = 0;
+    TLSFAllocator Allocator(c_ChunkSize * c_NumChunks, c_ChunkSize, &NumLive);
+    EXPECT_THROW(Allocator.Allocate(c_ChunkSize + 1), std::bad_alloc);
+
+    std::vector<Block> Blocks;
+    for (UINT i = 0; i < c_NumChunks; ++i)
+    {
+        Blocks.push_back(Allocator.Allocate(c_ChunkSize));
+        EXPECT_EQ(Blocks.back().GetSize(), c_ChunkSize);
+        EXPECT_EQ(Blocks.back().GetOffset() % c_ChunkSize, 0u);
+    }
+    EXPECT_EQ(NumLive, c_NumChunks);
+
+    // The virtual range is exhausted, which is reported with a null block.
+    Block Null = Allocator.Allocate(1);
+    EXPECT_EQ(Null.GetSize(), 0u);
+
+    for (Block const& b : Blocks)
+    {
+        Allocator.Deallocate(b);
+    }
+    EXPECT_EQ(NumLive, 0u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(TLSFAllocator, RandomAllocationsNeverOverlap)
+{
+    UINT NumLive = 0;
+    TLSFAllocator Allocator(c_ChunkSize * c_NumChunks, c_ChunkSize, &NumLive);
+    std::mt19937 Random(1234);
+    std::map<UINT64, UINT64> Live; // Offset to size
+    UINT64 LiveSize = 0;
+
+    for (UINT i = 0; i < 20000; ++i)
+    {
+        if (!Live.empty() && (Random() % 2 || Live.size() > 200))
+        {
+            auto iter = Live.begin();
+            std::advance(iter, Random() % Live.size());
+            Allocator.Deallocate(Block(iter->first, iter->second));
+            LiveSize -= iter->second;
+            Live.erase(iter);
+        }
+        else
+        {
+            // Mostly small blocks, with the occasional large one.
+            const UINT64 Size = (Random() % 8 == 0) ? Random() % c_ChunkSize : Random() % (4 * c_Granularity);
+            Block b = Allocator.Allocate(Size);
+            if (b.GetSize() == 0)
+            {
+                continue; // Fragmented out of room, which is allowed.
+            }
+            ASSERT_GE(b.GetSize(), Size);
+            ASSERT_LT(b.GetSize(), max<UINT64>(Size, 1) + c_Granularity);
+            ASSERT_EQ(b.GetOffset() / c_ChunkSize, (b.GetOffset() + b.GetSize() - 1) / c_ChunkSize) << "Block straddles a chunk";
+
+            auto next = Live.lower_bound(b.GetOffset());
+            if (next != Live.end())
+            {
+                ASSERT_LE(b.GetOffset() + b.GetSize(), next->first);
+            }
+            if (next != Live.begin())
+            {
+                auto prev = std::prev(next);
+                ASSERT_LE(prev->first + prev->second, b.GetOffset());
+            }
+            Live.emplace(b.GetOffset(), b.GetSize());
+            LiveSize += b.GetSize();
+        }
+        ASSERT_EQ(Allocator.GetAllocatedSize(), LiveSize);
+    }
+
+    for (auto const& [Offset, Size] : Live)
+    {
+        Allocator.Deallocate(Block(Offset, Size));
+    }
+    EXPECT_EQ(NumLive, 0u);
+    EXPECT_EQ(Allocator.GetCommittedSize(), 0u);
+
+    // Everything coalesced back into whole chunks.
+    for (UINT i = 0; i < c_NumChunks; ++i)
+    {
+        EXPECT_EQ(Allocator.Allocate(c_ChunkSize).GetSize(), c_ChunkSize);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(TLSFAllocator, ResetReleasesInnerAllocations)
+{
+    UINT NumLive = 0;
+    TLSFAllocator Allocator(c_ChunkSize * c_NumChunks, c_ChunkSize, &NumLive);
+    (void)Allocator.Allocate(c_ChunkSize);
+    (void)Allocator.Allocate(c_Granularity);
+    EXPECT_EQ(NumLive, 2u);
+
+    Allocator.Reset();
+    EXPECT_EQ(NumLive, 0u);
+    EXPECT_EQ(Allocator.GetAllocatedSize(), 0u);
+    EXPECT_EQ(Allocator.Allocate(c_ChunkSize).GetOffset(), 0u);
+}
@@ -0,0 +1,213 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+#include <future>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+// Occupies a worker until released, so that later work stays queued.
+class BlockingWork
+{
+public:
+    void Queue(CThreadPool& Pool)
+    {
+        Pool.QueueThreadpoolWork(m_Work, [this]()
+        {
+            m_Started.set_value();
+            m_Release.wait();
+        });
+        m_Started.get_future().wait();
+    }
+    void Release() { m_Gate.set_value(); }
+
+private:
+    std::promise<void> m_Started;
+    std::promise<void> m_Gate;
+    std::shared_future<void> m_Release{ m_Gate.get_future() };
+    CThreadPoolWork m_Work; // Last, so that it's waited for before the promises are destroyed
+};
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ThreadPool, StartsWorkersOnDemandUpToMaximum)
+{
+    CThreadPool Pool(2);
+    EXPECT_EQ(Pool.GetNumThreads(), 2u);
+    EXPECT_EQ(Pool.GetNumStartedThreads(), 0u);
+
+    std::promise<void> Gate;
+    std::shared_future<void> Release = Gate.get_future();
+    CThreadPoolWork Work[5];
+    for (auto& w : Work)
+    {
+        Pool.QueueThreadpoolWork(w, [Release]() { Release.wait(); });
+        EXPECT_LE(Pool.GetNumStartedThreads(), 2u);
+    }
+    // Every worker was busy or starting when the rest were queued
+    EXPECT_EQ(Pool.GetNumStartedThreads(), 2u);
+
+    Gate.set_value();
+    for (auto& w : Work)
+    {
+        w.Wait(false);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ThreadPool, RunsAllWork)
+{
+    CThreadPool Pool;
+    std::atomic<UINT> Count{ 0 };
+    std::vector<std::unique_ptr<CThreadPoolWork>> Work(1000);
+    for (auto& spWork : Work)
+    {
+        spWork.reset(new CThreadPoolWork);
+        Pool.QueueThreadpoolWork(*spWork, [&Count]() { Count.fetch_add(1, std::memory_order_relaxed); });
+    }
+    for (auto& spWork : Work)
+    {
+        spWork->Wait(false);
+        EXPECT_FALSE(*spWork);
+    }
+    EXPECT_EQ(Count.load(), 1000u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ThreadPool, WaitCancelsOrRunsUnstartedWork)
+{
+    CThreadPool Pool(1);
+    BlockingWork Blocker;
+    Blocker.Queue(Pool);
+
+    bool bCancelledRan = false;
+    CThreadPoolWork Cancelled;
+    Pool.QueueThreadpoolWork(Cancelled, [&bCancelledRan]() { bCancelledRan = true; });
+    EXPECT_TRUE(Cancelled);
+    Cancelled.Wait(true);
+    EXPECT_FALSE(Cancelled);
+    EXPECT_FALSE(bCancelledRan);
+
+    std::thread::id RanOn;
+    CThreadPoolWork Inline;
+    Pool.QueueThreadpoolWork(Inline, [&RanOn]() { RanOn = std::this_thread::get_id(); });
+    Inline.Wait(false);
+    EXPECT_EQ(RanOn, std::this_thread::get_id());
+
+    // Work can be queued again once it's been waited on
+    Pool.QueueThreadpoolWork(Cancelled, [&bCancelledRan]() { bCancelledRan = true; });
+    Blocker.Release();
+    Cancelled.Wait(false);
+    EXPECT_TRUE(bCancelledRan);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ThreadPool, QueueingOutstandingWorkFails)
+{
+    CThreadPool Pool(1);
+    BlockingWork Blocker;
+    Blocker.Queue(Pool);
+
+    CThreadPoolWork Work;
+    Pool.QueueThreadpoolWork(Work, []() {});
+    EXPECT_THROW(Pool.QueueThreadpoolWork(Work, []() {}), _com_error);
+    Blocker.Release();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ThreadPool, RunsHigherPriorityFirst)
+{
+    std::vector<CThreadPool::EPriority> Order;
+    CThreadPoolWork Work[3];
+    BlockingWork Blocker;
+    {
+        CThreadPool Pool(1);
+        Pool.SetCancelPendingWorkOnCleanup(false);
+        Blocker.Queue(Pool);
+
+        // Only the worker touches Order, and the pool's destruction waits for it
+        const CThreadPool::EPriority Priorities[] = { CThreadPool::EPriority::Low, CThreadPool::EPriority::Normal, CThreadPool::EPriority::High };
+        for (UINT i = 0; i < _countof(Priorities); ++i)
+        {
+            const CThreadPool::EPriority Priority = Priorities[i];
+            Pool.QueueThreadpoolWork(Work[i], [&Order, Priority]() { Order.push_back(Priority); }, Priority);
+        }
+        Blocker.Release();
+    }
+    EXPECT_EQ(Order, (std::vector<CThreadPool::EPriority>{ CThreadPool::EPriority::High, CThreadPool::EPriority::Normal, CThreadPool::EPriority::Low }));
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ThreadPool, WorkerCanQueueAndWaitForWork)
+{
+    CThreadPool Pool(2);
+    std::atomic<UINT> Count{ 0 };
+    CThreadPoolWork Outer, Inner;
+    Pool.QueueThreadpoolWork(Outer, [&]()
+    {
+        Pool.QueueThreadpoolWork(Inner, [&Count]() { Count.fetch_add(1); });
+        Inner.Wait(false);
+        Count.fetch_add(1);
+    });
+    Outer.Wait(false);
+    EXPECT_EQ(Count.load(), 2u);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(ThreadPool, ConcurrentQueueWaitAndCancel)
+{
+    CThreadPool Pool(4);
+    constexpr UINT NumThreads = 4;
+    constexpr UINT NumIterations = 2000;
+    std::atomic<UINT> NumRan{ 0 };
+    std::atomic<UINT> NumCancelled{ 0 };
+
+    std::vector<std::thread> Threads;
+    for (UINT t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]()
+        {
+            CThreadPoolWork Work[4];
+            bool bRan[4] = {};
+            bool bPending[4] = {};
+            UINT NumWaitedRan = 0, NumWaitedCancelled = 0;
+            auto WaitFor = [&](UINT Slot, bool bCancel)
+            {
+                Work[Slot].Wait(bCancel);
+                if (bPending[Slot])
+                {
+                    // Cancelled work never starts, anything else has run to completion
+                    (bRan[Slot] ? NumWaitedRan : NumWaitedCancelled)++;
+                    bPending[Slot] = false;
+                }
+            };
+
+            for (UINT i = 0; i < NumIterations; ++i)
+            {
+                const UINT Slot = i % _countof(Work);
+                WaitFor(Slot, false);
+                bRan[Slot] = false;
+                bPending[Slot] = true;
+                Pool.QueueThreadpoolWork(Work[Slot], [&bRan, Slot]() { bRan[Slot] = true; }, (CThreadPool::EPriority)((i + t) % 3));
+                if (i % 3 == 0)
+                {
+                    WaitFor(Slot, true);
+                }
+            }
+            for (UINT Slot = 0; Slot < _countof(Work); ++Slot)
+            {
+                WaitFor(Slot, false);
+            }
+            NumRan.fetch_add(NumWaitedRan);
+            NumCancelled.fetch_add(NumWaitedCancelled);
+        });
+    }
+    for (auto& Thread : Threads)
+    {
+        Thread.join();
+    }
+
+    EXPECT_EQ(NumRan.load() + NumCancelled.load(), NumThreads * NumIterations);
+    // Only every third item is waited on with cancellation
+    EXPECT_LE(NumCancelled.load(), NumThreads * NumIterations / 3 + NumThreads);
+}
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include <gtest/gtest.h>
+
+using namespace D3D12TranslationLayer;
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(TicksToMicroseconds, MatchesDirectConversion)
+{
+    EXPECT_EQ(TicksToMicroseconds(0, 10000000), 0u);
+    EXPECT_EQ(TicksToMicroseconds(9, 10000000), 0u);
+    EXPECT_EQ(TicksToMicroseconds(10, 10000000), 1u);
+    EXPECT_EQ(TicksToMicroseconds(15000000, 10000000), 1500000u);
+    EXPECT_EQ(TicksToMicroseconds(12345, 3000000), UINT64(12345) * 1000000 / 3000000);
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------
+TEST(TicksToMicroseconds, DoesNotOverflow)
+{
+    // Ticks * 1000000 overflows 64 bits past this many ticks
+    const UINT64 OverflowTicks = UINT64_MAX / 1000000 + 1;
+    constexpr UINT64 TicksPerSecond = 10000000;
+    EXPECT_EQ(TicksToMicroseconds(OverflowTicks, TicksPerSecond), OverflowTicks / 10);
+    EXPECT_EQ(TicksToMicroseconds(UINT64_MAX, TicksPerSecond), UINT64_MAX / 10);
+
+    // Odd frequencies, where the remainder is scaled separately
+    EXPECT_EQ(TicksToMicroseconds(OverflowTicks * 3, 3000000), OverflowTicks);
+}
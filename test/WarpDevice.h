@@ -0,0 +1,17 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+
+// Tests of components which need a device use WARP, so that they don't need a GPU. Returns null if WARP isn't available.
+inline CComPtr<ID3D12Device3> CreateWarpDevice()
+{
+    CComPtr<IDXGIFactory4> spFactory;
+    CComPtr<IDXGIAdapter> spAdapter;
+    CComPtr<ID3D12Device3> spDevice;
+    if (SUCCEEDED(CreateDXGIFactory2(0, IID_PPV_ARGS(&spFactory))) &&
+        SUCCEEDED(spFactory->EnumWarpAdapter(IID_PPV_ARGS(&spAdapter))))
+    {
+        (void)D3D12CreateDevice(spAdapter, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&spDevice));
+    }
+    return spDevice;
+}